@@ -31,6 +31,7 @@
 #include "celix_log_service.h"
 #include "celix_log_sink.h"
 #include "celix_utils.h"
+#include "celix_string_hash_map.h"
 #include "celix_log_utils.h"
 #include "celix_log_constants.h"
 #include "celix_shell_command.h"
@@ -54,8 +55,8 @@ struct celix_log_admin {
     long cmdSvcId;
 
     celix_thread_rwlock_t lock; //protects below
-    hash_map_t *loggers; //key = name, value = celix_log_service_instance_t
-    hash_map_t* sinks; //key = name, value = celix_log_sink_t
+    celix_string_hash_map_t *loggers; //key = name, value = celix_log_service_instance_t
+    celix_string_hash_map_t* sinks; //key = name, value = celix_log_sink_t
 };
 
 typedef struct celix_log_service_entry {
@@ -88,10 +89,9 @@ static void celix_logAdmin_vlogDetails(void *handle, celix_log_level_e level, co
 
     celixThreadRwlock_readLock(&entry->admin->lock);
     if (level >= entry->activeLogLevel) {
-        int nrOfLogWriters = hashMap_size(entry->admin->sinks);
-        hash_map_iterator_t iter = hashMapIterator_construct(entry->admin->sinks);
-        while (hashMapIterator_hasNext(&iter)) {
-            celix_log_sink_entry_t *sinkEntry = hashMapIterator_nextValue(&iter);
+        int nrOfLogWriters = (int)celix_stringHashMap_size(entry->admin->sinks);
+        CELIX_STRING_HASH_MAP_ITERATE(entry->admin->sinks, iter) {
+            celix_log_sink_entry_t *sinkEntry = iter.value;
             if (sinkEntry->enabled) {
                 celix_log_sink_t *sink = sinkEntry->sink;
                 sink->sinkLog(sink->handle, level, entry->logSvcId, entry->name, file, function, line, format, formatArgs);
@@ -175,7 +175,7 @@ static void celix_logAdmin_addLogSvcForName(celix_log_admin_t* admin, const char
     celix_log_service_entry_t* newEntry = NULL;
 
     celixThreadRwlock_writeLock(&admin->lock);
-    celix_log_service_entry_t* found = hashMap_get(admin->loggers, name);
+    celix_log_service_entry_t* found = celix_stringHashMap_get(admin->loggers, name);
     if (found == NULL) {
         //new
         newEntry = calloc(1, sizeof(*newEntry));
@@ -194,7 +194,7 @@ static void celix_logAdmin_addLogSvcForName(celix_log_admin_t* admin, const char
         newEntry->logSvc.logDetails = celix_logAdmin_logDetails;
         newEntry->logSvc.vlog = celix_logAdmin_vlog;
         newEntry->logSvc.vlogDetails = celix_logAdmin_vlogDetails;
-        hashMap_put(admin->loggers, (void*)newEntry->name, newEntry);
+        celix_stringHashMap_put(admin->loggers, newEntry->name, newEntry);
 
         if (celix_utils_stringEquals(newEntry->name, CELIX_LOG_ADMIN_FRAMEWORK_LOG_NAME)) {
             celix_framework_t* fw = celix_bundleContext_getFramework(admin->ctx);
@@ -236,13 +236,13 @@ static void celix_logAdmin_remLogSvcForName(celix_log_admin_t* admin, const char
     celix_log_service_entry_t* remEntry = NULL;
 
     celixThreadRwlock_writeLock(&admin->lock);
-    celix_log_service_entry_t* found = hashMap_get(admin->loggers, name);
+    celix_log_service_entry_t* found = celix_stringHashMap_get(admin->loggers, name);
     if (found != NULL) {
         found->count -= 1;
         if (found->count == 0) {
             //remove
             remEntry = found;
-            hashMap_remove(admin->loggers, name);
+            celix_stringHashMap_remove(admin->loggers, name);
         }
     }
     celixThreadRwlock_unlock(&admin->lock);
@@ -283,14 +283,14 @@ static void celix_logAdmin_addSink(void *handle, void *svc, const celix_properti
     }
 
     celixThreadRwlock_writeLock(&admin->lock);
-    celix_log_sink_entry_t* found = hashMap_get(admin->sinks, sinkName);
+    celix_log_sink_entry_t* found = celix_stringHashMap_get(admin->sinks, sinkName);
     if (found == NULL) {
         celix_log_sink_entry_t *entry = calloc(1, sizeof(*entry));
         entry->name = celix_utils_strdup(sinkName);
         entry->svcId = svcId;
         entry->enabled = admin->sinksDefaultEnabled;
         entry->sink = sink;
-        hashMap_put(admin->sinks, entry->name, entry);
+        celix_stringHashMap_put(admin->sinks, entry->name, entry);
     }
     celixThreadRwlock_unlock(&admin->lock);
 
@@ -310,13 +310,13 @@ static void celix_logAdmin_remSink(void *handle, void *svc __attribute__((unused
     }
 
     celixThreadRwlock_writeLock(&admin->lock);
-    celix_log_sink_entry_t* entry = hashMap_get(admin->sinks, sinkName);
+    celix_log_sink_entry_t* entry = celix_stringHashMap_get(admin->sinks, sinkName);
     if (entry->svcId != svcId) {
         //no match (note there can be invalid log sinks with the same name, but different svc ids.
         entry = NULL;
     }
     if (entry != NULL) {
-        hashMap_remove(admin->sinks, sinkName);
+        celix_stringHashMap_remove(admin->sinks, sinkName);
     }
     celixThreadRwlock_unlock(&admin->lock);
 
@@ -331,11 +331,10 @@ static size_t celix_logAdmin_nrOfLogServices(void *handle, const char* select) {
     size_t count = 0;
     celixThreadRwlock_readLock(&admin->lock);
     if (select == NULL) {
-        count = hashMap_size(admin->loggers);
+        count = celix_stringHashMap_size(admin->loggers);
     } else {
-        hash_map_iterator_t iter = hashMapIterator_construct(admin->loggers);
-        while (hashMapIterator_hasNext(&iter)) {
-            celix_log_service_entry_t *visit = hashMapIterator_nextValue(&iter);
+        CELIX_STRING_HASH_MAP_ITERATE(admin->loggers, iter) {
+            celix_log_service_entry_t *visit = iter.value;
             char *match = strcasestr(visit->name, select);
             if (match != NULL && match == visit->name) {
                 //note if select is found in visit->name and visit->name start with select
@@ -352,11 +351,10 @@ static size_t celix_logAdmin_nrOfSinks(void *handle, const char* select) {
     size_t count = 0;
     celixThreadRwlock_readLock(&admin->lock);
     if (select == NULL) {
-        count = hashMap_size(admin->sinks);
+        count = celix_stringHashMap_size(admin->sinks);
     } else {
-        hash_map_iterator_t iter = hashMapIterator_construct(admin->sinks);
-        while (hashMapIterator_hasNext(&iter)) {
-            celix_log_sink_entry_t *visit = hashMapIterator_nextValue(&iter);
+        CELIX_STRING_HASH_MAP_ITERATE(admin->sinks, iter) {
+            celix_log_sink_entry_t *visit = iter.value;
             char *match = strcasestr(visit->name, select);
             if (match != NULL && match == visit->name) {
                 //note if select is found in visit->name and visit->name start with select
@@ -372,9 +370,8 @@ static size_t celix_logAdmin_setActiveLogLevels(void *handle, const char* select
     celix_log_admin_t* admin = handle;
     size_t count = 0;
     celixThreadRwlock_writeLock(&admin->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(admin->loggers);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_log_service_entry_t* visit = hashMapIterator_nextValue(&iter);
+    CELIX_STRING_HASH_MAP_ITERATE(admin->loggers, iter) {
+        celix_log_service_entry_t* visit = iter.value;
         if (select == NULL) {
             visit->activeLogLevel = activeLogLevel;
             count += 1;
@@ -395,9 +392,8 @@ static size_t celix_logAdmin_setSinkEnabled(void *handle, const char* select, bo
     celix_log_admin_t* admin = handle;
     size_t count = 0;
     celixThreadRwlock_writeLock(&admin->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(admin->sinks);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_log_sink_entry_t* visit = hashMapIterator_nextValue(&iter);
+    CELIX_STRING_HASH_MAP_ITERATE(admin->sinks, iter) {
+        celix_log_sink_entry_t* visit = iter.value;
         if (select == NULL) {
             visit->enabled = enabled;
             count += 1;
@@ -419,9 +415,8 @@ static celix_array_list_t* celix_logAdmin_currentLogServices(void *handle) {
     celix_log_admin_t* admin = handle;
     celix_array_list_t* loggers = celix_arrayList_create();
     celixThreadRwlock_readLock(&admin->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(admin->loggers);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_log_service_entry_t* visit = hashMapIterator_nextValue(&iter);
+    CELIX_STRING_HASH_MAP_ITERATE(admin->loggers, iter) {
+        celix_log_service_entry_t* visit = iter.value;
         celix_arrayList_add(loggers, celix_utils_strdup(visit->name));
     }
     celixThreadRwlock_unlock(&admin->lock);
@@ -432,9 +427,8 @@ static celix_array_list_t* celix_logAdmin_currentSinks(void *handle) {
     celix_log_admin_t* admin = handle;
     celix_array_list_t* sinks = celix_arrayList_create();
     celixThreadRwlock_readLock(&admin->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(admin->sinks);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_log_sink_entry_t* entry = hashMapIterator_nextValue(&iter);
+    CELIX_STRING_HASH_MAP_ITERATE(admin->sinks, iter) {
+        celix_log_sink_entry_t* entry = iter.value;
         celix_arrayList_add(sinks, celix_utils_strdup(entry->name));
     }
     celixThreadRwlock_unlock(&admin->lock);
@@ -444,7 +438,7 @@ static celix_array_list_t* celix_logAdmin_currentSinks(void *handle) {
 static bool celix_logAdmin_logServiceInfo(void *handle, const char* logServiceName, celix_log_level_e* outActiveLogLevel) {
     celix_log_admin_t* admin = handle;
     celixThreadRwlock_readLock(&admin->lock);
-    celix_log_service_entry_t* found = hashMap_get(admin->loggers, logServiceName);
+    celix_log_service_entry_t* found = celix_stringHashMap_get(admin->loggers, logServiceName);
     if (found != NULL && outActiveLogLevel != NULL) {
         *outActiveLogLevel = found->activeLogLevel;
     }
@@ -455,7 +449,7 @@ static bool celix_logAdmin_logServiceInfo(void *handle, const char* logServiceNa
 static bool celix_logAdmin_sinkInfo(void *handle, const char* sinkName, bool* outEnabled) {
     celix_log_admin_t* admin = handle;
     celixThreadRwlock_readLock(&admin->lock);
-    celix_log_sink_entry_t* found = hashMap_get(admin->sinks, sinkName);
+    celix_log_sink_entry_t* found = celix_stringHashMap_get(admin->sinks, sinkName);
     if (found != NULL && outEnabled != NULL) {
         *outEnabled = found->enabled;
     }
@@ -573,8 +567,10 @@ static bool celix_logAdmin_executeCommand(void *handle, const char *commandLine,
 celix_log_admin_t* celix_logAdmin_create(celix_bundle_context_t *ctx) {
     celix_log_admin_t* admin = calloc(1, sizeof(*admin));
     admin->ctx = ctx;
-    admin->loggers = hashMap_create((void*)celix_utils_stringHash, NULL, (void*)celix_utils_stringEquals, NULL);
-    admin->sinks = hashMap_create((void*)celix_utils_stringHash, NULL, (void*)celix_utils_stringEquals, NULL);
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true; //note key is the name of the entry
+    admin->loggers = celix_stringHashMap_createWithOptions(&opts);
+    admin->sinks = celix_stringHashMap_createWithOptions(&opts);
 
     admin->fallbackToStdOut = celix_bundleContext_getPropertyAsBool(ctx, CELIX_LOG_ADMIN_FALLBACK_TO_STDOUT_CONFIG_NAME, CELIX_LOG_ADMIN_FALLBACK_TO_STDOUT_DEFAULT_VALUE);
     admin->alwaysLogToStdOut = celix_bundleContext_getPropertyAsBool(ctx, CELIX_LOG_ADMIN_ALWAYS_USE_STDOUT_CONFIG_NAME, CELIX_LOG_ADMIN_ALWAYS_USE_STDOUT_DEFAULT_VALUE);
@@ -647,11 +643,11 @@ void celix_logAdmin_destroy(celix_log_admin_t *admin) {
         celix_bundleContext_stopTracker(admin->ctx, admin->logServiceMetaTrackerId);
         celix_bundleContext_stopTracker(admin->ctx, admin->logWriterTrackerId);
 
-        assert(hashMap_size(admin->loggers) == 0); //note stopping service tracker tracker should triggered all needed remove events
-        hashMap_destroy(admin->loggers, false, false);
+        assert(celix_stringHashMap_size(admin->loggers) == 0); //note stopping service tracker tracker should triggered all needed remove events
+        celix_stringHashMap_destroy(admin->loggers);
 
-        assert(hashMap_size(admin->sinks) == 0); //note stopping service tracker should triggered all needed remove events
-        hashMap_destroy(admin->sinks, false, false);
+        assert(celix_stringHashMap_size(admin->sinks) == 0); //note stopping service tracker should triggered all needed remove events
+        celix_stringHashMap_destroy(admin->sinks);
 
         celixThreadRwlock_destroy(&admin->lock);
         free(admin);
@@ -57,6 +57,64 @@
 #define PUBSUB_TCP_SUBSCRIBER_RETRY_CNT_KEY     "PUBSUB_TCP_SUBSCRIBER_RETRY_COUNT"
 #define PUBSUB_TCP_SUBSCRIBER_RETRY_CNT_DEFAULT 5
 
+/**
+ * Nr of threads reading the connections of a subscriber, the connections are divided over the threads.
+ * If <= 1 (default), the connections are read by the socket thread.
+ * Note that without dispatch threads the messages are dispatched by the receive threads while reading, so subscribers
+ * are called concurrently for messages of publishers on connections read by different receive threads.
+ * The order of the messages of a publisher is kept.
+ */
+#define PUBSUB_TCP_SUBSCRIBER_RECEIVE_THREADS_KEY       "PUBSUB_TCP_SUBSCRIBER_RECEIVE_THREADS"
+#define PUBSUB_TCP_SUBSCRIBER_RECEIVE_THREADS_DEFAULT   0
+
+/**
+ * Nr of threads deserializing and dispatching the received messages to the subscribers.
+ * The messages of a publisher are always dispatched by the same thread, so the order of the messages of a publisher
+ * is kept. Note subscribers can be called concurrently for messages of different publishers.
+ * If 0 (default), the messages are dispatched by the thread reading the connection.
+ */
+#define PUBSUB_TCP_SUBSCRIBER_DISPATCH_THREADS_KEY      "PUBSUB_TCP_SUBSCRIBER_DISPATCH_THREADS"
+#define PUBSUB_TCP_SUBSCRIBER_DISPATCH_THREADS_DEFAULT  0
+
+/**
+ * Size of the per connection send queue of a publisher.
+ * If > 0, messages are send non-blocking and the part that cannot be send directly
+ * is queued and send by the socket thread when the connection is ready to write.
+ * If 0 (default), messages are send blocking.
+ */
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_KEY     "PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE"
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_DEFAULT 0
+
+/**
+ * Policy applied when the send queue of a connection is full.
+ * Can be "drop-oldest" (default), "drop-newest", "block" (wait at most the send timeout,
+ * else drop the newest message) or "disconnect".
+ */
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_KEY      "PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY"
+#define PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST        "drop-oldest"
+#define PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_NEWEST        "drop-newest"
+#define PUBSUB_TCP_SEND_QUEUE_POLICY_BLOCK              "block"
+#define PUBSUB_TCP_SEND_QUEUE_POLICY_DISCONNECT         "disconnect"
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_DEFAULT  PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST
+
+/**
+ * Max size in bytes of a batch of published messages.
+ * If > 0, messages are encoded in a batch and the batch is send as one write to the subscribers when
+ * its size exceeds the max batch size or its oldest message exceeds the max batch delay.
+ * If 0 (default), every message is send directly.
+ * Batching requires the send queue, if no send queue size is configured a send queue of
+ * PUBSUB_TCP_PUBLISHER_BATCH_SEND_QUEUE_SIZE_DEFAULT messages is used.
+ */
+#define PUBSUB_TCP_PUBLISHER_BATCH_SIZE_KEY      "PUBSUB_TCP_PUBLISHER_BATCH_SIZE"
+#define PUBSUB_TCP_PUBLISHER_BATCH_SIZE_DEFAULT  0
+#define PUBSUB_TCP_PUBLISHER_BATCH_SEND_QUEUE_SIZE_DEFAULT 16
+
+/**
+ * Max delay in ms of a message in a batch of published messages.
+ */
+#define PUBSUB_TCP_PUBLISHER_BATCH_DELAY_KEY     "PUBSUB_TCP_PUBLISHER_BATCH_DELAY"
+#define PUBSUB_TCP_PUBLISHER_BATCH_DELAY_DEFAULT 1
+
 
 //Time-out settings are only for BLOCKING connections
 #define PUBSUB_TCP_PUBLISHER_SNDTIMEO_KEY       "PUBSUB_TCP_PUBLISHER_SEND_TIMEOUT"
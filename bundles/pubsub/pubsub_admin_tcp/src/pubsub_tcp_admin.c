@@ -712,6 +712,20 @@ bool pubsub_tcpAdmin_executeCommand(void *handle, const char *commandLine __attr
         fprintf(out, "   |- serializer type = %s\n", serType);
         fprintf(out, "   |- protocol type = %s\n", protType);
         fprintf(out, "   |- url            = %s%s\n", url, postUrl);
+        pubsub_tcpHandler_sendQueueStats_t *stats = NULL;
+        size_t nrOfStats = pubsub_tcpTopicSender_sendQueueStats(sender, &stats);
+        for (size_t i = 0; i < nrOfStats; i++) {
+            fprintf(out, "   |- send queue %s: depth = %u, max depth = %u, queued = %lu, dropped = %lu\n",
+                    stats[i].url, stats[i].queueDepth, stats[i].maxQueueDepth, stats[i].nrOfQueuedMessages,
+                    stats[i].nrOfDroppedMessages);
+        }
+        free(stats);
+        pubsub_tcpHandler_batchStats_t batchStats;
+        if (pubsub_tcpTopicSender_batchStats(sender, &batchStats)) {
+            double avg = batchStats.nrOfBatches > 0 ? (double) batchStats.nrOfBatchedMessages / (double) batchStats.nrOfBatches : 0.0;
+            fprintf(out, "   |- batches = %lu, batched messages = %lu, avg messages per batch = %.1f, max messages per batch = %u\n",
+                    batchStats.nrOfBatches, batchStats.nrOfBatchedMessages, avg, batchStats.maxMessagesPerBatch);
+        }
     }
     celixThreadMutex_unlock(&psa->topicSenders.mutex);
     celixThreadMutex_unlock(&psa->protocols.mutex);
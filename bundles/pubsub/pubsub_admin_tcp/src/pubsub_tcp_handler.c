@@ -40,6 +40,7 @@
 #endif
 #include <limits.h>
 #include <assert.h>
+#include <poll.h>
 #include "ctype.h"
 #include <netdb.h>
 #include <signal.h>
@@ -52,6 +53,13 @@
 
 #define MAX_EVENTS   64
 #define MAX_DEFAULT_BUFFER_SIZE 4u
+#define MAX_DISPATCH_QUEUE_SIZE 1024u
+#define MIN_RECEIVE_BUFFER_SIZE 1024u
+#define NR_OF_RECEIVE_BUFFER_CLASSES 11 // 1 KiB .. 1 MiB, larger buffers are not pooled
+#define RECEIVE_BUFFER_POOL_DEPTH 64u // nr of free buffers per size class and per receive session
+#define SEND_BUFFER_NOF_IOV 4u // header, payload, metadata and footer, send buffers with more vector items are not pooled
+#define SEND_BUFFER_POOL_DEPTH 64u // nr of free send buffers
+#define MAX_POOLED_SEND_DATA_SIZE (1024u * 1024u) // larger contiguous copies are freed when the send buffer is pooled
 
 #if defined(__APPLE__)
 #define MSG_NOSIGNAL (0)
@@ -66,6 +74,15 @@
 #define L_ERROR(...) \
     celix_logHelper_log(handle->logHelper, CELIX_LOG_LEVEL_ERROR, __VA_ARGS__)
 
+//
+// Receive buffer of the receive buffer pool, used by a connection or by the dispatch job of a received message
+//
+typedef struct psa_tcp_receive_buffer {
+    void *data;
+    unsigned int size; // size of the size class, or the requested size for buffers which are too large to be pooled
+    struct psa_tcp_receive_buffer *next; // next free buffer of the size class
+} psa_tcp_receive_buffer_t;
+
 //
 // Entry administration
 //
@@ -84,14 +101,83 @@ typedef struct psa_tcp_connection_entry {
     void *headerBuffer;
     unsigned int footerSize;
     void *footerBuffer;
-    unsigned int bufferSize;
-    void *buffer;
+    psa_tcp_receive_buffer_t *buffer;
     unsigned int bufferReadSize;
-    unsigned int metaBufferSize;
-    void *metaBuffer;
+    psa_tcp_receive_buffer_t *metaBuffer;
     unsigned int retryCount;
+    celix_thread_mutex_t sendMutex; // protects the send queue fields below
+    struct psa_tcp_send_buffer **sendQueue; // ring buffer of queued messages, NULL if not (yet) used
+    unsigned int sendQueueCapacity;
+    unsigned int sendQueueHead;
+    unsigned int sendQueueDepth;
+    size_t sendOffset; // nr of bytes of the first queued message already send
+    bool sendPollOut; // true if the handler thread polls for "ready to write" events
+    unsigned int maxSendQueueDepth;
+    unsigned long nrOfQueuedMessages;
+    unsigned long nrOfDroppedMessages;
 } psa_tcp_connection_entry_t;
 
+//
+// Encoded message, shared by all connections the message is send to
+//
+typedef struct psa_tcp_send_buffer {
+    int refCount;
+    void *headerData;
+    size_t headerSize;
+    void *payloadData;
+    size_t payloadSize;
+    bool ownsPayload;
+    void *metadataData;
+    size_t metadataSize;
+    size_t metadataCapacity;
+    void *footerData;
+    size_t footerSize;
+    void *data; // contiguous copy of the message, used when the message is queued
+    size_t dataCapacity;
+    bool detached; // true if data contains the message
+    size_t iovOffset;
+    size_t iovLen;
+    size_t iovCapacity;
+    size_t size;
+    void *headerBuffer; // inline storage of the encoded header, after the vector buffer
+    void *footerBuffer; // inline storage of the encoded footer, after the header
+    struct psa_tcp_send_buffer *next; // next free buffer in the send buffer pool
+    struct iovec iov[]; // iov[0] is the header, unless the header is part of the payload (iovOffset = 1)
+} psa_tcp_send_buffer_t;
+
+//
+// Receive thread, with its own epoll instance for a part of the connections
+//
+typedef struct psa_tcp_receive_thread {
+    pubsub_tcpHandler_t *handle;
+    int efd;
+    celix_thread_t thread;
+} psa_tcp_receive_thread_t;
+
+//
+// Received message, which is handled by a dispatch thread
+//
+typedef struct psa_tcp_dispatch_job {
+    pubsub_protocol_message_t message;
+    psa_tcp_receive_buffer_t *buffer; // receive buffer of the payload, owned by the job
+    struct timespec receiveTime;
+    struct psa_tcp_dispatch_job *next;
+} psa_tcp_dispatch_job_t;
+
+//
+// Dispatch thread, handles the received messages of a part of the connections in order
+//
+typedef struct psa_tcp_dispatch_thread {
+    pubsub_tcpHandler_t *handle;
+    celix_thread_t thread;
+    celix_thread_mutex_t mutex; // protects the fields below
+    celix_thread_cond_t cond;
+    psa_tcp_dispatch_job_t *head;
+    psa_tcp_dispatch_job_t *tail;
+    unsigned int size;
+    bool running;
+} psa_tcp_dispatch_thread_t;
+
 //
 // Handle administration
 //
@@ -119,6 +205,28 @@ struct pubsub_tcpHandler {
     unsigned int maxRcvRetryCount;
     double sendTimeout;
     double rcvTimeout;
+    unsigned int sendQueueSize; // 0 is synchronous sending
+    pubsub_tcpHandler_sendQueuePolicy_t sendQueuePolicy;
+    celix_thread_mutex_t batchMutex; // protects the batch and serializes the batch flushes
+    size_t maxBatchSize; // 0 is no batching
+    unsigned int maxBatchDelay; // in ms
+    char *batchData;
+    size_t batchSize;
+    size_t batchCapacity;
+    unsigned int nrOfBatchedMessages;
+    int batchFlags; // send flags of the batched writes
+    struct timespec batchStart;
+    pubsub_tcpHandler_batchStats_t batchStats;
+    unsigned int nrOfReceiveThreads; // 0 is receiving by the handler thread
+    psa_tcp_receive_thread_t *receiveThreads;
+    unsigned int nrOfDispatchThreads; // 0 is dispatching by the receiving thread
+    psa_tcp_dispatch_thread_t *dispatchThreads;
+    celix_thread_mutex_t receiveBufferMutex; // protects the receive buffer pool
+    psa_tcp_receive_buffer_t *freeReceiveBuffers[NR_OF_RECEIVE_BUFFER_CLASSES];
+    unsigned int nrOfFreeReceiveBuffers[NR_OF_RECEIVE_BUFFER_CLASSES];
+    celix_thread_mutex_t sendBufferMutex; // protects the send buffer pool
+    psa_tcp_send_buffer_t *freeSendBuffers;
+    unsigned int nrOfFreeSendBuffers;
     celix_thread_t thread;
     bool running;
 };
@@ -134,9 +242,15 @@ static inline psa_tcp_connection_entry_t *
 pubsub_tcpHandler_createEntry(pubsub_tcpHandler_t *handle, int fd, char *url, char *external_url,
                               struct sockaddr_in *addr);
 
-static inline void pubsub_tcpHandler_freeEntry(psa_tcp_connection_entry_t *entry);
+static inline void pubsub_tcpHandler_freeEntry(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry);
+
+static inline void pubsub_tcpHandler_releaseSendBuffer(pubsub_tcpHandler_t *handle, psa_tcp_send_buffer_t *buffer);
 
-static inline void pubsub_tcpHandler_releaseEntryBuffer(pubsub_tcpHandler_t *handle, int fd, unsigned int index);
+static inline psa_tcp_receive_buffer_t *pubsub_tcpHandler_getReceiveBuffer(pubsub_tcpHandler_t *handle, unsigned int size);
+
+static inline void pubsub_tcpHandler_putReceiveBuffer(pubsub_tcpHandler_t *handle, psa_tcp_receive_buffer_t *buffer);
+
+static inline void pubsub_tcpHandler_detachReceiveBuffer(psa_tcp_receive_buffer_t *buffer);
 
 static inline int pubsub_tcpHandler_readSocket(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, int fd, void* buffer, unsigned int offset, unsigned int size, int flag );
 
@@ -144,10 +258,16 @@ static inline void pubsub_tcpHandler_decodePayload(pubsub_tcpHandler_t *handle,
 
 static inline void pubsub_tcpHandler_connectionHandler(pubsub_tcpHandler_t *handle, int fd);
 
-static inline void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle);
+static inline void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle, int efd);
 
 static void *pubsub_tcpHandler_thread(void *data);
 
+static void *pubsub_tcpHandler_receiveThread(void *data);
+
+static void *pubsub_tcpHandler_dispatchThread(void *data);
+
+static inline int pubsub_tcpHandler_getConnectionEfd(pubsub_tcpHandler_t *handle, int fd);
+
 //
 // Create a handle
 //
@@ -167,8 +287,11 @@ pubsub_tcpHandler_t *pubsub_tcpHandler_create(pubsub_protocol_service_t *protoco
         handle->logHelper = logHelper;
         handle->protocol = protocol;
         handle->bufferSize = MAX_DEFAULT_BUFFER_SIZE;
-        handle->maxNofBuffer = 1; // Reserved for future Use;
+        handle->maxNofBuffer = 1;
         celixThreadRwlock_create(&handle->dbLock, 0);
+        celixThreadMutex_create(&handle->batchMutex, NULL);
+        celixThreadMutex_create(&handle->receiveBufferMutex, NULL);
+        celixThreadMutex_create(&handle->sendBufferMutex, NULL);
         handle->running = true;
         celixThread_create(&handle->thread, NULL, pubsub_tcpHandler_thread, handle);
         // signal(SIGPIPE, SIG_IGN);
@@ -189,7 +312,21 @@ void pubsub_tcpHandler_destroy(pubsub_tcpHandler_t *handle) {
             handle->running = false;
             celixThreadRwlock_unlock(&handle->dbLock);
             celixThread_join(handle->thread, NULL);
+            for (unsigned int i = 0; i < handle->nrOfReceiveThreads; i++) {
+                celixThread_join(handle->receiveThreads[i].thread, NULL);
+            }
         }
+        for (unsigned int i = 0; i < handle->nrOfDispatchThreads; i++) {
+            psa_tcp_dispatch_thread_t *dispatchThread = &handle->dispatchThreads[i];
+            celixThreadMutex_lock(&dispatchThread->mutex);
+            dispatchThread->running = false;
+            celixThreadCondition_broadcast(&dispatchThread->cond);
+            celixThreadMutex_unlock(&dispatchThread->mutex);
+            celixThread_join(dispatchThread->thread, NULL);
+            celixThreadCondition_destroy(&dispatchThread->cond);
+            celixThreadMutex_destroy(&dispatchThread->mutex);
+        }
+        free(handle->dispatchThreads);
         celixThreadRwlock_writeLock(&handle->dbLock);
         hash_map_iterator_t interface_iter = hashMapIterator_construct(handle->interface_url_map);
         while (hashMapIterator_hasNext(&interface_iter)) {
@@ -206,13 +343,38 @@ void pubsub_tcpHandler_destroy(pubsub_tcpHandler_t *handle) {
                 pubsub_tcpHandler_closeConnectionEntry(handle, entry, true);
             }
         }
+        // Note the connections are closed first, because the connections are removed from the epoll of the receive thread
         if (handle->efd >= 0) close(handle->efd);
+        for (unsigned int i = 0; i < handle->nrOfReceiveThreads; i++) {
+            if (handle->receiveThreads[i].efd >= 0) close(handle->receiveThreads[i].efd);
+        }
+        free(handle->receiveThreads);
         hashMap_destroy(handle->connection_url_map, false, false);
         hashMap_destroy(handle->connection_fd_map, false, false);
         hashMap_destroy(handle->interface_url_map, false, false);
         hashMap_destroy(handle->interface_fd_map, false, false);
         celixThreadRwlock_unlock(&handle->dbLock);
         celixThreadRwlock_destroy(&handle->dbLock);
+        celixThreadMutex_destroy(&handle->batchMutex);
+        free(handle->batchData);
+        // Note buffers which are detached, because the message handler has taken ownership of the data, are not freed
+        for (unsigned int i = 0; i < NR_OF_RECEIVE_BUFFER_CLASSES; i++) {
+            while (handle->freeReceiveBuffers[i] != NULL) {
+                psa_tcp_receive_buffer_t *buffer = handle->freeReceiveBuffers[i];
+                handle->freeReceiveBuffers[i] = buffer->next;
+                free(buffer->data);
+                free(buffer);
+            }
+        }
+        celixThreadMutex_destroy(&handle->receiveBufferMutex);
+        while (handle->freeSendBuffers != NULL) {
+            psa_tcp_send_buffer_t *buffer = handle->freeSendBuffers;
+            handle->freeSendBuffers = buffer->next;
+            free(buffer->metadataData);
+            free(buffer->data);
+            free(buffer);
+        }
+        celixThreadMutex_destroy(&handle->sendBufferMutex);
         free(handle);
     }
 }
@@ -311,6 +473,7 @@ pubsub_tcpHandler_createEntry(pubsub_tcpHandler_t *handle, int fd, char *url, ch
     if (fd >= 0) {
         entry = calloc(sizeof(psa_tcp_connection_entry_t), 1);
         entry->fd = fd;
+        celixThreadMutex_create(&entry->sendMutex, NULL);
         if (url)
             entry->url = strndup(url, 1024 * 1024);
         if (interface_url) {
@@ -331,13 +494,12 @@ pubsub_tcpHandler_createEntry(pubsub_tcpHandler_t *handle, int fd, char *url, ch
         entry->syncSize = size;
         handle->protocol->getFooterSize(handle->protocol->handle, &size);
         entry->footerSize = size;
-        entry->bufferSize = handle->bufferSize;
         entry->connected = false;
         if (entry->headerBufferSize) {
             entry->headerBuffer = calloc(sizeof(char), entry->headerSize);
         }
         if (entry->footerSize) entry->footerBuffer = calloc(sizeof(char), entry->footerSize);
-        if (entry->bufferSize) entry->buffer = calloc(sizeof(char), entry->bufferSize);
+        if (handle->bufferSize) entry->buffer = pubsub_tcpHandler_getReceiveBuffer(handle, handle->bufferSize);
     }
     return entry;
 }
@@ -346,7 +508,7 @@ pubsub_tcpHandler_createEntry(pubsub_tcpHandler_t *handle, int fd, char *url, ch
 // Free connection/interface entry
 //
 static inline void
-pubsub_tcpHandler_freeEntry(psa_tcp_connection_entry_t *entry) {
+pubsub_tcpHandler_freeEntry(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry) {
     if (entry) {
         if (entry->url) {
             free(entry->url);
@@ -361,9 +523,8 @@ pubsub_tcpHandler_freeEntry(psa_tcp_connection_entry_t *entry) {
             entry->fd = -1;
         }
         if (entry->buffer) {
-            free(entry->buffer);
+            pubsub_tcpHandler_putReceiveBuffer(handle, entry->buffer);
             entry->buffer = NULL;
-            entry->bufferSize = 0;
         }
         if (entry->headerBuffer) {
             free(entry->headerBuffer);
@@ -377,24 +538,104 @@ pubsub_tcpHandler_freeEntry(psa_tcp_connection_entry_t *entry) {
         }
 
         if (entry->metaBuffer) {
-            free(entry->metaBuffer);
+            pubsub_tcpHandler_putReceiveBuffer(handle, entry->metaBuffer);
             entry->metaBuffer = NULL;
-            entry->metaBufferSize = 0;
         }
+        if (entry->sendQueue) {
+            for (unsigned int i = 0; i < entry->sendQueueDepth; i++) {
+                pubsub_tcpHandler_releaseSendBuffer(handle, entry->sendQueue[(entry->sendQueueHead + i) % entry->sendQueueCapacity]);
+            }
+            free(entry->sendQueue);
+            entry->sendQueue = NULL;
+        }
+        celixThreadMutex_destroy(&entry->sendMutex);
         entry->connected = false;
         free(entry);
     }
 }
 
 //
-// Releases the Buffer
+// Returns the size class of a receive buffer, or -1 if the buffer is too large to be pooled
 //
-static inline void
-pubsub_tcpHandler_releaseEntryBuffer(pubsub_tcpHandler_t *handle, int fd, unsigned int index __attribute__((unused))) {
-    psa_tcp_connection_entry_t *entry = hashMap_get(handle->connection_fd_map, (void *) (intptr_t) fd);
-    if (entry != NULL) {
-        entry->buffer = NULL;
-        entry->bufferSize = 0;
+static inline int pubsub_tcpHandler_getReceiveBufferClass(unsigned int size) {
+    int index = 0;
+    unsigned int classSize = MIN_RECEIVE_BUFFER_SIZE;
+    while (classSize < size) {
+        if (++index >= NR_OF_RECEIVE_BUFFER_CLASSES) {
+            return -1;
+        }
+        classSize <<= 1;
+    }
+    return index;
+}
+
+//
+// Gets a receive buffer of at least size bytes from the receive buffer pool, the caller is the only user
+//
+static inline psa_tcp_receive_buffer_t *pubsub_tcpHandler_getReceiveBuffer(pubsub_tcpHandler_t *handle, unsigned int size) {
+    int index = pubsub_tcpHandler_getReceiveBufferClass(size);
+    psa_tcp_receive_buffer_t *buffer = NULL;
+    celixThreadMutex_lock(&handle->receiveBufferMutex);
+    if (index >= 0 && handle->freeReceiveBuffers[index] != NULL) {
+        buffer = handle->freeReceiveBuffers[index];
+        handle->freeReceiveBuffers[index] = buffer->next;
+        handle->nrOfFreeReceiveBuffers[index]--;
+        buffer->next = NULL;
+    }
+    celixThreadMutex_unlock(&handle->receiveBufferMutex);
+    if (buffer == NULL) {
+        buffer = calloc(1, sizeof(*buffer));
+        if (buffer == NULL) {
+            return NULL;
+        }
+        buffer->size = (index >= 0) ? (MIN_RECEIVE_BUFFER_SIZE << index) : size;
+        buffer->data = malloc((size_t) buffer->size);
+        if (buffer->data == NULL) {
+            L_ERROR("[TCP Socket] Cannot allocate receive buffer of %u bytes", buffer->size);
+            free(buffer);
+            return NULL;
+        }
+    }
+    return buffer;
+}
+
+//
+// Returns the receive buffer to the receive buffer pool
+//
+static inline void pubsub_tcpHandler_putReceiveBuffer(pubsub_tcpHandler_t *handle, psa_tcp_receive_buffer_t *buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+    celixThreadMutex_lock(&handle->receiveBufferMutex);
+    int index = pubsub_tcpHandler_getReceiveBufferClass(buffer->size);
+    unsigned int maxNofBuffers = MAX(handle->maxNofBuffer, 1u) * RECEIVE_BUFFER_POOL_DEPTH;
+    if (index >= 0 && handle->nrOfFreeReceiveBuffers[index] < maxNofBuffers) {
+        buffer->next = handle->freeReceiveBuffers[index];
+        handle->freeReceiveBuffers[index] = buffer;
+        handle->nrOfFreeReceiveBuffers[index]++;
+        buffer = NULL;
+    }
+    celixThreadMutex_unlock(&handle->receiveBufferMutex);
+    if (buffer != NULL) {
+        free(buffer->data);
+        free(buffer);
+    }
+}
+
+//
+// Removes the receive buffer from the receive buffer pool, because the message handler has taken ownership of the data
+//
+static inline void pubsub_tcpHandler_detachReceiveBuffer(psa_tcp_receive_buffer_t *buffer) {
+    free(buffer);
+}
+
+//
+// Reserves a receive buffer of at least size bytes for the connection, the content of the buffer is not preserved
+//
+static inline void pubsub_tcpHandler_reserveReceiveBuffer(pubsub_tcpHandler_t *handle, psa_tcp_receive_buffer_t **buffer, unsigned int size) {
+    if (*buffer == NULL || (*buffer)->size < size) {
+        pubsub_tcpHandler_putReceiveBuffer(handle, *buffer);
+        *buffer = pubsub_tcpHandler_getReceiveBuffer(handle, MAX(handle->bufferSize, size));
     }
 }
 
@@ -432,16 +673,16 @@ int pubsub_tcpHandler_connect(pubsub_tcpHandler_t *handle, char *url) {
 #if defined(__APPLE__)
             struct kevent ev;
             EV_SET (&ev, entry->fd, EVFILT_READ | EVFILT_WRITE, EV_ADD | EV_ENABLE, 0, 0, 0);
-            rc = kevent (handle->efd, &ev, 1, NULL, 0, NULL);
+            rc = kevent (pubsub_tcpHandler_getConnectionEfd(handle, entry->fd), &ev, 1, NULL, 0, NULL);
 #else
             struct epoll_event event;
             bzero(&event,  sizeof(struct epoll_event)); // zero the struct
             event.events = EPOLLIN | EPOLLRDHUP | EPOLLERR;
             event.data.fd = entry->fd;
-            rc = epoll_ctl(handle->efd, EPOLL_CTL_ADD, entry->fd, &event);
+            rc = epoll_ctl(pubsub_tcpHandler_getConnectionEfd(handle, entry->fd), EPOLL_CTL_ADD, entry->fd, &event);
 #endif
             if (rc < 0) {
-                pubsub_tcpHandler_freeEntry(entry);
+                pubsub_tcpHandler_freeEntry(handle, entry);
                 L_ERROR("[TCP Socket] Cannot create poll event %s\n", strerror(errno));
                 entry = NULL;
             }
@@ -484,15 +725,16 @@ static inline int pubsub_tcpHandler_closeConnectionEntry(
     if (handle != NULL && entry != NULL) {
         fprintf(stdout, "[TCP Socket] Close connection to url: %s: \n", entry->url);
         hashMap_remove(handle->connection_fd_map, (void *) (intptr_t) entry->fd);
-        if ((handle->efd >= 0)) {
+        int efd = pubsub_tcpHandler_getConnectionEfd(handle, entry->fd);
+        if ((efd >= 0)) {
 #if defined(__APPLE__)
           struct kevent ev;
           EV_SET (&ev, entry->fd, EVFILT_READ, EV_DELETE , 0, 0, 0);
-          rc = kevent (handle->efd, &ev, 1, NULL, 0, NULL);
+          rc = kevent (efd, &ev, 1, NULL, 0, NULL);
 #else
             struct epoll_event event;
             bzero(&event, sizeof(struct epoll_event)); // zero the struct
-            rc = epoll_ctl(handle->efd, EPOLL_CTL_DEL, entry->fd, &event);
+            rc = epoll_ctl(efd, EPOLL_CTL_DEL, entry->fd, &event);
 #endif
             if (rc < 0) {
                 L_ERROR("[PSA TCP] Error disconnecting %s\n", strerror(errno));
@@ -503,7 +745,7 @@ static inline int pubsub_tcpHandler_closeConnectionEntry(
                 handle->receiverDisconnectMessageCallback(handle->receiverConnectPayload, entry->url, lock);
             if (handle->acceptConnectMessageCallback)
                 handle->acceptConnectMessageCallback(handle->acceptConnectPayload, entry->url);
-            pubsub_tcpHandler_freeEntry(entry);
+            pubsub_tcpHandler_freeEntry(handle, entry);
             entry = NULL;
         }
     }
@@ -535,7 +777,7 @@ pubsub_tcpHandler_closeInterfaceEntry(pubsub_tcpHandler_t *handle,
             }
         }
         if (entry->fd >= 0) {
-            pubsub_tcpHandler_freeEntry(entry);
+            pubsub_tcpHandler_freeEntry(handle, entry);
         }
     }
     return rc;
@@ -584,14 +826,14 @@ int pubsub_tcpHandler_listen(pubsub_tcpHandler_t *handle, char *url) {
                 rc = listen(fd, SOMAXCONN);
                 if (rc != 0) {
                     L_ERROR("[TCP Socket] Error listen: %s\n", strerror(errno));
-                    pubsub_tcpHandler_freeEntry(entry);
+                    pubsub_tcpHandler_freeEntry(handle, entry);
                     entry = NULL;
                 }
             }
             if (rc >= 0) {
                 rc = pubsub_tcpHandler_makeNonBlocking(handle, fd);
                 if (rc < 0) {
-                    pubsub_tcpHandler_freeEntry(entry);
+                    pubsub_tcpHandler_freeEntry(handle, entry);
                     entry = NULL;
                 }
             }
@@ -610,7 +852,7 @@ int pubsub_tcpHandler_listen(pubsub_tcpHandler_t *handle, char *url) {
                 if (rc < 0) {
                     L_ERROR("[TCP Socket] Cannot create poll: %s\n", strerror(errno));
                     errno = 0;
-                    pubsub_tcpHandler_freeEntry(entry);
+                    pubsub_tcpHandler_freeEntry(handle, entry);
                     entry = NULL;
                 }
                 if (entry) {
@@ -628,17 +870,18 @@ int pubsub_tcpHandler_listen(pubsub_tcpHandler_t *handle, char *url) {
 }
 
 //
-// Setup buffer sizes
+// Setup buffer sizes and the size of the receive buffer pool
 //
 int pubsub_tcpHandler_createReceiveBufferStore(pubsub_tcpHandler_t *handle,
-                                               unsigned int maxNofBuffers
-                                               __attribute__((__unused__)),
+                                               unsigned int maxNofBuffers,
                                                unsigned int bufferSize) {
     if (handle != NULL) {
         celixThreadRwlock_writeLock(&handle->dbLock);
         handle->bufferSize = bufferSize;
-        handle->maxNofBuffer = maxNofBuffers;
         celixThreadRwlock_unlock(&handle->dbLock);
+        celixThreadMutex_lock(&handle->receiveBufferMutex);
+        handle->maxNofBuffer = maxNofBuffers;
+        celixThreadMutex_unlock(&handle->receiveBufferMutex);
     }
     return 0;
 }
@@ -655,6 +898,90 @@ void pubsub_tcpHandler_setTimeout(pubsub_tcpHandler_t *handle,
     }
 }
 
+//
+// The epoll instance of a connection, the connections are divided over the receive threads (if configured)
+//
+static inline int pubsub_tcpHandler_getConnectionEfd(pubsub_tcpHandler_t *handle, int fd) {
+    if (handle->nrOfReceiveThreads > 0) {
+        return handle->receiveThreads[fd % handle->nrOfReceiveThreads].efd;
+    }
+    return handle->efd;
+}
+
+//
+// Setup receive threads
+//
+int pubsub_tcpHandler_setReceiveThreads(pubsub_tcpHandler_t *handle, unsigned int nrOfThreads) {
+    int rc = 0;
+    if (handle != NULL && nrOfThreads > 1) {
+        celixThreadRwlock_writeLock(&handle->dbLock);
+        if (handle->receiveThreads != NULL || hashMap_size(handle->connection_fd_map) > 0) {
+            L_WARN("[TCP Socket] Cannot configure receive threads, receive threads or connections already exists");
+            rc = -1;
+        } else {
+            psa_tcp_receive_thread_t *receiveThreads = calloc(nrOfThreads, sizeof(*receiveThreads));
+            rc = receiveThreads != NULL ? 0 : -1;
+            // Create all poll fds before starting the threads, so that on failure the handler thread keeps receiving
+            unsigned int nrOfCreated = 0;
+            for (; rc == 0 && nrOfCreated < nrOfThreads; nrOfCreated++) {
+#if defined(__APPLE__)
+                receiveThreads[nrOfCreated].efd = kqueue();
+#else
+                receiveThreads[nrOfCreated].efd = epoll_create1(0);
+#endif
+                if (receiveThreads[nrOfCreated].efd < 0) {
+                    L_ERROR("[TCP Socket] Cannot create poll fd for receive thread: %s", strerror(errno));
+                    rc = -1;
+                }
+            }
+            if (rc == 0) {
+                handle->receiveThreads = receiveThreads;
+                for (unsigned int i = 0; i < nrOfThreads; i++) {
+                    psa_tcp_receive_thread_t *receiveThread = &handle->receiveThreads[i];
+                    receiveThread->handle = handle;
+                    celixThread_create(&receiveThread->thread, NULL, pubsub_tcpHandler_receiveThread, receiveThread);
+                    handle->nrOfReceiveThreads++;
+                }
+            } else if (receiveThreads != NULL) {
+                for (unsigned int i = 0; i < nrOfCreated; i++) {
+                    if (receiveThreads[i].efd >= 0) close(receiveThreads[i].efd);
+                }
+                free(receiveThreads);
+            }
+        }
+        celixThreadRwlock_unlock(&handle->dbLock);
+    }
+    return rc;
+}
+
+//
+// Setup dispatch threads
+//
+int pubsub_tcpHandler_setDispatchThreads(pubsub_tcpHandler_t *handle, unsigned int nrOfThreads) {
+    int rc = 0;
+    if (handle != NULL && nrOfThreads > 0) {
+        celixThreadRwlock_writeLock(&handle->dbLock);
+        if (handle->dispatchThreads != NULL || hashMap_size(handle->connection_fd_map) > 0) {
+            L_WARN("[TCP Socket] Cannot configure dispatch threads, dispatch threads or connections already exists");
+            rc = -1;
+        } else {
+            handle->dispatchThreads = calloc(nrOfThreads, sizeof(*handle->dispatchThreads));
+            for (unsigned int i = 0; handle->dispatchThreads != NULL && i < nrOfThreads; i++) {
+                psa_tcp_dispatch_thread_t *dispatchThread = &handle->dispatchThreads[i];
+                dispatchThread->handle = handle;
+                dispatchThread->running = true;
+                celixThreadMutex_create(&dispatchThread->mutex, NULL);
+                celixThreadCondition_init(&dispatchThread->cond, NULL);
+                celixThread_create(&dispatchThread->thread, NULL, pubsub_tcpHandler_dispatchThread, dispatchThread);
+                handle->nrOfDispatchThreads++;
+            }
+            rc = handle->dispatchThreads != NULL ? 0 : -1;
+        }
+        celixThreadRwlock_unlock(&handle->dbLock);
+    }
+    return rc;
+}
+
 //
 // Setup thread name
 //
@@ -668,6 +995,12 @@ void pubsub_tcpHandler_setThreadName(pubsub_tcpHandler_t *handle,
             asprintf(&thread_name, "TCP TS %s", topic);
         celixThreadRwlock_writeLock(&handle->dbLock);
         celixThread_setName(&handle->thread, thread_name);
+        for (unsigned int i = 0; i < handle->nrOfReceiveThreads; i++) {
+            celixThread_setName(&handle->receiveThreads[i].thread, thread_name);
+        }
+        for (unsigned int i = 0; i < handle->nrOfDispatchThreads; i++) {
+            celixThread_setName(&handle->dispatchThreads[i].thread, thread_name);
+        }
         celixThreadRwlock_unlock(&handle->dbLock);
         free(thread_name);
     }
@@ -710,6 +1043,9 @@ void pubsub_tcpHandler_setThreadPriority(pubsub_tcpHandler_t *handle, long prio,
                 bzero(&sch, sizeof(struct sched_param));
                 sch.sched_priority = prio;
                 pthread_setschedparam(handle->thread.thread, policy, &sch);
+                for (unsigned int i = 0; i < handle->nrOfReceiveThreads; i++) {
+                    pthread_setschedparam(handle->receiveThreads[i].thread.thread, policy, &sch);
+                }
             } else {
                 L_INFO("Skipping configuration of thread prio to %i and thread "
                        "scheduling to %s. No permission\n",
@@ -752,12 +1088,71 @@ void pubsub_tcpHandler_setReceiveTimeOut(pubsub_tcpHandler_t *handle, double tim
     }
 }
 
+void pubsub_tcpHandler_setSendBatch(pubsub_tcpHandler_t *handle, size_t maxBatchSize, unsigned int maxBatchDelay) {
+    if (handle != NULL) {
+        celixThreadMutex_lock(&handle->batchMutex);
+        celixThreadRwlock_writeLock(&handle->dbLock);
+        handle->maxBatchSize = maxBatchSize;
+        handle->maxBatchDelay = maxBatchDelay;
+        celixThreadRwlock_unlock(&handle->dbLock);
+        celixThreadMutex_unlock(&handle->batchMutex);
+    }
+}
+
+void pubsub_tcpHandler_setSendQueue(pubsub_tcpHandler_t *handle, unsigned int queueSize, pubsub_tcpHandler_sendQueuePolicy_t policy) {
+    if (handle != NULL) {
+        celixThreadRwlock_writeLock(&handle->dbLock);
+        handle->sendQueueSize = queueSize;
+        handle->sendQueuePolicy = policy;
+        celixThreadRwlock_unlock(&handle->dbLock);
+    }
+}
+
+bool pubsub_tcpHandler_getBatchStats(pubsub_tcpHandler_t *handle, pubsub_tcpHandler_batchStats_t *stats) {
+    bool batched = false;
+    if (handle != NULL) {
+        celixThreadMutex_lock(&handle->batchMutex);
+        batched = handle->maxBatchSize > 0;
+        *stats = handle->batchStats;
+        celixThreadMutex_unlock(&handle->batchMutex);
+    }
+    return batched;
+}
+
+size_t pubsub_tcpHandler_getSendQueueStats(pubsub_tcpHandler_t *handle, pubsub_tcpHandler_sendQueueStats_t **out) {
+    size_t size = 0;
+    *out = NULL;
+    if (handle != NULL && handle->sendQueueSize > 0) {
+        celixThreadRwlock_readLock(&handle->dbLock);
+        pubsub_tcpHandler_sendQueueStats_t *stats = calloc(hashMap_size(handle->connection_fd_map) + 1, sizeof(*stats));
+        hash_map_iterator_t iter = hashMapIterator_construct(handle->connection_fd_map);
+        while (stats != NULL && hashMapIterator_hasNext(&iter)) {
+            psa_tcp_connection_entry_t *entry = hashMapIterator_nextValue(&iter);
+            pubsub_tcpHandler_sendQueueStats_t *stat = &stats[size++];
+            snprintf(stat->url, sizeof(stat->url), "%s", entry->url ? entry->url : "");
+            celixThreadMutex_lock(&entry->sendMutex);
+            stat->queueDepth = entry->sendQueueDepth;
+            stat->maxQueueDepth = entry->maxSendQueueDepth;
+            stat->nrOfQueuedMessages = entry->nrOfQueuedMessages;
+            stat->nrOfDroppedMessages = entry->nrOfDroppedMessages;
+            celixThreadMutex_unlock(&entry->sendMutex);
+        }
+        celixThreadRwlock_unlock(&handle->dbLock);
+        *out = stats;
+    }
+    return size;
+}
+
 static inline
 int pubsub_tcpHandler_readSocket(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, int fd, void* _buffer, unsigned int offset, unsigned int size, int flag ) {
     int expectedReadSize = size;
     int nbytes = size;
     int msgSize = 0;
     char* buffer = (char*)_buffer;
+    if (flag & MSG_PEEK) {
+        // A peek does not consume the data, so a partial peek cannot be continued at the offset
+        return recv(fd, &buffer[offset], expectedReadSize, flag | MSG_NOSIGNAL);
+    }
     while (nbytes > 0 && expectedReadSize > 0) {
         // Read the message header
         nbytes = recv(fd, &buffer[offset], expectedReadSize, flag | MSG_NOSIGNAL);
@@ -771,23 +1166,78 @@ int pubsub_tcpHandler_readSocket(pubsub_tcpHandler_t *handle, psa_tcp_connection
 }
 
 
+//
+// Hand over the received message to the dispatch thread of the connection.
+// The receive buffer is handed over to the dispatch job, so the connection will get a new buffer from the pool.
+//
+static inline void pubsub_tcpHandler_dispatch(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry) {
+    psa_tcp_dispatch_job_t *job = calloc(1, sizeof(*job));
+    if (job == NULL) {
+        L_ERROR("[TCP Socket] Cannot allocate dispatch job for seq: %d", entry->header.header.seqNr);
+        if (entry->header.metadata.metadata) {
+            celix_properties_destroy(entry->header.metadata.metadata);
+        }
+        return;
+    }
+    job->message = entry->header;
+    job->buffer = entry->buffer;
+    clock_gettime(CLOCK_REALTIME, &job->receiveTime);
+    entry->buffer = NULL;
+
+    psa_tcp_dispatch_thread_t *dispatchThread = &handle->dispatchThreads[entry->fd % handle->nrOfDispatchThreads];
+    celixThreadMutex_lock(&dispatchThread->mutex);
+    if (dispatchThread->tail != NULL) {
+        dispatchThread->tail->next = job;
+    } else {
+        dispatchThread->head = job;
+    }
+    dispatchThread->tail = job;
+    dispatchThread->size++;
+    celixThreadCondition_broadcast(&dispatchThread->cond);
+    celixThreadMutex_unlock(&dispatchThread->mutex);
+}
+
+//
+// Waits till the dispatch thread of the connection has room for new messages, so that a slow message handler
+// results in back pressure on the connection instead of an unbounded dispatch queue.
+// Note called without the dbLock, because the dispatch threads call the message handler with the dbLock.
+//
+static inline void pubsub_tcpHandler_waitForDispatch(pubsub_tcpHandler_t *handle, int fd) {
+    if (handle->nrOfDispatchThreads > 0) {
+        psa_tcp_dispatch_thread_t *dispatchThread = &handle->dispatchThreads[fd % handle->nrOfDispatchThreads];
+        celixThreadMutex_lock(&dispatchThread->mutex);
+        while (dispatchThread->running && dispatchThread->size >= MAX_DISPATCH_QUEUE_SIZE) {
+            celixThreadCondition_timedwaitRelative(&dispatchThread->cond, &dispatchThread->mutex, 0, 100000000);
+        }
+        celixThreadMutex_unlock(&dispatchThread->mutex);
+    }
+}
+
 static inline
 void pubsub_tcpHandler_decodePayload(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry) {
 
+  // metadata is owned by the message handler, so do not pass the metadata of the previous message
+  entry->header.metadata.metadata = NULL;
   if (entry->header.header.payloadSize > 0) {
-    handle->protocol->decodePayload(handle->protocol->handle, entry->buffer, entry->header.header.payloadSize, &entry->header);
+    handle->protocol->decodePayload(handle->protocol->handle, entry->buffer->data, entry->header.header.payloadSize, &entry->header);
   }
   if (entry->header.header.metadataSize > 0) {
-    handle->protocol->decodeMetadata(handle->protocol->handle, entry->metaBuffer,
+    handle->protocol->decodeMetadata(handle->protocol->handle, entry->metaBuffer->data,
                                      entry->header.header.metadataSize, &entry->header);
-    entry->metaBufferSize = entry->header.header.metadataSize;
   }
-  if (handle->processMessageCallback && entry->header.payload.payload != NULL && entry->header.payload.length) {
+  if (handle->processMessageCallback && entry->header.payload.payload != NULL && entry->header.payload.length &&
+      handle->nrOfDispatchThreads > 0) {
+    pubsub_tcpHandler_dispatch(handle, entry);
+  } else if (handle->processMessageCallback && entry->header.payload.payload != NULL && entry->header.payload.length) {
     struct timespec receiveTime;
     clock_gettime(CLOCK_REALTIME, &receiveTime);
     bool releaseEntryBuffer = false;
     handle->processMessageCallback(handle->processMessagePayload, &entry->header, &releaseEntryBuffer, &receiveTime);
-    if (releaseEntryBuffer) pubsub_tcpHandler_releaseEntryBuffer(handle, entry->fd, 0);
+    // If released, the message handler has taken ownership of the data of the receive buffer
+    if (releaseEntryBuffer) {
+        pubsub_tcpHandler_detachReceiveBuffer(entry->buffer);
+        entry->buffer = NULL;
+    }
   }
 }
 
@@ -797,7 +1247,8 @@ void pubsub_tcpHandler_decodePayload(pubsub_tcpHandler_t *handle, psa_tcp_connec
 // If the message is completely reassembled true is returned and the index and size have valid values
 //
 int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd) {
-    celixThreadRwlock_writeLock(&handle->dbLock);
+    // Note a connection is only read by one thread, so the entry can be updated with the read lock
+    celixThreadRwlock_readLock(&handle->dbLock);
     psa_tcp_connection_entry_t *entry = hashMap_get(handle->interface_fd_map, (void *) (intptr_t) fd);
     if (entry == NULL)
         entry = hashMap_get(handle->connection_fd_map, (void *) (intptr_t) fd);
@@ -812,23 +1263,35 @@ int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd) {
         return -1;
     }
 
-    // Message buffer is to small, reallocate to make it bigger
-    if ((!entry->headerBufferSize) && (entry->headerSize > entry->bufferSize)) {
-        handle->bufferSize = MAX(handle->bufferSize, entry->headerSize );
-        if (entry->buffer) free(entry->buffer);
-            entry->buffer = malloc((size_t) handle->bufferSize);
-            entry->bufferSize = handle->bufferSize;
+    // Message buffer is to small, get a bigger one from the pool
+    if (!entry->headerBufferSize) {
+        pubsub_tcpHandler_reserveReceiveBuffer(handle, &entry->buffer, entry->headerSize);
+        if (entry->buffer == NULL) {
+            L_ERROR("[TCP Socket] No receive buffer for message header (fd: %d) (url: %s)! Closing connection...", entry->fd, entry->url);
+            celixThreadRwlock_unlock(&handle->dbLock);
+            return 0; //Return 0 as indicator to close the connection
         }
+    }
     // Read the message
     bool validMsg = false;
-    char* header_buffer = (entry->headerBufferSize) ? entry->headerBuffer : entry->buffer;
+    bool bufferError = false;
+    char* header_buffer = (entry->headerBufferSize) ? entry->headerBuffer : entry->buffer->data;
     int nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, header_buffer, 0, entry->headerSize, MSG_PEEK);
+    bool headerRead = false;
+    if (nbytes > 0 && nbytes < entry->headerSize) {
+        // The header is split over multiple tcp segments (e.g. coalesced messages), read the complete header.
+        // Note only reading (and not peeking) the socket updates the receive window, so that the remaining part is received
+        nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, header_buffer, 0, entry->headerSize, 0);
+        headerRead = true;
+    }
     if (nbytes > 0) {
         // Check header message buffer
         if (handle->protocol->decodeHeader(handle->protocol->handle, header_buffer, entry->headerSize, &entry->header) != CELIX_SUCCESS) {
             // Did not receive correct header
             // skip sync word and try to read next header
-            nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, header_buffer, 0, entry->syncSize, 0);
+            if (!headerRead) {
+                nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, header_buffer, 0, entry->syncSize, 0);
+            }
             if (!entry->headerError) {
                 L_WARN("[TCP Socket] Failed to decode message header (fd: %d) (url: %s)", entry->fd, entry->url);
             }
@@ -836,31 +1299,39 @@ int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd) {
             entry->bufferReadSize = 0;
         } else {
             // Read header message from queue
-            nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, header_buffer, 0, entry->headerSize, 0);
+            if (!headerRead) {
+                nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, header_buffer, 0, entry->headerSize, 0);
+            }
             if ((nbytes > 0) && (nbytes == entry->headerSize)) {
                 entry->headerError = false;
                 // For headerless message, add header to bufferReadSize;
                 if (!entry->headerBufferSize)
                     entry->bufferReadSize += nbytes;
-                // Alloc message buffers
-                if (entry->header.header.payloadSize > entry->bufferSize) {
-                    handle->bufferSize = MAX(handle->bufferSize, entry->header.header.payloadSize);
-                    if (entry->buffer)
-                        free(entry->buffer);
-                    entry->buffer = malloc((size_t) handle->bufferSize);
-                    entry->bufferSize = handle->bufferSize;
-                }
-                if (entry->header.header.metadataSize > entry->metaBufferSize) {
-                    if (entry->metaBuffer) {
-                      free(entry->metaBuffer);
+                // Get message buffers from the pool. Note for header less messages, the header is already in the buffer
+                if (entry->headerBufferSize) {
+                    pubsub_tcpHandler_reserveReceiveBuffer(handle, &entry->buffer, entry->header.header.payloadSize);
+                    bufferError = entry->buffer == NULL;
+                } else if (entry->header.header.payloadSize > entry->buffer->size) {
+                    psa_tcp_receive_buffer_t *buffer = pubsub_tcpHandler_getReceiveBuffer(handle, MAX(handle->bufferSize, entry->header.header.payloadSize));
+                    if (buffer != NULL) {
+                        memcpy(buffer->data, entry->buffer->data, entry->headerSize);
+                        pubsub_tcpHandler_putReceiveBuffer(handle, entry->buffer);
+                        entry->buffer = buffer;
                     }
-                    entry->metaBuffer = malloc((size_t) entry->header.header.metadataSize);
-                    entry->metaBufferSize = entry->header.header.metadataSize;
-                    L_WARN("[TCP Socket] socket: %d, url: %s,  realloc read meta buffer: (%d, %d) \n", entry->fd,
-                      entry->url, entry->metaBufferSize, entry->header.header.metadataSize);
+                    bufferError = buffer == NULL;
+                }
+                if (!bufferError && entry->header.header.metadataSize) {
+                    pubsub_tcpHandler_reserveReceiveBuffer(handle, &entry->metaBuffer, entry->header.header.metadataSize);
+                    bufferError = entry->metaBuffer == NULL;
                 }
 
-                if (entry->header.header.payloadSize) {
+                if (bufferError) {
+                    // The message cannot be read, so the stream cannot be synchronized with the next message anymore
+                    L_ERROR("[TCP Socket] No receive buffer for message seq %d with payload size %u and metadata size %u (fd: %d) (url: %s)! Closing connection...",
+                            entry->header.header.seqNr, entry->header.header.payloadSize, entry->header.header.metadataSize, entry->fd, entry->url);
+                    entry->bufferReadSize = 0;
+                    nbytes = 0;
+                } else if (entry->header.header.payloadSize) {
                     unsigned int offset = entry->header.header.payloadOffset;
                     unsigned int size = entry->header.header.payloadPartSize;
                     // For header less messages adjust offset and msg size;
@@ -869,7 +1340,7 @@ int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd) {
                         size -= offset;
                     }
                     // Read payload data from queue
-                    nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, entry->buffer, offset, size, 0);
+                    nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, entry->buffer->data, offset, size, 0);
                     if (nbytes > 0) {
                         if (nbytes == size) {
                             entry->bufferReadSize += nbytes;
@@ -882,7 +1353,7 @@ int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd) {
                 if (nbytes > 0 && entry->header.header.metadataSize) {
                     // Read meta data from queue
                     unsigned int size = entry->header.header.metadataSize;
-                    nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, entry->metaBuffer,0, size,0);
+                    nbytes = pubsub_tcpHandler_readSocket(handle, entry, fd, entry->metaBuffer->data,0, size,0);
                     if ((nbytes > 0) && (nbytes != size)) {
                         L_ERROR("[TCP Socket] Failed to receive complete payload buffer (fd: %d) nbytes : %d = msgSize %d", entry->fd, nbytes, size);
                     }
@@ -907,7 +1378,9 @@ int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd) {
             }
         }
     }
-    if (nbytes > 0) {
+    if (bufferError) {
+        nbytes = 0; //Return 0 as indicator to close the connection
+    } else if (nbytes > 0) {
         entry->retryCount = 0;
         // Check if complete message is received
         if ((entry->bufferReadSize >= entry->header.header.payloadSize) && validMsg) {
@@ -1003,157 +1476,479 @@ int pubsub_tcpHandler_writeSocket(pubsub_tcpHandler_t *handle, psa_tcp_connectio
   return msgSize;
 }
 //
-// Write large data to TCP. .
+// Gets a send buffer with room for nofIov vector items from the send buffer pool, the caller is the only user.
+// The header and footer are encoded in the send buffer itself and the metadata and data buffers of a pooled
+// send buffer are reused, so publishing a message does not allocate memory once the pool is filled.
 //
-int pubsub_tcpHandler_write(pubsub_tcpHandler_t *handle, pubsub_protocol_message_t *message, struct iovec *msgIoVec,
-                            size_t msg_iov_len, int flags) {
-    celixThreadRwlock_readLock(&handle->dbLock);
-    int result = 0;
-    int connFdCloseQueue[hashMap_size(handle->connection_fd_map)];
-    int nofConnToClose = 0;
-    if (handle) {
-        hash_map_iterator_t iter = hashMapIterator_construct(handle->connection_fd_map);
-        while (hashMapIterator_hasNext(&iter)) {
-            psa_tcp_connection_entry_t *entry = hashMapIterator_nextValue(&iter);
-            if (!entry->connected) continue;
-            void *payloadData = NULL;
-            size_t payloadSize = 0;
-            if (msg_iov_len == 1) {
-                handle->protocol->encodePayload(handle->protocol->handle, message, &payloadData, &payloadSize);
-            } else {
-                for (size_t i = 0; i < msg_iov_len; i++) {
-                    payloadSize += msgIoVec[i].iov_len;
-                }
-            }
-            message->header.convertEndianess = 0;
-            message->header.payloadSize = payloadSize;
-            message->header.payloadPartSize = payloadSize;
-            message->header.payloadOffset = 0;
-            message->header.isLastSegment = 1;
-
-            void *metadataData = NULL;
-            size_t metadataSize = 0;
-            if (message->metadata.metadata) {
-                metadataData = entry->metaBuffer;
-                handle->protocol->encodeMetadata(handle->protocol->handle, message,
-                                                 &metadataData,
-                                                 &metadataSize);
-                entry->metaBufferSize = metadataSize;
-            }
-            message->header.metadataSize = metadataSize;
-
-            void *footerData = NULL;
-            size_t footerDataSize = 0;
-            if (entry->footerSize) {
-                footerData = entry->footerBuffer;
-                handle->protocol->encodeFooter(handle->protocol->handle, message,
-                                                 &footerData,
-                                                 &footerDataSize);
-                entry->footerSize = footerDataSize;
-            }
+static inline psa_tcp_send_buffer_t *pubsub_tcpHandler_getSendBuffer(pubsub_tcpHandler_t *handle, size_t nofIov) {
+    psa_tcp_send_buffer_t *buffer = NULL;
+    if (nofIov <= SEND_BUFFER_NOF_IOV) {
+        nofIov = SEND_BUFFER_NOF_IOV;
+        celixThreadMutex_lock(&handle->sendBufferMutex);
+        if (handle->freeSendBuffers != NULL) {
+            buffer = handle->freeSendBuffers;
+            handle->freeSendBuffers = buffer->next;
+            handle->nrOfFreeSendBuffers--;
+        }
+        celixThreadMutex_unlock(&handle->sendBufferMutex);
+    }
+    if (buffer == NULL) {
+        size_t headerSize = 0;
+        size_t footerSize = 0;
+        handle->protocol->getHeaderSize(handle->protocol->handle, &headerSize);
+        handle->protocol->getFooterSize(handle->protocol->handle, &footerSize);
+        buffer = calloc(1, sizeof(*buffer) + nofIov * sizeof(struct iovec) + headerSize + footerSize);
+        if (buffer == NULL) {
+            return NULL;
+        }
+        buffer->iovCapacity = nofIov;
+        buffer->headerBuffer = &buffer->iov[nofIov];
+        buffer->footerBuffer = (char *) buffer->headerBuffer + headerSize;
+    }
+    buffer->refCount = 1;
+    buffer->headerData = NULL;
+    buffer->headerSize = 0;
+    buffer->payloadData = NULL;
+    buffer->payloadSize = 0;
+    buffer->ownsPayload = false;
+    buffer->metadataSize = 0;
+    buffer->footerData = NULL;
+    buffer->footerSize = 0;
+    buffer->detached = false;
+    buffer->iovOffset = 0;
+    buffer->iovLen = 0;
+    buffer->size = 0;
+    buffer->next = NULL;
+    memset(buffer->iov, 0, buffer->iovCapacity * sizeof(struct iovec));
+    return buffer;
+}
 
-            size_t msgSize = 0;
-            struct msghdr msg;
-            struct iovec msg_iov[IOV_MAX];
-            memset(&msg, 0x00, sizeof(struct msghdr));
-            msg.msg_name = &entry->addr;
-            msg.msg_namelen = entry->len;
-            msg.msg_flags = flags;
-            msg.msg_iov = msg_iov;
-
-            // Write generic seralized payload in vector buffer
-            if (payloadSize && payloadData) {
-                msg.msg_iovlen++;
-                msg.msg_iov[msg.msg_iovlen].iov_base = payloadData;
-                msg.msg_iov[msg.msg_iovlen].iov_len = payloadSize;
-                msgSize += msg.msg_iov[msg.msg_iovlen].iov_len;
-            } else {
-                // copy serialized vector into vector buffer
-                for (size_t i = 0; i < MIN(msg_iov_len, IOV_MAX - 2); i++) {
-                    msg.msg_iovlen++;
-                    msg.msg_iov[msg.msg_iovlen].iov_base = msgIoVec[i].iov_base;
-                    msg.msg_iov[msg.msg_iovlen].iov_len = msgIoVec[i].iov_len;
-                    msgSize += msg.msg_iov[msg.msg_iovlen].iov_len;
-                }
-            }
+//
+// Create a send buffer with the encoded message (header, payload, metadata and footer).
+// The send buffer is encoded once per message and shared (refcounted) by all the connections the message is send to.
+//
+static inline psa_tcp_send_buffer_t *pubsub_tcpHandler_createSendBuffer(pubsub_tcpHandler_t *handle, pubsub_protocol_message_t *message,
+                                                                       struct iovec *msgIoVec, size_t msg_iov_len) {
+    // header + payload (or the serialized vector) + metadata + footer
+    size_t nofIov = (msg_iov_len == 1 ? 1 : MIN(msg_iov_len, IOV_MAX - 2)) + 3;
+    psa_tcp_send_buffer_t *buffer = pubsub_tcpHandler_getSendBuffer(handle, nofIov);
+    if (buffer == NULL) {
+        return NULL;
+    }
 
-            // Write optional metadata in vector buffer
-            if (metadataSize && metadataData) {
-                msg.msg_iovlen++;
-                msg.msg_iov[msg.msg_iovlen].iov_base = metadataData;
-                msg.msg_iov[msg.msg_iovlen].iov_len = metadataSize;
-                msgSize += msg.msg_iov[msg.msg_iovlen].iov_len;
-            }
+    if (msg_iov_len == 1) {
+        handle->protocol->encodePayload(handle->protocol->handle, message, &buffer->payloadData, &buffer->payloadSize);
+    } else {
+        for (size_t i = 0; i < msg_iov_len; i++) {
+            buffer->payloadSize += msgIoVec[i].iov_len;
+        }
+    }
+    message->header.convertEndianess = 0;
+    message->header.payloadSize = buffer->payloadSize;
+    message->header.payloadPartSize = buffer->payloadSize;
+    message->header.payloadOffset = 0;
+    message->header.isLastSegment = 1;
+
+    if (message->metadata.metadata) {
+        // The metadata buffer of a pooled send buffer is reused, the encoder grows it when needed
+        size_t length = buffer->metadataCapacity;
+        handle->protocol->encodeMetadata(handle->protocol->handle, message, &buffer->metadataData, &length);
+        buffer->metadataSize = buffer->metadataData ? length : 0;
+        buffer->metadataCapacity = buffer->metadataData ? MAX(buffer->metadataCapacity, length) : 0;
+    }
+    message->header.metadataSize = buffer->metadataSize;
 
-            // Write optional footerData in vector buffer
-            if (footerData && footerDataSize) {
-                msg.msg_iovlen++;
-                msg.msg_iov[msg.msg_iovlen].iov_base = footerData;
-                msg.msg_iov[msg.msg_iovlen].iov_len = footerDataSize;
-                msgSize += msg.msg_iov[msg.msg_iovlen].iov_len;
-            }
+    size_t footerSize = 0;
+    handle->protocol->getFooterSize(handle->protocol->handle, &footerSize);
+    if (footerSize) {
+        buffer->footerData = buffer->footerBuffer;
+        handle->protocol->encodeFooter(handle->protocol->handle, message, &buffer->footerData, &buffer->footerSize);
+    }
+
+    // Write generic seralized payload in vector buffer, the 1st vector buffer item is reserved for the header
+    if (buffer->payloadSize && buffer->payloadData) {
+        buffer->iovLen++;
+        buffer->iov[buffer->iovLen].iov_base = buffer->payloadData;
+        buffer->iov[buffer->iovLen].iov_len = buffer->payloadSize;
+        buffer->size += buffer->payloadSize;
+    } else {
+        // copy serialized vector into vector buffer
+        for (size_t i = 0; i < MIN(msg_iov_len, IOV_MAX - 2); i++) {
+            buffer->iovLen++;
+            buffer->iov[buffer->iovLen].iov_base = msgIoVec[i].iov_base;
+            buffer->iov[buffer->iovLen].iov_len = msgIoVec[i].iov_len;
+            buffer->size += msgIoVec[i].iov_len;
+        }
+    }
+
+    // Write optional metadata in vector buffer
+    if (buffer->metadataSize && buffer->metadataData) {
+        buffer->iovLen++;
+        buffer->iov[buffer->iovLen].iov_base = buffer->metadataData;
+        buffer->iov[buffer->iovLen].iov_len = buffer->metadataSize;
+        buffer->size += buffer->metadataSize;
+    }
 
-            void *headerData = NULL;
-            size_t headerSize = 0;
-            // check if header is not part of the payload (=> headerBufferSize = 0)s
-            if (entry->headerBufferSize) {
-              headerData = entry->headerBuffer;
-              // Encode the header, with payload size and metadata size
-              handle->protocol->encodeHeader(handle->protocol->handle, message,
-                                             &headerData,
-                                             &headerSize);
-              entry->headerBufferSize = headerSize;
+    // Write optional footerData in vector buffer
+    if (buffer->footerData && buffer->footerSize) {
+        buffer->iovLen++;
+        buffer->iov[buffer->iovLen].iov_base = buffer->footerData;
+        buffer->iov[buffer->iovLen].iov_len = buffer->footerSize;
+        buffer->size += buffer->footerSize;
+    }
+
+    // check if header is not part of the payload (=> headerBufferSize = 0)
+    size_t headerBufferSize = 0;
+    handle->protocol->getHeaderBufferSize(handle->protocol->handle, &headerBufferSize);
+    if (!headerBufferSize) {
+        // Skip header buffer, when header is part of payload;
+        buffer->iovOffset = 1;
+    } else {
+        // Encode the header, with payload size and metadata size
+        buffer->headerData = buffer->headerBuffer;
+        handle->protocol->encodeHeader(handle->protocol->handle, message, &buffer->headerData, &buffer->headerSize);
+        if (buffer->headerSize && buffer->headerData) {
+            // Write header in 1st vector buffer item
+            buffer->iov[0].iov_base = buffer->headerData;
+            buffer->iov[0].iov_len = buffer->headerSize;
+            buffer->size += buffer->headerSize;
+            buffer->iovLen++;
+        } else {
+            L_ERROR("[TCP Socket] No header buffer is generated");
+            buffer->iovLen = 0;
+        }
+    }
+    // Note: serialized Payload is deleted by serializer
+    buffer->ownsPayload = buffer->payloadData && buffer->payloadData != message->payload.payload;
+    return buffer;
+}
+
+static inline void pubsub_tcpHandler_retainSendBuffer(psa_tcp_send_buffer_t *buffer) {
+    __atomic_add_fetch(&buffer->refCount, 1, __ATOMIC_RELAXED);
+}
+
+//
+// Drops a user of the send buffer, if it was the last user the buffer is returned to the send buffer pool
+//
+static inline void pubsub_tcpHandler_releaseSendBuffer(pubsub_tcpHandler_t *handle, psa_tcp_send_buffer_t *buffer) {
+    if (buffer == NULL || __atomic_sub_fetch(&buffer->refCount, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+    if (buffer->ownsPayload) {
+        free(buffer->payloadData);
+    }
+    if (buffer->dataCapacity > MAX_POOLED_SEND_DATA_SIZE) {
+        free(buffer->data);
+        buffer->data = NULL;
+        buffer->dataCapacity = 0;
+    }
+    celixThreadMutex_lock(&handle->sendBufferMutex);
+    if (buffer->iovCapacity == SEND_BUFFER_NOF_IOV && handle->nrOfFreeSendBuffers < SEND_BUFFER_POOL_DEPTH) {
+        buffer->next = handle->freeSendBuffers;
+        handle->freeSendBuffers = buffer;
+        handle->nrOfFreeSendBuffers++;
+        buffer = NULL;
+    }
+    celixThreadMutex_unlock(&handle->sendBufferMutex);
+    if (buffer != NULL) {
+        free(buffer->metadataData);
+        free(buffer->data);
+        free(buffer);
+    }
+}
+
+//
+// Copy the message in a contiguous buffer, so that it can be queued after the publisher released the serialized data
+//
+static inline bool pubsub_tcpHandler_detachSendBuffer(psa_tcp_send_buffer_t *buffer) {
+    if (!buffer->detached) {
+        if (buffer->dataCapacity < buffer->size) {
+            void *data = realloc(buffer->data, buffer->size);
+            if (data == NULL) {
+                return false;
             }
-            if (!entry->headerBufferSize) {
-              // Skip header buffer, when header is part of payload;
-              msg.msg_iov = &msg_iov[1];
-            } else if (headerSize && headerData) {
-              // Write header in 1st vector buffer item
-                msg.msg_iov[0].iov_base = headerData;
-                msg.msg_iov[0].iov_len = headerSize;
-                msgSize += msg.msg_iov[0].iov_len;
-                msg.msg_iovlen++;
-            } else {
-              L_ERROR("[TCP Socket] No header buffer is generated");
-              msg.msg_iovlen = 0;
+            buffer->data = data;
+            buffer->dataCapacity = buffer->size;
+        }
+        buffer->detached = true;
+        char *data = buffer->data;
+        size_t offset = 0;
+        for (size_t i = buffer->iovOffset; i < buffer->iovOffset + buffer->iovLen; i++) {
+            memcpy(&data[offset], buffer->iov[i].iov_base, buffer->iov[i].iov_len);
+            offset += buffer->iov[i].iov_len;
+        }
+    }
+    return true;
+}
+
+//
+// Enable/disable the "ready to write" events for a connection with a (non) empty send queue
+//
+static inline void pubsub_tcpHandler_setPollOut(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, bool enable) {
+    int efd = pubsub_tcpHandler_getConnectionEfd(handle, entry->fd);
+    if (entry->sendPollOut == enable || efd < 0) {
+        return;
+    }
+#if defined(__APPLE__)
+    struct kevent ev;
+    EV_SET (&ev, entry->fd, EVFILT_WRITE, enable ? (EV_ADD | EV_ENABLE) : EV_DELETE, 0, 0, 0);
+    int rc = kevent(efd, &ev, 1, NULL, 0, NULL);
+#else
+    struct epoll_event event;
+    bzero(&event, sizeof(event)); // zero the struct
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLERR | (enable ? EPOLLOUT : 0);
+    event.data.fd = entry->fd;
+    int rc = epoll_ctl(efd, EPOLL_CTL_MOD, entry->fd, &event);
+#endif
+    if (rc < 0) {
+        L_ERROR("[TCP Socket] Cannot update poll event for (fd: %d): %s\n", entry->fd, strerror(errno));
+    } else {
+        entry->sendPollOut = enable;
+    }
+}
+
+//
+// Send the queued messages of a connection, without blocking. Should be called with the entry sendMutex locked.
+// Returns -1 if the connection failed.
+//
+static inline int pubsub_tcpHandler_sendQueuedMessages(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry) {
+    int rc = 0;
+    while (entry->sendQueueDepth > 0) {
+        psa_tcp_send_buffer_t *buffer = entry->sendQueue[entry->sendQueueHead];
+        char *data = buffer->data;
+        ssize_t nbytes = send(entry->fd, &data[entry->sendOffset], buffer->size - entry->sendOffset, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (nbytes < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                L_ERROR("[TCP Socket] Failed to send queued message (fd: %d), error: %s", entry->fd, strerror(errno));
+                rc = -1;
             }
-            long int nbytes = pubsub_tcpHandler_writeSocket(handle, entry, &msg, msgSize, flags);
-            //  When a specific socket keeps reporting errors can indicate a subscriber
-            //  which is not active anymore, the connection will remain until the retry
-            //  counter exceeds the maximum retry count.
-            //  Btw, also, SIGSTOP issued by a debugging tool can result in EINTR error.
-            if (nbytes == -1) {
-                if (entry->retryCount < handle->maxSendRetryCount) {
-                    entry->retryCount++;
-                    L_ERROR(
-                        "[TCP Socket] Failed to send message (fd: %d), error: %s. try again. Retry count %u of %u, ",
-                        entry->fd, strerror(errno), entry->retryCount, handle->maxSendRetryCount);
+            break;
+        }
+        entry->sendOffset += nbytes;
+        if (entry->sendOffset == buffer->size) {
+            entry->sendQueue[entry->sendQueueHead] = NULL;
+            entry->sendQueueHead = (entry->sendQueueHead + 1) % entry->sendQueueCapacity;
+            entry->sendQueueDepth--;
+            entry->sendOffset = 0;
+            pubsub_tcpHandler_releaseSendBuffer(handle, buffer);
+        }
+    }
+    if (rc == 0) {
+        pubsub_tcpHandler_setPollOut(handle, entry, entry->sendQueueDepth > 0);
+    }
+    return rc;
+}
+
+//
+// Send the queued messages of a connection, called by the handler thread when the connection is ready to write.
+//
+static inline int pubsub_tcpHandler_flushSendQueue(pubsub_tcpHandler_t *handle, int fd) {
+    int rc = 0;
+    celixThreadRwlock_readLock(&handle->dbLock);
+    psa_tcp_connection_entry_t *entry = hashMap_get(handle->connection_fd_map, (void *) (intptr_t) fd);
+    if (entry != NULL) {
+        celixThreadMutex_lock(&entry->sendMutex);
+        rc = pubsub_tcpHandler_sendQueuedMessages(handle, entry);
+        celixThreadMutex_unlock(&entry->sendMutex);
+    }
+    celixThreadRwlock_unlock(&handle->dbLock);
+    return rc;
+}
+
+//
+// Waits, at most the send timeout, till there is room in the full send queue of a connection.
+// Should be called with the entry sendMutex locked. Returns -1 if the connection failed.
+//
+static inline int pubsub_tcpHandler_waitForSendQueue(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry) {
+    int rc = 0;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double timeout = handle->sendTimeout != 0.0 ? handle->sendTimeout : handle->timeout / 1000.0;
+    while (rc == 0 && entry->sendQueueDepth == entry->sendQueueCapacity) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        double remaining = timeout - celix_difftime(&start, &now);
+        if (remaining <= 0.0) {
+            break;
+        }
+        struct pollfd pfd = {.fd = entry->fd, .events = POLLOUT, .revents = 0};
+        celixThreadMutex_unlock(&entry->sendMutex);
+        poll(&pfd, 1, (int) (remaining * 1000.0) + 1);
+        celixThreadMutex_lock(&entry->sendMutex);
+        rc = pubsub_tcpHandler_sendQueuedMessages(handle, entry);
+    }
+    return rc;
+}
+
+//
+// Add a message to the send queue of a connection, applying the send queue policy when the queue is full.
+// Should be called with the entry sendMutex locked.
+// Returns -1 if the connection failed, -2 if the connection should be closed because of the disconnect policy
+// or -3 if the message is dropped because of the drop newest or block policy.
+//
+static inline int pubsub_tcpHandler_queueMessage(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, psa_tcp_send_buffer_t *buffer) {
+    if (entry->sendQueue == NULL) {
+        entry->sendQueue = calloc(handle->sendQueueSize, sizeof(*entry->sendQueue));
+        if (entry->sendQueue == NULL) {
+            return -1;
+        }
+        entry->sendQueueCapacity = handle->sendQueueSize;
+    }
+    if (entry->sendQueueDepth == entry->sendQueueCapacity) {
+        // Note the socket thread never blocks (e.g. when flushing an expired batch), a full queue is handled as drop newest
+        if (handle->sendQueuePolicy == PUBSUB_TCP_SEND_QUEUE_BLOCK &&
+            !celixThread_equals(celixThread_self(), handle->thread) &&
+            pubsub_tcpHandler_waitForSendQueue(handle, entry) < 0) {
+            return -1;
+        }
+    }
+    if (entry->sendQueueDepth == entry->sendQueueCapacity) {
+        unsigned int dropIndex = entry->sendQueueHead;
+        switch (handle->sendQueuePolicy) {
+            case PUBSUB_TCP_SEND_QUEUE_DISCONNECT:
+                L_ERROR("[TCP Socket] Send queue of %s is full (%u messages)! Closing connection...", entry->url, entry->sendQueueDepth);
+                return -2;
+            case PUBSUB_TCP_SEND_QUEUE_DROP_OLDEST:
+                // Note a partially send message cannot be dropped, this would corrupt the stream
+                if (entry->sendOffset > 0) {
+                    if (entry->sendQueueCapacity == 1) {
+                        entry->nrOfDroppedMessages++;
+                        return -3;
+                    }
+                    // drop the 2nd message, by moving the partially send message one place
+                    dropIndex = (entry->sendQueueHead + 1) % entry->sendQueueCapacity;
+                    psa_tcp_send_buffer_t *dropped = entry->sendQueue[dropIndex];
+                    entry->sendQueue[dropIndex] = entry->sendQueue[entry->sendQueueHead];
+                    pubsub_tcpHandler_releaseSendBuffer(handle, dropped);
                 } else {
-                    L_ERROR(
-                        "[TCP Socket] Failed to send message (fd: %d) after %u retries! Closing connection... Error: %s",
-                        entry->fd, handle->maxSendRetryCount, strerror(errno));
-                    connFdCloseQueue[nofConnToClose++] = entry->fd;
-                }
-                result = -1; //At least one connection failed sending
-            } else if (msgSize) {
-                entry->retryCount = 0;
-                if (nbytes != msgSize) {
-                    L_ERROR("[TCP Socket] seq: %d MsgSize not correct: %d != %d (%s)\n", message->header.seqNr, msgSize, nbytes,  strerror(errno));
+                    pubsub_tcpHandler_releaseSendBuffer(handle, entry->sendQueue[dropIndex]);
                 }
+                entry->sendQueue[entry->sendQueueHead] = NULL;
+                entry->sendQueueHead = (entry->sendQueueHead + 1) % entry->sendQueueCapacity;
+                entry->sendQueueDepth--;
+                entry->nrOfDroppedMessages++;
+                break;
+            default: // drop newest or blocked till timeout
+                entry->nrOfDroppedMessages++;
+                return -3;
+        }
+    }
+    if (!pubsub_tcpHandler_detachSendBuffer(buffer)) {
+        L_ERROR("[TCP Socket] Cannot allocate send queue buffer for %s", entry->url);
+        return -1;
+    }
+    pubsub_tcpHandler_retainSendBuffer(buffer);
+    entry->sendQueue[(entry->sendQueueHead + entry->sendQueueDepth) % entry->sendQueueCapacity] = buffer;
+    entry->sendQueueDepth++;
+    entry->nrOfQueuedMessages++;
+    entry->maxSendQueueDepth = MAX(entry->maxSendQueueDepth, entry->sendQueueDepth);
+    pubsub_tcpHandler_setPollOut(handle, entry, true);
+    return 0;
+}
+
+//
+// Asynchronous write of a message to a connection.
+// If nothing is queued, the message is send directly without blocking and the remaining part (if any) is queued.
+// Returns the message size, -1 if the connection failed, -2 if the connection should be closed
+// or -3 if the message is dropped.
+//
+static inline long int pubsub_tcpHandler_writeAsync(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry,
+                                                     psa_tcp_send_buffer_t *buffer, struct msghdr *msg) {
+    long int result = (long int) buffer->size;
+    celixThreadMutex_lock(&entry->sendMutex);
+    if (entry->sendQueueDepth == 0 && msg->msg_iovlen) {
+        ssize_t nbytes = sendmsg(entry->fd, msg, msg->msg_flags | MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (nbytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            result = -1;
+        } else if (nbytes < (ssize_t) buffer->size) {
+            // queue the remaining part of the message
+            int rc = pubsub_tcpHandler_queueMessage(handle, entry, buffer);
+            if (rc == 0) {
+                entry->sendOffset = nbytes > 0 ? (size_t) nbytes : 0;
+            } else {
+                result = rc;
             }
-            // Release data
-            if (headerData && headerData != entry->headerBuffer) {
-                free(headerData);
-            }
-            // Note: serialized Payload is deleted by serializer
-            if (payloadData && (payloadData != message->payload.payload)) {
-                free(payloadData);
+        }
+    } else if (msg->msg_iovlen) {
+        int rc = pubsub_tcpHandler_queueMessage(handle, entry, buffer);
+        if (rc < 0) {
+            result = rc;
+        }
+    }
+    celixThreadMutex_unlock(&entry->sendMutex);
+    return result;
+}
+
+//
+// Write a send buffer to all connected connections.
+// If no buffer is provided, the message is encoded once, for the first connected connection.
+//
+static inline int pubsub_tcpHandler_writeToConnections(pubsub_tcpHandler_t *handle, psa_tcp_send_buffer_t **sendBuffer,
+                                                       pubsub_protocol_message_t *message, struct iovec *msgIoVec,
+                                                       size_t msg_iov_len, int flags) {
+    celixThreadRwlock_readLock(&handle->dbLock);
+    int result = 0;
+    int connFdCloseQueue[hashMap_size(handle->connection_fd_map)];
+    int nofConnToClose = 0;
+    unsigned int seqNr = message ? message->header.seqNr : 0;
+    psa_tcp_send_buffer_t *buffer = *sendBuffer;
+    hash_map_iterator_t iter = hashMapIterator_construct(handle->connection_fd_map);
+    while (hashMapIterator_hasNext(&iter)) {
+        psa_tcp_connection_entry_t *entry = hashMapIterator_nextValue(&iter);
+        if (!entry->connected) continue;
+        if (buffer == NULL) {
+            // Encode the message once, for the first connected connection
+            buffer = pubsub_tcpHandler_createSendBuffer(handle, message, msgIoVec, msg_iov_len);
+            if (buffer == NULL) {
+                L_ERROR("[TCP Socket] Cannot allocate send buffer for seq: %d", seqNr);
+                result = -1;
+                break;
             }
-            if (metadataData && metadataData != entry->metaBuffer) {
-                free(metadataData);
+            *sendBuffer = buffer;
+        }
+        // Per connection copy of the vector buffer, because a partial write updates the vector buffer
+        struct msghdr msg;
+        struct iovec msg_iov[IOV_MAX];
+        memset(&msg, 0x00, sizeof(struct msghdr));
+        msg.msg_name = &entry->addr;
+        msg.msg_namelen = entry->len;
+        msg.msg_flags = flags;
+        memcpy(msg_iov, buffer->iov, (buffer->iovLen + buffer->iovOffset) * sizeof(struct iovec));
+        msg.msg_iov = &msg_iov[buffer->iovOffset];
+        msg.msg_iovlen = buffer->iovLen;
+        size_t msgSize = buffer->size;
+
+        long int nbytes = handle->sendQueueSize > 0 ?
+                pubsub_tcpHandler_writeAsync(handle, entry, buffer, &msg) :
+                pubsub_tcpHandler_writeSocket(handle, entry, &msg, msgSize, flags);
+        //  When a specific socket keeps reporting errors can indicate a subscriber
+        //  which is not active anymore, the connection will remain until the retry
+        //  counter exceeds the maximum retry count.
+        //  Btw, also, SIGSTOP issued by a debugging tool can result in EINTR error.
+        if (nbytes == -2) {
+            // Send queue overflow with the disconnect policy, close without retrying
+            connFdCloseQueue[nofConnToClose++] = entry->fd;
+            result = -1;
+        } else if (nbytes == -3) {
+            // Dropped by the send queue policy, the connection itself is still usable
+            result = -1;
+        } else if (nbytes == -1) {
+            if (entry->retryCount < handle->maxSendRetryCount) {
+                entry->retryCount++;
+                L_ERROR(
+                    "[TCP Socket] Failed to send message (fd: %d), error: %s. try again. Retry count %u of %u, ",
+                    entry->fd, strerror(errno), entry->retryCount, handle->maxSendRetryCount);
+            } else {
+                L_ERROR(
+                    "[TCP Socket] Failed to send message (fd: %d) after %u retries! Closing connection... Error: %s",
+                    entry->fd, handle->maxSendRetryCount, strerror(errno));
+                connFdCloseQueue[nofConnToClose++] = entry->fd;
             }
-            if (footerData && footerData != entry->footerBuffer) {
-                free(footerData);
+            result = -1; //At least one connection failed sending
+        } else if (msgSize) {
+            entry->retryCount = 0;
+            if (nbytes != msgSize) {
+                L_ERROR("[TCP Socket] seq: %d MsgSize not correct: %d != %d (%s)\n", seqNr, msgSize, nbytes,  strerror(errno));
             }
         }
     }
@@ -1165,6 +1960,138 @@ int pubsub_tcpHandler_write(pubsub_tcpHandler_t *handle, pubsub_protocol_message
     return result;
 }
 
+//
+// Send the batched messages as one write, with the send flags of the batched writes.
+// Should be called with the batchMutex locked.
+//
+static inline int pubsub_tcpHandler_flushBatch(pubsub_tcpHandler_t *handle) {
+    if (handle->batchSize == 0) {
+        return 0;
+    }
+    psa_tcp_send_buffer_t *buffer = pubsub_tcpHandler_getSendBuffer(handle, 1);
+    if (buffer == NULL) {
+        return -1;
+    }
+    // The batch data is swapped with the data of the send buffer, so it can be queued without a copy
+    void *data = buffer->data;
+    size_t capacity = buffer->dataCapacity;
+    buffer->data = handle->batchData;
+    buffer->dataCapacity = handle->batchCapacity;
+    buffer->detached = true;
+    buffer->size = handle->batchSize;
+    buffer->iov[0].iov_base = buffer->data;
+    buffer->iov[0].iov_len = buffer->size;
+    buffer->iovLen = 1;
+    handle->batchData = data;
+    handle->batchSize = 0;
+    handle->batchCapacity = capacity;
+    handle->batchStats.nrOfBatches++;
+    handle->batchStats.nrOfBatchedMessages += handle->nrOfBatchedMessages;
+    handle->batchStats.maxMessagesPerBatch = MAX(handle->batchStats.maxMessagesPerBatch, handle->nrOfBatchedMessages);
+    handle->nrOfBatchedMessages = 0;
+    int flags = handle->batchFlags;
+    handle->batchFlags = 0;
+    int rc = pubsub_tcpHandler_writeToConnections(handle, &buffer, NULL, NULL, 0, flags);
+    pubsub_tcpHandler_releaseSendBuffer(handle, buffer);
+    return rc;
+}
+
+//
+// Add the encoded message to the batch, the batch is send when it exceeds the max batch size or max batch delay.
+//
+static inline int pubsub_tcpHandler_writeBatched(pubsub_tcpHandler_t *handle, pubsub_protocol_message_t *message,
+                                                 struct iovec *msgIoVec, size_t msg_iov_len, int flags) {
+    int rc = 0;
+    celixThreadMutex_lock(&handle->batchMutex);
+    psa_tcp_send_buffer_t *buffer = pubsub_tcpHandler_createSendBuffer(handle, message, msgIoVec, msg_iov_len);
+    if (buffer == NULL) {
+        L_ERROR("[TCP Socket] Cannot allocate send buffer for seq: %d", message->header.seqNr);
+        celixThreadMutex_unlock(&handle->batchMutex);
+        return -1;
+    }
+    if (handle->batchSize + buffer->size > handle->batchCapacity) {
+        size_t capacity = MAX(handle->batchSize + buffer->size, handle->maxBatchSize + handle->maxBatchSize / 2);
+        char *data = realloc(handle->batchData, capacity);
+        if (data == NULL) {
+            L_ERROR("[TCP Socket] Cannot allocate batch buffer for seq: %d", message->header.seqNr);
+            pubsub_tcpHandler_releaseSendBuffer(handle, buffer);
+            celixThreadMutex_unlock(&handle->batchMutex);
+            return -1;
+        }
+        handle->batchData = data;
+        handle->batchCapacity = capacity;
+    }
+    if (handle->batchSize == 0) {
+        clock_gettime(CLOCK_MONOTONIC, &handle->batchStart);
+    }
+    for (size_t i = buffer->iovOffset; i < buffer->iovOffset + buffer->iovLen; i++) {
+        memcpy(&handle->batchData[handle->batchSize], buffer->iov[i].iov_base, buffer->iov[i].iov_len);
+        handle->batchSize += buffer->iov[i].iov_len;
+    }
+    handle->nrOfBatchedMessages++;
+    handle->batchFlags |= flags;
+    pubsub_tcpHandler_releaseSendBuffer(handle, buffer);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (handle->batchSize >= handle->maxBatchSize ||
+        celix_difftime(&handle->batchStart, &now) * 1000.0 >= handle->maxBatchDelay) {
+        rc = pubsub_tcpHandler_flushBatch(handle);
+    }
+    celixThreadMutex_unlock(&handle->batchMutex);
+    return rc;
+}
+
+//
+// Send the batched messages, if the max batch delay is exceeded. Called by the handler thread.
+// Batching requires the send queue, so the batch is send without blocking the handler thread.
+//
+static inline void pubsub_tcpHandler_flushExpiredBatch(pubsub_tcpHandler_t *handle) {
+    celixThreadMutex_lock(&handle->batchMutex);
+    if (handle->batchSize > 0) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (celix_difftime(&handle->batchStart, &now) * 1000.0 >= handle->maxBatchDelay) {
+            pubsub_tcpHandler_flushBatch(handle);
+        }
+    }
+    celixThreadMutex_unlock(&handle->batchMutex);
+}
+
+//
+// Send the batched messages
+//
+int pubsub_tcpHandler_flush(pubsub_tcpHandler_t *handle) {
+    int rc = 0;
+    if (handle != NULL) {
+        celixThreadMutex_lock(&handle->batchMutex);
+        rc = pubsub_tcpHandler_flushBatch(handle);
+        celixThreadMutex_unlock(&handle->batchMutex);
+    }
+    return rc;
+}
+
+//
+// Write large data to TCP. .
+//
+int pubsub_tcpHandler_write(pubsub_tcpHandler_t *handle, pubsub_protocol_message_t *message, struct iovec *msgIoVec,
+                            size_t msg_iov_len, int flags) {
+    int result = 0;
+    if (handle) {
+        celixThreadRwlock_readLock(&handle->dbLock);
+        bool batched = handle->maxBatchSize > 0;
+        celixThreadRwlock_unlock(&handle->dbLock);
+        if (batched) {
+            result = pubsub_tcpHandler_writeBatched(handle, message, msgIoVec, msg_iov_len, flags);
+        } else {
+            psa_tcp_send_buffer_t *buffer = NULL;
+            result = pubsub_tcpHandler_writeToConnections(handle, &buffer, message, msgIoVec, msg_iov_len, flags);
+            pubsub_tcpHandler_releaseSendBuffer(handle, buffer);
+        }
+    }
+    return result;
+}
+
 //
 // get interface URL
 //
@@ -1212,17 +2139,17 @@ int pubsub_tcpHandler_acceptHandler(pubsub_tcpHandler_t *handle, psa_tcp_connect
 #if defined(__APPLE__)
         struct kevent ev;
         EV_SET (&ev, entry->fd, EVFILT_READ, EV_ADD | EV_ENABLE , 0, 0, 0);
-        rc = kevent (handle->efd, &ev, 1, NULL, 0, NULL);
+        rc = kevent (pubsub_tcpHandler_getConnectionEfd(handle, entry->fd), &ev, 1, NULL, 0, NULL);
 #else
         struct epoll_event event;
         bzero(&event, sizeof(event)); // zero the struct
         event.events = EPOLLIN | EPOLLRDHUP | EPOLLERR;
         event.data.fd = entry->fd;
         // Register Read to epoll
-        rc = epoll_ctl(handle->efd, EPOLL_CTL_ADD, entry->fd, &event);
+        rc = epoll_ctl(pubsub_tcpHandler_getConnectionEfd(handle, entry->fd), EPOLL_CTL_ADD, entry->fd, &event);
 #endif
         if (rc < 0) {
-            pubsub_tcpHandler_freeEntry(entry);
+            pubsub_tcpHandler_freeEntry(handle, entry);
             free(entry);
             L_ERROR("[TCP Socket] Cannot create epoll\n");
         } else {
@@ -1257,19 +2184,31 @@ void pubsub_tcpHandler_connectionHandler(pubsub_tcpHandler_t *handle, int fd) {
     celixThreadRwlock_unlock(&handle->dbLock);
 }
 
+//
+// Timeout of the socket event loop, when batching the loop also flushes the expired batch
+//
+static inline unsigned int pubsub_tcpHandler_getPollTimeout(pubsub_tcpHandler_t *handle) {
+    unsigned int timeout = handle->timeout;
+    if (handle->maxBatchSize > 0 && handle->maxBatchDelay > 0 && handle->maxBatchDelay < timeout) {
+        timeout = handle->maxBatchDelay;
+    }
+    return timeout;
+}
+
 #if defined(__APPLE__)
 //
 // The main socket event loop
 //
 static inline
-void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
+void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle, int efd) {
   int rc = 0;
-  if (handle->efd >= 0) {
+  if (efd >= 0) {
     int nof_events = 0;
     //  Wait for events.
     struct kevent events[MAX_EVENTS];
-    struct timespec ts = {handle->timeout / 1000, (handle->timeout  % 1000) * 1000000};
-    nof_events = kevent (handle->efd, NULL, 0, &events[0], MAX_EVENTS, handle->timeout ? &ts : NULL);
+    unsigned int timeout = pubsub_tcpHandler_getPollTimeout(handle);
+    struct timespec ts = {timeout / 1000, (timeout  % 1000) * 1000000};
+    nof_events = kevent (efd, NULL, 0, &events[0], MAX_EVENTS, timeout ? &ts : NULL);
     if (nof_events < 0) {
       if ((errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
       } else
@@ -1286,9 +2225,13 @@ void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
       if (pendingConnectionEntry) {
         int fd = pubsub_tcpHandler_acceptHandler(handle, pendingConnectionEntry);
         pubsub_tcpHandler_connectionHandler(handle, fd);
+      } else if (events[i].filter == EVFILT_WRITE) {
+        // Connection is ready to write, send the queued messages
+        if (pubsub_tcpHandler_flushSendQueue(handle, events[i].ident) < 0) pubsub_tcpHandler_close(handle, events[i].ident);
       } else if (events[i].filter & EVFILT_READ) {
         int rc = pubsub_tcpHandler_read(handle, events[i].ident);
         if (rc == 0) pubsub_tcpHandler_close(handle, events[i].ident);
+        else pubsub_tcpHandler_waitForDispatch(handle, events[i].ident);
       } else if (events[i].flags & EV_EOF) {
         int err = 0;
         socklen_t len = sizeof(int);
@@ -1314,12 +2257,12 @@ void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
 // The main socket event loop
 //
 static inline
-void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
+void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle, int efd) {
     int rc = 0;
-    if (handle->efd >= 0) {
+    if (efd >= 0) {
         int nof_events = 0;
         struct epoll_event events[MAX_EVENTS];
-        nof_events = epoll_wait(handle->efd, events, MAX_EVENTS, handle->timeout);
+        nof_events = epoll_wait(efd, events, MAX_EVENTS, pubsub_tcpHandler_getPollTimeout(handle));
         if (nof_events < 0) {
             if ((errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
             } else
@@ -1333,12 +2276,20 @@ void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
                 if (events[i].data.fd == entry->fd)
                     pendingConnectionEntry = entry;
             }
+            if (!pendingConnectionEntry && (events[i].events & EPOLLOUT)) {
+                // Connection is ready to write, send the queued messages
+                if (pubsub_tcpHandler_flushSendQueue(handle, events[i].data.fd) < 0) {
+                    pubsub_tcpHandler_close(handle, events[i].data.fd);
+                    continue;
+                }
+            }
             if (pendingConnectionEntry) {
                int fd = pubsub_tcpHandler_acceptHandler(handle, pendingConnectionEntry);
                pubsub_tcpHandler_connectionHandler(handle, fd);
             } else if (events[i].events & EPOLLIN) {
                 rc = pubsub_tcpHandler_read(handle, events[i].data.fd);
                 if (rc == 0) pubsub_tcpHandler_close(handle, events[i].data.fd);
+                else pubsub_tcpHandler_waitForDispatch(handle, events[i].data.fd);
             } else if (events[i].events & EPOLLRDHUP) {
                 int err = 0;
                 socklen_t len = sizeof(int);
@@ -1359,6 +2310,67 @@ void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
 }
 #endif
 
+//
+// The receive thread, handles the events of a part of the connections
+//
+static void *pubsub_tcpHandler_receiveThread(void *data) {
+    psa_tcp_receive_thread_t *receiveThread = data;
+    pubsub_tcpHandler_t *handle = receiveThread->handle;
+    celixThreadRwlock_readLock(&handle->dbLock);
+    bool running = handle->running;
+    celixThreadRwlock_unlock(&handle->dbLock);
+
+    while (running) {
+        pubsub_tcpHandler_handler(handle, receiveThread->efd);
+        celixThreadRwlock_readLock(&handle->dbLock);
+        running = handle->running;
+        celixThreadRwlock_unlock(&handle->dbLock);
+    }
+    return NULL;
+}
+
+//
+// The dispatch thread, calls the message handler for the received messages in order of arrival
+//
+static void *pubsub_tcpHandler_dispatchThread(void *data) {
+    psa_tcp_dispatch_thread_t *dispatchThread = data;
+    pubsub_tcpHandler_t *handle = dispatchThread->handle;
+    celixThreadMutex_lock(&dispatchThread->mutex);
+    while (dispatchThread->running || dispatchThread->head != NULL) {
+        psa_tcp_dispatch_job_t *job = dispatchThread->head;
+        if (job == NULL) {
+            celixThreadCondition_wait(&dispatchThread->cond, &dispatchThread->mutex);
+            continue;
+        }
+        dispatchThread->head = job->next;
+        if (dispatchThread->head == NULL) {
+            dispatchThread->tail = NULL;
+        }
+        dispatchThread->size--;
+        celixThreadCondition_broadcast(&dispatchThread->cond);
+        celixThreadMutex_unlock(&dispatchThread->mutex);
+
+        bool releaseBuffer = false;
+        celixThreadRwlock_readLock(&handle->dbLock);
+        if (handle->processMessageCallback) {
+            handle->processMessageCallback(handle->processMessagePayload, &job->message, &releaseBuffer, &job->receiveTime);
+        } else if (job->message.metadata.metadata) {
+            celix_properties_destroy(job->message.metadata.metadata);
+        }
+        celixThreadRwlock_unlock(&handle->dbLock);
+        // If released, the message handler has taken ownership of the data of the receive buffer
+        if (releaseBuffer) {
+            pubsub_tcpHandler_detachReceiveBuffer(job->buffer);
+        } else {
+            pubsub_tcpHandler_putReceiveBuffer(handle, job->buffer);
+        }
+        free(job);
+        celixThreadMutex_lock(&dispatchThread->mutex);
+    }
+    celixThreadMutex_unlock(&dispatchThread->mutex);
+    return NULL;
+}
+
 //
 // The socket thread
 //
@@ -1369,10 +2381,14 @@ static void *pubsub_tcpHandler_thread(void *data) {
     celixThreadRwlock_unlock(&handle->dbLock);
 
     while (running) {
-        pubsub_tcpHandler_handler(handle);
+        pubsub_tcpHandler_handler(handle, handle->efd);
         celixThreadRwlock_readLock(&handle->dbLock);
         running = handle->running;
+        bool batched = handle->maxBatchSize > 0;
         celixThreadRwlock_unlock(&handle->dbLock);
+        if (batched) {
+            pubsub_tcpHandler_flushExpiredBatch(handle);
+        }
     } // while
     return NULL;
 }
\ No newline at end of file
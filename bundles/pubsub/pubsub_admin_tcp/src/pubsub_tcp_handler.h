@@ -46,6 +46,35 @@
 #endif
 
 typedef struct pubsub_tcpHandler pubsub_tcpHandler_t;
+
+/**
+ * What to do when a message is published to a connection with a full send queue.
+ */
+typedef enum pubsub_tcpHandler_sendQueuePolicy {
+    PUBSUB_TCP_SEND_QUEUE_DROP_OLDEST,  // drop the oldest not yet (partially) send message
+    PUBSUB_TCP_SEND_QUEUE_DROP_NEWEST,  // drop the published message
+    PUBSUB_TCP_SEND_QUEUE_BLOCK,        // block the publisher till there is room, at most the send timeout
+    PUBSUB_TCP_SEND_QUEUE_DISCONNECT    // close the connection
+} pubsub_tcpHandler_sendQueuePolicy_t;
+
+typedef struct pubsub_tcpHandler_sendQueueStats {
+    char url[128];
+    unsigned int queueDepth;            // nr of messages currently queued
+    unsigned int maxQueueDepth;         // max nr of messages queued
+    unsigned long nrOfQueuedMessages;   // nr of messages which could not be send directly and were queued
+    unsigned long nrOfDroppedMessages;  // nr of messages dropped because the send queue was full
+} pubsub_tcpHandler_sendQueueStats_t;
+
+typedef struct pubsub_tcpHandler_batchStats {
+    unsigned long nrOfBatches;          // nr of send batches
+    unsigned long nrOfBatchedMessages;  // nr of messages send in a batch
+    unsigned int maxMessagesPerBatch;   // max nr of messages in a send batch
+} pubsub_tcpHandler_batchStats_t;
+/**
+ * Handles a received message. The payload of the message is a receive buffer of the handler, which is valid till the
+ * callback returns and is then reused for new messages. To keep the payload (e.g. a message which is deserialized in
+ * place), the callback sets release to true, which hands over the ownership of the payload (to be freed with free()).
+ */
 typedef void(*pubsub_tcpHandler_processMessage_callback_t)
     (void *payload, const pubsub_protocol_message_t *header, bool *release, struct timespec *receiveTime);
 typedef void (*pubsub_tcpHandler_receiverConnectMessage_callback_t)(void *payload, const char *url, bool lock);
@@ -59,6 +88,11 @@ int pubsub_tcpHandler_connect(pubsub_tcpHandler_t *handle, char *url);
 int pubsub_tcpHandler_disconnect(pubsub_tcpHandler_t *handle, char *url);
 int pubsub_tcpHandler_listen(pubsub_tcpHandler_t *handle, char *url);
 
+/**
+ * Configures the receive buffers. The receive buffers are taken from a pool with size classes, which is shared by the
+ * connections of the handler. bufferSize is the minimal size of a receive buffer and maxNofBuffers (the nr of receive
+ * sessions) scales the nr of free buffers kept per size class.
+ */
 int pubsub_tcpHandler_createReceiveBufferStore(pubsub_tcpHandler_t *handle,
                                                unsigned int maxNofBuffers,
                                                unsigned int bufferSize);
@@ -67,6 +101,45 @@ void pubsub_tcpHandler_setSendRetryCnt(pubsub_tcpHandler_t *handle, unsigned int
 void pubsub_tcpHandler_setReceiveRetryCnt(pubsub_tcpHandler_t *handle, unsigned int count);
 void pubsub_tcpHandler_setSendTimeOut(pubsub_tcpHandler_t *handle, double timeout);
 void pubsub_tcpHandler_setReceiveTimeOut(pubsub_tcpHandler_t *handle, double timeout);
+/**
+ * Configures asynchronous sending. With a queue size > 0, a write does not block on a slow connection, but queues the
+ * (remaining part of the) message in the send queue of the connection, which is send by the handler thread.
+ * Should be configured before connections are made.
+ */
+void pubsub_tcpHandler_setSendQueue(pubsub_tcpHandler_t *handle, unsigned int queueSize, pubsub_tcpHandler_sendQueuePolicy_t policy);
+/**
+ * Configures multiple receive threads, each with its own epoll instance. The connections are divided over the receive
+ * threads, so that the connections are read in parallel. Should be configured before connections are made.
+ */
+int pubsub_tcpHandler_setReceiveThreads(pubsub_tcpHandler_t *handle, unsigned int nrOfThreads);
+/**
+ * Configures dispatch threads, which call the message handler for the received messages. The messages of a connection
+ * are always handled by the same dispatch thread, so the order of the messages of a publisher is kept.
+ * Note with multiple dispatch threads, the message handler is called concurrently for different connections.
+ * Should be configured before connections are made.
+ */
+int pubsub_tcpHandler_setDispatchThreads(pubsub_tcpHandler_t *handle, unsigned int nrOfThreads);
+/**
+ * Configures batching. With a max batch size > 0, written messages are encoded in a batch, which is send as one write
+ * when the batch exceeds the max batch size, when the oldest message in the batch is older than the max batch delay (ms)
+ * or when the handler is flushed.
+ * Batching requires the send queue (see pubsub_tcpHandler_setSendQueue), because an expired batch is send by the
+ * socket thread, which should not block on a slow connection.
+ */
+void pubsub_tcpHandler_setSendBatch(pubsub_tcpHandler_t *handle, size_t maxBatchSize, unsigned int maxBatchDelay);
+/**
+ * Sends the batched messages.
+ */
+int pubsub_tcpHandler_flush(pubsub_tcpHandler_t *handle);
+/**
+ * Gets the batch statistics. Returns false if batching is disabled.
+ */
+bool pubsub_tcpHandler_getBatchStats(pubsub_tcpHandler_t *handle, pubsub_tcpHandler_batchStats_t *stats);
+/**
+ * Returns the send queue statistics of the connections, none if the send queue is disabled.
+ * Caller is owner of the returned array (free).
+ */
+size_t pubsub_tcpHandler_getSendQueueStats(pubsub_tcpHandler_t *handle, pubsub_tcpHandler_sendQueueStats_t **stats);
 
 int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd);
 int pubsub_tcpHandler_write(pubsub_tcpHandler_t *handle,
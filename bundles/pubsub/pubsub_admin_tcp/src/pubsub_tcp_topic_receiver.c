@@ -82,7 +82,7 @@ struct pubsub_tcp_topic_receiver {
 
     long subscriberTrackerId;
     struct {
-        celix_thread_mutex_t mutex;
+        celix_thread_rwlock_t lock; // read lock for receiving messages, which can be done by multiple dispatch threads
         hash_map_t *map; //key = bnd id, value = psa_tcp_subscriber_entry_t
         bool allInitialized;
     } subscribers;
@@ -228,11 +228,23 @@ pubsub_tcp_topic_receiver_t *pubsub_tcpTopicReceiver_create(celix_bundle_context
         pubsub_tcpHandler_setThreadPriority(receiver->socketHandler, prio, sched);
         pubsub_tcpHandler_setReceiveRetryCnt(receiver->socketHandler, (unsigned int) retryCnt);
         pubsub_tcpHandler_setReceiveTimeOut(receiver->socketHandler, rcvTimeout);
+        long receiveThreads = celix_properties_getAsLong(topicProperties, PUBSUB_TCP_SUBSCRIBER_RECEIVE_THREADS_KEY,
+                                                         PUBSUB_TCP_SUBSCRIBER_RECEIVE_THREADS_DEFAULT);
+        long dispatchThreads = celix_properties_getAsLong(topicProperties, PUBSUB_TCP_SUBSCRIBER_DISPATCH_THREADS_KEY,
+                                                          PUBSUB_TCP_SUBSCRIBER_DISPATCH_THREADS_DEFAULT);
+        if (receiveThreads > 1 &&
+            pubsub_tcpHandler_setReceiveThreads(receiver->socketHandler, (unsigned int) receiveThreads) != 0) {
+            L_WARN("[PSA_TCP] Cannot create %li receive threads for %s/%s, receiving on a single thread",
+                   receiveThreads, scope == NULL ? "(null)" : scope, topic);
+        }
+        if (dispatchThreads > 0) {
+            pubsub_tcpHandler_setDispatchThreads(receiver->socketHandler, (unsigned int) dispatchThreads);
+        }
     }
     receiver->metricsEnabled = celix_bundleContext_getPropertyAsBool(ctx, PSA_TCP_METRICS_ENABLED,
                                                                      PSA_TCP_DEFAULT_METRICS_ENABLED);
 
-    celixThreadMutex_create(&receiver->subscribers.mutex, NULL);
+    celixThreadRwlock_create(&receiver->subscribers.lock, NULL);
     celixThreadMutex_create(&receiver->requestedConnections.mutex, NULL);
     celixThreadMutex_create(&receiver->thread.mutex, NULL);
 
@@ -303,7 +315,11 @@ void pubsub_tcpTopicReceiver_destroy(pubsub_tcp_topic_receiver_t *receiver) {
 
         celix_bundleContext_stopTracker(receiver->ctx, receiver->subscriberTrackerId);
 
-        celixThreadMutex_lock(&receiver->subscribers.mutex);
+        // Note removing the message handler waits for (dispatch) threads handling a message
+        pubsub_tcpHandler_addMessageHandler(receiver->socketHandler, NULL, NULL);
+        pubsub_tcpHandler_addReceiverConnectionCallback(receiver->socketHandler, NULL, NULL, NULL);
+
+        celixThreadRwlock_writeLock(&receiver->subscribers.lock);
         hash_map_iterator_t iter = hashMapIterator_construct(receiver->subscribers.map);
         while (hashMapIterator_hasNext(&iter)) {
             psa_tcp_subscriber_entry_t *entry = hashMapIterator_nextValue(&iter);
@@ -322,7 +338,7 @@ void pubsub_tcpTopicReceiver_destroy(pubsub_tcp_topic_receiver_t *receiver) {
         }
         hashMap_destroy(receiver->subscribers.map, false, false);
 
-        celixThreadMutex_unlock(&receiver->subscribers.mutex);
+        celixThreadRwlock_unlock(&receiver->subscribers.lock);
 
         celixThreadMutex_lock(&receiver->requestedConnections.mutex);
         iter = hashMapIterator_construct(receiver->requestedConnections.map);
@@ -336,12 +352,10 @@ void pubsub_tcpTopicReceiver_destroy(pubsub_tcp_topic_receiver_t *receiver) {
         hashMap_destroy(receiver->requestedConnections.map, false, false);
         celixThreadMutex_unlock(&receiver->requestedConnections.mutex);
 
-        celixThreadMutex_destroy(&receiver->subscribers.mutex);
+        celixThreadRwlock_destroy(&receiver->subscribers.lock);
         celixThreadMutex_destroy(&receiver->requestedConnections.mutex);
         celixThreadMutex_destroy(&receiver->thread.mutex);
 
-        pubsub_tcpHandler_addMessageHandler(receiver->socketHandler, NULL, NULL);
-        pubsub_tcpHandler_addReceiverConnectionCallback(receiver->socketHandler, NULL, NULL, NULL);
         if ((receiver->socketHandler) && (receiver->sharedSocketHandler == NULL)) {
             pubsub_tcpHandler_destroy(receiver->socketHandler);
             receiver->socketHandler = NULL;
@@ -453,7 +467,7 @@ static void pubsub_tcpTopicReceiver_addSubscriber(void *handle, void *svc, const
         return;
     }
 
-    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    celixThreadRwlock_writeLock(&receiver->subscribers.lock);
     psa_tcp_subscriber_entry_t *entry = hashMap_get(receiver->subscribers.map, (void *) bndId);
     if (entry != NULL) {
         hashMap_put(entry->subscriberServices, (void*)svcId, svc);
@@ -488,7 +502,7 @@ static void pubsub_tcpTopicReceiver_addSubscriber(void *handle, void *svc, const
             free(entry);
         }
     }
-    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+    celixThreadRwlock_unlock(&receiver->subscribers.lock);
 }
 
 static void pubsub_tcpTopicReceiver_removeSubscriber(void *handle, void *svc, const celix_properties_t *props,
@@ -499,7 +513,7 @@ static void pubsub_tcpTopicReceiver_removeSubscriber(void *handle, void *svc, co
     long svcId = celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_ID, -1);
 
 
-    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    celixThreadRwlock_writeLock(&receiver->subscribers.lock);
     psa_tcp_subscriber_entry_t *entry = hashMap_get(receiver->subscribers.map, (void *) bndId);
     if (entry != NULL) {
         hashMap_remove(entry->subscriberServices, (void*)svcId);
@@ -522,13 +536,13 @@ static void pubsub_tcpTopicReceiver_removeSubscriber(void *handle, void *svc, co
         hashMap_destroy(entry->subscriberServices, false, false);
         free(entry);
     }
-    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+    celixThreadRwlock_unlock(&receiver->subscribers.lock);
 }
 
 static inline void
 processMsgForSubscriberEntry(pubsub_tcp_topic_receiver_t *receiver, psa_tcp_subscriber_entry_t *entry,
                              const pubsub_protocol_message_t *message, bool *releaseMsg, struct timespec *receiveTime) {
-    //NOTE receiver->subscribers.mutex locked
+    //NOTE receiver->subscribers.lock (read) locked
     pubsub_msg_serializer_t *msgSer = hashMap_get(entry->msgTypes, (void *) (uintptr_t) (message->header.msgId));
     bool monitor = receiver->metricsEnabled;
 
@@ -553,10 +567,10 @@ processMsgForSubscriberEntry(pubsub_tcp_topic_receiver_t *receiver, psa_tcp_subs
             if (monitor) {
                 clock_gettime(CLOCK_REALTIME, &endSer);
             }
-            // When received payload pointer is the same as deserializedMsg, set ownership of pointer to topic receiver
-            if (message->payload.payload == deSerializedMsg) {
-                *releaseMsg = true;
-            }
+            // When received payload pointer is the same as deserializedMsg, the message is deserialized in place.
+            // The receive buffer is valid till this function returns, unless a subscriber keeps the message. Then the
+            // ownership of the receive buffer is handed over to the subscriber with the release flag of the handler.
+            bool inPlace = status == CELIX_SUCCESS && message->payload.payload == deSerializedMsg;
 
             if (status == CELIX_SUCCESS) {
                 hash_map_iterator_t iter = hashMapIterator_construct(entry->subscriberServices);
@@ -565,7 +579,12 @@ processMsgForSubscriberEntry(pubsub_tcp_topic_receiver_t *receiver, psa_tcp_subs
                     pubsub_subscriber_t *svc = hashMapIterator_nextValue(&iter);
                     svc->receive(svc->handle, msgSer->msgName, msgSer->msgId, deSerializedMsg, message->metadata.metadata,
                                  &release);
-                    if (!release && hashMapIterator_hasNext(&iter)) {
+                    if (!release && inPlace) {
+                        //receive function has taken ownership of the receive buffer, the message stays valid for the
+                        //other receive functions till this function returns
+                        *releaseMsg = true;
+                        release = true;
+                    } else if (!release && hashMapIterator_hasNext(&iter)) {
                         //receive function has taken ownership and still more receive function to come ..
                         //deserialize again for new message
                         status = msgSer->deserialize(msgSer->handle, &deSerializeBuffer, 1, &deSerializedMsg);
@@ -577,7 +596,7 @@ processMsgForSubscriberEntry(pubsub_tcp_topic_receiver_t *receiver, psa_tcp_subs
                         release = true;
                     }
                 }
-                if (release) {
+                if (!inPlace && release) {
                     msgSer->freeDeserializeMsg(msgSer->handle, deSerializedMsg);
                 }
                 if (message->metadata.metadata) {
@@ -598,7 +617,7 @@ processMsgForSubscriberEntry(pubsub_tcp_topic_receiver_t *receiver, psa_tcp_subs
 static void
 processMsg(void *handle, const pubsub_protocol_message_t *message, bool *release, struct timespec *receiveTime) {
     pubsub_tcp_topic_receiver_t *receiver = handle;
-    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    celixThreadRwlock_readLock(&receiver->subscribers.lock);
     hash_map_iterator_t iter = hashMapIterator_construct(receiver->subscribers.map);
     while (hashMapIterator_hasNext(&iter)) {
         psa_tcp_subscriber_entry_t *entry = hashMapIterator_nextValue(&iter);
@@ -606,7 +625,7 @@ processMsg(void *handle, const pubsub_protocol_message_t *message, bool *release
             processMsgForSubscriberEntry(receiver, entry, message, release, receiveTime);
         }
     }
-    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+    celixThreadRwlock_unlock(&receiver->subscribers.lock);
 }
 
 static void *psa_tcp_recvThread(void *data) {
@@ -620,9 +639,9 @@ static void *psa_tcp_recvThread(void *data) {
     bool allConnected = receiver->requestedConnections.allConnected;
     celixThreadMutex_unlock(&receiver->requestedConnections.mutex);
 
-    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    celixThreadRwlock_readLock(&receiver->subscribers.lock);
     bool allInitialized = receiver->subscribers.allInitialized;
-    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+    celixThreadRwlock_unlock(&receiver->subscribers.lock);
 
     while (running) {
         if (!allConnected) {
@@ -641,9 +660,9 @@ static void *psa_tcp_recvThread(void *data) {
         allConnected = receiver->requestedConnections.allConnected;
         celixThreadMutex_unlock(&receiver->requestedConnections.mutex);
 
-        celixThreadMutex_lock(&receiver->subscribers.mutex);
+        celixThreadRwlock_readLock(&receiver->subscribers.lock);
         allInitialized = receiver->subscribers.allInitialized;
-        celixThreadMutex_unlock(&receiver->subscribers.mutex);
+        celixThreadRwlock_unlock(&receiver->subscribers.lock);
     } // while
     return NULL;
 }
@@ -657,7 +676,7 @@ pubsub_admin_receiver_metrics_t *pubsub_tcpTopicReceiver_metrics(pubsub_tcp_topi
     snprintf(result->topic, PUBSUB_AMDIN_METRICS_NAME_MAX, "%s", receiver->topic);
 
     int msgTypesCount = 0;
-    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    celixThreadRwlock_writeLock(&receiver->subscribers.lock);
     hash_map_iterator_t iter = hashMapIterator_construct(receiver->subscribers.map);
     while (hashMapIterator_hasNext(&iter)) {
         psa_tcp_subscriber_entry_t *entry = hashMapIterator_nextValue(&iter);
@@ -710,7 +729,7 @@ pubsub_admin_receiver_metrics_t *pubsub_tcpTopicReceiver_metrics(pubsub_tcp_topi
             i += 1;
         }
     }
-    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+    celixThreadRwlock_unlock(&receiver->subscribers.lock);
     return result;
 }
 
@@ -773,7 +792,7 @@ static void psa_tcp_disConnectHandler(void *handle, const char *url, bool lock)
 }
 
 static void psa_tcp_initializeAllSubscribers(pubsub_tcp_topic_receiver_t *receiver) {
-    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    celixThreadRwlock_writeLock(&receiver->subscribers.lock);
     if (!receiver->subscribers.allInitialized) {
         bool allInitialized = true;
         hash_map_iterator_t iter = hashMapIterator_construct(receiver->subscribers.map);
@@ -799,7 +818,7 @@ static void psa_tcp_initializeAllSubscribers(pubsub_tcp_topic_receiver_t *receiv
         }
         receiver->subscribers.allInitialized = allInitialized;
     }
-    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+    celixThreadRwlock_unlock(&receiver->subscribers.lock);
 }
 
 static bool psa_tcp_checkVersion(version_pt msgVersion, uint16_t major, uint16_t minor) {
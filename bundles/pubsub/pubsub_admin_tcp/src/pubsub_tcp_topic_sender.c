@@ -33,6 +33,8 @@
 #include "pubsub_tcp_common.h"
 #include <uuid/uuid.h>
 #include "celix_constants.h"
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
 #include <signal.h>
 #include <pubsub_utils.h>
 
@@ -104,8 +106,8 @@ typedef struct psa_tcp_bounded_service_entry {
     pubsub_publisher_t service;
     long bndId;
     hash_map_t *msgTypes; //key = msg type id, value = pubsub_msg_serializer_t
-    hash_map_t *msgTypeIds; // key = msg name, value = msg type id
-    hash_map_t *msgEntries; //key = msg type id, value = psa_tcp_send_msg_entry_t
+    celix_string_hash_map_t *msgTypeIds; // key = msg name, value = msg type id
+    celix_long_hash_map_t *msgEntries; //key = msg type id, value = psa_tcp_send_msg_entry_t
     int getCount;
 } psa_tcp_bounded_service_entry_t;
 
@@ -206,6 +208,38 @@ pubsub_tcp_topic_sender_t *pubsub_tcpTopicSender_create(
         pubsub_tcpHandler_setThreadPriority(sender->socketHandler, prio, sched);
         pubsub_tcpHandler_setSendRetryCnt(sender->socketHandler, (unsigned int) retryCnt);
         pubsub_tcpHandler_setSendTimeOut(sender->socketHandler, timeout);
+        long queueSize = celix_properties_getAsLong(topicProperties, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_KEY,
+                                                    PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_DEFAULT);
+        long batchSize = celix_properties_getAsLong(topicProperties, PUBSUB_TCP_PUBLISHER_BATCH_SIZE_KEY,
+                                                    PUBSUB_TCP_PUBLISHER_BATCH_SIZE_DEFAULT);
+        if (batchSize > 0 && queueSize <= 0) {
+            // Batching requires the send queue, an expired batch is send by the socket thread without blocking
+            L_INFO("[PSA_TCP_V2] Batching for topic %s, using a send queue size of %i", topic,
+                   PUBSUB_TCP_PUBLISHER_BATCH_SEND_QUEUE_SIZE_DEFAULT);
+            queueSize = PUBSUB_TCP_PUBLISHER_BATCH_SEND_QUEUE_SIZE_DEFAULT;
+        }
+        if (queueSize > 0) {
+            const char *policyStr = celix_properties_get(topicProperties, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_KEY,
+                                                         PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_DEFAULT);
+            pubsub_tcpHandler_sendQueuePolicy_t policy = PUBSUB_TCP_SEND_QUEUE_DROP_OLDEST;
+            if (strcmp(policyStr, PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_NEWEST) == 0) {
+                policy = PUBSUB_TCP_SEND_QUEUE_DROP_NEWEST;
+            } else if (strcmp(policyStr, PUBSUB_TCP_SEND_QUEUE_POLICY_BLOCK) == 0) {
+                policy = PUBSUB_TCP_SEND_QUEUE_BLOCK;
+            } else if (strcmp(policyStr, PUBSUB_TCP_SEND_QUEUE_POLICY_DISCONNECT) == 0) {
+                policy = PUBSUB_TCP_SEND_QUEUE_DISCONNECT;
+            } else if (strcmp(policyStr, PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST) != 0) {
+                L_WARN("[PSA_TCP_V2] Unknown send queue policy %s for topic %s, using %s", policyStr, topic,
+                       PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST);
+            }
+            pubsub_tcpHandler_setSendQueue(sender->socketHandler, (unsigned int) queueSize, policy);
+        }
+        if (batchSize > 0) {
+            long batchDelay = celix_properties_getAsLong(topicProperties, PUBSUB_TCP_PUBLISHER_BATCH_DELAY_KEY,
+                                                         PUBSUB_TCP_PUBLISHER_BATCH_DELAY_DEFAULT);
+            pubsub_tcpHandler_setSendBatch(sender->socketHandler, (size_t) batchSize,
+                                           batchDelay > 0 ? (unsigned int) batchDelay : 0);
+        }
     }
 
     //setting up tcp socket for TCP TopicSender
@@ -288,6 +322,8 @@ void pubsub_tcpTopicSender_destroy(pubsub_tcp_topic_sender_t *sender) {
     if (sender != NULL) {
 
         celix_bundleContext_unregisterService(sender->ctx, sender->publisher.svcId);
+        // send the messages which are still batched
+        pubsub_tcpHandler_flush(sender->socketHandler);
 
         celixThreadMutex_lock(&sender->boundedServices.mutex);
         hash_map_iterator_t iter = hashMapIterator_construct(sender->boundedServices.map);
@@ -295,16 +331,16 @@ void pubsub_tcpTopicSender_destroy(pubsub_tcp_topic_sender_t *sender) {
             psa_tcp_bounded_service_entry_t *entry = hashMapIterator_nextValue(&iter);
             if (entry != NULL) {
                 sender->serializer->destroySerializerMap(sender->serializer->handle, entry->msgTypes);
-                hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-                while (hashMapIterator_hasNext(&iter2)) {
-                    psa_tcp_send_msg_entry_t *msgEntry = hashMapIterator_nextValue(&iter2);
+                CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter2) {
+                    psa_tcp_send_msg_entry_t *msgEntry = iter2.value;
                     if (msgEntry->serializedIoVecOutput)
                         free(msgEntry->serializedIoVecOutput);
                     msgEntry->serializedIoVecOutput = NULL;
                     celixThreadMutex_destroy(&msgEntry->metrics.mutex);
                     free(msgEntry);
                 }
-                hashMap_destroy(entry->msgEntries, false, false);
+                celix_longHashMap_destroy(entry->msgEntries);
+                celix_stringHashMap_destroy(entry->msgTypeIds);
                 free(entry);
             }
         }
@@ -350,6 +386,14 @@ bool pubsub_tcpTopicSender_isStatic(pubsub_tcp_topic_sender_t *sender) {
     return sender->isStatic;
 }
 
+size_t pubsub_tcpTopicSender_sendQueueStats(pubsub_tcp_topic_sender_t *sender, pubsub_tcpHandler_sendQueueStats_t **stats) {
+    return pubsub_tcpHandler_getSendQueueStats(sender->socketHandler, stats);
+}
+
+bool pubsub_tcpTopicSender_batchStats(pubsub_tcp_topic_sender_t *sender, pubsub_tcpHandler_batchStats_t *stats) {
+    return pubsub_tcpHandler_getBatchStats(sender->socketHandler, stats);
+}
+
 void pubsub_tcpTopicSender_connectTo(pubsub_tcp_topic_sender_t *sender, const celix_properties_t *endpoint) {
     //TODO subscriber count -> topic info
 }
@@ -360,7 +404,7 @@ void pubsub_tcpTopicSender_disconnectFrom(pubsub_tcp_topic_sender_t *sender, con
 
 static int psa_tcp_localMsgTypeIdForMsgType(void *handle, const char *msgType, unsigned int *msgTypeId) {
     psa_tcp_bounded_service_entry_t *entry = (psa_tcp_bounded_service_entry_t *) handle;
-    *msgTypeId = (unsigned int) (uintptr_t) hashMap_get(entry->msgTypeIds, msgType);
+    *msgTypeId = (unsigned int) celix_stringHashMap_getLong(entry->msgTypeIds, msgType, 0);
     return 0;
 }
 
@@ -378,8 +422,8 @@ static void *psa_tcp_getPublisherService(void *handle, const celix_bundle_t *req
         entry->getCount = 1;
         entry->parent = sender;
         entry->bndId = bndId;
-        entry->msgEntries = hashMap_create(NULL, NULL, NULL, NULL);
-        entry->msgTypeIds = hashMap_create(utils_stringHash, NULL, utils_stringEquals, NULL);
+        entry->msgEntries = celix_longHashMap_create();
+        entry->msgTypeIds = celix_stringHashMap_create();
 
         int rc = sender->serializer->createSerializerMap(sender->serializer->handle,
                                                          (celix_bundle_t *) requestingBundle, &entry->msgTypes);
@@ -400,9 +444,8 @@ static void *psa_tcp_getPublisherService(void *handle, const celix_bundle_t *req
                 sendEntry->minor = (uint8_t) minor;
                 uuid_copy(sendEntry->originUUID, sender->fwUUID);
                 celixThreadMutex_create(&sendEntry->metrics.mutex, NULL);
-                hashMap_put(entry->msgEntries, key, sendEntry);
-                hashMap_put(entry->msgTypeIds, strndup(sendEntry->msgSer->msgName, 1024),
-                            (void *) (uintptr_t) sendEntry->msgSer->msgId);
+                celix_longHashMap_put(entry->msgEntries, (long) (uintptr_t) key, sendEntry);
+                celix_stringHashMap_putLong(entry->msgTypeIds, sendEntry->msgSer->msgName, (long) sendEntry->msgSer->msgId);
             }
             entry->service.handle = entry;
             entry->service.localMsgTypeIdForMsgType = psa_tcp_localMsgTypeIdForMsgType;
@@ -435,18 +478,17 @@ static void psa_tcp_ungetPublisherService(void *handle, const celix_bundle_t *re
             L_ERROR("Error destroying publisher service, serializer not available / cannot get msg serializer map\n");
         }
 
-        hash_map_iterator_t iter = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter)) {
-            psa_tcp_send_msg_entry_t *msgEntry = hashMapIterator_nextValue(&iter);
+        CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter) {
+            psa_tcp_send_msg_entry_t *msgEntry = iter.value;
             if (msgEntry->serializedIoVecOutput)
                 free(msgEntry->serializedIoVecOutput);
             msgEntry->serializedIoVecOutput = NULL;
             celixThreadMutex_destroy(&msgEntry->metrics.mutex);
             free(msgEntry);
         }
-        hashMap_destroy(entry->msgEntries, false, false);
+        celix_longHashMap_destroy(entry->msgEntries);
 
-        hashMap_destroy(entry->msgTypeIds, true, false);
+        celix_stringHashMap_destroy(entry->msgTypeIds);
         free(entry);
     }
     celixThreadMutex_unlock(&sender->boundedServices.mutex);
@@ -462,11 +504,7 @@ pubsub_admin_sender_metrics_t *pubsub_tcpTopicSender_metrics(pubsub_tcp_topic_se
     hash_map_iterator_t iter = hashMapIterator_construct(sender->boundedServices.map);
     while (hashMapIterator_hasNext(&iter)) {
         psa_tcp_bounded_service_entry_t *entry = hashMapIterator_nextValue(&iter);
-        hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter2)) {
-            hashMapIterator_nextValue(&iter2);
-            count += 1;
-        }
+        count += celix_longHashMap_size(entry->msgEntries);
     }
 
     result->msgMetrics = calloc(count, sizeof(*result));
@@ -475,9 +513,8 @@ pubsub_admin_sender_metrics_t *pubsub_tcpTopicSender_metrics(pubsub_tcp_topic_se
     int i = 0;
     while (hashMapIterator_hasNext(&iter)) {
         psa_tcp_bounded_service_entry_t *entry = hashMapIterator_nextValue(&iter);
-        hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter2)) {
-            psa_tcp_send_msg_entry_t *mEntry = hashMapIterator_nextValue(&iter2);
+        CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter2) {
+            psa_tcp_send_msg_entry_t *mEntry = iter2.value;
             celixThreadMutex_lock(&mEntry->metrics.mutex);
             result->msgMetrics[i].nrOfMessagesSend = mEntry->metrics.nrOfMessagesSend;
             result->msgMetrics[i].nrOfMessagesSendFailed = mEntry->metrics.nrOfMessagesSendFailed;
@@ -506,7 +543,7 @@ psa_tcp_topicPublicationSend(void *handle, unsigned int msgTypeId, const void *i
     pubsub_tcp_topic_sender_t *sender = bound->parent;
     bool monitor = sender->metricsEnabled;
 
-    psa_tcp_send_msg_entry_t *entry = hashMap_get(bound->msgEntries, (void *) (uintptr_t) (msgTypeId));
+    psa_tcp_send_msg_entry_t *entry = celix_longHashMap_get(bound->msgEntries, (long) msgTypeId);
 
     //metrics updates
     struct timespec sendTime = {0, 0};
@@ -24,6 +24,7 @@
 #include "pubsub_admin_metrics.h"
 #include "pubsub_protocol.h"
 #include "pubsub_tcp_common.h"
+#include "pubsub_tcp_handler.h"
 
 typedef struct pubsub_tcp_topic_sender pubsub_tcp_topic_sender_t;
 
@@ -53,6 +54,17 @@ long pubsub_tcpTopicSender_serializerSvcId(pubsub_tcp_topic_sender_t *sender);
 
 long pubsub_tcpTopicSender_protocolSvcId(pubsub_tcp_topic_sender_t *sender);
 
+/**
+ * Returns the send queue statistics of the connections of the topic sender.
+ * The caller is owner of the returned array.
+ */
+size_t pubsub_tcpTopicSender_sendQueueStats(pubsub_tcp_topic_sender_t *sender, pubsub_tcpHandler_sendQueueStats_t **stats);
+
+/**
+ * Gets the batch statistics of the topic sender. Returns false if batching is disabled.
+ */
+bool pubsub_tcpTopicSender_batchStats(pubsub_tcp_topic_sender_t *sender, pubsub_tcpHandler_batchStats_t *stats);
+
 void pubsub_tcpTopicSender_connectTo(pubsub_tcp_topic_sender_t *sender, const celix_properties_t *endpoint);
 
 void pubsub_tcpTopicSender_disconnectFrom(pubsub_tcp_topic_sender_t *sender, const celix_properties_t *endpoint);
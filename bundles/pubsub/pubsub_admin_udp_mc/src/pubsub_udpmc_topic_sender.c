@@ -31,6 +31,7 @@
 #include "pubsub_psa_udpmc_constants.h"
 #include "large_udp.h"
 #include "pubsub_udpmc_common.h"
+#include "celix_string_hash_map.h"
 
 #define FIRST_SEND_DELAY_IN_SECONDS     2
 
@@ -68,7 +69,7 @@ typedef struct psa_udpmc_bounded_service_entry {
     pubsub_publisher_t service;
     long bndId;
     hash_map_t *msgTypes;
-    hash_map_t *msgTypeIds;
+    celix_string_hash_map_t *msgTypeIds;
     int getCount;
     largeUdp_t *largeUdpHandle;
 } psa_udpmc_bounded_service_entry_t;
@@ -216,7 +217,7 @@ void pubsub_udpmcTopicSender_disconnectFrom(pubsub_udpmc_topic_sender_t *sender,
 
 static int psa_udpmc_localMsgTypeIdForMsgType(void *handle, const char *msgType, unsigned int *msgTypeId) {
     psa_udpmc_bounded_service_entry_t *entry = (psa_udpmc_bounded_service_entry_t *) handle;
-    *msgTypeId = (unsigned int)(uintptr_t) hashMap_get(entry->msgTypeIds, msgType);
+    *msgTypeId = (unsigned int) celix_stringHashMap_getLong(entry->msgTypeIds, msgType, 0);
     return 0;
 }
 
@@ -236,14 +237,14 @@ static void* psa_udpmc_getPublisherService(void *handle, const celix_bundle_t *r
         entry->parent = sender;
         entry->bndId = bndId;
         entry->largeUdpHandle = largeUdp_create(1);
-        entry->msgTypeIds = hashMap_create(utils_stringHash, NULL, utils_stringEquals, NULL);
+        entry->msgTypeIds = celix_stringHashMap_create();
 
         int rc = sender->serializer->createSerializerMap(sender->serializer->handle, (celix_bundle_t*)requestingBundle, &entry->msgTypes);
         if (rc == 0) {
             hash_map_iterator_t iter = hashMapIterator_construct(entry->msgTypes);
             while (hashMapIterator_hasNext(&iter)) {
                 pubsub_msg_serializer_t *msgSer  = hashMapIterator_nextValue(&iter);
-                hashMap_put(entry->msgTypeIds, strndup(msgSer->msgName, 1024), (void *)(uintptr_t) msgSer->msgId);
+                celix_stringHashMap_putLong(entry->msgTypeIds, msgSer->msgName, (long) msgSer->msgId);
             }
 
             entry->service.handle = entry;
@@ -279,7 +280,7 @@ static void psa_udpmc_ungetPublisherService(void *handle, const celix_bundle_t *
             fprintf(stderr, "Error destroying publisher service, serializer not available / cannot get msg serializer map\n");
         }
 
-        hashMap_destroy(entry->msgTypeIds, true, false);
+        celix_stringHashMap_destroy(entry->msgTypeIds);
         largeUdp_destroy(entry->largeUdpHandle);
         free(entry);
     }
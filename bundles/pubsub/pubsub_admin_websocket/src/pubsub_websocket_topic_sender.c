@@ -31,6 +31,8 @@
 #include <uuid/uuid.h>
 #include <jansson.h>
 #include "celix_constants.h"
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
 #include "http_admin/api.h"
 #include "civetweb.h"
 
@@ -82,8 +84,8 @@ typedef struct psa_websocket_bounded_service_entry {
     pubsub_publisher_t service;
     long bndId;
     hash_map_t *msgTypes; //key = msg type id, value = pubsub_msg_serializer_t
-    hash_map_t *msgTypeIds; //key = msg name, value = msg type id
-    hash_map_t *msgEntries; //key = msg type id, value = psa_websocket_send_msg_entry_t
+    celix_string_hash_map_t *msgTypeIds; //key = msg name, value = msg type id
+    celix_long_hash_map_t *msgEntries; //key = msg type id, value = psa_websocket_send_msg_entry_t
     int getCount;
 } psa_websocket_bounded_service_entry_t;
 
@@ -173,13 +175,13 @@ void pubsub_websocketTopicSender_destroy(pubsub_websocket_topic_sender_t *sender
             if (entry != NULL) {
                 sender->serializer->destroySerializerMap(sender->serializer->handle, entry->msgTypes);
 
-                hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-                while (hashMapIterator_hasNext(&iter2)) {
-                    psa_websocket_send_msg_entry_t *msgEntry = hashMapIterator_nextValue(&iter2);
+                CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter2) {
+                    psa_websocket_send_msg_entry_t *msgEntry = iter2.value;
                     free(msgEntry);
 
                 }
-                hashMap_destroy(entry->msgEntries, false, false);
+                celix_longHashMap_destroy(entry->msgEntries);
+                celix_stringHashMap_destroy(entry->msgTypeIds);
 
                 free(entry);
             }
@@ -218,7 +220,7 @@ const char* pubsub_websocketTopicSender_url(pubsub_websocket_topic_sender_t *sen
 
 static int psa_websocket_localMsgTypeIdForMsgType(void* handle, const char* msgType, unsigned int* msgTypeId) {
     psa_websocket_bounded_service_entry_t *entry = (psa_websocket_bounded_service_entry_t *) handle;
-    *msgTypeId = (unsigned int)(uintptr_t) hashMap_get(entry->msgTypeIds, msgType);
+    *msgTypeId = (unsigned int) celix_stringHashMap_getLong(entry->msgTypeIds, msgType, 0);
     return 0;
 }
 
@@ -235,8 +237,8 @@ static void* psa_websocket_getPublisherService(void *handle, const celix_bundle_
         entry->getCount = 1;
         entry->parent = sender;
         entry->bndId = bndId;
-        entry->msgEntries = hashMap_create(NULL, NULL, NULL, NULL);
-        entry->msgTypeIds = hashMap_create(utils_stringHash, NULL, utils_stringEquals, NULL);
+        entry->msgEntries = celix_longHashMap_create();
+        entry->msgTypeIds = celix_stringHashMap_create();
 
         int rc = sender->serializer->createSerializerMap(sender->serializer->handle, (celix_bundle_t*)requestingBundle, &entry->msgTypes);
         if (rc == 0) {
@@ -253,8 +255,8 @@ static void* psa_websocket_getPublisherService(void *handle, const celix_bundle_
                 version_getMinor(sendEntry->msgSer->msgVersion, &minor);
                 sendEntry->header.major = (uint8_t)major;
                 sendEntry->header.minor = (uint8_t)minor;
-                hashMap_put(entry->msgEntries, key, sendEntry);
-                hashMap_put(entry->msgTypeIds, strndup(sendEntry->msgSer->msgName, 1024), (void *)(uintptr_t) sendEntry->msgSer->msgId);
+                celix_longHashMap_put(entry->msgEntries, (long)(uintptr_t)key, sendEntry);
+                celix_stringHashMap_putLong(entry->msgTypeIds, sendEntry->msgSer->msgName, (long)sendEntry->msgSer->msgId);
             }
             entry->service.handle = entry;
             entry->service.localMsgTypeIdForMsgType = psa_websocket_localMsgTypeIdForMsgType;
@@ -286,14 +288,13 @@ static void psa_websocket_ungetPublisherService(void *handle, const celix_bundle
             L_ERROR("Error destroying publisher service, serializer not available / cannot get msg serializer map\n");
         }
 
-        hash_map_iterator_t iter = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter)) {
-            psa_websocket_send_msg_entry_t *msgEntry = hashMapIterator_nextValue(&iter);
+        CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter) {
+            psa_websocket_send_msg_entry_t *msgEntry = iter.value;
             free(msgEntry);
         }
-        hashMap_destroy(entry->msgEntries, false, false);
+        celix_longHashMap_destroy(entry->msgEntries);
 
-        hashMap_destroy(entry->msgTypeIds, true, false);
+        celix_stringHashMap_destroy(entry->msgTypeIds);
         free(entry);
     }
     celixThreadMutex_unlock(&sender->boundedServices.mutex);
@@ -303,7 +304,7 @@ static int psa_websocket_topicPublicationSend(void* handle, unsigned int msgType
     int status = CELIX_SERVICE_EXCEPTION;
     psa_websocket_bounded_service_entry_t *bound = handle;
     pubsub_websocket_topic_sender_t *sender = bound->parent;
-    psa_websocket_send_msg_entry_t *entry = hashMap_get(bound->msgEntries, (void *) (uintptr_t) (msgTypeId));
+    psa_websocket_send_msg_entry_t *entry = celix_longHashMap_get(bound->msgEntries, (long) msgTypeId);
 
     if (sender->sockConnection != NULL && entry != NULL) {
         delay_first_send_for_late_joiners(sender);
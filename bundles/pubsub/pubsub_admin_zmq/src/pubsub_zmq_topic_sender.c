@@ -32,6 +32,8 @@
 #include "pubsub_psa_zmq_constants.h"
 #include <uuid/uuid.h>
 #include "celix_constants.h"
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
 #include "pubsub_interceptors_handler.h"
 
 #define FIRST_SEND_DELAY_IN_SECONDS             2
@@ -111,8 +113,8 @@ typedef struct psa_zmq_bounded_service_entry {
     pubsub_publisher_t service;
     long bndId;
     hash_map_t *msgTypes; //key = msg type id, value = pubsub_msg_serializer_t
-    hash_map_t *msgTypeIds; //key = msg name, value = msg type id
-    hash_map_t *msgEntries; //key = msg type id, value = psa_zmq_send_msg_entry_t
+    celix_string_hash_map_t *msgTypeIds; //key = msg name, value = msg type id
+    celix_long_hash_map_t *msgEntries; //key = msg type id, value = psa_zmq_send_msg_entry_t
     int getCount;
 } psa_zmq_bounded_service_entry_t;
 
@@ -332,12 +334,12 @@ void pubsub_zmqTopicSender_destroy(pubsub_zmq_topic_sender_t *sender) {
             if (entry != NULL) {
                 sender->serializer->destroySerializerMap(sender->serializer->handle, entry->msgTypes);
 
-                hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-                while (hashMapIterator_hasNext(&iter2)) {
-                    psa_zmq_send_msg_entry_t *msgEntry = hashMapIterator_nextValue(&iter2);
+                CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter2) {
+                    psa_zmq_send_msg_entry_t *msgEntry = iter2.value;
                     pubsub_zmqTopicSender_destroyEntry(msgEntry);
                 }
-                hashMap_destroy(entry->msgEntries, false, false);
+                celix_longHashMap_destroy(entry->msgEntries);
+                celix_stringHashMap_destroy(entry->msgTypeIds);
 
                 free(entry);
             }
@@ -392,7 +394,7 @@ void pubsub_zmqTopicSender_disconnectFrom(pubsub_zmq_topic_sender_t *sender __at
 
 static int psa_zmq_localMsgTypeIdForMsgType(void* handle, const char* msgType, unsigned int* msgTypeId) {
     psa_zmq_bounded_service_entry_t *entry = (psa_zmq_bounded_service_entry_t *) handle;
-    *msgTypeId = (unsigned int)(uintptr_t) hashMap_get(entry->msgTypeIds, msgType);
+    *msgTypeId = (unsigned int) celix_stringHashMap_getLong(entry->msgTypeIds, msgType, 0);
     return 0;
 }
 
@@ -409,8 +411,8 @@ static void* psa_zmq_getPublisherService(void *handle, const celix_bundle_t *req
         entry->getCount = 1;
         entry->parent = sender;
         entry->bndId = bndId;
-        entry->msgEntries = hashMap_create(NULL, NULL, NULL, NULL);
-        entry->msgTypeIds = hashMap_create(utils_stringHash, NULL, utils_stringEquals, NULL);
+        entry->msgEntries = celix_longHashMap_create();
+        entry->msgTypeIds = celix_stringHashMap_create();
 
         int rc = sender->serializer->createSerializerMap(sender->serializer->handle, (celix_bundle_t*)requestingBundle, &entry->msgTypes);
         if (rc == 0) {
@@ -430,8 +432,8 @@ static void* psa_zmq_getPublisherService(void *handle, const celix_bundle_t *req
                 sendEntry->minor = (uint8_t)minor;
                 uuid_copy(sendEntry->originUUID, sender->fwUUID);
                 celixThreadMutex_create(&sendEntry->metrics.mutex, NULL);
-                hashMap_put(entry->msgEntries, key, sendEntry);
-                hashMap_put(entry->msgTypeIds, strndup(sendEntry->msgSer->msgName, 1024), (void *)(uintptr_t) sendEntry->msgSer->msgId);
+                celix_longHashMap_put(entry->msgEntries, (long)(uintptr_t)key, sendEntry);
+                celix_stringHashMap_putLong(entry->msgTypeIds, sendEntry->msgSer->msgName, (long)sendEntry->msgSer->msgId);
             }
             entry->service.handle = entry;
             entry->service.localMsgTypeIdForMsgType = psa_zmq_localMsgTypeIdForMsgType;
@@ -463,14 +465,13 @@ static void psa_zmq_ungetPublisherService(void *handle, const celix_bundle_t *re
             L_ERROR("Error destroying publisher service, serializer not available / cannot get msg serializer map\n");
         }
 
-        hash_map_iterator_t iter = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter)) {
-            psa_zmq_send_msg_entry_t *msgEntry = hashMapIterator_nextValue(&iter);
+        CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter) {
+            psa_zmq_send_msg_entry_t *msgEntry = iter.value;
             pubsub_zmqTopicSender_destroyEntry(msgEntry);
         }
-        hashMap_destroy(entry->msgEntries, false, false);
+        celix_longHashMap_destroy(entry->msgEntries);
 
-        hashMap_destroy(entry->msgTypeIds, true, false);
+        celix_stringHashMap_destroy(entry->msgTypeIds);
         free(entry);
     }
     celixThreadMutex_unlock(&sender->boundedServices.mutex);
@@ -485,11 +486,7 @@ pubsub_admin_sender_metrics_t* pubsub_zmqTopicSender_metrics(pubsub_zmq_topic_se
     hash_map_iterator_t iter = hashMapIterator_construct(sender->boundedServices.map);
     while (hashMapIterator_hasNext(&iter)) {
         psa_zmq_bounded_service_entry_t *entry = hashMapIterator_nextValue(&iter);
-        hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter2)) {
-            hashMapIterator_nextValue(&iter2);
-            count += 1;
-        }
+        count += celix_longHashMap_size(entry->msgEntries);
     }
 
     result->msgMetrics = calloc(count, sizeof(*result));
@@ -498,9 +495,8 @@ pubsub_admin_sender_metrics_t* pubsub_zmqTopicSender_metrics(pubsub_zmq_topic_se
     int i = 0;
     while (hashMapIterator_hasNext(&iter)) {
         psa_zmq_bounded_service_entry_t *entry = hashMapIterator_nextValue(&iter);
-        hash_map_iterator_t iter2 = hashMapIterator_construct(entry->msgEntries);
-        while (hashMapIterator_hasNext(&iter2)) {
-            psa_zmq_send_msg_entry_t *mEntry = hashMapIterator_nextValue(&iter2);
+        CELIX_LONG_HASH_MAP_ITERATE(entry->msgEntries, iter2) {
+            psa_zmq_send_msg_entry_t *mEntry = iter2.value;
             celixThreadMutex_lock(&mEntry->metrics.mutex);
             result->msgMetrics[i].nrOfMessagesSend = mEntry->metrics.nrOfMessagesSend;
             result->msgMetrics[i].nrOfMessagesSendFailed = mEntry->metrics.nrOfMessagesSendFailed;
@@ -538,7 +534,7 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
     pubsub_zmq_topic_sender_t *sender = bound->parent;
     bool monitor = sender->metricsEnabled;
 
-    psa_zmq_send_msg_entry_t *entry = hashMap_get(bound->msgEntries, (void*)(uintptr_t)(msgTypeId));
+    psa_zmq_send_msg_entry_t *entry = celix_longHashMap_get(bound->msgEntries, (long)msgTypeId);
 
     //metrics updates
     struct timespec sendTime = { 0, 0 };
@@ -54,4 +54,35 @@ TEST_F(WireProtocolCommonTest, WireProtocolCommonTest_EncodeMetadata_Benchmark)
 
     std::cout << "WireProtocolCommonTest_EncodeMetadata_Benchmark took " << std::chrono::duration_cast<std::chrono::microseconds>(end-start).count() << " µs\n";
     celix_properties_destroy(message.metadata.metadata);
-}
\ No newline at end of file
+}
+TEST_F(WireProtocolCommonTest, WireProtocolCommonTest_EncodeMetadata_GrowReusedBuffer) { // NOLINT(cert-err58-cpp)
+    pubsub_protocol_message_t message;
+    message.header.convertEndianess = 0;
+    message.metadata.metadata = celix_properties_create();
+    celix_properties_set(message.metadata.metadata, "a", "b");
+
+    void *data = nullptr;
+    size_t length = 0;
+    ASSERT_EQ(CELIX_SUCCESS, pubsubProtocol_encodeMetadata(&message, &data, &length));
+
+    //reuse the encoded buffer, with its encoded length as capacity, for metadata larger than the initial 1024 bytes
+    for (int i = 0; i < 200; ++i) {
+        char key[8];
+        snprintf(key, sizeof(key), "k%03d", i);
+        celix_properties_set(message.metadata.metadata, key, "value");
+    }
+    ASSERT_EQ(CELIX_SUCCESS, pubsubProtocol_encodeMetadata(&message, &data, &length));
+    EXPECT_GT(length, 1024);
+
+    pubsub_protocol_message_t decoded;
+    decoded.header.convertEndianess = 0;
+    decoded.metadata.metadata = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, pubsubProtocol_decodeMetadata(data, length, &decoded));
+    EXPECT_EQ(201, celix_properties_size(decoded.metadata.metadata));
+    EXPECT_STREQ("b", celix_properties_get(decoded.metadata.metadata, "a", nullptr));
+    EXPECT_STREQ("value", celix_properties_get(decoded.metadata.metadata, "k199", nullptr));
+
+    free(data);
+    celix_properties_destroy(decoded.metadata.metadata);
+    celix_properties_destroy(message.metadata.metadata);
+}
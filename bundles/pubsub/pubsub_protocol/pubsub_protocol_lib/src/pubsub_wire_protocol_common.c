@@ -196,9 +196,11 @@ celix_status_t pubsubProtocol_encodeMetadata(pubsub_protocol_message_t *message,
     size_t lineMemoryLength = *outBuffer == NULL ? 1024 : *outLength;
     unsigned char *line = *outBuffer == NULL ? calloc(1, lineMemoryLength) : *outBuffer;
     size_t idx = 4;
-    size_t len = 0;
+    size_t len = idx; // encoded length, including the number of elements
 
-    if (message->metadata.metadata != NULL && celix_properties_size(message->metadata.metadata) > 0) {
+    if (line == NULL) {
+        status = CELIX_ENOMEM;
+    } else if (message->metadata.metadata != NULL && celix_properties_size(message->metadata.metadata) > 0) {
         const char *key;
         char *keyNetString = NULL;
         int netStringMemoryLength = 0;
@@ -215,10 +217,13 @@ celix_status_t pubsubProtocol_encodeMetadata(pubsub_protocol_message_t *message,
 
             len += strlenKeyNetString;
             if(lineMemoryLength < len + 1) {
-                lineMemoryLength *= 2;
+                while(lineMemoryLength < len + 1) {
+                    lineMemoryLength *= 2;
+                }
                 unsigned char *tmp = realloc(line, lineMemoryLength);
                 if (!tmp) {
                     free(line);
+                    line = NULL;
                     status = CELIX_ENOMEM;
                     break;
                 }
@@ -240,6 +245,7 @@ celix_status_t pubsubProtocol_encodeMetadata(pubsub_protocol_message_t *message,
                 unsigned char *tmp = realloc(line, lineMemoryLength);
                 if (!tmp) {
                     free(line);
+                    line = NULL;
                     status = CELIX_ENOMEM;
                     break;
                 }
@@ -251,8 +257,12 @@ celix_status_t pubsubProtocol_encodeMetadata(pubsub_protocol_message_t *message,
 
         free(keyNetString);
     }
-    int size = celix_properties_size(message->metadata.metadata);
-    pubsubProtocol_writeInt((unsigned char *) line, 0, true, size);
+    if (line != NULL) {
+        int size = celix_properties_size(message->metadata.metadata);
+        pubsubProtocol_writeInt((unsigned char *) line, 0, true, size);
+    } else {
+        idx = 0;
+    }
 
     *outBuffer = line;
     *outLength = idx;
@@ -23,6 +23,8 @@
 #include <string.h>
 
 #include "celix_version.h"
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
 #include "pubsub_message_serialization_service.h"
 #include "celix_log_helper.h"
 
@@ -51,7 +53,8 @@ struct pubsub_serializer_handler {
     celix_log_helper_t *logHelper;
 
     celix_thread_rwlock_t lock;
-    hash_map_t *serializationServices; //key = msg id, value = sorted array list with pubsub_serialization_service_entry_t*
+    celix_long_hash_map_t *serializationServices; //key = msg id, value = sorted array list with pubsub_serialization_service_entry_t*
+    celix_string_hash_map_t *msgIds; //key = msg fqn, value = msg id
 };
 
 static void addSerializationService(void *handle, void* svc, const celix_properties_t *props) {
@@ -81,7 +84,7 @@ int compareEntries(const void *a, const void *b) {
 
 static pubsub_serialization_service_entry_t* findEntry(pubsub_serializer_handler_t* handler, uint32_t msgId) {
     //NOTE assumes mutex is locked
-    celix_array_list_t* entries = hashMap_get(handler->serializationServices, (void*)(uintptr_t)msgId);
+    celix_array_list_t* entries = celix_longHashMap_get(handler->serializationServices, msgId);
     if (entries != NULL) {
         return celix_arrayList_get(entries, 0); //NOTE if entries not null, always at least 1 entry
     }
@@ -101,7 +104,7 @@ static bool isCompatible(pubsub_serializer_handler_t* handler, pubsub_serializat
 static const char* getMsgFqn(pubsub_serializer_handler_t* handler, uint32_t msgId) {
     //NOTE assumes mutex is locked
     const char *result = NULL;
-    celix_array_list_t* entries = hashMap_get(handler->serializationServices, (void*)(uintptr_t)msgId);
+    celix_array_list_t* entries = celix_longHashMap_get(handler->serializationServices, msgId);
     if (entries != NULL) {
         pubsub_serialization_service_entry_t *entry = celix_arrayList_get(entries, 0); //NOTE if an entries exists, there is at least 1 entry.
         result = entry->msgFqn;
@@ -117,7 +120,8 @@ pubsub_serializer_handler_t* pubsub_serializerHandler_create(celix_bundle_contex
     handler->logHelper = celix_logHelper_create(ctx, "celix_pubsub_serialization_handler");
 
     celixThreadRwlock_create(&handler->lock, NULL);
-    handler->serializationServices = hashMap_create(NULL, NULL, NULL, NULL);
+    handler->serializationServices = celix_longHashMap_create();
+    handler->msgIds = celix_stringHashMap_create();
 
     char *filter = NULL;
     asprintf(&filter, "(%s=%s)", PUBSUB_MESSAGE_SERIALIZATION_SERVICE_SERIALIZATION_TYPE_PROPERTY, serializerType);
@@ -139,9 +143,8 @@ void pubsub_serializerHandler_destroy(pubsub_serializer_handler_t* handler) {
     if (handler != NULL) {
         celix_bundleContext_stopTracker(handler->ctx, handler->serializationSvcTrackerId);
         celixThreadRwlock_destroy(&handler->lock);
-        hash_map_iterator_t iter = hashMapIterator_construct(handler->serializationServices);
-        while (hashMapIterator_hasNext(&iter)) {
-            celix_array_list_t *entries = hashMapIterator_nextValue(&iter);
+        CELIX_LONG_HASH_MAP_ITERATE(handler->serializationServices, iter) {
+            celix_array_list_t *entries = iter.value;
             for (int i = 0; i < celix_arrayList_size(entries); ++i) {
                 pubsub_serialization_service_entry_t* entry = celix_arrayList_get(entries, i);
                 free(entry->msgFqn);
@@ -150,7 +153,8 @@ void pubsub_serializerHandler_destroy(pubsub_serializer_handler_t* handler) {
             }
             celix_arrayList_destroy(entries);
         }
-        hashMap_destroy(handler->serializationServices, false, false);
+        celix_longHashMap_destroy(handler->serializationServices);
+        celix_stringHashMap_destroy(handler->msgIds);
         celix_logHelper_destroy(handler->logHelper);
         free(handler);
     }
@@ -190,9 +194,12 @@ void pubsub_serializerHandler_addSerializationService(pubsub_serializer_handler_
     }
 
     if (valid) {
-        celix_array_list_t *entries = hashMap_get(handler->serializationServices, (void *) (uintptr_t) msgId);
+        celix_array_list_t *entries = celix_longHashMap_get(handler->serializationServices, msgId);
         if (entries == NULL) {
             entries = celix_arrayList_create();
+            if (msgFqn != NULL) {
+                celix_stringHashMap_putLong(handler->msgIds, msgFqn, msgId);
+            }
         }
         pubsub_serialization_service_entry_t *entry = calloc(1, sizeof(*entry));
         entry->svcId = svcId;
@@ -204,7 +211,7 @@ void pubsub_serializerHandler_addSerializationService(pubsub_serializer_handler_
         celix_arrayList_add(entries, entry);
         celix_arrayList_sort(entries, compareEntries);
 
-        hashMap_put(handler->serializationServices, (void *) (uintptr_t) msgId, entries);
+        celix_longHashMap_put(handler->serializationServices, msgId, entries);
     } else {
         celix_version_destroy(msgVersion);
     }
@@ -220,7 +227,7 @@ void pubsub_serializerHandler_removeSerializationService(pubsub_serializer_handl
     }
 
     celixThreadRwlock_writeLock(&handler->lock);
-    celix_array_list_t* entries = hashMap_get(handler->serializationServices, (void*)(uintptr_t)msgId);
+    celix_array_list_t* entries = celix_longHashMap_get(handler->serializationServices, msgId);
     if (entries != NULL) {
         pubsub_serialization_service_entry_t *found = NULL;
         for (int i = 0; i < celix_arrayList_size(entries); ++i) {
@@ -238,7 +245,10 @@ void pubsub_serializerHandler_removeSerializationService(pubsub_serializer_handl
             free(found);
         }
         if (celix_arrayList_size(entries) == 0) {
-            hashMap_remove(handler->serializationServices, (void*)(uintptr_t)msgId);
+            celix_longHashMap_remove(handler->serializationServices, msgId);
+            if (msgFqn != NULL) {
+                celix_stringHashMap_remove(handler->msgIds, msgFqn);
+            }
             celix_arrayList_destroy(entries);
         }
     }
@@ -333,13 +343,8 @@ char* pubsub_serializerHandler_getMsgFqn(pubsub_serializer_handler_t* handler, u
 uint32_t pubsub_serializerHandler_getMsgId(pubsub_serializer_handler_t* handler, const char* msgFqn) {
     uint32_t result = 0;
     celixThreadRwlock_readLock(&handler->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(handler->serializationServices);
-    while (hashMapIterator_hasNext(&iter) && result == 0) {
-        celix_array_list_t *entries = hashMapIterator_nextValue(&iter);
-        pubsub_serialization_service_entry_t* entry = celix_arrayList_get(entries, 0); //NOTE if an entries exists, there is at least 1 entry.
-        if (strncmp(entry->msgFqn, msgFqn, 1024*1024) == 0) {
-            result = entry->msgId;
-        }
+    if (msgFqn != NULL) {
+        result = (uint32_t)celix_stringHashMap_getLong(handler->msgIds, msgFqn, 0);
     }
     celixThreadRwlock_unlock(&handler->lock);
     return result;
@@ -348,9 +353,8 @@ uint32_t pubsub_serializerHandler_getMsgId(pubsub_serializer_handler_t* handler,
 size_t pubsub_serializerHandler_messageSerializationServiceCount(pubsub_serializer_handler_t* handler) {
     size_t count = 0;
     celixThreadRwlock_readLock(&handler->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(handler->serializationServices);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_array_list_t *entries = hashMapIterator_nextValue(&iter);
+    CELIX_LONG_HASH_MAP_ITERATE(handler->serializationServices, iter) {
+        celix_array_list_t *entries = iter.value;
         count += celix_arrayList_size(entries);
     }
     celixThreadRwlock_unlock(&handler->lock);
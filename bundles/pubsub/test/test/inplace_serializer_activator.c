@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_api.h"
+#include "pubsub_constants.h"
+#include "pubsub_serializer.h"
+
+#include "msg.h"
+
+/**
+ * Serializer for the msg type which deserializes the messages in place, i.e. the deserialized message is the received
+ * payload. Used to test the in place (zero-copy) receive path of the pubsub admins.
+ */
+#define INPLACE_SERIALIZER_TYPE "inplace"
+
+struct activator {
+    pubsub_serializer_service_t serializerSvc;
+    long serializerSvcId;
+};
+
+static celix_status_t inplace_serialize(void *handle __attribute__((unused)), const void *input, struct iovec **output, size_t *outputIovLen) {
+    struct iovec *iov = calloc(1, sizeof(*iov));
+    void *data = malloc(sizeof(msg_t));
+    if (iov == NULL || data == NULL) {
+        free(iov);
+        free(data);
+        return CELIX_ENOMEM;
+    }
+    memcpy(data, input, sizeof(msg_t));
+    iov->iov_base = data;
+    iov->iov_len = sizeof(msg_t);
+    *output = iov;
+    *outputIovLen = 1;
+    return CELIX_SUCCESS;
+}
+
+static void inplace_freeSerializeMsg(void *handle __attribute__((unused)), const struct iovec *input, size_t inputIovLen) {
+    for (size_t i = 0; input != NULL && i < inputIovLen; ++i) {
+        free(input[i].iov_base);
+    }
+    free((void *) input);
+}
+
+static celix_status_t inplace_deserialize(void *handle __attribute__((unused)), const struct iovec *input, size_t inputIovLen, void **out) {
+    if (inputIovLen != 1 || input->iov_len != sizeof(msg_t)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    *out = input->iov_base;
+    return CELIX_SUCCESS;
+}
+
+static void inplace_freeDeserializeMsg(void *handle __attribute__((unused)), void *msg) {
+    //the message is the payload, which is owned by the caller when the message is not used in place
+    free(msg);
+}
+
+static celix_status_t inplace_createSerializerMap(void *handle __attribute__((unused)), const celix_bundle_t *bundle __attribute__((unused)), hash_map_pt *serializerMap) {
+    pubsub_msg_serializer_t *msgSer = calloc(1, sizeof(*msgSer));
+    msgSer->msgId = celix_utils_stringHash(MSG_NAME);
+    msgSer->msgName = MSG_NAME;
+    version_createVersion(1, 0, 0, "", &msgSer->msgVersion);
+    msgSer->serialize = inplace_serialize;
+    msgSer->freeSerializeMsg = inplace_freeSerializeMsg;
+    msgSer->deserialize = inplace_deserialize;
+    msgSer->freeDeserializeMsg = inplace_freeDeserializeMsg;
+
+    *serializerMap = hashMap_create(NULL, NULL, NULL, NULL);
+    hashMap_put(*serializerMap, (void *) (uintptr_t) msgSer->msgId, msgSer);
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t inplace_destroySerializerMap(void *handle __attribute__((unused)), hash_map_pt serializerMap) {
+    hash_map_iterator_t iter = hashMapIterator_construct(serializerMap);
+    while (hashMapIterator_hasNext(&iter)) {
+        pubsub_msg_serializer_t *msgSer = hashMapIterator_nextValue(&iter);
+        version_destroy(msgSer->msgVersion);
+        free(msgSer);
+    }
+    hashMap_destroy(serializerMap, false, false);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
+    act->serializerSvc.handle = act;
+    act->serializerSvc.createSerializerMap = inplace_createSerializerMap;
+    act->serializerSvc.destroySerializerMap = inplace_destroySerializerMap;
+    celix_properties_t *props = celix_properties_create();
+    celix_properties_set(props, PUBSUB_SERIALIZER_TYPE_KEY, INPLACE_SERIALIZER_TYPE);
+    act->serializerSvcId = celix_bundleContext_registerService(ctx, &act->serializerSvc, PUBSUB_SERIALIZER_SERVICE_NAME, props);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t bnd_stop(struct activator *act, celix_bundle_context_t *ctx) {
+    celix_bundleContext_unregisterService(ctx, act->serializerSvcId);
+    return CELIX_SUCCESS;
+}
+
+CELIX_GEN_BUNDLE_ACTIVATOR(struct activator, bnd_start, bnd_stop)
@@ -24,6 +24,13 @@
 
 #define MSG_NAME "msg"
 
+/**
+ * Optional metadata entry with the id (0 .. MSG_MAX_PUBLISHERS - 1) of the publisher of the message,
+ * used to check the order of the messages per publisher when there are multiple publishers.
+ */
+#define MSG_PUBLISHER_METADATA_KEY "publisher"
+#define MSG_MAX_PUBLISHERS 8
+
 typedef struct msg {
     uint32_t seqNr;
 } msg_t;
@@ -25,6 +25,12 @@
 typedef struct celix_receive_count_service {
     void *handle;
     size_t (*receiveCount)(void *handle);
+
+    /**
+     * Nr of received messages which were not newer than the previous message of the same publisher
+     * (see MSG_PUBLISHER_METADATA_KEY), or which were changed while kept by the subscriber. Optional, can be NULL.
+     */
+    size_t (*outOfOrderCount)(void *handle);
 } celix_receive_count_service_t;
 
 #endif //CELIX_RECEIVE_COUNT_SERVICE_H
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_api.h"
+#include "celix_shell_command.h"
+#include <unistd.h>
+#include <cstring>
+#include "receive_count_service.h"
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/CommandLineTestRunner.h>
+
+int main(int argc, char **argv) {
+    MemoryLeakWarningPlugin::turnOffNewDeleteOverloads();
+    int rc = RUN_ALL_TESTS(argc, argv);
+    return rc;
+}
+
+TEST_GROUP(PUBSUB_TCP_BATCH_GROUP) {
+    celix_framework_t *fw = nullptr;
+    celix_bundle_context_t *ctx = nullptr;
+    void setup() override {
+        celixLauncher_launch("config.properties", &fw);
+        ctx = celix_framework_getFrameworkContext(fw);
+    }
+
+    void teardown() override {
+        celixLauncher_stop(fw);
+        celixLauncher_waitForShutdown(fw);
+        celixLauncher_destroy(fw);
+        ctx = nullptr;
+        fw = nullptr;
+    }
+};
+
+TEST(PUBSUB_TCP_BATCH_GROUP, recvBatchedTest) {
+    constexpr int TRIES = 50;
+    constexpr int TIMEOUT = 250000;
+    constexpr int MSG_COUNT = 100;
+
+    int count = 0;
+    for (int i = 0; i < TRIES; ++i) {
+        celix_bundleContext_useService(ctx, CELIX_RECEIVE_COUNT_SERVICE_NAME, &count, [](void *handle, void *svc) {
+            auto *count_ptr = static_cast<int *>(handle);
+            auto *count = static_cast<celix_receive_count_service_t *>(svc);
+            *count_ptr = count->receiveCount(count->handle);
+        });
+        printf("Current msg count is %i, waiting for at least %i\n", count, MSG_COUNT);
+        if (count >= MSG_COUNT) {
+            break;
+        }
+        usleep(TIMEOUT);
+    }
+    CHECK(count >= MSG_COUNT);
+
+    //the batch counters of the ping sender are printed by the psa_tcp command
+    char *output = nullptr;
+    size_t outputSize = 0;
+    FILE *out = open_memstream(&output, &outputSize);
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_SHELL_COMMAND_SERVICE_NAME;
+    opts.filter.filter = "(" CELIX_SHELL_COMMAND_NAME "=celix::psa_tcp)";
+    opts.callbackHandle = out;
+    opts.use = [](void *handle, void *svc) {
+        auto *cmd = static_cast<celix_shell_command_t *>(svc);
+        cmd->executeCommand(cmd->handle, "psa_tcp", static_cast<FILE *>(handle), stderr);
+    };
+    bool called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    fclose(out);
+    printf("%s\n", output);
+    CHECK(called);
+
+    const char *line = strstr(output, "batches = ");
+    CHECK(line != nullptr);
+    unsigned long nrOfBatches = 0;
+    unsigned long nrOfBatchedMessages = 0;
+    double avg = 0.0;
+    unsigned int max = 0;
+    int rc = sscanf(line, "batches = %lu, batched messages = %lu, avg messages per batch = %lf, max messages per batch = %u",
+                    &nrOfBatches, &nrOfBatchedMessages, &avg, &max);
+    CHECK_EQUAL(4, rc);
+    CHECK(nrOfBatches > 0);
+    //at least the received messages are send in a batch and the batches contain more than one message
+    CHECK(nrOfBatchedMessages >= (unsigned long) MSG_COUNT);
+    CHECK(nrOfBatchedMessages > nrOfBatches);
+    CHECK(max > 1);
+    free(output);
+}
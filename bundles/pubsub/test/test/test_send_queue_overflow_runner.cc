@@ -0,0 +1,346 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_api.h"
+#include "celix_shell_command.h"
+#include "bundle.h"
+#include <unistd.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+#include "pubsub/api.h"
+#include "pubsub_protocol.h"
+#include "msg.h"
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/CommandLineTestRunner.h>
+
+/**
+ * The test publishes on the topics of meta_data/tcp_send_queue_overflow, one topic per send queue policy. The topic
+ * properties are only used for bundles (not the framework), so the publishers are requested with the context of the
+ * pubsub_tcp_send_queue_overflow_pub resource bundle.
+ * A "raw" TCP subscriber connects to the static bind url of the publisher and stops reading, so that the socket
+ * buffers and the send queue of the connection fill up and the send queue policy is applied.
+ */
+constexpr const char *PUB_BUNDLE_NAME = "pubsub_tcp_send_queue_overflow_pub";
+constexpr int MAX_MSG_COUNT = 100000;
+constexpr unsigned int SEND_QUEUE_SIZE = 4;
+constexpr unsigned long MIN_DROPPED_COUNT = 10;
+
+int main(int argc, char **argv) {
+    MemoryLeakWarningPlugin::turnOffNewDeleteOverloads();
+    int rc = RUN_ALL_TESTS(argc, argv);
+    return rc;
+}
+
+TEST_GROUP(PUBSUB_TCP_SEND_QUEUE_OVERFLOW_GROUP) {
+    celix_framework_t *fw = nullptr;
+    celix_bundle_context_t *ctx = nullptr;
+    celix_bundle_context_t *pubCtx = nullptr;
+    long pubTrkId = -1L;
+    std::atomic<pubsub_publisher_t *> pubSvc{nullptr};
+    int fd = -1;
+
+    struct send_queue_stats {
+        bool found;
+        unsigned int depth;
+        unsigned int maxDepth;
+        unsigned long queued;
+        unsigned long dropped;
+    };
+
+    struct publish_result {
+        int published;
+        int failed;
+        double minFailedDuration;
+    };
+
+    void setup() override {
+        celixLauncher_launch("config.properties", &fw);
+        ctx = celix_framework_getFrameworkContext(fw);
+    }
+
+    void teardown() override {
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (pubTrkId >= 0) {
+            celix_bundleContext_stopTracker(pubCtx, pubTrkId);
+        }
+        celixLauncher_stop(fw);
+        celixLauncher_waitForShutdown(fw);
+        celixLauncher_destroy(fw);
+        ctx = nullptr;
+        fw = nullptr;
+    }
+
+    pubsub_publisher_t *trackPublisher(const char *topic) {
+        char filter[128];
+        snprintf(filter, sizeof(filter), "(%s=%s)", PUBSUB_PUBLISHER_TOPIC, topic);
+        celix_service_tracking_options_t opts{};
+        opts.filter.serviceName = PUBSUB_PUBLISHER_SERVICE_NAME;
+        opts.filter.filter = filter;
+        opts.callbackHandle = &pubSvc;
+        opts.set = [](void *handle, void *svc) {
+            static_cast<std::atomic<pubsub_publisher_t *> *>(handle)->store(static_cast<pubsub_publisher_t *>(svc));
+        };
+        celix_bundleContext_useBundles(ctx, &pubCtx, [](void *handle, const celix_bundle_t *bnd) {
+            if (strcmp(celix_bundle_getSymbolicName(bnd), PUB_BUNDLE_NAME) == 0) {
+                bundle_getContext(bnd, static_cast<celix_bundle_context_t **>(handle));
+            }
+        });
+        CHECK(pubCtx != nullptr);
+        pubTrkId = celix_bundleContext_trackServicesWithOptions(pubCtx, &opts);
+        for (int i = 0; i < 100 && pubSvc.load() == nullptr; ++i) {
+            usleep(100000);
+        }
+        CHECK(pubSvc.load() != nullptr);
+        return pubSvc.load();
+    }
+
+    //connects a subscriber with a small receive buffer, which never reads till readFrames is called
+    void connectStalledSubscriber(int port) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        CHECK(fd >= 0);
+        int rcvBuf = 1024;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        CHECK_EQUAL(0, connect(fd, (struct sockaddr *) &addr, sizeof(addr)));
+
+        //wait till the publisher has accepted the connection
+        send_queue_stats stats{};
+        for (int i = 0; i < 50 && !stats.found; ++i) {
+            usleep(100000);
+            stats = sendQueueStats();
+        }
+        CHECK(stats.found);
+        //and marked it as connected
+        usleep(100000);
+    }
+
+    //the send queue counters of the (single) publisher connection are printed by the psa_tcp command
+    send_queue_stats sendQueueStats() {
+        char *output = nullptr;
+        size_t outputSize = 0;
+        FILE *out = open_memstream(&output, &outputSize);
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = CELIX_SHELL_COMMAND_SERVICE_NAME;
+        opts.filter.filter = "(" CELIX_SHELL_COMMAND_NAME "=celix::psa_tcp)";
+        opts.callbackHandle = out;
+        opts.use = [](void *handle, void *svc) {
+            auto *cmd = static_cast<celix_shell_command_t *>(svc);
+            cmd->executeCommand(cmd->handle, "psa_tcp", static_cast<FILE *>(handle), stderr);
+        };
+        bool called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+        fclose(out);
+        CHECK(called);
+
+        send_queue_stats stats{};
+        const char *line = strstr(output, "send queue ");
+        if (line != nullptr) {
+            line = strstr(line, ": depth");
+            stats.found = line != nullptr &&
+                    sscanf(line, ": depth = %u, max depth = %u, queued = %lu, dropped = %lu",
+                           &stats.depth, &stats.maxDepth, &stats.queued, &stats.dropped) == 4;
+        }
+        free(output);
+        return stats;
+    }
+
+    //publishes till the publisher reports minDropped dropped messages or till a send fails (if stopOnFailure)
+    publish_result publishTillDropped(pubsub_publisher_t *pub, unsigned long minDropped, bool stopOnFailure) {
+        publish_result result{0, 0, 1.0e9};
+        unsigned int msgId = 0;
+        CHECK_EQUAL(0, pub->localMsgTypeIdForMsgType(pub->handle, MSG_NAME, &msgId));
+        msg_t msg{};
+        for (int i = 0; i < MAX_MSG_COUNT; ++i) {
+            msg.seqNr = (uint32_t) i;
+            struct timespec start{};
+            struct timespec end{};
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            int rc = pub->send(pub->handle, msgId, &msg, nullptr);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            result.published++;
+            if (rc != 0) {
+                result.failed++;
+                result.minFailedDuration = std::min(result.minFailedDuration, celix_difftime(&start, &end));
+                if (stopOnFailure) {
+                    break;
+                }
+            }
+            if (i % 100 == 0 && sendQueueStats().dropped >= minDropped) {
+                break;
+            }
+        }
+        printf("Published %i messages, %i failed\n", result.published, result.failed);
+        return result;
+    }
+
+    /**
+     * Reads the frames send to the subscriber, till no data is received for a second or the connection is closed.
+     * Checks that all frames are valid (only the last frame can be incomplete if the connection is closed) and
+     * returns the header sequence numbers.
+     */
+    std::vector<unsigned int> readFrames(bool *closed) {
+        std::vector<char> data;
+        *closed = false;
+        struct pollfd pfd{};
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        while (!*closed && poll(&pfd, 1, 1000) == 1) {
+            char buf[4096];
+            ssize_t nbytes = recv(fd, buf, sizeof(buf), 0);
+            if (nbytes <= 0) {
+                *closed = true;
+            } else {
+                data.insert(data.end(), buf, buf + nbytes);
+            }
+        }
+
+        struct decode_data {
+            std::vector<char> *data;
+            std::vector<unsigned int> seqNrs;
+            size_t remaining;
+            bool valid;
+        } decode{&data, {}, 0, true};
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = PUBSUB_PROTOCOL_SERVICE_NAME;
+        opts.callbackHandle = &decode;
+        opts.use = [](void *handle, void *svc) {
+            auto *decode = static_cast<decode_data *>(handle);
+            auto *protocol = static_cast<pubsub_protocol_service_t *>(svc);
+            size_t headerSize = 0;
+            size_t footerSize = 0;
+            protocol->getHeaderSize(protocol->handle, &headerSize);
+            protocol->getFooterSize(protocol->handle, &footerSize);
+            size_t offset = 0;
+            while (decode->valid && decode->data->size() - offset >= headerSize) {
+                char *frame = decode->data->data() + offset;
+                pubsub_protocol_message_t message{};
+                decode->valid = protocol->decodeHeader(protocol->handle, frame, headerSize, &message) == CELIX_SUCCESS;
+                size_t frameSize = headerSize + message.header.payloadPartSize + message.header.metadataSize + footerSize;
+                if (!decode->valid || decode->data->size() - offset < frameSize) {
+                    break;
+                }
+                if (footerSize > 0) {
+                    decode->valid = protocol->decodeFooter(protocol->handle, frame + frameSize - footerSize, footerSize,
+                                                           &message) == CELIX_SUCCESS;
+                }
+                if (decode->valid) {
+                    decode->seqNrs.push_back(message.header.seqNr);
+                    offset += frameSize;
+                }
+            }
+            decode->remaining = decode->data->size() - offset;
+        };
+        CHECK(celix_bundleContext_useServiceWithOptions(ctx, &opts));
+        CHECK(decode.valid);
+        if (!*closed) {
+            CHECK_EQUAL(0, decode.remaining);
+        }
+        for (size_t i = 1; i < decode.seqNrs.size(); ++i) {
+            CHECK(decode.seqNrs[i] > decode.seqNrs[i - 1]);
+        }
+        printf("Received %zu messages\n", decode.seqNrs.size());
+        return decode.seqNrs;
+    }
+};
+
+TEST(PUBSUB_TCP_SEND_QUEUE_OVERFLOW_GROUP, dropOldestTest) {
+    pubsub_publisher_t *pub = trackPublisher("drop_oldest");
+    connectStalledSubscriber(9008);
+
+    publish_result result = publishTillDropped(pub, MIN_DROPPED_COUNT, false);
+    send_queue_stats stats = sendQueueStats();
+    CHECK(stats.dropped >= MIN_DROPPED_COUNT);
+    CHECK(stats.queued > stats.dropped);
+    CHECK_EQUAL(SEND_QUEUE_SIZE, stats.maxDepth);
+    //the oldest queued messages are dropped in favor of the published message
+    CHECK_EQUAL(0, result.failed);
+
+    //the dropped messages are skipped, but the (partially send) messages in the stream stay intact
+    bool closed = false;
+    std::vector<unsigned int> seqNrs = readFrames(&closed);
+    CHECK(!closed);
+    CHECK_EQUAL((size_t) result.published - stats.dropped, seqNrs.size());
+    CHECK_EQUAL(0, sendQueueStats().depth);
+}
+
+TEST(PUBSUB_TCP_SEND_QUEUE_OVERFLOW_GROUP, dropNewestTest) {
+    pubsub_publisher_t *pub = trackPublisher("drop_newest");
+    connectStalledSubscriber(9009);
+
+    publish_result result = publishTillDropped(pub, MIN_DROPPED_COUNT, false);
+    send_queue_stats stats = sendQueueStats();
+    CHECK(stats.dropped >= MIN_DROPPED_COUNT);
+    CHECK_EQUAL(SEND_QUEUE_SIZE, stats.maxDepth);
+    //a dropped published message is reported as failed send
+    CHECK_EQUAL((int) stats.dropped, result.failed);
+
+    bool closed = false;
+    std::vector<unsigned int> seqNrs = readFrames(&closed);
+    CHECK(!closed);
+    CHECK_EQUAL((size_t) (result.published - result.failed), seqNrs.size());
+}
+
+TEST(PUBSUB_TCP_SEND_QUEUE_OVERFLOW_GROUP, blockTest) {
+    constexpr double SEND_TIMEOUT = 0.05;
+    pubsub_publisher_t *pub = trackPublisher("block");
+    connectStalledSubscriber(9010);
+
+    publish_result result = publishTillDropped(pub, 3, false);
+    send_queue_stats stats = sendQueueStats();
+    CHECK(stats.dropped >= 3);
+    CHECK_EQUAL(SEND_QUEUE_SIZE, stats.maxDepth);
+    //the publisher is blocked for the send timeout, before the message is dropped and the send fails
+    CHECK_EQUAL((int) stats.dropped, result.failed);
+    CHECK(result.minFailedDuration >= SEND_TIMEOUT);
+
+    bool closed = false;
+    std::vector<unsigned int> seqNrs = readFrames(&closed);
+    CHECK(!closed);
+    CHECK_EQUAL((size_t) (result.published - result.failed), seqNrs.size());
+}
+
+TEST(PUBSUB_TCP_SEND_QUEUE_OVERFLOW_GROUP, disconnectTest) {
+    pubsub_publisher_t *pub = trackPublisher("disconnect");
+    connectStalledSubscriber(9011);
+
+    publish_result result = publishTillDropped(pub, 1, true);
+    CHECK_EQUAL(1, result.failed);
+    //the connection is closed and removed, without counting a dropped message
+    CHECK(!sendQueueStats().found);
+
+    //the queued messages are discarded, but the frames send before the disconnect are intact
+    bool closed = false;
+    std::vector<unsigned int> seqNrs = readFrames(&closed);
+    CHECK(closed);
+    CHECK(!seqNrs.empty());
+    CHECK(seqNrs.size() < (size_t) result.published);
+}
@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_api.h"
+#include <unistd.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cstring>
+#include <vector>
+
+#include "pubsub_protocol.h"
+#include "pubsub_message_serialization_service.h"
+#include "receive_count_service.h"
+#include "msg.h"
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/CommandLineTestRunner.h>
+
+/**
+ * The test acts as a "raw" TCP publisher on the static connect url of the ping subscriber (see
+ * meta_data/tcp_split_header/ping.properties) and writes the wire protocol messages in small parts, so that the
+ * headers of the messages are received split over multiple TCP segments.
+ */
+constexpr int PUBLISHER_PORT = 9005;
+
+int main(int argc, char **argv) {
+    MemoryLeakWarningPlugin::turnOffNewDeleteOverloads();
+    int rc = RUN_ALL_TESTS(argc, argv);
+    return rc;
+}
+
+TEST_GROUP(PUBSUB_TCP_SPLIT_HEADER_GROUP) {
+    celix_framework_t *fw = nullptr;
+    celix_bundle_context_t *ctx = nullptr;
+    int listenFd = -1;
+    int fd = -1;
+
+    void setup() override {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(PUBLISHER_PORT);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        CHECK_EQUAL(0, bind(listenFd, (struct sockaddr *) &addr, sizeof(addr)));
+        CHECK_EQUAL(0, listen(listenFd, 1));
+
+        celixLauncher_launch("config.properties", &fw);
+        ctx = celix_framework_getFrameworkContext(fw);
+    }
+
+    void teardown() override {
+        celixLauncher_stop(fw);
+        celixLauncher_waitForShutdown(fw);
+        celixLauncher_destroy(fw);
+        if (fd >= 0) {
+            close(fd);
+        }
+        close(listenFd);
+        ctx = nullptr;
+        fw = nullptr;
+    }
+
+    void acceptSubscriber() {
+        struct pollfd pfd{};
+        pfd.fd = listenFd;
+        pfd.events = POLLIN;
+        CHECK_EQUAL(1, poll(&pfd, 1, 10000));
+        fd = accept(listenFd, nullptr, nullptr);
+        CHECK(fd >= 0);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    struct encode_data {
+        uint32_t seqNr;
+        uint32_t msgId;
+        std::vector<char> payload;
+        std::vector<char> frame;
+    };
+
+    std::vector<char> encodeMessage(uint32_t seqNr) {
+        encode_data data{};
+        data.seqNr = seqNr;
+
+        celix_service_use_options_t serOpts{};
+        serOpts.filter.serviceName = PUBSUB_MESSAGE_SERIALIZATION_SERVICE_NAME;
+        serOpts.filter.filter = "(" PUBSUB_MESSAGE_SERIALIZATION_SERVICE_MSG_FQN_PROPERTY "=" MSG_NAME ")";
+        serOpts.waitTimeoutInSeconds = 10.0;
+        serOpts.callbackHandle = &data;
+        serOpts.useWithProperties = [](void *handle, void *svc, const celix_properties_t *props) {
+            auto *data = static_cast<encode_data *>(handle);
+            auto *serSvc = static_cast<pubsub_message_serialization_service_t *>(svc);
+            data->msgId = (uint32_t) celix_properties_getAsLong(props, PUBSUB_MESSAGE_SERIALIZATION_SERVICE_MSG_ID_PROPERTY, 0);
+            msg_t msg{};
+            msg.seqNr = data->seqNr;
+            struct iovec *serialized = nullptr;
+            size_t serializedLen = 0;
+            if (serSvc->serialize(serSvc->handle, &msg, &serialized, &serializedLen) == CELIX_SUCCESS) {
+                for (size_t i = 0; i < serializedLen; ++i) {
+                    auto *base = static_cast<char *>(serialized[i].iov_base);
+                    data->payload.insert(data->payload.end(), base, base + serialized[i].iov_len);
+                }
+                serSvc->freeSerializedMsg(serSvc->handle, serialized, serializedLen);
+            }
+        };
+        CHECK(celix_bundleContext_useServiceWithOptions(ctx, &serOpts));
+        CHECK(!data.payload.empty());
+
+        celix_service_use_options_t protocolOpts{};
+        protocolOpts.filter.serviceName = PUBSUB_PROTOCOL_SERVICE_NAME;
+        protocolOpts.waitTimeoutInSeconds = 10.0;
+        protocolOpts.callbackHandle = &data;
+        protocolOpts.use = [](void *handle, void *svc) {
+            auto *data = static_cast<encode_data *>(handle);
+            auto *protocol = static_cast<pubsub_protocol_service_t *>(svc);
+            pubsub_protocol_message_t message{};
+            message.header.msgId = data->msgId;
+            message.header.seqNr = data->seqNr;
+            message.header.msgMajorVersion = 1;
+            message.header.msgMinorVersion = 0;
+            message.header.payloadSize = data->payload.size();
+            message.header.payloadPartSize = data->payload.size();
+            message.header.isLastSegment = 1;
+            message.payload.payload = data->payload.data();
+            message.payload.length = data->payload.size();
+
+            void *headerData = nullptr;
+            size_t headerSize = 0;
+            protocol->encodeHeader(protocol->handle, &message, &headerData, &headerSize);
+            data->frame.insert(data->frame.end(), (char *) headerData, (char *) headerData + headerSize);
+            free(headerData);
+            data->frame.insert(data->frame.end(), data->payload.begin(), data->payload.end());
+
+            size_t footerSize = 0;
+            protocol->getFooterSize(protocol->handle, &footerSize);
+            if (footerSize > 0) {
+                void *footerData = nullptr;
+                protocol->encodeFooter(protocol->handle, &message, &footerData, &footerSize);
+                data->frame.insert(data->frame.end(), (char *) footerData, (char *) footerData + footerSize);
+                free(footerData);
+            }
+        };
+        CHECK(celix_bundleContext_useServiceWithOptions(ctx, &protocolOpts));
+        return data.frame;
+    }
+
+    void writePart(const char *data, size_t size) {
+        CHECK_EQUAL((ssize_t) size, write(fd, data, size));
+        //give the subscriber time to read the part as a separate TCP segment
+        usleep(5000);
+    }
+};
+
+TEST(PUBSUB_TCP_SPLIT_HEADER_GROUP, recvSplitHeaderTest) {
+    constexpr int MSG_COUNT = 20;
+    constexpr int TRIES = 50;
+    constexpr int TIMEOUT = 100000;
+
+    acceptSubscriber();
+    //give the receiver time to setup the subscriber for the connection
+    usleep(250000);
+
+    for (uint32_t seqNr = 1; seqNr <= MSG_COUNT; ++seqNr) {
+        std::vector<char> frame = encodeMessage(seqNr);
+        //split the header at a different position for every message, including the sync word
+        size_t split = 1 + seqNr % 12;
+        writePart(frame.data(), split);
+        writePart(frame.data() + split, 3);
+        writePart(frame.data() + split + 3, frame.size() - split - 3);
+    }
+
+    int count = 0;
+    for (int i = 0; i < TRIES; ++i) {
+        celix_bundleContext_useService(ctx, CELIX_RECEIVE_COUNT_SERVICE_NAME, &count, [](void *handle, void *svc) {
+            auto *count_ptr = static_cast<int *>(handle);
+            auto *count = static_cast<celix_receive_count_service_t *>(svc);
+            *count_ptr = count->receiveCount(count->handle);
+        });
+        if (count >= MSG_COUNT) {
+            break;
+        }
+        usleep(TIMEOUT);
+    }
+    CHECK_EQUAL(MSG_COUNT, count);
+
+    int outOfOrderCount = 0;
+    celix_bundleContext_useService(ctx, CELIX_RECEIVE_COUNT_SERVICE_NAME, &outOfOrderCount, [](void *handle, void *svc) {
+        auto *count_ptr = static_cast<int *>(handle);
+        auto *count = static_cast<celix_receive_count_service_t *>(svc);
+        *count_ptr = (int)count->outOfOrderCount(count->handle);
+    });
+    CHECK_EQUAL(0, outOfOrderCount);
+}
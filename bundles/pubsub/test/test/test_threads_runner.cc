@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_api.h"
+#include <unistd.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <cstring>
+#include <vector>
+
+#include "pubsub_protocol.h"
+#include "pubsub_message_serialization_service.h"
+#include "receive_count_service.h"
+#include "msg.h"
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/CommandLineTestRunner.h>
+
+/**
+ * The test acts as multiple "raw" TCP publishers on the static connect urls of the ping subscriber (see
+ * meta_data/tcp_threads/ping.properties), so that the connections are divided over the receive threads and the
+ * dispatch threads. Every publisher has its own sequence numbers and adds its id to the metadata of the messages,
+ * so that the subscriber can check the order of the messages per publisher.
+ */
+constexpr int NR_OF_PUBLISHERS = 4;
+constexpr int FIRST_PUBLISHER_PORT = 9012;
+
+int main(int argc, char **argv) {
+    MemoryLeakWarningPlugin::turnOffNewDeleteOverloads();
+    int rc = RUN_ALL_TESTS(argc, argv);
+    return rc;
+}
+
+TEST_GROUP(PUBSUB_TCP_THREADS_GROUP) {
+    celix_framework_t *fw = nullptr;
+    celix_bundle_context_t *ctx = nullptr;
+    int listenFds[NR_OF_PUBLISHERS]{};
+    int fds[NR_OF_PUBLISHERS]{};
+
+    void setup() override {
+        for (int i = 0; i < NR_OF_PUBLISHERS; ++i) {
+            fds[i] = -1;
+            listenFds[i] = socket(AF_INET, SOCK_STREAM, 0);
+            int one = 1;
+            setsockopt(listenFds[i], SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            struct sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(FIRST_PUBLISHER_PORT + i);
+            addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+            CHECK_EQUAL(0, bind(listenFds[i], (struct sockaddr *) &addr, sizeof(addr)));
+            CHECK_EQUAL(0, listen(listenFds[i], 1));
+        }
+
+        celixLauncher_launch("config.properties", &fw);
+        ctx = celix_framework_getFrameworkContext(fw);
+    }
+
+    void teardown() override {
+        celixLauncher_stop(fw);
+        celixLauncher_waitForShutdown(fw);
+        celixLauncher_destroy(fw);
+        for (int i = 0; i < NR_OF_PUBLISHERS; ++i) {
+            if (fds[i] >= 0) {
+                close(fds[i]);
+            }
+            close(listenFds[i]);
+        }
+        ctx = nullptr;
+        fw = nullptr;
+    }
+
+    void acceptSubscribers() {
+        for (int i = 0; i < NR_OF_PUBLISHERS; ++i) {
+            struct pollfd pfd{};
+            pfd.fd = listenFds[i];
+            pfd.events = POLLIN;
+            CHECK_EQUAL(1, poll(&pfd, 1, 10000));
+            fds[i] = accept(listenFds[i], nullptr, nullptr);
+            CHECK(fds[i] >= 0);
+            int one = 1;
+            setsockopt(fds[i], IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+    }
+
+    struct encode_data {
+        int publisher;
+        uint32_t seqNr;
+        uint32_t msgId;
+        std::vector<char> payload;
+        std::vector<char> frame;
+    };
+
+    std::vector<char> encodeMessage(int publisher, uint32_t seqNr) {
+        encode_data data{};
+        data.publisher = publisher;
+        data.seqNr = seqNr;
+
+        celix_service_use_options_t serOpts{};
+        serOpts.filter.serviceName = PUBSUB_MESSAGE_SERIALIZATION_SERVICE_NAME;
+        serOpts.filter.filter = "(" PUBSUB_MESSAGE_SERIALIZATION_SERVICE_MSG_FQN_PROPERTY "=" MSG_NAME ")";
+        serOpts.waitTimeoutInSeconds = 10.0;
+        serOpts.callbackHandle = &data;
+        serOpts.useWithProperties = [](void *handle, void *svc, const celix_properties_t *props) {
+            auto *data = static_cast<encode_data *>(handle);
+            auto *serSvc = static_cast<pubsub_message_serialization_service_t *>(svc);
+            data->msgId = (uint32_t) celix_properties_getAsLong(props, PUBSUB_MESSAGE_SERIALIZATION_SERVICE_MSG_ID_PROPERTY, 0);
+            msg_t msg{};
+            msg.seqNr = data->seqNr;
+            struct iovec *serialized = nullptr;
+            size_t serializedLen = 0;
+            if (serSvc->serialize(serSvc->handle, &msg, &serialized, &serializedLen) == CELIX_SUCCESS) {
+                for (size_t i = 0; i < serializedLen; ++i) {
+                    auto *base = static_cast<char *>(serialized[i].iov_base);
+                    data->payload.insert(data->payload.end(), base, base + serialized[i].iov_len);
+                }
+                serSvc->freeSerializedMsg(serSvc->handle, serialized, serializedLen);
+            }
+        };
+        CHECK(celix_bundleContext_useServiceWithOptions(ctx, &serOpts));
+        CHECK(!data.payload.empty());
+
+        celix_service_use_options_t protocolOpts{};
+        protocolOpts.filter.serviceName = PUBSUB_PROTOCOL_SERVICE_NAME;
+        protocolOpts.waitTimeoutInSeconds = 10.0;
+        protocolOpts.callbackHandle = &data;
+        protocolOpts.use = [](void *handle, void *svc) {
+            auto *data = static_cast<encode_data *>(handle);
+            auto *protocol = static_cast<pubsub_protocol_service_t *>(svc);
+            pubsub_protocol_message_t message{};
+            message.header.msgId = data->msgId;
+            message.header.seqNr = data->seqNr;
+            message.header.msgMajorVersion = 1;
+            message.header.msgMinorVersion = 0;
+            message.header.payloadSize = data->payload.size();
+            message.header.payloadPartSize = data->payload.size();
+            message.header.isLastSegment = 1;
+            message.payload.payload = data->payload.data();
+            message.payload.length = data->payload.size();
+
+            message.metadata.metadata = celix_properties_create();
+            celix_properties_setLong(message.metadata.metadata, MSG_PUBLISHER_METADATA_KEY, data->publisher);
+            void *metadataData = nullptr;
+            size_t metadataSize = 0;
+            protocol->encodeMetadata(protocol->handle, &message, &metadataData, &metadataSize);
+            message.header.metadataSize = metadataSize;
+            celix_properties_destroy(message.metadata.metadata);
+
+            void *headerData = nullptr;
+            size_t headerSize = 0;
+            protocol->encodeHeader(protocol->handle, &message, &headerData, &headerSize);
+            data->frame.insert(data->frame.end(), (char *) headerData, (char *) headerData + headerSize);
+            free(headerData);
+            data->frame.insert(data->frame.end(), data->payload.begin(), data->payload.end());
+            data->frame.insert(data->frame.end(), (char *) metadataData, (char *) metadataData + metadataSize);
+            free(metadataData);
+
+            size_t footerSize = 0;
+            protocol->getFooterSize(protocol->handle, &footerSize);
+            if (footerSize > 0) {
+                void *footerData = nullptr;
+                protocol->encodeFooter(protocol->handle, &message, &footerData, &footerSize);
+                data->frame.insert(data->frame.end(), (char *) footerData, (char *) footerData + footerSize);
+                free(footerData);
+            }
+        };
+        CHECK(celix_bundleContext_useServiceWithOptions(ctx, &protocolOpts));
+        return data.frame;
+    }
+};
+
+TEST(PUBSUB_TCP_THREADS_GROUP, recvInOrderPerPublisherTest) {
+    constexpr int MSG_COUNT = 100;
+    constexpr int TRIES = 50;
+    constexpr int TIMEOUT = 100000;
+
+    acceptSubscribers();
+    //give the receiver time to setup the subscriber for the connections
+    usleep(250000);
+
+    //interleave the messages of the publishers, so that the receive and dispatch threads handle them concurrently
+    for (uint32_t seqNr = 1; seqNr <= MSG_COUNT; ++seqNr) {
+        for (int i = 0; i < NR_OF_PUBLISHERS; ++i) {
+            std::vector<char> frame = encodeMessage(i, seqNr);
+            CHECK_EQUAL((ssize_t) frame.size(), write(fds[i], frame.data(), frame.size()));
+        }
+    }
+
+    int count = 0;
+    for (int i = 0; i < TRIES; ++i) {
+        celix_bundleContext_useService(ctx, CELIX_RECEIVE_COUNT_SERVICE_NAME, &count, [](void *handle, void *svc) {
+            auto *count_ptr = static_cast<int *>(handle);
+            auto *count = static_cast<celix_receive_count_service_t *>(svc);
+            *count_ptr = count->receiveCount(count->handle);
+        });
+        if (count >= NR_OF_PUBLISHERS * MSG_COUNT) {
+            break;
+        }
+        usleep(TIMEOUT);
+    }
+    CHECK_EQUAL(NR_OF_PUBLISHERS * MSG_COUNT, count);
+
+    //the messages of a publisher are received over one connection and must be received in order
+    int outOfOrderCount = 0;
+    celix_bundleContext_useService(ctx, CELIX_RECEIVE_COUNT_SERVICE_NAME, &outOfOrderCount, [](void *handle, void *svc) {
+        auto *count_ptr = static_cast<int *>(handle);
+        auto *count = static_cast<celix_receive_count_service_t *>(svc);
+        *count_ptr = (int)count->outOfOrderCount(count->handle);
+    });
+    CHECK_EQUAL(0, outOfOrderCount);
+}
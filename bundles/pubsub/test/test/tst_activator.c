@@ -28,9 +28,18 @@
 #include "msg.h"
 #include "receive_count_service.h"
 
+/**
+ * If true, the first subscriber keeps the received messages (release set to false), which is only valid for messages
+ * which are deserialized in place, i.e. the message is the received payload and is freed with free().
+ * The kept messages are checked for changes when they are freed, a changed message is counted as out of order.
+ */
+#define TST_KEEP_IN_PLACE_MESSAGES "PUBSUB_TEST_KEEP_IN_PLACE_MESSAGES"
+#define TST_NR_OF_KEPT_MESSAGES 16
+
 static int tst_receive(void *handle, const char *msgType, unsigned int msgTypeId, void *msg, const celix_properties_t *metadata, bool *release);
 static int tst_receive2(void *handle, const char *msgType, unsigned int msgTypeId, void *msg, const celix_properties_t *metadata, bool *release);
 static size_t tst_count(void *handle);
+static size_t tst_outOfOrderCount(void *handle);
 
 struct activator {
     pubsub_subscriber_t subSvc1;
@@ -45,10 +54,19 @@ struct activator {
     pthread_mutex_t mutex;
     unsigned int count1;
     unsigned int count2;
+    uint32_t lastSeqNr1[MSG_MAX_PUBLISHERS];
+    uint32_t lastSeqNr2[MSG_MAX_PUBLISHERS];
+    unsigned int outOfOrderCount;
+
+    bool keepMessages;
+    msg_t *keptMessages[TST_NR_OF_KEPT_MESSAGES];
+    uint32_t keptSeqNrs[TST_NR_OF_KEPT_MESSAGES];
+    unsigned int nrOfKeptMessages;
 };
 
 celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
     pthread_mutex_init(&act->mutex, NULL);
+    act->keepMessages = celix_bundleContext_getPropertyAsBool(ctx, TST_KEEP_IN_PLACE_MESSAGES, false);
 
     {
         celix_properties_t *props = celix_properties_create();
@@ -69,6 +87,7 @@ celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
     {
         act->countSvc.handle = act;
         act->countSvc.receiveCount = tst_count;
+        act->countSvc.outOfOrderCount = tst_outOfOrderCount;
         act->countSvcId = celix_bundleContext_registerService(ctx, &act->countSvc, CELIX_RECEIVE_COUNT_SERVICE_NAME, NULL);
     }
 
@@ -79,14 +98,37 @@ celix_status_t bnd_stop(struct activator *act, celix_bundle_context_t *ctx) {
     celix_bundleContext_unregisterService(ctx, act->subSvcId1);
     celix_bundleContext_unregisterService(ctx, act->subSvcId2);
     celix_bundleContext_unregisterService(ctx, act->countSvcId);
+    for (int i = 0; i < TST_NR_OF_KEPT_MESSAGES; ++i) {
+        free(act->keptMessages[i]);
+    }
     pthread_mutex_destroy(&act->mutex);
     return CELIX_SUCCESS;
 }
 
 CELIX_GEN_BUNDLE_ACTIVATOR(struct activator, bnd_start, bnd_stop) ;
 
+//Should be called with the mutex locked
+static void tst_keepMessage(struct activator *act, msg_t *msg) {
+    unsigned int index = act->nrOfKeptMessages++ % TST_NR_OF_KEPT_MESSAGES;
+    msg_t *kept = act->keptMessages[index];
+    if (kept != NULL) {
+        if (kept->seqNr != act->keptSeqNrs[index]) {
+            fprintf(stderr, "Error: kept message changed. seq %i changed to %i\n", act->keptSeqNrs[index], kept->seqNr);
+            act->outOfOrderCount += 1;
+        }
+        free(kept);
+    }
+    act->keptMessages[index] = msg;
+    act->keptSeqNrs[index] = msg->seqNr;
+}
+
+static unsigned int tst_publisher(const celix_properties_t *metadata) {
+    long publisher = metadata != NULL ? celix_properties_getAsLong(metadata, MSG_PUBLISHER_METADATA_KEY, 0) : 0;
+    return publisher >= 0 && publisher < MSG_MAX_PUBLISHERS ? (unsigned int) publisher : 0;
+}
+
 
-static int tst_receive(void *handle, const char * msgType __attribute__((unused)), unsigned int msgTypeId  __attribute__((unused)), void * voidMsg, const celix_properties_t *metadata  __attribute__((unused)), bool *release  __attribute__((unused))) {
+static int tst_receive(void *handle, const char * msgType __attribute__((unused)), unsigned int msgTypeId  __attribute__((unused)), void * voidMsg, const celix_properties_t *metadata, bool *release) {
     struct activator *act = handle;
 
     msg_t *msg = voidMsg;
@@ -97,13 +139,23 @@ static int tst_receive(void *handle, const char * msgType __attribute__((unused)
     }
     prevSeqNr = msg->seqNr;
 
+    unsigned int publisher = tst_publisher(metadata);
     pthread_mutex_lock(&act->mutex);
+    if (msg->seqNr <= act->lastSeqNr1[publisher]) {
+        fprintf(stderr, "Error: message of publisher %u out of order. seq %i received after %i\n", publisher, msg->seqNr, act->lastSeqNr1[publisher]);
+        act->outOfOrderCount += 1;
+    }
+    act->lastSeqNr1[publisher] = msg->seqNr;
     act->count1 += 1;
+    if (act->keepMessages) {
+        tst_keepMessage(act, msg);
+        *release = false;
+    }
     pthread_mutex_unlock(&act->mutex);
     return CELIX_SUCCESS;
 }
 
-static int tst_receive2(void *handle, const char * msgType __attribute__((unused)), unsigned int msgTypeId  __attribute__((unused)), void * voidMsg, const celix_properties_t *metadata  __attribute__((unused)), bool *release  __attribute__((unused))) {
+static int tst_receive2(void *handle, const char * msgType __attribute__((unused)), unsigned int msgTypeId  __attribute__((unused)), void * voidMsg, const celix_properties_t *metadata, bool *release  __attribute__((unused))) {
     struct activator *act = handle;
 
     msg_t *msg = voidMsg;
@@ -114,7 +166,13 @@ static int tst_receive2(void *handle, const char * msgType __attribute__((unused
     }
     prevSeqNr = msg->seqNr;
 
+    unsigned int publisher = tst_publisher(metadata);
     pthread_mutex_lock(&act->mutex);
+    if (msg->seqNr <= act->lastSeqNr2[publisher]) {
+        fprintf(stderr, "Error: message of publisher %u out of order. seq %i received after %i\n", publisher, msg->seqNr, act->lastSeqNr2[publisher]);
+        act->outOfOrderCount += 1;
+    }
+    act->lastSeqNr2[publisher] = msg->seqNr;
     act->count2 += 1;
     pthread_mutex_unlock(&act->mutex);
     return CELIX_SUCCESS;
@@ -131,3 +189,12 @@ static size_t tst_count(void *handle) {
     printf("msg count1 is %lu and msg count 2 is %lu\n", count1, count2);
     return count1 >= count2 ? count1 : count2;
 }
+
+static size_t tst_outOfOrderCount(void *handle) {
+    struct activator *act = handle;
+    size_t count;
+    pthread_mutex_lock(&act->mutex);
+    count = act->outOfOrderCount;
+    pthread_mutex_unlock(&act->mutex);
+    return count;
+}
@@ -401,20 +401,8 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void*)"key2");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "key2", NULL);
             STRCMP_EQUAL("inaetics", value);
-            /*
-            printf("Service: %s ", ep->service);
-            hash_map_iterator_pt iter = hashMapIterator_create(props);
-            while (hashMapIterator_hasNext(iter)) {
-                hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-                printf("%s - %s\n", (char*)hashMapEntry_getKey(entry),
-                                   (char*)hashMapEntry_getValue(entry));
-            }
-            printf("\n");
-            hashMapIterator_destroy(iter);
-            */
         }
         printf("End: %s\n", __func__);
     }
@@ -437,8 +425,7 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void*)"key2");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "key2", NULL);
             STRCMP_EQUAL("inaetics", value);
         }
         printf("End: %s\n", __func__);
@@ -462,8 +449,7 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void *)"key2");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "key2", NULL);
             STRCMP_EQUAL("inaetics", value);
         }
         printf("End: %s\n", __func__);
@@ -159,6 +159,15 @@ celix_status_t bundleActivator_create(celix_bundle_context_t* ctx, void **_pptr)
                       .usage = "quit"
               };
         activator->std_commands[11] =
+                (struct celix_shell_command_register_entry) {
+                        .exec = timelineCommand_execute,
+                        .name = "celix::timeline",
+                        .description = "Print the recorded bundle and component lifecycle timeline (install, extract, resolve, load libraries," \
+                            "\nactivator and component phases) with begin times relative to the framework creation." \
+                            "\nUse -t to print the timeline as Chrome trace event JSON or -t <file> to write it to a file.",
+                        .usage = "timeline [-t [<file>]]"
+                };
+        activator->std_commands[12] =
                 (struct celix_shell_command_register_entry) {
                         .exec = NULL
                 };
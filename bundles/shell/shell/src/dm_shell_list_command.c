@@ -63,14 +63,16 @@ static void printFullInfo(FILE *out, bool colors, long bundleId, dm_component_in
     }
     fprintf(out, "Component: Name=%s\n|- ID=%s, %sActive=%s%s, State=%s, Bundle=%li\n", compInfo->name, compInfo->id,
             startColors, compInfo->active ? "true " : "false", endColors, compInfo->state, bundleId);
+    fprintf(out, "|- Dependency events=%zu, Event batches=%zu, State evaluations=%zu, Coalesced state evaluations=%zu\n",
+            compInfo->nrOfDependencyEvents, compInfo->nrOfEventBatches, compInfo->nrOfStateEvaluations,
+            compInfo->nrOfCoalescedStateEvaluations);
     fprintf(out, "|- Interfaces (%d):\n", arrayList_size(compInfo->interfaces));
     for (unsigned int interfCnt = 0; interfCnt < arrayList_size(compInfo->interfaces); interfCnt++) {
         dm_interface_info_pt intfInfo = arrayList_get(compInfo->interfaces, interfCnt);
         fprintf(out, "   |- Interface: %s\n", intfInfo->name);
 
-        hash_map_iterator_t iter = hashMapIterator_construct((hash_map_pt) intfInfo->properties);
-        char *key = NULL;
-        while ((key = hashMapIterator_nextKey(&iter)) != NULL) {
+        const char *key = NULL;
+        CELIX_PROPERTIES_FOR_EACH(intfInfo->properties, key) {
             fprintf(out, "      | %15s = %s\n", key, properties_get(intfInfo->properties, key));
         }
     }
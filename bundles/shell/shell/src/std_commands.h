@@ -41,6 +41,7 @@ bool updateCommand_execute(void *handle, const char* commandLine, FILE *outStrea
 bool helpCommand_execute(void *handle, const char* commandLine, FILE *outStream, FILE *errStream);
 bool dmListCommand_execute(void* handle, const char* commandLine, FILE *out, FILE *err);
 bool quitCommand_execute(void *handle, const char* commandLine, FILE *sout, FILE *serr);
+bool timelineCommand_execute(void *handle, const char* commandLine, FILE *outStream, FILE *errStream);
 
 
 #endif
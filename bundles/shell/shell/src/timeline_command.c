@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "celix_api.h"
+#include "std_commands.h"
+
+bool timelineCommand_execute(void *handle, const char *const_command, FILE *outStream, FILE *errStream) {
+    celix_bundle_context_t *ctx = handle;
+    celix_framework_t *fw = celix_bundleContext_getFramework(ctx);
+
+    char *save_ptr = NULL;
+    char *command = celix_utils_strdup(const_command);
+
+    strtok_r(command, OSGI_SHELL_COMMAND_SEPARATOR, &save_ptr);
+    char *option = strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &save_ptr);
+    char *file = option != NULL ? strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &save_ptr) : NULL;
+
+    bool succeeded = false;
+    if (option == NULL) {
+        celix_framework_printLifecycleTimeline(fw, outStream);
+        succeeded = true;
+    } else if (strcmp(option, "-t") == 0) {
+        FILE *stream = file == NULL ? outStream : fopen(file, "w");
+        if (stream == NULL) {
+            fprintf(errStream, "Cannot open file '%s' for writing.\n", file);
+        } else {
+            celix_status_t status = celix_framework_writeLifecycleTimelineAsTraceEvents(fw, stream);
+            if (stream != outStream) {
+                fclose(stream);
+            }
+            if (status == CELIX_SUCCESS) {
+                if (file != NULL) {
+                    fprintf(outStream, "Written trace events to '%s'.\n", file);
+                }
+                succeeded = true;
+            } else {
+                fprintf(errStream, "Cannot write trace events: %s.\n", celix_strerror(status));
+            }
+        }
+    } else {
+        fprintf(errStream, "Unknown option '%s'.\n", option);
+    }
+
+    free(command);
+    return succeeded;
+}
@@ -108,6 +108,9 @@ TEST(CelixShellTests, testAllCommandsAreCallable) {
     callCommand(ctx, "start 15", false);
     callCommand(ctx, "uninstall 15", false);
     callCommand(ctx, "update 15", false);
+    callCommand(ctx, "timeline", true);
+    callCommand(ctx, "timeline -t", true);
+    callCommand(ctx, "timeline -x", false);
 }
 
 TEST(CelixShellTests, quitTest) {
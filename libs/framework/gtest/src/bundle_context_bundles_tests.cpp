@@ -25,6 +25,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <vector>
 #include <celix_log_utils.h>
 
 #include "celix_api.h"
@@ -158,6 +159,41 @@ TEST_F(CelixBundleContextBundlesTests, installAndUninstallBundlesTest) {
     ASSERT_FALSE(bndId5 == bndId6); //not new id
 }
 
+TEST_F(CelixBundleContextBundlesTests, bundleLookupByIdAndLocationTest) {
+    long bndId1 = celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, true);
+    ASSERT_GE(bndId1, 0);
+    //installing an already installed location returns the installed bundle
+    EXPECT_EQ(bndId1, celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, true));
+
+    //concurrent lookups by id while bundles are installed and uninstalled
+    std::atomic<bool> stop{false};
+    std::atomic<int> missed{0};
+    std::thread reader{[&] {
+        while (!stop.load()) {
+            bool called = celix_bundleContext_useBundle(ctx, bndId1, nullptr, [](void *, const celix_bundle_t *) {});
+            if (!called || !celix_bundleContext_isBundleInstalled(ctx, bndId1)) {
+                missed += 1;
+            }
+        }
+    }};
+    for (int i = 0; i < 20; ++i) {
+        long bndId2 = celix_bundleContext_installBundle(ctx, TEST_BND2_LOC, true);
+        EXPECT_GE(bndId2, 0);
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId2));
+        EXPECT_TRUE(celix_bundleContext_uninstallBundle(ctx, bndId2));
+        EXPECT_FALSE(celix_bundleContext_isBundleInstalled(ctx, bndId2));
+    }
+    stop = true;
+    reader.join();
+    EXPECT_EQ(0, missed.load());
+
+    EXPECT_TRUE(celix_bundleContext_uninstallBundle(ctx, bndId1));
+    EXPECT_FALSE(celix_bundleContext_isBundleInstalled(ctx, bndId1));
+    long reinstalledId = celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, false);
+    EXPECT_GE(reinstalledId, 0);
+    EXPECT_NE(bndId1, reinstalledId);
+}
+
 TEST_F(CelixBundleContextBundlesTests, startBundleWithException) {
     long bndId = celix_bundleContext_installBundle(ctx, TEST_BND_WITH_EXCEPTION_LOC, true);
     ASSERT_TRUE(bndId > 0); //bundle is installed, but not started
@@ -471,3 +507,138 @@ TEST_F(CelixBundleContextBundlesTests, bundleInfoTests) {
     celix_bundleContext_unregisterService(ctx, svcId);
     celix_bundleContext_stopTracker(ctx, trackerId);
 }
+
+TEST_F(CelixBundleContextBundlesTests, concurrentBundleEventsTest) {
+    //note more events than the number of preallocated event queue nodes are fired concurrently
+    std::atomic<int> startedCount{0};
+    std::atomic<int> stoppedCount{0};
+
+    celix_bundle_tracking_options_t opts{};
+    opts.callbackHandle = static_cast<void*>(&startedCount);
+    opts.onStarted = [](void *handle, const celix_bundle_t *) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    };
+    long trackerId = celix_bundleContext_trackBundlesWithOptions(ctx, &opts);
+
+    celix_bundle_tracking_options_t stopOpts{};
+    stopOpts.callbackHandle = static_cast<void*>(&stoppedCount);
+    stopOpts.onStopped = [](void *handle, const celix_bundle_t *) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    };
+    long stopTrackerId = celix_bundleContext_trackBundlesWithOptions(ctx, &stopOpts);
+
+    const int nrOfIterations = 20;
+    std::vector<std::thread> threads{};
+    for (const char* loc : {TEST_BND1_LOC, TEST_BND2_LOC, TEST_BND3_LOC, TEST_BND4_LOC, TEST_BND5_LOC}) {
+        threads.emplace_back([this, loc] {
+            for (int i = 0; i < nrOfIterations; ++i) {
+                long bndId = celix_bundleContext_installBundle(ctx, loc, true);
+                EXPECT_GE(bndId, 0);
+                celix_bundleContext_uninstallBundle(ctx, bndId);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    celix_framework_waitForEmptyEventQueue(fw);
+    EXPECT_EQ(5 * nrOfIterations, startedCount.load());
+    EXPECT_EQ(5 * nrOfIterations, stoppedCount.load());
+
+    celix_bundleContext_stopTracker(ctx, trackerId);
+    celix_bundleContext_stopTracker(ctx, stopTrackerId);
+}
+
+TEST(CelixBundleContextBundlesWithListenerWorkersTests, slowListenerDoesNotBlockOtherListenersTest) {
+    celix_properties_t *properties = properties_create();
+    properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextListenerWorkersTest");
+    properties_set(properties, CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, "2");
+    celix_framework_t *fw = celix_frameworkFactory_createFramework(properties);
+    ASSERT_TRUE(fw != nullptr);
+    celix_bundle_context_t *ctx = framework_getContext(fw);
+
+    struct slow_data {
+        std::mutex mutex{};
+        std::condition_variable cond{};
+        bool release{false};
+        std::vector<long> startedBundles{};
+    };
+    slow_data slow{};
+    struct fast_data {
+        std::mutex mutex{};
+        std::vector<long> startedBundles{};
+    };
+    fast_data fast{};
+
+    celix_bundle_tracking_options_t slowOpts{};
+    slowOpts.callbackHandle = &slow;
+    slowOpts.onStarted = [](void *handle, const celix_bundle_t *bnd) {
+        auto *d = static_cast<slow_data*>(handle);
+        std::unique_lock<std::mutex> lck{d->mutex};
+        d->cond.wait(lck, [d]{ return d->release; });
+        d->startedBundles.push_back(celix_bundle_getId(bnd));
+    };
+    long slowTrackerId = celix_bundleContext_trackBundlesWithOptions(ctx, &slowOpts);
+
+    celix_bundle_tracking_options_t fastOpts{};
+    fastOpts.callbackHandle = &fast;
+    fastOpts.onStarted = [](void *handle, const celix_bundle_t *bnd) {
+        auto *d = static_cast<fast_data*>(handle);
+        std::lock_guard<std::mutex> lck{d->mutex};
+        d->startedBundles.push_back(celix_bundle_getId(bnd));
+    };
+    long fastTrackerId = celix_bundleContext_trackBundlesWithOptions(ctx, &fastOpts);
+
+    std::vector<long> bndIds{};
+    for (const char* loc : {SIMPLE_TEST_BUNDLE1_LOCATION, SIMPLE_TEST_BUNDLE2_LOCATION, SIMPLE_TEST_BUNDLE3_LOCATION}) {
+        bndIds.push_back(celix_bundleContext_installBundle(ctx, loc, true));
+    }
+
+    //the fast listener gets all events, while the slow listener is blocked
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::seconds{5}) {
+        std::lock_guard<std::mutex> lck{fast.mutex};
+        if (fast.startedBundles.size() == bndIds.size()) {
+            break;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lck{fast.mutex};
+        EXPECT_EQ(bndIds, fast.startedBundles);
+    }
+
+    size_t maxQueueDepth = 0;
+    auto *stats = celix_framework_listBundleListenerStats(fw);
+    EXPECT_GE(celix_arrayList_size(stats), 2);
+    for (int i = 0; i < celix_arrayList_size(stats); ++i) {
+        auto *s = static_cast<celix_framework_bundle_listener_stats_t*>(celix_arrayList_get(stats, i));
+        maxQueueDepth = std::max(maxQueueDepth, s->queueDepth);
+    }
+    celix_framework_destroyBundleListenerStats(stats);
+    EXPECT_GE(maxQueueDepth, 1); //the events queued for the slow listener
+
+    {
+        std::lock_guard<std::mutex> lck{slow.mutex};
+        slow.release = true;
+        slow.cond.notify_all();
+    }
+    celix_framework_waitForEmptyEventQueue(fw);
+    {
+        std::lock_guard<std::mutex> lck{slow.mutex};
+        EXPECT_EQ(bndIds, slow.startedBundles); //per listener ordering is kept
+    }
+
+    stats = celix_framework_listBundleListenerStats(fw);
+    for (int i = 0; i < celix_arrayList_size(stats); ++i) {
+        auto *s = static_cast<celix_framework_bundle_listener_stats_t*>(celix_arrayList_get(stats, i));
+        EXPECT_EQ(0, s->queueDepth);
+        EXPECT_GE(s->maxLatencyInSeconds, s->averageLatencyInSeconds);
+    }
+    celix_framework_destroyBundleListenerStats(stats);
+
+    celix_bundleContext_stopTracker(ctx, slowTrackerId);
+    celix_bundleContext_stopTracker(ctx, fastTrackerId);
+    celix_frameworkFactory_destroyFramework(fw);
+}
@@ -27,11 +27,17 @@
 #include <condition_variable>
 #include <string.h>
 #include <future>
+#include <atomic>
+#include <vector>
+#include <string>
 
 #include "celix_api.h"
 #include "celix_framework_factory.h"
 #include "celix_service_factory.h"
 #include "service_tracker_private.h"
+extern "C" {
+#include "framework_private.h"
+}
 
 class CelixBundleContextServicesTests : public ::testing::Test {
 public:
@@ -711,6 +717,129 @@ TEST_F(CelixBundleContextServicesTests, servicesTrackerSetTest) {
     ASSERT_EQ(3, count); //check if the set is called the expected times
 }
 
+TEST_F(CelixBundleContextServicesTests, useHighestRankingServiceTest) {
+    celix_service_tracking_options_t opts{};
+    opts.filter.serviceName = "NA";
+    celix_service_tracker_t *tracker = celix_serviceTracker_createWithOptions(ctx, &opts);
+    ASSERT_TRUE(tracker != nullptr);
+
+    auto use = [](void *handle, void *svc) {
+        *static_cast<long*>(handle) = (long)svc;
+    };
+    long used = 0;
+
+    auto *props1 = celix_properties_create();
+    celix_properties_setLong(props1, OSGI_FRAMEWORK_SERVICE_RANKING, 5);
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "NA", props1);
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x100, used);
+
+    //higher ranking registered later
+    auto *props2 = celix_properties_create();
+    celix_properties_setLong(props2, OSGI_FRAMEWORK_SERVICE_RANKING, 10);
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x200, "NA", props2);
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x200, used);
+
+    //equal ranking, but higher service id
+    auto *props3 = celix_properties_create();
+    celix_properties_setLong(props3, OSGI_FRAMEWORK_SERVICE_RANKING, 10);
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x300, "NA", props3);
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x200, used);
+
+    //service name sanity check
+    EXPECT_FALSE(celix_serviceTracker_useHighestRankingService(tracker, "Other", 0, &used, use, nullptr, nullptr));
+
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x300, used);
+
+    celix_bundleContext_unregisterService(ctx, svcId3);
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x100, used);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    EXPECT_FALSE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+
+    celix_serviceTracker_destroy(tracker);
+}
+
+TEST_F(CelixBundleContextServicesTests, useHighestRankingServiceAfterSetPropertiesTest) {
+    celix_service_tracking_options_t opts{};
+    opts.filter.serviceName = "NA";
+    opts.filter.ignoreServiceLanguage = true; //note registered with the bundle context api, without service language
+    celix_service_tracker_t *tracker = celix_serviceTracker_createWithOptions(ctx, &opts);
+    ASSERT_TRUE(tracker != nullptr);
+
+    auto use = [](void *handle, void *svc) {
+        *static_cast<long*>(handle) = (long)svc;
+    };
+    long used = 0;
+
+    auto *props1 = celix_properties_create();
+    celix_properties_setLong(props1, OSGI_FRAMEWORK_SERVICE_RANKING, 10);
+    service_registration_t *reg1 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_registerService(ctx, "NA", (void*)0x100, props1, &reg1));
+    auto *props2 = celix_properties_create();
+    celix_properties_setLong(props2, OSGI_FRAMEWORK_SERVICE_RANKING, 5);
+    service_registration_t *reg2 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_registerService(ctx, "NA", (void*)0x200, props2, &reg2));
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x100, used);
+
+    //raise the ranking of the second service above the first one, the tracker should use the new properties
+    auto *newProps = celix_properties_create();
+    celix_properties_setLong(newProps, OSGI_FRAMEWORK_SERVICE_RANKING, 20);
+    celix_properties_t *oldProps = nullptr;
+    serviceRegistration_getProperties(reg2, &oldProps);
+    ASSERT_EQ(CELIX_SUCCESS, serviceRegistration_setProperties(reg2, newProps));
+    //note the replaced properties are not destroyed by the registration and still have the old ranking.
+    //The registry does not publish modified events, so the event is delivered to the tracker listener directly.
+    array_list_t *refs = nullptr;
+    std::string filter = std::string{"("} + OSGI_FRAMEWORK_SERVICE_ID + "=" + std::to_string(serviceRegistration_getServiceId(reg2)) + ")";
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReferences(ctx, "NA", filter.c_str(), &refs));
+    ASSERT_EQ(1, celix_arrayList_size(refs));
+    celix_service_event_t event{};
+    event.type = OSGI_FRAMEWORK_SERVICE_EVENT_MODIFIED;
+    event.reference = static_cast<service_reference_pt>(celix_arrayList_get(refs, 0));
+    tracker->instance->listener.serviceChanged(tracker->instance->listener.handle, &event);
+    bundleContext_ungetServiceReference(ctx, event.reference);
+    arrayList_destroy(refs);
+    EXPECT_TRUE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0, &used, use, nullptr, nullptr));
+    EXPECT_EQ(0x200, used);
+
+    serviceRegistration_unregister(reg1);
+    serviceRegistration_unregister(reg2);
+    celix_properties_destroy(oldProps);
+    celix_serviceTracker_destroy(tracker);
+}
+
+TEST_F(CelixBundleContextServicesTests, useHighestRankingServiceWaitsForServiceTest) {
+    celix_service_tracking_options_t opts{};
+    opts.filter.serviceName = "NA";
+    celix_service_tracker_t *tracker = celix_serviceTracker_createWithOptions(ctx, &opts);
+    ASSERT_TRUE(tracker != nullptr);
+
+    //timeout without service
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(celix_serviceTracker_useHighestRankingService(tracker, "NA", 0.1, nullptr, nullptr, nullptr, nullptr));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{100});
+
+    //waiting call is woken up when the service is registered
+    std::future<bool> result{std::async(std::launch::async, [&] {
+        return celix_serviceTracker_useHighestRankingService(tracker, "NA", 10.0, nullptr, [](void *, void *) {}, nullptr, nullptr);
+    })};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    start = std::chrono::steady_clock::now();
+    long svcId = celix_bundleContext_registerService(ctx, (void*)0x100, "NA", nullptr);
+    EXPECT_TRUE(result.get());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+
+    celix_bundleContext_unregisterService(ctx, svcId);
+    celix_serviceTracker_destroy(tracker);
+}
+
 //TODO test tracker with options for properties & service owners
 
 
@@ -782,6 +911,354 @@ TEST_F(CelixBundleContextServicesTests, findServicesTest) {
     celix_bundleContext_unregisterService(ctx, svcId2);
 }
 
+TEST_F(CelixBundleContextServicesTests, useServiceWithCachedTrackerTest) {
+    auto *config = properties_create();
+    properties_set(config, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(config, "org.osgi.framework.storage", ".cacheBundleContextTestFramework2");
+    properties_set(config, CELIX_USE_SERVICE_TRACKER_CACHE, "true");
+    auto *cacheFw = celix_frameworkFactory_createFramework(config);
+    auto *cacheCtx = framework_getContext(cacheFw);
+
+    struct calc {
+        int (*calc)(int);
+    };
+    auto name = "CALC";
+
+    int count = 0;
+    celix_service_factory_t fac;
+    memset(&fac, 0, sizeof(fac));
+    fac.handle = (void*)&count;
+    fac.getService = [](void *handle, const celix_bundle_t *, const celix_properties_t *) -> void* {
+        auto *c = (int *)handle;
+        *c += 1;
+        static struct calc svc;
+        svc.calc = [](int arg) { return arg * 42; };
+        return &svc;
+    };
+    fac.ungetService = [](void *handle, const celix_bundle_t *, const celix_properties_t *) {
+        auto *c = (int *)handle;
+        *c += 1;
+    };
+    long facId = celix_bundleContext_registerServiceFactory(cacheCtx, &fac, name, nullptr);
+    ASSERT_TRUE(facId >= 0);
+
+    for (int i = 0; i < 10; ++i) {
+        int result = -1;
+        bool called = celix_bundleContext_useService(cacheCtx, name, &result, [](void *handle, void* svc) {
+            auto *r = (int *)(handle);
+            auto *calc = (struct calc*)svc;
+            *r = calc->calc(2);
+        });
+        ASSERT_TRUE(called);
+        ASSERT_EQ(84, result);
+        ASSERT_EQ(facId, celix_bundleContext_findService(cacheCtx, name));
+    }
+    ASSERT_EQ(1, count); //expecting only a single getService call, because the tracker is reused
+
+    long svcId = celix_bundleContext_registerService(cacheCtx, (void*)0x42, name, nullptr);
+    celix_array_list_t *ids = celix_bundleContext_findServices(cacheCtx, name);
+    ASSERT_EQ(2, celix_arrayList_size(ids));
+    celix_arrayList_destroy(ids);
+
+    celix_bundleContext_unregisterService(cacheCtx, facId);
+    ASSERT_EQ(2, count); //unregister removes the service from the cached tracker
+    ASSERT_EQ(svcId, celix_bundleContext_findService(cacheCtx, name));
+    celix_bundleContext_unregisterService(cacheCtx, svcId);
+    ASSERT_EQ(-1L, celix_bundleContext_findService(cacheCtx, name));
+
+    celix_frameworkFactory_destroyFramework(cacheFw);
+}
+
+TEST_F(CelixBundleContextServicesTests, getServiceReferencesUsesNameIndexTest) {
+    auto *props1 = celix_properties_create();
+    celix_properties_setLong(props1, OSGI_FRAMEWORK_SERVICE_RANKING, 1);
+    celix_properties_set(props1, "key", "a");
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props1);
+
+    auto *props2 = celix_properties_create();
+    celix_properties_setLong(props2, OSGI_FRAMEWORK_SERVICE_RANKING, 10);
+    celix_properties_set(props2, "key", "b");
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props2);
+
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", nullptr);
+    long svcId4 = celix_bundleContext_registerService(ctx, (void*)0x100, "other", nullptr);
+
+    //references for a service name are ordered on ranking
+    array_list_t *refs = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReferences(ctx, "example", nullptr, &refs));
+    ASSERT_EQ(3, celix_arrayList_size(refs));
+    long expected[] = {svcId2, svcId1, svcId3};
+    for (int i = 0; i < 3; ++i) {
+        auto *ref = static_cast<service_reference_pt>(celix_arrayList_get(refs, i));
+        const char *id = nullptr;
+        serviceReference_getProperty(ref, OSGI_FRAMEWORK_SERVICE_ID, &id);
+        EXPECT_EQ(expected[i], atol(id));
+        bundleContext_ungetServiceReference(ctx, ref);
+    }
+    arrayList_destroy(refs);
+
+    //objectClass in the filter is used as index
+    refs = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReferences(ctx, nullptr, "(&(objectClass=example)(key=b))", &refs));
+    ASSERT_EQ(1, celix_arrayList_size(refs));
+    bundleContext_ungetServiceReference(ctx, static_cast<service_reference_pt>(celix_arrayList_get(refs, 0)));
+    arrayList_destroy(refs);
+
+    //objectClass in an OR filter cannot be used as index
+    refs = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReferences(ctx, nullptr, "(|(objectClass=example)(objectClass=other))", &refs));
+    ASSERT_EQ(4, celix_arrayList_size(refs));
+    for (int i = 0; i < 4; ++i) {
+        bundleContext_ungetServiceReference(ctx, static_cast<service_reference_pt>(celix_arrayList_get(refs, i)));
+    }
+    arrayList_destroy(refs);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId3);
+
+    refs = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReferences(ctx, "example", nullptr, &refs));
+    ASSERT_EQ(0, celix_arrayList_size(refs));
+    arrayList_destroy(refs);
+
+    celix_bundleContext_unregisterService(ctx, svcId4);
+}
+
+TEST_F(CelixBundleContextServicesTests, nameIndexSortedAfterSetPropertiesTest) {
+    auto *props1 = celix_properties_create();
+    celix_properties_setLong(props1, OSGI_FRAMEWORK_SERVICE_RANKING, 10);
+    service_registration_t *reg1 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_registerService(ctx, "example", (void*)0x100, props1, &reg1));
+
+    auto *props2 = celix_properties_create();
+    celix_properties_setLong(props2, OSGI_FRAMEWORK_SERVICE_RANKING, 5);
+    service_registration_t *reg2 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_registerService(ctx, "example", (void*)0x200, props2, &reg2));
+
+    auto checkOrder = [this](long firstSvcId, long secondSvcId) {
+        array_list_t *refs = nullptr;
+        ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReferences(ctx, "example", nullptr, &refs));
+        ASSERT_EQ(2, celix_arrayList_size(refs));
+        long expected[] = {firstSvcId, secondSvcId};
+        for (int i = 0; i < 2; ++i) {
+            auto *ref = static_cast<service_reference_pt>(celix_arrayList_get(refs, i));
+            const char *id = nullptr;
+            serviceReference_getProperty(ref, OSGI_FRAMEWORK_SERVICE_ID, &id);
+            EXPECT_EQ(expected[i], atol(id));
+            bundleContext_ungetServiceReference(ctx, ref);
+        }
+        arrayList_destroy(refs);
+    };
+    long svcId1 = serviceRegistration_getServiceId(reg1);
+    long svcId2 = serviceRegistration_getServiceId(reg2);
+    checkOrder(svcId1, svcId2);
+
+    //raise the ranking of the second service above the first one
+    auto *newProps = celix_properties_create();
+    celix_properties_setLong(newProps, OSGI_FRAMEWORK_SERVICE_RANKING, 20);
+    celix_properties_t *oldProps = nullptr;
+    serviceRegistration_getProperties(reg2, &oldProps);
+    ASSERT_EQ(CELIX_SUCCESS, serviceRegistration_setProperties(reg2, newProps));
+    //note the replaced properties are not destroyed by the registration
+    celix_properties_destroy(oldProps);
+    checkOrder(svcId2, svcId1);
+
+    serviceRegistration_unregister(reg1);
+    serviceRegistration_unregister(reg2);
+}
+
+TEST_F(CelixBundleContextServicesTests, serviceListenersOnlyReceiveMatchingObjectClassTest) {
+    struct counters {
+        std::atomic<int> example{0};
+        std::atomic<int> other{0};
+        std::atomic<int> any{0};
+    } count;
+
+    celix_service_listener_t exampleListener{};
+    exampleListener.handle = &count.example;
+    exampleListener.serviceChanged = [](void *handle, celix_service_event_t *event) -> celix_status_t {
+        if (event->type == OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED) {
+            *static_cast<std::atomic<int>*>(handle) += 1;
+        }
+        return CELIX_SUCCESS;
+    };
+    celix_service_listener_t otherListener = exampleListener;
+    otherListener.handle = &count.other;
+    celix_service_listener_t anyListener = exampleListener;
+    anyListener.handle = &count.any;
+
+    celix_bundle_t *bnd = celix_bundleContext_getBundle(ctx);
+    fw_addServiceListener(fw, bnd, &exampleListener, "(&(objectClass=example)(key=value))");
+    fw_addServiceListener(fw, bnd, &otherListener, "(objectClass=other)");
+    fw_addServiceListener(fw, bnd, &anyListener, "(|(objectClass=example)(objectClass=other))");
+
+    auto *props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props);
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", nullptr);
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x100, "other", nullptr);
+    long svcId4 = celix_bundleContext_registerService(ctx, (void*)0x100, "unrelated", nullptr);
+
+    EXPECT_EQ(1, count.example.load());
+    EXPECT_EQ(1, count.other.load());
+    EXPECT_EQ(3, count.any.load());
+
+    fw_removeServiceListener(fw, bnd, &exampleListener);
+    fw_removeServiceListener(fw, bnd, &otherListener);
+    fw_removeServiceListener(fw, bnd, &anyListener);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId3);
+    celix_bundleContext_unregisterService(ctx, svcId4);
+}
+
+TEST_F(CelixBundleContextServicesTests, lookupsDuringRegisterAndUnregisterTest) {
+    long stableSvcId = celix_bundleContext_registerService(ctx, (void*)0x100, "stable", nullptr);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> lookups{0};
+    std::atomic<int> missed{0};
+    auto lookup = [&] {
+        while (!stop.load()) {
+            array_list_t *refs = nullptr;
+            if (bundleContext_getServiceReferences(ctx, "stable", nullptr, &refs) != CELIX_SUCCESS || celix_arrayList_size(refs) != 1) {
+                missed += 1;
+            }
+            for (int i = 0; refs != nullptr && i < celix_arrayList_size(refs); ++i) {
+                bundleContext_ungetServiceReference(ctx, static_cast<service_reference_pt>(celix_arrayList_get(refs, i)));
+            }
+            if (refs != nullptr) {
+                arrayList_destroy(refs);
+            }
+
+            refs = nullptr;
+            bundleContext_getServiceReferences(ctx, "volatile", nullptr, &refs);
+            for (int i = 0; refs != nullptr && i < celix_arrayList_size(refs); ++i) {
+                bundleContext_ungetServiceReference(ctx, static_cast<service_reference_pt>(celix_arrayList_get(refs, i)));
+            }
+            if (refs != nullptr) {
+                arrayList_destroy(refs);
+            }
+            lookups += 1;
+        }
+    };
+    std::thread reader1{lookup};
+    std::thread reader2{lookup};
+    while (lookups.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    //register and unregister services and service listeners while the readers are using the registry
+    celix_service_listener_t listener{};
+    listener.serviceChanged = [](void *, celix_service_event_t *) -> celix_status_t { return CELIX_SUCCESS; };
+    celix_bundle_t *bnd = celix_bundleContext_getBundle(ctx);
+    for (int i = 0; i < 200; ++i) {
+        fw_addServiceListener(fw, bnd, &listener, "(objectClass=volatile)");
+        long svcId = celix_bundleContext_registerService(ctx, (void*)0x200, "volatile", nullptr);
+        celix_bundleContext_unregisterService(ctx, svcId);
+        fw_removeServiceListener(fw, bnd, &listener);
+    }
+
+    stop = true;
+    reader1.join();
+    reader2.join();
+    EXPECT_GT(lookups.load(), 0);
+    EXPECT_EQ(0, missed.load());
+
+    celix_bundleContext_unregisterService(ctx, stableSvcId);
+}
+
+TEST_F(CelixBundleContextServicesTests, registerServicesAsyncEventsDeliveredOnceTest) {
+    struct counters {
+        std::atomic<int> registered{0};
+        std::atomic<int> unregistering{0};
+    };
+    auto serviceChanged = [](void *handle, celix_service_event_t *event) -> celix_status_t {
+        auto *count = static_cast<counters*>(handle);
+        if (event->type == OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED) {
+            count->registered += 1;
+        } else if (event->type == OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING) {
+            count->unregistering += 1;
+        }
+        return CELIX_SUCCESS;
+    };
+    counters countKeep{};
+    counters countRemove{};
+    counters countLateKeep{};
+    counters countLateRemove{};
+    celix_service_listener_t keepListener{&countKeep, serviceChanged};
+    celix_service_listener_t removeListener{&countRemove, serviceChanged};
+    celix_service_listener_t lateKeepListener{&countLateKeep, serviceChanged};
+    celix_service_listener_t lateRemoveListener{&countLateRemove, serviceChanged};
+
+    //block the event thread, so that the REGISTERED events of the batch are not delivered yet
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto block = [](void *handle, void *) {
+        static_cast<std::shared_future<void>*>(handle)->wait();
+    };
+    long trackerId = celix_bundleContext_trackServices(ctx, "blocker", &released, block, nullptr);
+    celix_service_registration_options_t blockerOpts{};
+    blockerOpts.svc = (void*)0x42;
+    blockerOpts.serviceName = "blocker";
+    long blockerSvcId = -1;
+    celix_bundleContext_registerServicesWithOptionsAsync(ctx, &blockerOpts, 1, &blockerSvcId);
+
+    celix_bundle_t *bnd = celix_bundleContext_getBundle(ctx);
+    fw_addServiceListener(fw, bnd, &keepListener, "(&(objectClass=pending)(name=keep))");
+    fw_addServiceListener(fw, bnd, &removeListener, "(&(objectClass=pending)(name=remove))");
+
+    std::vector<celix_service_registration_options_t> opts{2};
+    opts[0].svc = (void*)0x42;
+    opts[0].serviceName = "pending";
+    opts[0].properties = celix_properties_create();
+    celix_properties_set(opts[0].properties, "name", "keep");
+    opts[1].svc = (void*)0x42;
+    opts[1].serviceName = "pending";
+    opts[1].properties = celix_properties_create();
+    celix_properties_set(opts[1].properties, "name", "remove");
+    std::vector<long> svcIds(2, -1);
+    EXPECT_EQ(2, celix_bundleContext_registerServicesWithOptionsAsync(ctx, opts.data(), opts.size(), svcIds.data()));
+
+    //listeners added before the events are delivered directly get the REGISTERED event, but only once
+    fw_addServiceListener(fw, bnd, &lateKeepListener, "(&(objectClass=pending)(name=keep))");
+    fw_addServiceListener(fw, bnd, &lateRemoveListener, "(&(objectClass=pending)(name=remove))");
+    EXPECT_EQ(0, countKeep.registered.load());
+    EXPECT_EQ(1, countLateKeep.registered.load());
+    EXPECT_EQ(1, countLateRemove.registered.load());
+    //the services are directly available
+    EXPECT_EQ(svcIds[0], celix_bundleContext_findService(ctx, "pending"));
+
+    //service unregistered before the events are delivered, only listeners which got the REGISTERED event should get
+    //an UNREGISTERING event
+    celix_bundleContext_unregisterService(ctx, svcIds[1]);
+    EXPECT_EQ(0, countRemove.unregistering.load());
+    EXPECT_EQ(1, countLateRemove.unregistering.load());
+
+    release.set_value();
+    celix_framework_waitForEmptyEventQueue(fw);
+    EXPECT_EQ(1, countKeep.registered.load());
+    EXPECT_EQ(1, countLateKeep.registered.load());
+    EXPECT_EQ(0, countRemove.registered.load());
+    EXPECT_EQ(0, countRemove.unregistering.load());
+    EXPECT_EQ(1, countLateRemove.registered.load());
+    EXPECT_EQ(1, countLateRemove.unregistering.load());
+
+    celix_bundleContext_unregisterService(ctx, svcIds[0]);
+    EXPECT_EQ(1, countKeep.unregistering.load());
+    EXPECT_EQ(1, countLateKeep.unregistering.load());
+
+    fw_removeServiceListener(fw, bnd, &keepListener);
+    fw_removeServiceListener(fw, bnd, &removeListener);
+    fw_removeServiceListener(fw, bnd, &lateKeepListener);
+    fw_removeServiceListener(fw, bnd, &lateRemoveListener);
+    celix_bundleContext_unregisterService(ctx, blockerSvcId);
+    celix_bundleContext_stopTracker(ctx, trackerId);
+}
+
 TEST_F(CelixBundleContextServicesTests, trackServiceTrackerTest) {
 
     int count = 0;
@@ -825,3 +1302,78 @@ TEST_F(CelixBundleContextServicesTests, trackServiceTrackerTest) {
     celix_bundleContext_stopTracker(ctx, trackerId);
     celix_bundleContext_stopTracker(ctx, tracker4);
 }
+
+TEST_F(CelixBundleContextServicesTests, registerServicesInBatchTest) {
+    std::atomic<int> count{0};
+    auto add = [](void *handle, void *) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    };
+    auto remove = [](void *handle, void *) {
+        static_cast<std::atomic<int>*>(handle)->fetch_sub(1);
+    };
+    long trackerId = celix_bundleContext_trackServices(ctx, "batch", &count, add, remove);
+
+    const size_t nrOfServices = 100;
+    std::vector<celix_service_registration_options_t> opts{nrOfServices};
+    for (auto& opt : opts) {
+        opt.svc = (void*)0x42;
+        opt.serviceName = "batch";
+    }
+    opts[50].serviceName = nullptr; //invalid registration in the batch
+    std::vector<long> svcIds(nrOfServices, 0);
+
+    size_t nrOfRegistered = celix_bundleContext_registerServicesWithOptions(ctx, opts.data(), opts.size(), svcIds.data());
+    EXPECT_EQ(nrOfServices - 1, nrOfRegistered);
+    EXPECT_EQ(-1, svcIds[50]);
+    EXPECT_EQ((int)nrOfServices - 1, count.load()); //events delivered before returning
+
+    for (long svcId : svcIds) {
+        celix_bundleContext_unregisterService(ctx, svcId);
+    }
+    EXPECT_EQ(0, count.load());
+
+    celix_bundleContext_stopTracker(ctx, trackerId);
+}
+
+TEST_F(CelixBundleContextServicesTests, registerServicesAsyncTest) {
+    std::atomic<int> count{0};
+    auto add = [](void *handle, void *) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    };
+    auto remove = [](void *handle, void *) {
+        static_cast<std::atomic<int>*>(handle)->fetch_sub(1);
+    };
+    long trackerId = celix_bundleContext_trackServices(ctx, "async", &count, add, remove);
+
+    const size_t nrOfServices = 100;
+    std::vector<celix_service_registration_options_t> opts{nrOfServices};
+    for (auto& opt : opts) {
+        opt.svc = (void*)0x42;
+        opt.serviceName = "async";
+    }
+    std::vector<long> svcIds(nrOfServices, -1);
+
+    size_t nrOfRegistered = celix_bundleContext_registerServicesWithOptionsAsync(ctx, opts.data(), opts.size(), svcIds.data());
+    EXPECT_EQ(nrOfServices, nrOfRegistered);
+    //services are directly available, events are delivered on the event thread
+    EXPECT_EQ(svcIds[0], celix_bundleContext_findService(ctx, "async"));
+    celix_framework_waitForEmptyEventQueue(fw);
+    EXPECT_EQ((int)nrOfServices, count.load());
+
+    for (long svcId : svcIds) {
+        celix_bundleContext_unregisterService(ctx, svcId);
+    }
+    EXPECT_EQ(0, count.load());
+
+    //services unregistered before their events are delivered do not trigger REGISTERED events later
+    nrOfRegistered = celix_bundleContext_registerServicesWithOptionsAsync(ctx, opts.data(), opts.size(), svcIds.data());
+    EXPECT_EQ(nrOfServices, nrOfRegistered);
+    for (long svcId : svcIds) {
+        celix_bundleContext_unregisterService(ctx, svcId);
+    }
+    celix_framework_waitForEmptyEventQueue(fw);
+    EXPECT_EQ(0, count.load());
+    EXPECT_EQ(-1, celix_bundleContext_findService(ctx, "async"));
+
+    celix_bundleContext_stopTracker(ctx, trackerId);
+}
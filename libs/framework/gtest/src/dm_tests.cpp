@@ -19,6 +19,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <string>
+#include <unistd.h>
+
 #include "celix_api.h"
 
 class DepenencyManagerTests : public ::testing::Test {
@@ -75,3 +79,233 @@ TEST_F(DepenencyManagerTests, TestCheckActive) {
     celix_dependencyManager_add(mng, cmp);
     ASSERT_FALSE(celix_dependencyManager_areComponentsActive(mng));
 }
+
+TEST_F(DepenencyManagerTests, CoalesceDependencyEvents) {
+    const int nrOfServices = 50;
+    void *svc = (void*)0x42;
+    long svcIds[nrOfServices];
+    for (int i = 0; i < nrOfServices; ++i) {
+        svcIds[i] = celix_bundleContext_registerService(ctx, svc, "svcname", nullptr);
+    }
+
+    auto *mng = celix_bundleContext_getDependencyManager(ctx);
+    auto *cmp = celix_dmComponent_create(ctx, "test1");
+    auto *dep = celix_dmServiceDependency_create();
+    celix_dmServiceDependency_setService(dep, "svcname", nullptr, nullptr);
+    celix_dmServiceDependency_setRequired(dep, true);
+    int addCount = 0;
+    celix_dm_service_dependency_callback_options_t opts{};
+    opts.add = [](void *handle, void *) -> int {
+        auto *count = static_cast<int*>(handle);
+        *count += 1;
+        return 0;
+    };
+    celix_dmServiceDependency_setCallbacksWithOptions(dep, &opts);
+    celix_dmServiceDependency_setCallbackHandle(dep, &addCount);
+    celix_dmComponent_addServiceDependency(cmp, dep);
+
+    //note the tracked services are added while the component is starting, so they are handled as one batch
+    celix_dependencyManager_add(mng, cmp);
+    EXPECT_TRUE(celix_dependencyManager_areComponentsActive(mng));
+    EXPECT_EQ(nrOfServices, addCount);
+
+    dm_component_info_pt info = nullptr;
+    celix_dmComponent_getComponentInfo(cmp, &info);
+    ASSERT_NE(nullptr, info);
+    EXPECT_EQ(nrOfServices, info->nrOfDependencyEvents);
+    EXPECT_EQ(1, info->nrOfEventBatches);
+    EXPECT_EQ(nrOfServices - 1, info->nrOfCoalescedStateEvaluations);
+    EXPECT_LT(info->nrOfStateEvaluations, 10);
+    celix_dmComponent_destroyComponentInfo(info);
+
+    for (int i = 0; i < nrOfServices; ++i) {
+        celix_bundleContext_unregisterService(ctx, svcIds[i]);
+    }
+    EXPECT_FALSE(celix_dependencyManager_areComponentsActive(mng));
+}
+
+class DepenencyManagerWithExecutorPoolTests : public ::testing::Test {
+public:
+    celix_framework_t* fw = nullptr;
+    celix_bundle_context_t *ctx = nullptr;
+    celix_properties_t *properties = nullptr;
+
+    DepenencyManagerWithExecutorPoolTests() {
+        properties = properties_create();
+        properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+        properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+        properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+        properties_set(properties, CELIX_DM_COMPONENT_EXECUTOR_THREADS, "2");
+
+        fw = celix_frameworkFactory_createFramework(properties);
+        ctx = framework_getContext(fw);
+    }
+
+    ~DepenencyManagerWithExecutorPoolTests() override {
+        celix_frameworkFactory_destroyFramework(fw);
+    }
+
+    DepenencyManagerWithExecutorPoolTests(DepenencyManagerWithExecutorPoolTests&&) = delete;
+    DepenencyManagerWithExecutorPoolTests(const DepenencyManagerWithExecutorPoolTests&) = delete;
+    DepenencyManagerWithExecutorPoolTests& operator=(DepenencyManagerWithExecutorPoolTests&&) = delete;
+    DepenencyManagerWithExecutorPoolTests& operator=(const DepenencyManagerWithExecutorPoolTests&) = delete;
+};
+
+TEST_F(DepenencyManagerWithExecutorPoolTests, ComponentsBecomeActiveOnSharedPool) {
+    auto *mng = celix_bundleContext_getDependencyManager(ctx);
+    const int nrOfComponents = 10;
+    const int nrOfDependencies = 20; //more queued tasks than the initial executor queue capacity
+
+    for (int i = 0; i < nrOfComponents; ++i) {
+        auto *cmp = celix_dmComponent_create(ctx, "test");
+        for (int j = 0; j < nrOfDependencies; ++j) {
+            auto *dep = celix_dmServiceDependency_create();
+            std::string svcName = std::string{"svc"} + std::to_string(j);
+            celix_dmServiceDependency_setService(dep, svcName.c_str(), nullptr, nullptr);
+            celix_dmServiceDependency_setRequired(dep, true);
+            celix_dmComponent_addServiceDependency(cmp, dep);
+        }
+        celix_dependencyManager_add(mng, cmp);
+    }
+    celix_dependencyManager_wait(mng);
+    EXPECT_EQ(nrOfComponents, celix_dependencyManager_nrOfComponents(mng));
+    EXPECT_FALSE(celix_dependencyManager_areComponentsActive(mng));
+
+    void *svc = (void*)0x42;
+    long svcIds[nrOfDependencies];
+    for (int j = 0; j < nrOfDependencies; ++j) {
+        std::string svcName = std::string{"svc"} + std::to_string(j);
+        svcIds[j] = celix_bundleContext_registerService(ctx, svc, svcName.c_str(), nullptr);
+    }
+    celix_dependencyManager_wait(mng);
+    EXPECT_TRUE(celix_dependencyManager_areComponentsActive(mng));
+
+    celix_bundleContext_unregisterService(ctx, svcIds[0]);
+    celix_dependencyManager_wait(mng);
+    EXPECT_FALSE(celix_dependencyManager_areComponentsActive(mng));
+
+    celix_dependencyManager_removeAllComponents(mng); //note also waits for the queued stop tasks
+    EXPECT_EQ(0, celix_dependencyManager_nrOfComponents(mng));
+    for (int j = 1; j < nrOfDependencies; ++j) {
+        celix_bundleContext_unregisterService(ctx, svcIds[j]);
+    }
+}
+
+TEST_F(DepenencyManagerWithExecutorPoolTests, RequiredServiceRemovedBeforeUnregisterReturns) {
+    struct test_svc {
+        int magic;
+    };
+    struct test_cmp {
+        std::atomic<int> stopCount{0};
+        std::atomic<int> removeCount{0};
+        std::atomic<int> seenMagic{0};
+    };
+    test_cmp impl{};
+
+    auto *mng = celix_bundleContext_getDependencyManager(ctx);
+    auto *cmp = celix_dmComponent_create(ctx, "test");
+    celix_dmComponent_setImplementation(cmp, &impl);
+    celix_dmComponent_setCallbacks(cmp, nullptr, nullptr, [](void *handle) -> int {
+        usleep(50000); //note slow stop, so that an asynchronous remove event is noticed
+        static_cast<test_cmp*>(handle)->stopCount++;
+        return 0;
+    }, nullptr);
+    auto *dep = celix_dmServiceDependency_create();
+    celix_dmServiceDependency_setService(dep, "test_svc", nullptr, nullptr);
+    celix_dmServiceDependency_setRequired(dep, true);
+    celix_dm_service_dependency_callback_options_t opts{};
+    opts.remove = [](void *handle, void *svc) -> int {
+        auto *c = static_cast<test_cmp*>(handle);
+        c->seenMagic = static_cast<test_svc*>(svc)->magic;
+        c->removeCount++;
+        return 0;
+    };
+    celix_dmServiceDependency_setCallbacksWithOptions(dep, &opts);
+    celix_dmComponent_addServiceDependency(cmp, dep);
+    celix_dependencyManager_add(mng, cmp);
+
+    auto *svc = new test_svc{42};
+    long svcId = celix_bundleContext_registerService(ctx, svc, "test_svc", nullptr);
+    celix_dependencyManager_wait(mng);
+    EXPECT_TRUE(celix_dependencyManager_areComponentsActive(mng));
+
+    //note no dm wait, the component should be stopped before the unregister call returns
+    celix_bundleContext_unregisterService(ctx, svcId);
+    int stopCount = impl.stopCount;
+    int removeCount = impl.removeCount;
+    svc->magic = 0;
+    delete svc;
+    EXPECT_EQ(1, stopCount);
+    EXPECT_EQ(1, removeCount);
+    EXPECT_EQ(42, impl.seenMagic);
+    EXPECT_FALSE(celix_dependencyManager_areComponentsActive(mng));
+
+    celix_dependencyManager_removeAllComponents(mng);
+}
+
+TEST_F(DepenencyManagerWithExecutorPoolTests, RequiredServicesRemovedFromConcurrentPoolWorkers) {
+    //note two components, starting concurrently on the two pool workers, unregister the required service of each
+    //other. The removed events should not wait for the executor of the other component, because it is waiting too.
+    struct test_cmp {
+        celix_bundle_context_t *ctx{nullptr};
+        std::atomic<int> *nrOfStarting{nullptr};
+        long otherSvcId{-1};
+        std::atomic<int> stopCount{0};
+    };
+    std::atomic<int> nrOfStarting{0};
+    test_cmp impls[2];
+
+    auto *mng = celix_bundleContext_getDependencyManager(ctx);
+    void *svc = (void*)0x42;
+    long svcIds[2];
+    for (long &svcId : svcIds) {
+        svcId = celix_bundleContext_registerService(ctx, svc, "required_svc", nullptr);
+    }
+    for (int i = 0; i < 2; ++i) {
+        impls[i].ctx = ctx;
+        impls[i].nrOfStarting = &nrOfStarting;
+        impls[i].otherSvcId = svcIds[1 - i];
+        auto *cmp = celix_dmComponent_create(ctx, "test");
+        celix_dmComponent_setImplementation(cmp, &impls[i]);
+        celix_dmComponent_setCallbacks(cmp, nullptr, [](void *handle) -> int {
+            auto *c = static_cast<test_cmp*>(handle);
+            (*c->nrOfStarting)++;
+            for (int j = 0; j < 100 && *c->nrOfStarting < 2; ++j) {
+                usleep(10000); //note wait till the other component is starting on the other worker
+            }
+            celix_bundleContext_unregisterService(c->ctx, c->otherSvcId);
+            return 0;
+        }, [](void *handle) -> int {
+            static_cast<test_cmp*>(handle)->stopCount++;
+            return 0;
+        }, nullptr);
+
+        auto *dep = celix_dmServiceDependency_create();
+        std::string filter = std::string{"(service.id="} + std::to_string(svcIds[i]) + ")";
+        celix_dmServiceDependency_setService(dep, "required_svc", nullptr, filter.c_str());
+        celix_dmServiceDependency_setRequired(dep, true);
+        celix_dmComponent_addServiceDependency(cmp, dep);
+
+        auto *trigger = celix_dmServiceDependency_create();
+        celix_dmServiceDependency_setService(trigger, "trigger_svc", nullptr, nullptr);
+        celix_dmServiceDependency_setRequired(trigger, true);
+        celix_dmComponent_addServiceDependency(cmp, trigger);
+        celix_dependencyManager_add(mng, cmp);
+    }
+    celix_dependencyManager_wait(mng);
+    EXPECT_FALSE(celix_dependencyManager_areComponentsActive(mng));
+
+    //note the components are started on the pool workers, which would deadlock if the removed events are waited for
+    long triggerSvcId = celix_bundleContext_registerService(ctx, svc, "trigger_svc", nullptr);
+    for (int i = 0; i < 200 && (impls[0].stopCount == 0 || impls[1].stopCount == 0); ++i) {
+        usleep(10000);
+    }
+    celix_dependencyManager_wait(mng);
+    EXPECT_EQ(2, nrOfStarting);
+    EXPECT_EQ(1, impls[0].stopCount);
+    EXPECT_EQ(1, impls[1].stopCount);
+    EXPECT_FALSE(celix_dependencyManager_areComponentsActive(mng));
+
+    celix_bundleContext_unregisterService(ctx, triggerSvcId);
+    celix_dependencyManager_removeAllComponents(mng);
+}
@@ -26,9 +26,21 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <dirent.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <ftw.h>
+#include <string>
+#include <map>
 
 #include "celix_launcher.h"
 #include "celix_framework_factory.h"
+#include "celix_constants.h"
+#include "celix_bundle_context.h"
+#include "celix_framework.h"
+#include "celix_bundle.h"
 
 
     static celix_framework_t *framework = nullptr;
@@ -173,3 +185,192 @@ TEST_F(FrameworkFactory, restartFramework) {
     framework_destroy(fw);
 }
 
+TEST_F(FrameworkFactory, parallelAutoStart) {
+    celix_properties_t* config = celix_properties_create();
+    celix_properties_set(config, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    celix_properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+    celix_properties_set(config, "org.osgi.framework.storage", ".cacheParallelAutoStart");
+    celix_properties_set(config, CELIX_AUTO_START_PARALLEL, "true");
+    celix_properties_set(config, CELIX_AUTO_START_PARALLEL_THREADS, "4");
+    celix_properties_set(config, CELIX_AUTO_START_0, SIMPLE_TEST_BUNDLE1_LOCATION " " SIMPLE_TEST_BUNDLE2_LOCATION " " SIMPLE_TEST_BUNDLE1_LOCATION);
+    celix_properties_set(config, CELIX_AUTO_START_1, SIMPLE_TEST_BUNDLE3_LOCATION);
+
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+    celix_bundle_context_t* ctx = celix_framework_getFrameworkContext(fw);
+
+    celix_array_list_t* bundleIds = celix_bundleContext_listBundles(ctx);
+    EXPECT_EQ(3, celix_arrayList_size(bundleIds)); //duplicate location is only installed once
+    for (int i = 0; i < celix_arrayList_size(bundleIds); ++i) {
+        long bndId = celix_arrayList_getLong(bundleIds, i);
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId));
+    }
+    celix_arrayList_destroy(bundleIds);
+
+    celix_frameworkFactory_destroyFramework(fw);
+}
+
+TEST_F(FrameworkFactory, bundleExtractionCache) {
+    const char* extractionCacheDir = ".extractionCacheTest";
+    auto countEntries = [extractionCacheDir](bool links) {
+        int count = 0;
+        DIR* dir = opendir(extractionCacheDir);
+        if (dir != nullptr) {
+            for (struct dirent* dent = readdir(dir); dent != nullptr; dent = readdir(dir)) {
+                std::string path = std::string{extractionCacheDir} + "/" + dent->d_name;
+                struct stat st{};
+                if (dent->d_name[0] != '.' && lstat(path.c_str(), &st) == 0 && S_ISLNK(st.st_mode) == links) {
+                    count += 1;
+                }
+            }
+            closedir(dir);
+        }
+        return count;
+    };
+
+    //start with an empty extraction cache, so that entries of previously built bundle zips are not counted
+    nftw(extractionCacheDir, [](const char* path, const struct stat*, int, struct FTW*) { return remove(path); }, 16, FTW_DEPTH | FTW_PHYS);
+
+    //stale temporary dirs of interrupted extractions are removed when the cache is opened, recent ones are kept
+    mkdir(extractionCacheDir, S_IRWXU);
+    std::string staleTmpDir = std::string{extractionCacheDir} + "/0000000000000000-0.tmp.stale";
+    std::string recentTmpDir = std::string{extractionCacheDir} + "/0000000000000000-0.tmp.recent";
+    mkdir(staleTmpDir.c_str(), S_IRWXU);
+    mkdir(recentTmpDir.c_str(), S_IRWXU);
+    struct timeval times[2]{};
+    times[0].tv_sec = times[1].tv_sec = time(nullptr) - 3600;
+    utimes(staleTmpDir.c_str(), times);
+
+    for (int i = 0; i < 2; ++i) {
+        celix_properties_t* config = celix_properties_create();
+        celix_properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+        celix_properties_set(config, "org.osgi.framework.storage", ".cacheExtractionCacheTest");
+        celix_properties_set(config, CELIX_BUNDLE_EXTRACTION_CACHE_DIR, extractionCacheDir);
+        framework_t* fw = celix_frameworkFactory_createFramework(config);
+        ASSERT_TRUE(fw != nullptr);
+        celix_bundle_context_t* ctx = celix_framework_getFrameworkContext(fw);
+        if (i == 0) {
+            EXPECT_NE(0, access(staleTmpDir.c_str(), F_OK));
+            EXPECT_EQ(0, access(recentTmpDir.c_str(), F_OK));
+            rmdir(recentTmpDir.c_str());
+        }
+
+        long bndId = celix_bundleContext_installBundle(ctx, SIMPLE_TEST_BUNDLE1_LOCATION, true);
+        EXPECT_GE(bndId, 0);
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId));
+        EXPECT_EQ(1, countEntries(false)); //second iteration reuses the extracted bundle
+        EXPECT_EQ(1, countEntries(true)); //key link (path, size and modification time) of the bundle zip
+
+        celix_frameworkFactory_destroyFramework(fw);
+    }
+}
+
+TEST_F(FrameworkFactory, loadBundleLibrariesFromArchive) {
+    celix_properties_t* config = celix_properties_create();
+    celix_properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+    celix_properties_set(config, "org.osgi.framework.storage", ".cacheLoadFromArchiveTest");
+    celix_properties_set(config, CELIX_LOAD_BUNDLE_LIBRARIES_FROM_ARCHIVE, "true");
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+    celix_bundle_context_t* ctx = celix_framework_getFrameworkContext(fw);
+
+    //note the activator of the bundle returns an exception on start, but the bundle library is loaded (i.e. resolved)
+    long bndId = celix_bundleContext_installBundle(ctx, TEST_BUNDLE_WITH_EXCEPTION_LOCATION, false);
+    ASSERT_GE(bndId, 0);
+    celix_bundleContext_startBundle(ctx, bndId);
+    celix_bundle_state_e state = OSGI_FRAMEWORK_BUNDLE_UNKNOWN;
+    celix_framework_useBundle(fw, false, bndId, &state, [](void* handle, const celix_bundle_t* bnd) {
+        *static_cast<celix_bundle_state_e*>(handle) = celix_bundle_getState(bnd);
+    });
+    EXPECT_EQ(OSGI_FRAMEWORK_BUNDLE_RESOLVED, state);
+
+    //the bundle library is not extracted
+    std::string revisionRoot = ".cacheLoadFromArchiveTest/bundle" + std::to_string(bndId) + "/version0.0";
+    DIR* dir = opendir(revisionRoot.c_str());
+    ASSERT_TRUE(dir != nullptr);
+    for (struct dirent* dent = readdir(dir); dent != nullptr; dent = readdir(dir)) {
+        EXPECT_NE(0, strncmp(dent->d_name, "lib", 3)) << dent->d_name;
+    }
+    closedir(dir);
+
+    celix_frameworkFactory_destroyFramework(fw);
+}
+
+TEST_F(FrameworkFactory, loadMultipleBundleLibrariesFromArchive) {
+    for (const char* noDelete : {"false", "true"}) {
+        celix_properties_t* config = celix_properties_create();
+        celix_properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+        celix_properties_set(config, "org.osgi.framework.storage", ".cacheLoadMultipleFromArchiveTest");
+        celix_properties_set(config, CELIX_LOAD_BUNDLE_LIBRARIES_FROM_ARCHIVE, "true");
+        celix_properties_set(config, CELIX_LOAD_BUNDLES_WITH_NODELETE, noDelete);
+        framework_t* fw = celix_frameworkFactory_createFramework(config);
+        ASSERT_TRUE(fw != nullptr);
+        celix_bundle_context_t* ctx = celix_framework_getFrameworkContext(fw);
+
+        //every bundle must use the activator of its own library
+        long bndId1 = celix_bundleContext_installBundle(ctx, NAMED_SERVICE_BUNDLE1_LOCATION, true);
+        long bndId2 = celix_bundleContext_installBundle(ctx, NAMED_SERVICE_BUNDLE2_LOCATION, true);
+        ASSERT_GE(bndId1, 0);
+        ASSERT_GE(bndId2, 0);
+
+        std::map<long, std::string> names{};
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = "named_service";
+        opts.callbackHandle = &names;
+        opts.useWithOwner = [](void* handle, void*, const celix_properties_t* props, const celix_bundle_t* owner) {
+            auto* names = static_cast<std::map<long, std::string>*>(handle);
+            (*names)[celix_bundle_getId(owner)] = celix_properties_get(props, "name", "");
+        };
+        EXPECT_EQ(2, celix_bundleContext_useServicesWithOptions(ctx, &opts));
+        EXPECT_EQ("bundle1", names[bndId1]) << "NODELETE=" << noDelete;
+        EXPECT_EQ("bundle2", names[bndId2]) << "NODELETE=" << noDelete;
+
+        celix_frameworkFactory_destroyFramework(fw);
+    }
+}
+
+TEST_F(FrameworkFactory, lifecycleTimeline) {
+    celix_properties_t* config = celix_properties_create();
+    celix_properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+    celix_properties_set(config, "org.osgi.framework.storage", ".cacheLifecycleTimelineTest");
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+    celix_bundle_context_t* ctx = celix_framework_getFrameworkContext(fw);
+    long bndId = celix_bundleContext_installBundle(ctx, SIMPLE_TEST_BUNDLE1_LOCATION, true);
+    EXPECT_GE(bndId, 0);
+
+    char* buf = nullptr;
+    size_t bufLen = 0;
+    FILE* stream = open_memstream(&buf, &bufLen);
+    celix_framework_printLifecycleTimeline(fw, stream);
+    fclose(stream);
+    std::string table{buf};
+    free(buf);
+    EXPECT_NE(std::string::npos, table.find("extract"));
+    EXPECT_NE(std::string::npos, table.find("install"));
+    EXPECT_NE(std::string::npos, table.find("resolve"));
+
+    stream = open_memstream(&buf, &bufLen);
+    EXPECT_EQ(CELIX_SUCCESS, celix_framework_writeLifecycleTimelineAsTraceEvents(fw, stream));
+    fclose(stream);
+    std::string trace{buf};
+    free(buf);
+    EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"install\",\"cat\":\"bundle\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"thread_name\""));
+
+    celix_frameworkFactory_destroyFramework(fw);
+
+    //disabled timeline
+    config = celix_properties_create();
+    celix_properties_set(config, "org.osgi.framework.storage.clean", "onFirstInit");
+    celix_properties_set(config, "org.osgi.framework.storage", ".cacheLifecycleTimelineTest");
+    celix_properties_set(config, CELIX_FRAMEWORK_LIFECYCLE_TIMELINE_MAX_EVENTS, "0");
+    fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+    stream = open_memstream(&buf, &bufLen);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_framework_writeLifecycleTimelineAsTraceEvents(fw, stream));
+    fclose(stream);
+    free(buf);
+    celix_frameworkFactory_destroyFramework(fw);
+}
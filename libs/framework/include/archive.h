@@ -48,6 +48,47 @@ extern "C" {
  */
 celix_status_t extractBundle(const char *bundleName, const char *revisionRoot);
 
+/**
+ * Extracts the bundle pointed to by bundleName to the given root, except for the (top level) shared libraries.
+ * If memory files are not supported on this platform, the shared libraries are extracted as well.
+ *
+ * @param bundleName location of the bundle to extract.
+ * @param revisionRoot directory to where the bundle must be extracted.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_FILE_IO_EXCEPTION If the zip file cannot be extracted.
+ */
+celix_status_t extractBundleWithoutLibraries(const char *bundleName, const char *revisionRoot);
+
+/**
+ * Extracts a single entry of the bundle pointed to by bundleName to an anonymous memory file (memfd).
+ * The caller is owner of the returned file descriptor.
+ *
+ * @param bundleName location of the bundle.
+ * @param entryName the name of the entry in the bundle zip.
+ * @param fd output param for the file descriptor of the memory file.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_FILE_IO_EXCEPTION If the entry cannot be found or extracted.
+ * 		- CELIX_ILLEGAL_STATE If memory files are not supported on this platform.
+ */
+celix_status_t extractBundleEntryToMemoryFile(const char *bundleName, const char *entryName, int *fd);
+
+/**
+ * Extracts a single entry of the bundle pointed to by bundleName to the given root.
+ *
+ * @param bundleName location of the bundle.
+ * @param entryName the name of the entry in the bundle zip.
+ * @param revisionRoot directory to where the entry must be extracted.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_FILE_IO_EXCEPTION If the entry cannot be found or extracted.
+ */
+celix_status_t extractBundleEntry(const char *bundleName, const char *entryName, const char *revisionRoot);
+
 #ifdef __cplusplus
 }
 #endif
@@ -151,6 +151,40 @@ typedef struct celix_service_registration_options {
 long celix_bundleContext_registerServiceWithOptions(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts);
 
 
+/**
+ * Register multiple services to the Celix framework using the provided service registration options.
+ *
+ * All services are added to the service registry under a single registry lock acquisition and the REGISTERED
+ * events for all services are delivered in one pass before this call returns.
+ * This is more efficient than calling celix_bundleContext_registerServiceWithOptions for every service.
+ *
+ * @param ctx The bundle context
+ * @param opts Array of nrOfOpts registration options. The options are only used during the registration call.
+ * @param nrOfOpts The number of registration options.
+ * @param svcIds Output array of (at least) nrOfOpts entries. Will be filled with the service ids (>= 0) or -1 for
+ *               services which could not be registered.
+ * @return The number of registered services.
+ */
+size_t celix_bundleContext_registerServicesWithOptions(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfOpts, long *svcIds);
+
+/**
+ * Register multiple services to the Celix framework, without waiting for the service events.
+ *
+ * Same as celix_bundleContext_registerServicesWithOptions, but the REGISTERED events are delivered on the
+ * Celix event thread. The services can be found directly after this call returns, but service trackers can be
+ * updated later. celix_framework_waitForEmptyEventQueue can be used to wait until the events are delivered.
+ * Service listeners and trackers added before the events are delivered get exactly one REGISTERED event and
+ * only get an UNREGISTERING event for services for which they got the REGISTERED event.
+ *
+ * @param ctx The bundle context
+ * @param opts Array of nrOfOpts registration options. The options are only used during the registration call.
+ * @param nrOfOpts The number of registration options.
+ * @param svcIds Output array of (at least) nrOfOpts entries. Will be filled with the service ids (>= 0) or -1 for
+ *               services which could not be registered.
+ * @return The number of registered services.
+ */
+size_t celix_bundleContext_registerServicesWithOptionsAsync(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfOpts, long *svcIds);
+
 /**
  * Unregister the service or service factory with service id.
  * The service will only be unregistered if the bundle of the bundle context is the owner of the service.
@@ -78,6 +78,48 @@ static const char *const CELIX_BUNDLES_PATH_DEFAULT = "bundles";
 
 static const char *const CELIX_LOAD_BUNDLES_WITH_NODELETE = "CELIX_LOAD_BUNDLES_WITH_NODELETE";
 
+/**
+ * If set, bundle zips are extracted once in this directory, keyed on the content hash of the zip, and the extracted
+ * content is reused across restarts and across frameworks using the same directory. The bundle cache revision
+ * directories link to the extracted content. The directory should not be inside the framework storage dir.
+ * The content hash is only calculated if the path, size or modification time of the zip is not yet known in the cache.
+ * Note that frameworks in the same process using the same extraction cache share the loaded bundle libraries.
+ * Default is not set (every bundle is extracted in the bundle cache).
+ */
+static const char *const CELIX_BUNDLE_EXTRACTION_CACHE_DIR = "CELIX_BUNDLE_EXTRACTION_CACHE_DIR";
+
+/**
+ * If set to true, the shared libraries of bundles are not extracted to disk but loaded directly from the bundle zip
+ * using an anonymous memory file (Linux memfd). Other bundle entries are still extracted.
+ * Only supported for bundles installed from a location (not from an input file).
+ * Default is false.
+ */
+static const char *const CELIX_LOAD_BUNDLE_LIBRARIES_FROM_ARCHIVE = "CELIX_LOAD_BUNDLE_LIBRARIES_FROM_ARCHIVE";
+
+/**
+ * The maximum number of bundle and component lifecycle phases recorded in the framework lifecycle timeline.
+ * The timeline can be printed with the shell `timeline` command or written as Chrome trace event JSON.
+ * Default is 4096, 0 disables the timeline.
+ */
+static const char *const CELIX_FRAMEWORK_LIFECYCLE_TIMELINE_MAX_EVENTS = "CELIX_FRAMEWORK_LIFECYCLE_TIMELINE_MAX_EVENTS";
+
+/**
+ * The number of threads used to call bundle listeners.
+ * Default is 0, which means that all bundle listeners are called - one after the other - on the framework event
+ * dispatcher thread. If > 0 every bundle listener gets its own ordered event queue and the listener queues are
+ * handled in parallel by the configured number of threads, so that a slow bundle listener does not delay the
+ * bundle events for other listeners.
+ */
+static const char *const CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS = "CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS";
+
+/**
+ * The number of threads of the worker pool shared by all dependency manager components.
+ * Default is 0, which means that component tasks (start, stop, dependency changes) are run on the calling thread.
+ * If > 0 the component tasks are queued and run by the shared worker pool, one task at a time per component.
+ * Use celix_dependencyManager_wait to wait until the queued component tasks are handled.
+ */
+static const char *const CELIX_DM_COMPONENT_EXECUTOR_THREADS = "CELIX_DM_COMPONENT_EXECUTOR_THREADS";
+
 /**
  * The path used getting entries from the framework bundle.
  * Normal bundles have an archive directory.
@@ -85,6 +127,23 @@ static const char *const CELIX_LOAD_BUNDLES_WITH_NODELETE = "CELIX_LOAD_BUNDLES_
  */
 static const char *const CELIX_SYSTEM_BUNDLE_ARCHIVE_PATH = "CELIX_SYSTEM_BUNDLE_ARCHIVE_PATH";
 
+/**
+ * If set to true, the bundle contexts cache the service trackers used by celix_bundleContext_useService(s)
+ * and celix_bundleContext_findService(s) calls, keyed by the used filter options.
+ * Repeated use/find calls with the same filter options will then reuse the already opened tracker instead of creating
+ * and destroying a service tracker per call.
+ * Note that a cached tracker keeps the tracked services in use (i.e. service factories are not ungotten after
+ * a use call) until the tracker is evicted or the bundle is stopped.
+ * Default is false.
+ */
+static const char *const CELIX_USE_SERVICE_TRACKER_CACHE = "CELIX_USE_SERVICE_TRACKER_CACHE";
+
+/**
+ * The time in seconds a cached use/find service tracker can be idle, before it is evicted.
+ * Default is 30 seconds.
+ */
+static const char *const CELIX_USE_SERVICE_TRACKER_CACHE_IDLE_TIMEOUT = "CELIX_USE_SERVICE_TRACKER_CACHE_IDLE_TIMEOUT";
+
 
 #define CELIX_AUTO_START_0 "CELIX_AUTO_START_0"
 #define CELIX_AUTO_START_1 "CELIX_AUTO_START_1"
@@ -94,6 +153,21 @@ static const char *const CELIX_SYSTEM_BUNDLE_ARCHIVE_PATH = "CELIX_SYSTEM_BUNDLE
 #define CELIX_AUTO_START_5 "CELIX_AUTO_START_5"
 #define CELIX_AUTO_START_6 "CELIX_AUTO_START_6"
 
+/**
+ * If set to true, the bundles of a single auto start level are installed concurrently and started in dependency
+ * ordered waves; bundles in the same wave are started concurrently. Auto start levels are still handled one after
+ * the other. Note that in this mode the bundle ids of the bundles within a auto start level are not deterministic.
+ * Per bundle install and start times are logged on info level.
+ * Default is false.
+ */
+static const char *const CELIX_AUTO_START_PARALLEL = "CELIX_AUTO_START_PARALLEL";
+
+/**
+ * The number of threads used to install and start auto start bundles if CELIX_AUTO_START_PARALLEL is true.
+ * Default is the number of online processors.
+ */
+static const char *const CELIX_AUTO_START_PARALLEL_THREADS = "CELIX_AUTO_START_PARALLEL_THREADS";
+
 
 #ifdef __cplusplus
 }
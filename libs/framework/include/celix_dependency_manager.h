@@ -46,6 +46,14 @@ celix_status_t celix_dependencyManager_remove(celix_dependency_manager_t *manage
  */
 celix_status_t celix_dependencyManager_removeAllComponents(celix_dependency_manager_t *manager);
 
+/**
+ * Waits until the queued tasks (start, stop, dependency changes) of all DM components of the dependency manager
+ * are handled.
+ * Only needed if the components run their tasks on the shared worker pool (see CELIX_DM_COMPONENT_EXECUTOR_THREADS),
+ * otherwise the component tasks are always handled before the dependency manager / component calls return.
+ */
+void celix_dependencyManager_wait(celix_dependency_manager_t *manager);
+
 /**
  * Create and returns a dependency manager info struct for the specified bundle.
  * The dependency manager info contains information about the state of the dependency manager components
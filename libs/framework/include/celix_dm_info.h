@@ -56,6 +56,10 @@ struct celix_dm_component_info_struct {
     char * state;
     celix_array_list_t *interfaces;   // type dm_interface_info_pt
     celix_array_list_t *dependency_list;  // type dm_service_dependency_info_pt
+    size_t nrOfDependencyEvents; // nr of service dependency events (added, changed, removed, swapped) received
+    size_t nrOfEventBatches; // nr of batches in which the dependency events were handled
+    size_t nrOfStateEvaluations; // nr of component state (re)evaluations
+    size_t nrOfCoalescedStateEvaluations; // nr of state evaluations avoided by handling dependency events in batches
 };
 typedef struct celix_dm_component_info_struct *dm_component_info_pt; //deprecated
 typedef struct celix_dm_component_info_struct dm_component_info_t; //deprecated
@@ -24,6 +24,8 @@
 #include "celix_types.h"
 #include "celix_properties.h"
 #include "celix_log_level.h"
+#include "celix_array_list.h"
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -141,6 +143,7 @@ bool celix_framework_startBundle(celix_framework_t *fw, long bndId);
  * The Celix framework has an event queue which (among others) handles bundle events.
  * This function can be used to ensure that all queue event are handled, mainly useful
  * for testing.
+ * Waits until all events queued before this call are handled; events queued during the wait are not waited for.
  *
  * @param fw The Celix Framework
  */
@@ -155,6 +158,51 @@ void celix_framework_waitForEmptyEventQueue(celix_framework_t *fw);
  */
 void celix_framework_setLogCallback(celix_framework_t* fw, void* logHandle, void (*logFunction)(void* handle, celix_log_level_e level, const char* file, const char *function, int line, const char *format, va_list formatArgs));
 
+/**
+ * Prints the recorded bundle and component lifecycle timeline (install, extract, resolve, load libraries,
+ * activator create/start/stop and component init/start/stop phases) as a table ordered on begin time.
+ * See CELIX_FRAMEWORK_LIFECYCLE_TIMELINE_MAX_EVENTS.
+ *
+ * @param fw The Celix framework
+ * @param stream The stream to print to.
+ */
+void celix_framework_printLifecycleTimeline(celix_framework_t *fw, FILE *stream);
+
+/**
+ * Writes the recorded bundle and component lifecycle timeline as Chrome trace event JSON, which can be loaded in
+ * chrome://tracing or Perfetto. Every bundle is shown as a separate thread (tid is the bundle id).
+ *
+ * @param fw The Celix framework
+ * @param stream The stream to write to.
+ * @return CELIX_SUCCESS if the trace events are written, CELIX_ILLEGAL_STATE if the timeline is disabled.
+ */
+celix_status_t celix_framework_writeLifecycleTimelineAsTraceEvents(celix_framework_t *fw, FILE *stream);
+
+/**
+ * Statistics of a bundle listener, see celix_framework_listBundleListenerStats.
+ */
+typedef struct celix_framework_bundle_listener_stats {
+    long bndId; //the bundle id of the bundle which added the bundle listener
+    size_t queueDepth; //nr of bundle events queued for the listener, always 0 without event dispatcher threads
+    size_t nrOfDeliveredEvents;
+    double averageLatencyInSeconds; //average time between firing a bundle event and calling the listener
+    double maxLatencyInSeconds;
+} celix_framework_bundle_listener_stats_t;
+
+/**
+ * List the statistics (queue depth and event latency) of the registered bundle listeners.
+ * See CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS.
+ *
+ * @param fw The Celix framework
+ * @return A array list with celix_framework_bundle_listener_stats_t*. The caller is owner of the list and should
+ *         destroy it with celix_framework_destroyBundleListenerStats.
+ */
+celix_array_list_t* celix_framework_listBundleListenerStats(celix_framework_t *fw);
+
+/**
+ * Destroys the list returned by celix_framework_listBundleListenerStats.
+ */
+void celix_framework_destroyBundleListenerStats(celix_array_list_t *list);
 
 #ifdef __cplusplus
 }
@@ -105,6 +105,40 @@ celix_serviceRegistry_registerServiceFactory(
         celix_properties_t* props,
         service_registration_t **registration);
 
+/**
+ * A single service registration for celix_serviceRegistry_registerServices.
+ */
+typedef struct celix_service_registry_registration_entry {
+    const char *serviceName;
+    const void *svc; //the service or - if factory is true - the celix_service_factory_t
+    bool factory;
+    celix_properties_t *properties; //ownership is transferred to the registry
+    service_registration_t *registration; //output, the created registration
+} celix_service_registry_registration_entry_t;
+
+/**
+ * Register multiple services (or service factories) for the provided bundle.
+ * All services are added to the registry under a single registry lock acquisition.
+ *
+ * If fireRegisteredEvents is true the REGISTERED events for all services are fired in one pass before returning.
+ * If false no events are fired and celix_serviceRegistry_deliverRegisteredEvents should be called (e.g. on the
+ * Celix event thread) for the created registrations.
+ */
+celix_status_t celix_serviceRegistry_registerServices(
+        celix_service_registry_t *registry,
+        const celix_bundle_t *bnd,
+        celix_service_registry_registration_entry_t *entries,
+        size_t nrOfEntries,
+        bool fireRegisteredEvents);
+
+/**
+ * Fire the REGISTERED events for registrations created with celix_serviceRegistry_registerServices without events.
+ * Registrations which are already unregistered or already delivered are skipped.
+ * The events are only delivered to service listeners added before the registration, service listeners added after the
+ * registration already got the REGISTERED event when they were added.
+ */
+void celix_serviceRegistry_deliverRegisteredEvents(celix_service_registry_t *registry, service_registration_t **registrations, size_t nrOfRegistrations);
+
 /**
  * List the registered service for the provided bundle.
  * @return A list of service ids. Caller is owner of the array list.
@@ -28,7 +28,8 @@
 #include <string.h>
 
 #include "celix_utils_api.h"
-#include "bundle_archive.h"
+#include "bundle_archive_private.h"
+#include "bundle_revision_private.h"
 #include "linked_list_iterator.h"
 
 struct bundleArchive {
@@ -41,6 +42,9 @@ struct bundleArchive {
 	time_t lastModified;
 
 	bundle_state_e persistentState;
+
+	char *extractionCacheDir; //NULL if the bundle extraction cache is not used
+	bool loadLibrariesFromArchive;
 };
 
 static celix_status_t bundleArchive_getRevisionLocation(bundle_archive_pt archive, long revNr, char **revision_location);
@@ -94,6 +98,10 @@ celix_status_t bundleArchive_createSystemBundleArchive(bundle_archive_pt *bundle
 }
 
 celix_status_t bundleArchive_create(const char *archiveRoot, long id, const char * location, const char *inputFile, bundle_archive_pt *bundle_archive) {
+	return celix_bundleArchive_create(archiveRoot, id, location, inputFile, NULL, bundle_archive);
+}
+
+celix_status_t celix_bundleArchive_create(const char *archiveRoot, long id, const char * location, const char *inputFile, const celix_bundle_extract_options_t *opts, bundle_archive_pt *bundle_archive) {
 	celix_status_t status = CELIX_SUCCESS;
 	char *error = NULL;
 	bundle_archive_pt archive = NULL;
@@ -113,6 +121,8 @@ celix_status_t bundleArchive_create(const char *archiveRoot, long id, const char
 				archive->archiveRootDir = NULL;
 				archive->archiveRoot = strdup(archiveRoot);
 				archive->refreshCount = -1;
+				archive->extractionCacheDir = opts == NULL || opts->extractionCacheDir == NULL ? NULL : strdup(opts->extractionCacheDir);
+				archive->loadLibrariesFromArchive = opts != NULL && opts->loadLibrariesFromArchive;
 				time(&archive->lastModified);
 
 				status = bundleArchive_initialize(archive);
@@ -158,6 +168,7 @@ celix_status_t bundleArchive_destroy(bundle_archive_pt archive) {
 		if (archive->location != NULL) {
 			free(archive->location);
 		}
+		free(archive->extractionCacheDir);
 
 		free(archive);
 		archive = NULL;
@@ -169,6 +180,10 @@ celix_status_t bundleArchive_destroy(bundle_archive_pt archive) {
 }
 
 celix_status_t bundleArchive_recreate(const char * archiveRoot, bundle_archive_pt *bundle_archive) {
+	return celix_bundleArchive_recreate(archiveRoot, NULL, bundle_archive);
+}
+
+celix_status_t celix_bundleArchive_recreate(const char * archiveRoot, const celix_bundle_extract_options_t *opts, bundle_archive_pt *bundle_archive) {
 	celix_status_t status = CELIX_SUCCESS;
 
 	bundle_archive_pt archive = NULL;
@@ -186,6 +201,8 @@ celix_status_t bundleArchive_recreate(const char * archiveRoot, bundle_archive_p
 			archive->location = NULL;
 			archive->refreshCount = -1;
 			archive->lastModified = (time_t) NULL;
+			archive->extractionCacheDir = opts == NULL || opts->extractionCacheDir == NULL ? NULL : strdup(opts->extractionCacheDir);
+			archive->loadLibrariesFromArchive = opts != NULL && opts->loadLibrariesFromArchive;
 
 			archive->archiveRootDir = opendir(archiveRoot);
 			if (archive->archiveRootDir == NULL) {
@@ -596,7 +613,10 @@ static celix_status_t bundleArchive_createRevisionFromLocation(bundle_archive_pt
 		bundle_revision_pt revision = NULL;
 
 		sprintf(root, "%s/version%ld.%ld", archive->archiveRoot, refreshCount, revNr);
-		status = bundleRevision_create(root, location, revNr, inputFile, &revision);
+		celix_bundle_extract_options_t opts;
+		opts.extractionCacheDir = archive->extractionCacheDir;
+		opts.loadLibrariesFromArchive = archive->loadLibrariesFromArchive;
+		status = celix_bundleRevision_create(root, location, revNr, inputFile, &opts, &revision);
 
 		if (status == CELIX_SUCCESS) {
 			*bundle_revision = revision;
@@ -756,7 +776,7 @@ static celix_status_t bundleArchive_deleteTree(bundle_archive_pt archive, const
 				snprintf(subdir, 512, "%s/%s", directory, dent->d_name);
 
 				struct stat st;
-				if (stat(subdir, &st) == 0) {
+				if (lstat(subdir, &st) == 0) { //note lstat, links into the bundle extraction cache are removed, not followed
 					if (S_ISDIR (st.st_mode)) {
 						status = bundleArchive_deleteTree(archive, subdir);
 					} else {
@@ -0,0 +1,38 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BUNDLE_ARCHIVE_PRIVATE_H_
+#define BUNDLE_ARCHIVE_PRIVATE_H_
+
+#include "bundle_archive.h"
+#include "bundle_revision_private.h"
+
+/**
+ * Creates a bundle archive. The revisions of the archive are created with the provided extract options (can be NULL).
+ */
+celix_status_t celix_bundleArchive_create(const char *archiveRoot, long id, const char *location, const char *inputFile,
+                                          const celix_bundle_extract_options_t *opts, bundle_archive_pt *bundle_archive);
+
+/**
+ * Recreates a bundle archive from an existing archive root. The revisions of the archive are created with the
+ * provided extract options (can be NULL).
+ */
+celix_status_t celix_bundleArchive_recreate(const char *archiveRoot, const celix_bundle_extract_options_t *opts, bundle_archive_pt *bundle_archive);
+
+#endif /* BUNDLE_ARCHIVE_PRIVATE_H_ */
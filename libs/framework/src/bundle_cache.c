@@ -27,7 +27,7 @@
 #include <sys/errno.h>
 
 #include "bundle_cache_private.h"
-#include "bundle_archive.h"
+#include "bundle_archive_private.h"
 #include "celix_constants.h"
 #include "celix_log.h"
 #include "celix_properties.h"
@@ -78,6 +78,13 @@ celix_status_t bundleCache_create(const char *fwUUID, celix_properties_t *config
 			cache->deleteOnDestroy = false;
 		}
 
+		const char *extractionCacheDir = celix_properties_get(configurationMap, CELIX_BUNDLE_EXTRACTION_CACHE_DIR, NULL);
+		cache->extractionCacheDir = extractionCacheDir == NULL ? NULL : strdup(extractionCacheDir);
+		if (cache->extractionCacheDir != NULL) {
+			celix_bundleRevision_cleanExtractionCacheDir(cache->extractionCacheDir);
+		}
+		cache->loadLibrariesFromArchive = celix_properties_getAsBool(configurationMap, CELIX_LOAD_BUNDLE_LIBRARIES_FROM_ARCHIVE, false);
+
 		*bundle_cache = cache;
 		status = CELIX_SUCCESS;
 	}
@@ -92,6 +99,7 @@ celix_status_t bundleCache_destroy(bundle_cache_pt *cache) {
 		bundleCache_delete(*cache);
 	}
 	free((*cache)->cacheDir);
+	free((*cache)->extractionCacheDir);
 	free(*cache);
 	*cache = NULL;
 
@@ -137,7 +145,10 @@ celix_status_t bundleCache_getArchives(bundle_cache_pt cache, array_list_pt *arc
 						&& (strcmp(dent->d_name, "bundle0") != 0)) {
 
 					bundle_archive_pt archive = NULL;
-					status = bundleArchive_recreate(archiveRoot, &archive);
+					celix_bundle_extract_options_t opts;
+					opts.extractionCacheDir = cache->extractionCacheDir;
+					opts.loadLibrariesFromArchive = cache->loadLibrariesFromArchive;
+					status = celix_bundleArchive_recreate(archiveRoot, &opts, &archive);
 					if (status == CELIX_SUCCESS) {
 						arrayList_add(list, archive);
 					}
@@ -187,7 +198,10 @@ celix_status_t bundleCache_createArchive(bundle_cache_pt cache, long id, const c
 
 	if (cache && location) {
 		snprintf(archiveRoot, sizeof(archiveRoot), "%s/bundle%ld",  cache->cacheDir, id);
-		status = bundleArchive_create(archiveRoot, id, location, inputFile, bundle_archive);
+		celix_bundle_extract_options_t opts;
+		opts.extractionCacheDir = cache->extractionCacheDir;
+		opts.loadLibrariesFromArchive = cache->loadLibrariesFromArchive;
+		status = celix_bundleArchive_create(archiveRoot, id, location, inputFile, &opts, bundle_archive);
 	}
 
 	framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Failed to create archive");
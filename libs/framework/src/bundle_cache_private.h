@@ -34,6 +34,8 @@ struct bundleCache {
 	properties_pt configurationMap;
 	char * cacheDir;
 	bool deleteOnDestroy;
+	char *extractionCacheDir; //NULL if CELIX_BUNDLE_EXTRACTION_CACHE_DIR is not configured
+	bool loadLibrariesFromArchive;
 };
 
 
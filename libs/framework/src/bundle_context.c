@@ -39,6 +39,10 @@ static celix_status_t bundleContext_bundleChanged(void *handle, bundle_event_t *
 static void bundleContext_cleanupBundleTrackers(bundle_context_t *ct);
 static void bundleContext_cleanupServiceTrackers(bundle_context_t *ctx);
 static void bundleContext_cleanupServiceTrackerTrackers(bundle_context_t *ctx);
+static celix_bundle_context_use_tracker_entry_t* bundleContext_acquireUseTracker(celix_bundle_context_t *ctx, const celix_service_filter_options_t *opts);
+static void bundleContext_releaseUseTracker(celix_bundle_context_t *ctx, celix_bundle_context_use_tracker_entry_t *entry);
+
+#define CELIX_USE_SERVICE_TRACKER_CACHE_IDLE_TIMEOUT_DEFAULT 30.0
 
 celix_status_t bundleContext_create(framework_pt framework, celix_framework_logger_t*  logger, bundle_pt bundle, bundle_context_pt *bundle_context) {
 	celix_status_t status = CELIX_SUCCESS;
@@ -63,6 +67,11 @@ celix_status_t bundleContext_create(framework_pt framework, celix_framework_logg
             context->metaTrackers =  hashMap_create(NULL,NULL,NULL,NULL);
             context->nextTrackerId = 1L;
 
+            context->useTrackerCacheEnabled = celix_bundleContext_getPropertyAsBool(context, CELIX_USE_SERVICE_TRACKER_CACHE, false);
+            context->useTrackerCacheIdleTimeout = celix_bundleContext_getPropertyAsDouble(context, CELIX_USE_SERVICE_TRACKER_CACHE_IDLE_TIMEOUT, CELIX_USE_SERVICE_TRACKER_CACHE_IDLE_TIMEOUT_DEFAULT);
+            clock_gettime(CLOCK_MONOTONIC, &context->lastUseTrackerEvictionCheck);
+            context->useTrackers = hashMap_create(utils_stringHash, NULL, utils_stringEquals, NULL);
+
             *bundle_context = context;
 
         }
@@ -77,12 +86,14 @@ celix_status_t bundleContext_destroy(bundle_context_pt context) {
 	celix_status_t status = CELIX_SUCCESS;
 
 	if (context != NULL) {
+	    celix_bundleContext_cleanupUseTrackers(context);
 	    celixThreadMutex_lock(&context->mutex);
 
 
 	    bundleContext_cleanupBundleTrackers(context);
 	    bundleContext_cleanupServiceTrackers(context);
         bundleContext_cleanupServiceTrackerTrackers(context);
+        hashMap_destroy(context->useTrackers, false, false);
 
 	    //NOTE still present service registrations will be cleared during bundle stop in the
 	    //service registry (serviceRegistry_clearServiceRegistrations).
@@ -449,9 +460,7 @@ long celix_bundleContext_registerServiceFactory(celix_bundle_context_t *ctx, cel
     return celix_bundleContext_registerServiceWithOptions(ctx, &opts);
 }
 
-long celix_bundleContext_registerServiceWithOptions(bundle_context_t *ctx, const celix_service_registration_options_t *opts) {
-    long svcId = -1;
-    service_registration_t *reg = NULL;
+static celix_properties_t* celix_bundleContext_createServiceProperties(const celix_service_registration_options_t *opts) {
     celix_properties_t *props = opts->properties;
     if (props == NULL) {
         props = celix_properties_create();
@@ -461,6 +470,13 @@ long celix_bundleContext_registerServiceWithOptions(bundle_context_t *ctx, const
     }
     const char *lang = opts->serviceLanguage != NULL && strncmp("", opts->serviceLanguage, 1) != 0 ? opts->serviceLanguage : CELIX_FRAMEWORK_SERVICE_C_LANGUAGE;
     celix_properties_set(props, CELIX_FRAMEWORK_SERVICE_LANGUAGE, lang);
+    return props;
+}
+
+long celix_bundleContext_registerServiceWithOptions(bundle_context_t *ctx, const celix_service_registration_options_t *opts) {
+    long svcId = -1;
+    service_registration_t *reg = NULL;
+    celix_properties_t *props = celix_bundleContext_createServiceProperties(opts);
     if (opts->serviceName != NULL && strncmp("", opts->serviceName, 1) != 0) {
         if (opts->factory != NULL) {
             reg = celix_framework_registerServiceFactory(ctx->framework, ctx->bundle, opts->serviceName, opts->factory, props);
@@ -481,6 +497,67 @@ long celix_bundleContext_registerServiceWithOptions(bundle_context_t *ctx, const
     return svcId;
 }
 
+static size_t celix_bundleContext_registerServicesInternal(bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfOpts, long *svcIds, bool async) {
+    celix_service_registry_registration_entry_t *entries = calloc(nrOfOpts, sizeof(*entries));
+    size_t *optIndices = calloc(nrOfOpts, sizeof(*optIndices));
+    size_t nrOfEntries = 0;
+    for (size_t i = 0; i < nrOfOpts; ++i) {
+        svcIds[i] = -1;
+    }
+    if (entries == NULL || optIndices == NULL) {
+        framework_logIfError(ctx->framework->logger, CELIX_ENOMEM, NULL, "Cannot register services");
+        free(entries);
+        free(optIndices);
+        return 0;
+    }
+
+    for (size_t i = 0; i < nrOfOpts; ++i) {
+        const celix_service_registration_options_t *opt = &opts[i];
+        bool validSvc = opt->factory != NULL || opt->svc != NULL;
+        if (opt->serviceName == NULL || strncmp("", opt->serviceName, 1) == 0 || !validSvc) {
+            framework_logIfError(ctx->framework->logger, CELIX_ILLEGAL_ARGUMENT, NULL, "Required serviceName or svc argument is NULL for service %zu", i);
+            if (opt->properties != NULL) {
+                celix_properties_destroy(opt->properties);
+            }
+            continue;
+        }
+        celix_service_registry_registration_entry_t *entry = &entries[nrOfEntries];
+        entry->serviceName = opt->serviceName;
+        entry->factory = opt->factory != NULL;
+        entry->svc = opt->factory != NULL ? (const void*)opt->factory : opt->svc;
+        entry->properties = celix_bundleContext_createServiceProperties(opt);
+        optIndices[nrOfEntries] = i;
+        nrOfEntries += 1;
+    }
+
+    size_t nrOfRegistered = 0;
+    celix_status_t status = celix_framework_registerServices(ctx->framework, ctx->bundle, entries, nrOfEntries, async);
+    if (status == CELIX_SUCCESS) {
+        celixThreadMutex_lock(&ctx->mutex);
+        for (size_t i = 0; i < nrOfEntries; ++i) {
+            arrayList_add(ctx->svcRegistrations, entries[i].registration);
+            svcIds[optIndices[i]] = serviceRegistration_getServiceId(entries[i].registration);
+        }
+        celixThreadMutex_unlock(&ctx->mutex);
+        nrOfRegistered = nrOfEntries;
+    } else {
+        for (size_t i = 0; i < nrOfEntries; ++i) {
+            celix_properties_destroy(entries[i].properties);
+        }
+    }
+    free(entries);
+    free(optIndices);
+    return nrOfRegistered;
+}
+
+size_t celix_bundleContext_registerServicesWithOptions(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfOpts, long *svcIds) {
+    return celix_bundleContext_registerServicesInternal(ctx, opts, nrOfOpts, svcIds, false);
+}
+
+size_t celix_bundleContext_registerServicesWithOptionsAsync(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfOpts, long *svcIds) {
+    return celix_bundleContext_registerServicesInternal(ctx, opts, nrOfOpts, svcIds, true);
+}
+
 void celix_bundleContext_unregisterService(bundle_context_t *ctx, long serviceId) {
     service_registration_t *found = NULL;
     if (ctx != NULL && serviceId >= 0) {
@@ -761,28 +838,11 @@ bool celix_bundleContext_useServiceWithOptions(
         celix_bundle_context_t *ctx,
         const celix_service_use_options_t *opts) {
     bool called = false;
-    celix_service_tracking_options_t trkOpts;
-    memset(&trkOpts, 0, sizeof(trkOpts));
-
     if (opts != NULL) {
-        trkOpts.filter.serviceName = opts->filter.serviceName;
-        trkOpts.filter = opts->filter;
-        trkOpts.filter.versionRange = opts->filter.versionRange;
-        trkOpts.filter.serviceLanguage = opts->filter.serviceLanguage;
-
-        service_tracker_t *trk = celix_serviceTracker_createWithOptions(ctx, &trkOpts);
-        if (trk != NULL) {
-            if (opts->use != NULL) {
-
-            }
-            if (opts->useWithProperties != NULL) {
-
-            }
-            if (opts->useWithOwner != NULL) {
-
-            }
-            called = celix_serviceTracker_useHighestRankingService(trk, opts->filter.serviceName, opts->waitTimeoutInSeconds, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
-            celix_serviceTracker_destroy(trk);
+        celix_bundle_context_use_tracker_entry_t *entry = bundleContext_acquireUseTracker(ctx, &opts->filter);
+        if (entry != NULL) {
+            called = celix_serviceTracker_useHighestRankingService(entry->tracker, opts->filter.serviceName, opts->waitTimeoutInSeconds, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
+            bundleContext_releaseUseTracker(ctx, entry);
         }
     }
     return called;
@@ -794,21 +854,175 @@ size_t celix_bundleContext_useServicesWithOptions(
         celix_bundle_context_t *ctx,
         const celix_service_use_options_t *opts) {
     size_t count = 0;
-    celix_service_tracking_options_t trkOpts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
     if (opts != NULL) {
-        trkOpts.filter.serviceName = opts->filter.serviceName;
-        trkOpts.filter.filter = opts->filter.filter;
-        trkOpts.filter.versionRange = opts->filter.versionRange;
-        trkOpts.filter.serviceLanguage = opts->filter.serviceLanguage;
-        trkOpts.filter.ignoreServiceLanguage = opts->filter.ignoreServiceLanguage;
+        celix_bundle_context_use_tracker_entry_t *entry = bundleContext_acquireUseTracker(ctx, &opts->filter);
+        if (entry != NULL) {
+            count = celix_serviceTracker_useServices(entry->tracker, opts->filter.serviceName, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
+            bundleContext_releaseUseTracker(ctx, entry);
+        }
+    }
+    return count;
+}
+
+static char* bundleContext_createUseTrackerKey(const celix_service_filter_options_t *opts, char *buf, size_t bufLen) {
+    const char *fmt = "%s|%s|%s|%s|%i";
+    const char *svcName = opts->serviceName == NULL ? "" : opts->serviceName;
+    const char *range = opts->versionRange == NULL ? "" : opts->versionRange;
+    const char *filter = opts->filter == NULL ? "" : opts->filter;
+    const char *lang = opts->serviceLanguage == NULL ? "" : opts->serviceLanguage;
+    int ignoreLang = opts->ignoreServiceLanguage ? 1 : 0;
+    int len = snprintf(buf, bufLen, fmt, svcName, range, filter, lang, ignoreLang);
+    if (len >= 0 && (size_t)len < bufLen) {
+        return buf;
+    }
+    char *key = NULL;
+    asprintf(&key, fmt, svcName, range, filter, lang, ignoreLang);
+    return key;
+}
+
+static void bundleContext_destroyUseTrackerEntry(celix_bundle_context_use_tracker_entry_t *entry) {
+    celix_serviceTracker_destroy(entry->tracker);
+    free(entry->key);
+    free(entry);
+}
+
+//precondition ctx->mutex locked
+static void bundleContext_collectIdleUseTrackers(celix_bundle_context_t *ctx, const struct timespec *now, celix_array_list_t **evicted) {
+    if (celix_difftime(&ctx->lastUseTrackerEvictionCheck, now) < ctx->useTrackerCacheIdleTimeout / 2) {
+        return;
+    }
+    ctx->lastUseTrackerEvictionCheck = *now;
+    hash_map_iterator_t iter = hashMapIterator_construct(ctx->useTrackers);
+    while (hashMapIterator_hasNext(&iter)) {
+        celix_bundle_context_use_tracker_entry_t *entry = hashMapIterator_nextValue(&iter);
+        if (entry->useCount == 0 && celix_difftime(&entry->lastUsed, now) >= ctx->useTrackerCacheIdleTimeout) {
+            hashMapIterator_remove(&iter);
+            if (*evicted == NULL) {
+                *evicted = celix_arrayList_create();
+            }
+            celix_arrayList_add(*evicted, entry);
+        }
+    }
+}
+
+static celix_bundle_context_use_tracker_entry_t* bundleContext_acquireUseTracker(celix_bundle_context_t *ctx, const celix_service_filter_options_t *opts) {
+    celix_service_tracking_options_t trkOpts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
+    trkOpts.filter.serviceName = opts->serviceName;
+    trkOpts.filter.filter = opts->filter;
+    trkOpts.filter.versionRange = opts->versionRange;
+    trkOpts.filter.serviceLanguage = opts->serviceLanguage;
+    trkOpts.filter.ignoreServiceLanguage = opts->ignoreServiceLanguage;
+
+    celixThreadMutex_lock(&ctx->mutex);
+    bool cacheEnabled = ctx->useTrackerCacheEnabled;
+    celixThreadMutex_unlock(&ctx->mutex);
 
-        service_tracker_t *trk = celix_serviceTracker_createWithOptions(ctx, &trkOpts);
+    if (!cacheEnabled) {
+        //no caching, create a tracker per use call
+        celix_service_tracker_t *trk = celix_serviceTracker_createWithOptions(ctx, &trkOpts);
+        celix_bundle_context_use_tracker_entry_t *entry = NULL;
         if (trk != NULL) {
-            count = celix_serviceTracker_useServices(trk, opts->filter.serviceName, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
-            celix_serviceTracker_destroy(trk);
+            entry = calloc(1, sizeof(*entry));
+            entry->tracker = trk;
+            entry->useCount = 1;
+            entry->evicted = true;
         }
+        return entry;
     }
-    return count;
+
+    char buf[256];
+    char *key = bundleContext_createUseTrackerKey(opts, buf, sizeof(buf));
+    if (key == NULL) {
+        return NULL;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    celix_array_list_t *evicted = NULL;
+
+    celixThreadMutex_lock(&ctx->mutex);
+    celix_bundle_context_use_tracker_entry_t *entry = hashMap_get(ctx->useTrackers, key);
+    if (entry != NULL) {
+        entry->useCount += 1;
+    }
+    bundleContext_collectIdleUseTrackers(ctx, &now, &evicted);
+    celixThreadMutex_unlock(&ctx->mutex);
+
+    if (evicted != NULL) {
+        for (int i = 0; i < celix_arrayList_size(evicted); ++i) {
+            bundleContext_destroyUseTrackerEntry(celix_arrayList_get(evicted, i));
+        }
+        celix_arrayList_destroy(evicted);
+    }
+
+    if (entry == NULL) {
+        //note creating the tracker outside the lock, because opening a tracker triggers service listener callbacks
+        celix_service_tracker_t *trk = celix_serviceTracker_createWithOptions(ctx, &trkOpts);
+        if (trk != NULL) {
+            celix_service_tracker_t *duplicate = NULL;
+            celixThreadMutex_lock(&ctx->mutex);
+            entry = hashMap_get(ctx->useTrackers, key);
+            if (entry != NULL) {
+                //created concurrently by another thread
+                entry->useCount += 1;
+                duplicate = trk;
+            } else {
+                entry = calloc(1, sizeof(*entry));
+                entry->key = celix_utils_strdup(key);
+                entry->tracker = trk;
+                entry->useCount = 1;
+                entry->lastUsed = now;
+                //if the cache is disabled concurrently (bundle stopping) the entry is not cached and destroyed after use
+                entry->evicted = !ctx->useTrackerCacheEnabled;
+                if (!entry->evicted) {
+                    hashMap_put(ctx->useTrackers, entry->key, entry);
+                }
+            }
+            celixThreadMutex_unlock(&ctx->mutex);
+            if (duplicate != NULL) {
+                celix_serviceTracker_destroy(duplicate);
+            }
+        }
+    }
+
+    if (key != buf) {
+        free(key);
+    }
+    return entry;
+}
+
+static void bundleContext_releaseUseTracker(celix_bundle_context_t *ctx, celix_bundle_context_use_tracker_entry_t *entry) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    celixThreadMutex_lock(&ctx->mutex);
+    entry->useCount -= 1;
+    entry->lastUsed = now;
+    bool destroy = entry->evicted && entry->useCount == 0;
+    celixThreadMutex_unlock(&ctx->mutex);
+    if (destroy) {
+        bundleContext_destroyUseTrackerEntry(entry);
+    }
+}
+
+void celix_bundleContext_cleanupUseTrackers(celix_bundle_context_t *ctx) {
+    celix_array_list_t *unused = celix_arrayList_create();
+    celixThreadMutex_lock(&ctx->mutex);
+    ctx->useTrackerCacheEnabled = false;
+    hash_map_iterator_t iter = hashMapIterator_construct(ctx->useTrackers);
+    while (hashMapIterator_hasNext(&iter)) {
+        celix_bundle_context_use_tracker_entry_t *entry = hashMapIterator_nextValue(&iter);
+        hashMapIterator_remove(&iter);
+        entry->evicted = true;
+        if (entry->useCount == 0) {
+            celix_arrayList_add(unused, entry);
+        } //else destroyed by the last user
+    }
+    celixThreadMutex_unlock(&ctx->mutex);
+
+    for (int i = 0; i < celix_arrayList_size(unused); ++i) {
+        bundleContext_destroyUseTrackerEntry(celix_arrayList_get(unused, i));
+    }
+    celix_arrayList_destroy(unused);
 }
 
 
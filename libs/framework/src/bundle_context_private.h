@@ -20,11 +20,14 @@
 #ifndef BUNDLE_CONTEXT_PRIVATE_H_
 #define BUNDLE_CONTEXT_PRIVATE_H_
 
+#include <time.h>
+
 #include "bundle_context.h"
 #include "celix_log.h"
 #include "bundle_listener.h"
 #include "celix_bundle_context.h"
 #include "listener_hook_service.h"
+#include "service_tracker.h"
 
 typedef struct celix_bundle_context_bundle_tracker_entry {
 	celix_bundle_context_t *ctx;
@@ -45,6 +48,14 @@ typedef struct celix_bundle_context_service_tracker_tracker_entry {
 	void (*remove)(void *handle, const celix_service_tracker_info_t *info);
 } celix_bundle_context_service_tracker_tracker_entry_t;
 
+typedef struct celix_bundle_context_use_tracker_entry {
+    char *key; //normalized filter options
+    celix_service_tracker_t *tracker;
+    size_t useCount; //protected by ctx->mutex
+    struct timespec lastUsed; //protected by ctx->mutex
+    bool evicted; //protected by ctx->mutex, if true the last user destroys the entry
+} celix_bundle_context_use_tracker_entry_t;
+
 struct celix_bundle_context {
 	celix_framework_t *framework;
 	celix_bundle_t *bundle;
@@ -56,7 +67,18 @@ struct celix_bundle_context {
 	hash_map_t *bundleTrackers; //key = trackerId, value = celix_bundle_context_bundle_tracker_entry_t*
 	hash_map_t *serviceTrackers; //key = trackerId, value = celix_service_tracker_t*
 	hash_map_t *metaTrackers; //key = trackerId, value = celix_bundle_context_service_tracker_tracker_entry_t*
+
+	bool useTrackerCacheEnabled;
+	double useTrackerCacheIdleTimeout; //in seconds
+	struct timespec lastUseTrackerEvictionCheck;
+	hash_map_t *useTrackers; //key = normalized filter options (char*), value = celix_bundle_context_use_tracker_entry_t*
 };
 
+/**
+ * Destroys all cached use/find service trackers of the bundle context.
+ * Called by the framework when the bundle is stopped, before the service references of the bundle are cleared.
+ */
+void celix_bundleContext_cleanupUseTrackers(celix_bundle_context_t *ctx);
+
 
 #endif /* BUNDLE_CONTEXT_PRIVATE_H_ */
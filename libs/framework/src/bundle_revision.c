@@ -23,11 +23,23 @@
 #include <archive.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <errno.h>
+#include <dirent.h>
+#include <limits.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <time.h>
 
 
 #include "bundle_revision_private.h"
 
+static celix_status_t bundleRevision_extract(const char *zip, const char *root, const char *extractionCacheDir, bool skipLibraries);
+
 celix_status_t bundleRevision_create(const char *root, const char *location, long revisionNr, const char *inputFile, bundle_revision_pt *bundle_revision) {
+    return celix_bundleRevision_create(root, location, revisionNr, inputFile, NULL, bundle_revision);
+}
+
+celix_status_t celix_bundleRevision_create(const char *root, const char *location, long revisionNr, const char *inputFile, const celix_bundle_extract_options_t *opts, bundle_revision_pt *bundle_revision) {
     celix_status_t status = CELIX_SUCCESS;
 	bundle_revision_pt revision = NULL;
 
@@ -35,20 +47,24 @@ celix_status_t bundleRevision_create(const char *root, const char *location, lon
     if (!revision) {
     	status = CELIX_ENOMEM;
     } else {
+        const char *extractionCacheDir = opts == NULL ? NULL : opts->extractionCacheDir;
+        bool loadLibrariesFromArchive = opts != NULL && opts->loadLibrariesFromArchive;
         int state = mkdir(root, S_IRWXU);
         if ((state != 0) && (errno != EEXIST)) {
             free(revision);
             status = CELIX_FILE_IO_EXCEPTION;
         } else {
             if (inputFile != NULL) {
-                status = extractBundle(inputFile, root);
+                status = bundleRevision_extract(inputFile, root, extractionCacheDir, false);
             } else if (strcmp(location, "inputstream:") != 0) {
             	// If location != inputstream, extract it, else ignore it and assume this is a cache entry.
-                status = extractBundle(location, root);
+                //note libraries can only be loaded from the bundle zip if the bundle zip is the revision location
+                status = bundleRevision_extract(location, root, extractionCacheDir, loadLibrariesFromArchive);
             }
 
             status = CELIX_DO_IF(status, arrayList_create(&(revision->libraryHandles)));
             if (status == CELIX_SUCCESS) {
+                revision->libraryFds = celix_arrayList_create();
                 revision->revisionNr = revisionNr;
                 revision->root = strdup(root);
                 revision->location = strdup(location);
@@ -73,6 +89,10 @@ celix_status_t bundleRevision_create(const char *root, const char *location, lon
 
 celix_status_t bundleRevision_destroy(bundle_revision_pt revision) {
     arrayList_destroy(revision->libraryHandles);
+    for (int i = 0; i < celix_arrayList_size(revision->libraryFds); ++i) {
+        close(celix_arrayList_getInt(revision->libraryFds, i));
+    }
+    celix_arrayList_destroy(revision->libraryFds);
     manifest_destroy(revision->manifest);
     free(revision->root);
     free(revision->location);
@@ -132,6 +152,10 @@ celix_status_t bundleRevision_getManifest(bundle_revision_pt revision, manifest_
 	return status;
 }
 
+void celix_bundleRevision_addLibraryFd(bundle_revision_pt revision, int fd) {
+    celix_arrayList_addInt(revision->libraryFds, fd);
+}
+
 celix_status_t bundleRevision_getHandles(bundle_revision_pt revision, array_list_pt *handles) {
     celix_status_t status = CELIX_SUCCESS;
     if (revision == NULL) {
@@ -144,3 +168,239 @@ celix_status_t bundleRevision_getHandles(bundle_revision_pt revision, array_list
 
     return status;
 }
+
+#define BUNDLE_REVISION_FNV_OFFSET_BASIS 14695981039346656037ULL
+
+/**
+ * The age (in seconds) after which a temporary extraction dir in the extraction cache dir is considered stale.
+ * Younger temporary dirs can still be in use by a concurrent extraction of another process.
+ */
+#define BUNDLE_REVISION_STALE_EXTRACTION_SECONDS 600
+
+static uint64_t bundleRevision_hashUpdate(uint64_t hash, const unsigned char *data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Calculates a FNV-1a 64 bit hash over the content of the file.
+ */
+static celix_status_t bundleRevision_hashFile(const char *path, uint64_t *hashOut, long *sizeOut) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    uint64_t hash = BUNDLE_REVISION_FNV_OFFSET_BASIS;
+    long size = 0;
+    unsigned char buf[64 * 1024];
+    size_t read;
+    while ((read = fread(buf, 1, sizeof(buf), file)) > 0) {
+        hash = bundleRevision_hashUpdate(hash, buf, read);
+        size += (long)read;
+    }
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    *hashOut = hash;
+    *sizeOut = size;
+    return failed ? CELIX_FILE_IO_EXCEPTION : CELIX_SUCCESS;
+}
+
+static celix_status_t bundleRevision_createDirectories(const char *dir) {
+    char path[PATH_MAX];
+    int written = snprintf(path, sizeof(path), "%s", dir);
+    if (written < 0 || written >= (int)sizeof(path)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    for (char *sep = strchr(path + 1, '/'); sep != NULL; sep = strchr(sep + 1, '/')) {
+        *sep = '\0';
+        if (mkdir(path, S_IRWXU) != 0 && errno != EEXIST) {
+            return CELIX_FILE_IO_EXCEPTION;
+        }
+        *sep = '/';
+    }
+    if (mkdir(path, S_IRWXU) != 0 && errno != EEXIST) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    return CELIX_SUCCESS;
+}
+
+static void bundleRevision_deleteTree(const char *dir) {
+    DIR *d = opendir(dir);
+    if (d != NULL) {
+        struct dirent *dent;
+        while ((dent = readdir(d)) != NULL) {
+            if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0) {
+                continue;
+            }
+            char path[PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s", dir, dent->d_name);
+            struct stat st;
+            if (lstat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+                bundleRevision_deleteTree(path);
+            } else {
+                unlink(path);
+            }
+        }
+        closedir(d);
+    }
+    rmdir(dir);
+}
+
+void celix_bundleRevision_cleanExtractionCacheDir(const char *extractionCacheDir) {
+    DIR *d = opendir(extractionCacheDir);
+    if (d == NULL) {
+        return;
+    }
+    time_t now = time(NULL);
+    struct dirent *dent;
+    while ((dent = readdir(d)) != NULL) {
+        char path[PATH_MAX];
+        struct stat st;
+        int written = snprintf(path, sizeof(path), "%s/%s", extractionCacheDir, dent->d_name);
+        if (dent->d_name[0] == '.' || written < 0 || written >= (int)sizeof(path) || lstat(path, &st) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode) && strstr(dent->d_name, ".tmp.") != NULL) {
+            //left behind by an interrupted extraction
+            if (now - st.st_mtime > BUNDLE_REVISION_STALE_EXTRACTION_SECONDS) {
+                fw_log(celix_frameworkLogger_globalLogger(), CELIX_LOG_LEVEL_DEBUG, "Removing stale extraction dir '%s'", path);
+                bundleRevision_deleteTree(path);
+            }
+        } else if (S_ISLNK(st.st_mode) && stat(path, &st) != 0) {
+            //key link of a removed cache entry
+            unlink(path);
+        }
+    }
+    closedir(d);
+}
+
+/**
+ * Creates the path of the key link for the zip. The key link name is based on the (absolute) path, size and
+ * modification time of the zip and links to the content hash based cache entry, so that an unchanged zip can be found
+ * in the cache without hashing its content.
+ */
+static celix_status_t bundleRevision_getKeyLink(const char *zip, const char *extractionCacheDir, bool skipLibraries, char *keyLink, size_t keyLinkSize) {
+    char absZip[PATH_MAX];
+    struct stat st;
+    if (realpath(zip, absZip) == NULL || stat(absZip, &st) != 0) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+#ifdef __APPLE__
+    struct timespec mtime = st.st_mtimespec;
+#else
+    struct timespec mtime = st.st_mtim;
+#endif
+    uint64_t pathHash = bundleRevision_hashUpdate(BUNDLE_REVISION_FNV_OFFSET_BASIS, (const unsigned char *)absZip, strlen(absZip));
+    int written = snprintf(keyLink, keyLinkSize, "%s/%016llx-%lx-%llx.%09ld%s.key", extractionCacheDir,
+                           (unsigned long long)pathHash, (long)st.st_size, (unsigned long long)mtime.tv_sec,
+                           mtime.tv_nsec, skipLibraries ? "-nolibs" : "");
+    if (written < 0 || written >= (int)keyLinkSize) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * Ensures the zip is extracted in the extraction cache dir (keyed on the content hash of the zip) and links the
+ * top level entries of the extracted bundle into the revision root.
+ *
+ * The extraction is done in a temporary dir which is atomically renamed to the cache entry, so a cache entry is
+ * always complete and concurrent extractions (other processes or frameworks) of the same zip are harmless.
+ * The content hash is only calculated if the key link of the zip (see bundleRevision_getKeyLink) does not resolve to
+ * a cache entry.
+ */
+static celix_status_t bundleRevision_extractUsingCache(const char *zip, const char *root, const char *extractionCacheDir, bool skipLibraries) {
+    celix_status_t status = bundleRevision_createDirectories(extractionCacheDir);
+
+    char keyLink[PATH_MAX];
+    bool haveKeyLink = status == CELIX_SUCCESS && bundleRevision_getKeyLink(zip, extractionCacheDir, skipLibraries, keyLink, sizeof(keyLink)) == CELIX_SUCCESS;
+
+    struct stat st;
+    char entry[PATH_MAX];
+    bool cached = false;
+    if (haveKeyLink && stat(keyLink, &st) == 0 && S_ISDIR(st.st_mode)) {
+        snprintf(entry, sizeof(entry), "%s", keyLink);
+        cached = true;
+    }
+
+    uint64_t hash = 0;
+    long size = 0;
+    if (status == CELIX_SUCCESS && !cached) {
+        status = bundleRevision_hashFile(zip, &hash, &size);
+    }
+    if (status == CELIX_SUCCESS && !cached) {
+        int written = snprintf(entry, sizeof(entry), "%s/%016llx-%lx%s", extractionCacheDir, (unsigned long long)hash, size, skipLibraries ? "-nolibs" : "");
+        if (written < 0 || written >= (int)sizeof(entry)) {
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    if (status == CELIX_SUCCESS && !cached && (stat(entry, &st) != 0 || !S_ISDIR(st.st_mode))) {
+        char tmp[PATH_MAX];
+        snprintf(tmp, sizeof(tmp), "%s.tmp.XXXXXX", entry);
+        if (mkdtemp(tmp) == NULL) {
+            status = CELIX_FILE_IO_EXCEPTION;
+        } else {
+            status = skipLibraries ? extractBundleWithoutLibraries(zip, tmp) : extractBundle(zip, tmp);
+            if (status == CELIX_SUCCESS && rename(tmp, entry) != 0) {
+                //note EEXIST/ENOTEMPTY: a concurrent extraction already provided the cache entry
+                if (errno != EEXIST && errno != ENOTEMPTY) {
+                    status = CELIX_FILE_IO_EXCEPTION;
+                }
+                bundleRevision_deleteTree(tmp);
+            } else if (status != CELIX_SUCCESS) {
+                bundleRevision_deleteTree(tmp);
+            }
+        }
+    }
+
+    if (status == CELIX_SUCCESS && !cached && haveKeyLink) {
+        //note a failing key link only means the next extraction of the zip calculates the content hash again
+        unlink(keyLink);
+        if (symlink(strrchr(entry, '/') + 1, keyLink) != 0 && errno != EEXIST) {
+            fw_log(celix_frameworkLogger_globalLogger(), CELIX_LOG_LEVEL_DEBUG, "Cannot create extraction cache key link '%s'", keyLink);
+        }
+    }
+
+    char absEntry[PATH_MAX];
+    if (status == CELIX_SUCCESS && realpath(entry, absEntry) == NULL) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    }
+
+    DIR *dir = status == CELIX_SUCCESS ? opendir(absEntry) : NULL;
+    if (status == CELIX_SUCCESS && dir == NULL) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    }
+    if (dir != NULL) {
+        struct dirent *dent;
+        while (status == CELIX_SUCCESS && (dent = readdir(dir)) != NULL) {
+            if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0) {
+                continue;
+            }
+            char target[PATH_MAX];
+            char link[PATH_MAX];
+            snprintf(target, sizeof(target), "%s/%s", absEntry, dent->d_name);
+            snprintf(link, sizeof(link), "%s/%s", root, dent->d_name);
+            if (lstat(link, &st) == 0 && S_ISLNK(st.st_mode)) {
+                unlink(link); //reload of an existing revision
+            }
+            if (symlink(target, link) != 0) {
+                status = CELIX_FILE_IO_EXCEPTION;
+            }
+        }
+        closedir(dir);
+    }
+
+    framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Failed to use extraction cache dir '%s' for bundle '%s'", extractionCacheDir, zip);
+    return status;
+}
+
+static celix_status_t bundleRevision_extract(const char *zip, const char *root, const char *extractionCacheDir, bool skipLibraries) {
+    if (extractionCacheDir == NULL) {
+        return skipLibraries ? extractBundleWithoutLibraries(zip, root) : extractBundle(zip, root);
+    }
+    return bundleRevision_extractUsingCache(zip, root, extractionCacheDir, skipLibraries);
+}
@@ -36,6 +36,43 @@ struct bundleRevision {
 	manifest_pt manifest;
 
 	array_list_pt libraryHandles;
+	celix_array_list_t *libraryFds; //memory files of the libraries loaded from the bundle zip
 };
 
+typedef struct celix_bundle_extract_options {
+    /**
+     * If not NULL, the bundle zip is extracted (once) in the extraction cache dir keyed on the content hash of the zip
+     * and the revision root links to the extracted content.
+     */
+    const char *extractionCacheDir;
+
+    /**
+     * If true, the shared libraries of a bundle installed from a location are not extracted. They are loaded directly
+     * from the bundle zip instead.
+     */
+    bool loadLibrariesFromArchive;
+} celix_bundle_extract_options_t;
+
+/**
+ * Creates a bundle revision using the provided extract options. The options can be NULL, in which case the bundle is
+ * fully extracted in the revision root.
+ */
+celix_status_t celix_bundleRevision_create(const char *root, const char *location, long revisionNr, const char *inputFile,
+                                           const celix_bundle_extract_options_t *opts, bundle_revision_pt *bundle_revision);
+
+/**
+ * Adds the memory file of a library loaded from the bundle zip to the revision. The memory file is closed when the
+ * revision is destroyed, i.e. after the library is closed.
+ *
+ * Note that the memory file must stay open while the library is loaded; the library is loaded using the
+ * /proc/self/fd/<fd> path and dlopen returns the already loaded library for a path (fd) which is reused.
+ */
+void celix_bundleRevision_addLibraryFd(bundle_revision_pt revision, int fd);
+
+/**
+ * Removes the stale temporary dirs of interrupted extractions and the key links of removed cache entries from the
+ * extraction cache dir.
+ */
+void celix_bundleRevision_cleanExtractionCacheDir(const char *extractionCacheDir);
+
 #endif /* BUNDLE_REVISION_PRIVATE_H_ */
@@ -0,0 +1,251 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+
+#include "celix_epoch.h"
+#include "celix_threads.h"
+
+#define CELIX_EPOCH_CACHE_LINE_SIZE 64
+
+typedef struct celix_epoch_record celix_epoch_record_t;
+typedef struct celix_epoch_retired_entry celix_epoch_retired_entry_t;
+
+/**
+ * Per thread epoch record. Aligned on a cache line, so that readers on different threads do not share cache lines.
+ */
+struct celix_epoch_record {
+    unsigned long epoch; //global epoch observed when entering the outermost read section, 0 if not in a read section
+    bool inUse; //true if the record is owned by a thread
+    unsigned int nesting; //only used by the owning thread
+    celix_epoch_record_t *next; //immutable after the record is published
+} __attribute__((aligned(CELIX_EPOCH_CACHE_LINE_SIZE)));
+
+struct celix_epoch_retired_entry {
+    void *object;
+    void (*freeFunction)(void *object);
+    unsigned long epoch; //global epoch when the object was retired
+    celix_epoch_retired_entry_t *next;
+};
+
+struct celix_epoch_domain {
+    unsigned long globalEpoch; //starts at 1, 0 is used for records not in a read section
+    pthread_key_t recordKey;
+    celix_epoch_record_t *records; //append only list, records are reused when a thread exits
+
+    celix_thread_mutex_t mutex; //protects below and the claiming of records
+    celix_epoch_retired_entry_t *retired;
+
+    /**
+     * Used by celix_epochDomain_synchronize to wait for readers. Readers only take the syncMutex when exiting their
+     * outermost read section while a synchronize call is waiting (nrOfSyncWaiters > 0).
+     */
+    unsigned int nrOfSyncWaiters; //accessed atomically
+    celix_thread_mutex_t syncMutex;
+    celix_thread_cond_t syncCond;
+};
+
+static void celix_epochDomain_releaseRecord(void *data) {
+    celix_epoch_record_t *record = data;
+    __atomic_store_n(&record->epoch, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&record->inUse, false, __ATOMIC_RELEASE);
+}
+
+static void celix_epochDomain_wakeSyncWaiters(celix_epoch_domain_t *domain) {
+    //the epoch store (seq cst) before this load ensures that either a waiter sees the cleared epoch or this reader
+    //sees the waiter. The broadcast is done under the syncMutex, so that it cannot be lost between the check and the
+    //wait of the waiter.
+    if (__atomic_load_n(&domain->nrOfSyncWaiters, __ATOMIC_SEQ_CST) > 0) {
+        celixThreadMutex_lock(&domain->syncMutex);
+        celixThreadCondition_broadcast(&domain->syncCond);
+        celixThreadMutex_unlock(&domain->syncMutex);
+    }
+}
+
+celix_epoch_domain_t* celix_epochDomain_create(void) {
+    celix_epoch_domain_t *domain = calloc(1, sizeof(*domain));
+    if (domain != NULL) {
+        if (pthread_key_create(&domain->recordKey, celix_epochDomain_releaseRecord) != 0) {
+            free(domain);
+            return NULL;
+        }
+        domain->globalEpoch = 1;
+        celixThreadMutex_create(&domain->mutex, NULL);
+        celixThreadMutex_create(&domain->syncMutex, NULL);
+        celixThreadCondition_init(&domain->syncCond, NULL);
+    }
+    return domain;
+}
+
+void celix_epochDomain_destroy(celix_epoch_domain_t *domain) {
+    if (domain == NULL) {
+        return;
+    }
+    pthread_key_delete(domain->recordKey);
+
+    celix_epoch_retired_entry_t *entry = domain->retired;
+    while (entry != NULL) {
+        celix_epoch_retired_entry_t *next = entry->next;
+        entry->freeFunction(entry->object);
+        free(entry);
+        entry = next;
+    }
+
+    celix_epoch_record_t *record = domain->records;
+    while (record != NULL) {
+        celix_epoch_record_t *next = record->next;
+        free(record);
+        record = next;
+    }
+
+    celixThreadMutex_destroy(&domain->mutex);
+    celixThreadMutex_destroy(&domain->syncMutex);
+    celixThreadCondition_destroy(&domain->syncCond);
+    free(domain);
+}
+
+static celix_epoch_record_t* celix_epochDomain_claimRecord(celix_epoch_domain_t *domain) {
+    celix_epoch_record_t *record = NULL;
+    celixThreadMutex_lock(&domain->mutex);
+    for (celix_epoch_record_t *visit = domain->records; visit != NULL; visit = visit->next) {
+        if (!__atomic_load_n(&visit->inUse, __ATOMIC_ACQUIRE)) {
+            record = visit;
+            break;
+        }
+    }
+    if (record == NULL) {
+        void *mem = NULL;
+        if (posix_memalign(&mem, CELIX_EPOCH_CACHE_LINE_SIZE, sizeof(celix_epoch_record_t)) == 0) {
+            record = mem;
+            memset(record, 0, sizeof(*record));
+            record->next = domain->records;
+            __atomic_store_n(&domain->records, record, __ATOMIC_RELEASE);
+        }
+    }
+    if (record != NULL) {
+        record->nesting = 0;
+        __atomic_store_n(&record->inUse, true, __ATOMIC_RELEASE);
+    }
+    celixThreadMutex_unlock(&domain->mutex);
+    if (record != NULL) {
+        pthread_setspecific(domain->recordKey, record);
+    }
+    return record;
+}
+
+void celix_epochDomain_enter(celix_epoch_domain_t *domain) {
+    celix_epoch_record_t *record = pthread_getspecific(domain->recordKey);
+    if (record == NULL) {
+        record = celix_epochDomain_claimRecord(domain);
+        if (record == NULL) {
+            abort(); //cannot guarantee a safe read section without a record
+        }
+    }
+    if (record->nesting++ == 0) {
+        unsigned long epoch = __atomic_load_n(&domain->globalEpoch, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&record->epoch, epoch, __ATOMIC_SEQ_CST);
+        //ensure the epoch is visible before any of the protected data is read
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+}
+
+void celix_epochDomain_exit(celix_epoch_domain_t *domain) {
+    celix_epoch_record_t *record = pthread_getspecific(domain->recordKey);
+    if (record != NULL && record->nesting > 0 && --record->nesting == 0) {
+        __atomic_store_n(&record->epoch, 0, __ATOMIC_SEQ_CST);
+        celix_epochDomain_wakeSyncWaiters(domain);
+    }
+}
+
+void celix_epochDomain_retire(celix_epoch_domain_t *domain, void *object, void (*freeFunction)(void *object)) {
+    if (object == NULL) {
+        return;
+    }
+    celix_epoch_retired_entry_t *entry = malloc(sizeof(*entry));
+    entry->object = object;
+    entry->freeFunction = freeFunction;
+
+    celixThreadMutex_lock(&domain->mutex);
+    entry->epoch = __atomic_fetch_add(&domain->globalEpoch, 1, __ATOMIC_SEQ_CST);
+    entry->next = domain->retired;
+    domain->retired = entry;
+    celixThreadMutex_unlock(&domain->mutex);
+
+    celix_epochDomain_reclaim(domain);
+}
+
+static unsigned long celix_epochDomain_oldestActiveEpoch(celix_epoch_domain_t *domain) {
+    unsigned long oldest = ULONG_MAX;
+    celix_epoch_record_t *record = __atomic_load_n(&domain->records, __ATOMIC_ACQUIRE);
+    for (; record != NULL; record = record->next) {
+        unsigned long epoch = __atomic_load_n(&record->epoch, __ATOMIC_SEQ_CST);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    return oldest;
+}
+
+int celix_epochDomain_reclaim(celix_epoch_domain_t *domain) {
+    celix_epoch_retired_entry_t *reclaimable = NULL;
+    int pending = 0;
+
+    celixThreadMutex_lock(&domain->mutex);
+    //an object retired in epoch E can still be seen by readers which entered in epoch E or earlier
+    unsigned long oldest = celix_epochDomain_oldestActiveEpoch(domain);
+    celix_epoch_retired_entry_t **link = &domain->retired;
+    while (*link != NULL) {
+        celix_epoch_retired_entry_t *entry = *link;
+        if (entry->epoch < oldest) {
+            *link = entry->next;
+            entry->next = reclaimable;
+            reclaimable = entry;
+        } else {
+            link = &entry->next;
+            pending += 1;
+        }
+    }
+    celixThreadMutex_unlock(&domain->mutex);
+
+    while (reclaimable != NULL) {
+        celix_epoch_retired_entry_t *next = reclaimable->next;
+        reclaimable->freeFunction(reclaimable->object);
+        free(reclaimable);
+        reclaimable = next;
+    }
+    return pending;
+}
+
+void celix_epochDomain_synchronize(celix_epoch_domain_t *domain) {
+    unsigned long target = __atomic_fetch_add(&domain->globalEpoch, 1, __ATOMIC_SEQ_CST);
+    if (celix_epochDomain_oldestActiveEpoch(domain) <= target) {
+        //readers are still in a read section started before this call, wait until they signal their exit
+        celixThreadMutex_lock(&domain->syncMutex);
+        __atomic_fetch_add(&domain->nrOfSyncWaiters, 1, __ATOMIC_SEQ_CST);
+        while (celix_epochDomain_oldestActiveEpoch(domain) <= target) {
+            celixThreadCondition_wait(&domain->syncCond, &domain->syncMutex);
+        }
+        __atomic_fetch_sub(&domain->nrOfSyncWaiters, 1, __ATOMIC_SEQ_CST);
+        celixThreadMutex_unlock(&domain->syncMutex);
+    }
+    celix_epochDomain_reclaim(domain);
+}
@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_EPOCH_H
+#define CELIX_CELIX_EPOCH_H
+
+#include <stdbool.h>
+
+/**
+ * Epoch based reclamation for read-mostly data structures.
+ *
+ * Readers enter a read section with celix_epochDomain_enter and leave it with celix_epochDomain_exit. Entering and
+ * exiting does not lock; the first enter of a thread only registers a per thread epoch record.
+ * Writers publish a new version of the data (e.g. an atomic pointer swap) and retire the previous version with
+ * celix_epochDomain_retire. A retired object is freed when no reader that could still see it is inside a read section.
+ *
+ * Read sections must be short and must not block on locks held by writers.
+ */
+typedef struct celix_epoch_domain celix_epoch_domain_t;
+
+celix_epoch_domain_t* celix_epochDomain_create(void);
+
+/**
+ * Destroys the epoch domain and frees all retired objects.
+ * Precondition: no reader is inside a read section.
+ */
+void celix_epochDomain_destroy(celix_epoch_domain_t *domain);
+
+/**
+ * Enters a read section. Read sections can be nested.
+ * Data published before the enter call and retired after it stays valid until the matching celix_epochDomain_exit.
+ */
+void celix_epochDomain_enter(celix_epoch_domain_t *domain);
+
+/**
+ * Exits a read section.
+ */
+void celix_epochDomain_exit(celix_epoch_domain_t *domain);
+
+/**
+ * Retires an object which is no longer reachable for new readers. The freeFunction is called - possibly on an other
+ * thread - when all readers which could have seen the object have exited their read section.
+ */
+void celix_epochDomain_retire(celix_epoch_domain_t *domain, void *object, void (*freeFunction)(void *object));
+
+/**
+ * Waits until all readers that entered a read section before this call have exited that read section.
+ * Can be used before releasing data which is referenced - but not owned - by a retired object.
+ * Must not be called from within a read section.
+ */
+void celix_epochDomain_synchronize(celix_epoch_domain_t *domain);
+
+/**
+ * Frees the retired objects which are no longer visible to any reader.
+ * Returns the number of retired objects still pending.
+ */
+int celix_epochDomain_reclaim(celix_epoch_domain_t *domain);
+
+#endif //CELIX_CELIX_EPOCH_H
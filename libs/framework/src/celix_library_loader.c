@@ -21,14 +21,17 @@
 #include "celix_library_loader.h"
 #include <dlfcn.h>
 
-celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const char *libPath) {
+bool celix_libloader_isNoDelete(celix_bundle_context_t *ctx) {
 #if defined(DEBUG) && !defined(ANDROID)
     bool def = true;
 #else
     bool def = false;
 #endif
-    bool noDelete = celix_bundleContext_getPropertyAsBool(ctx, CELIX_LOAD_BUNDLES_WITH_NODELETE, def);
-    if (noDelete) {
+    return celix_bundleContext_getPropertyAsBool(ctx, CELIX_LOAD_BUNDLES_WITH_NODELETE, def);
+}
+
+celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const char *libPath) {
+    if (celix_libloader_isNoDelete(ctx)) {
         return dlopen(libPath, RTLD_LAZY|RTLD_LOCAL|RTLD_NODELETE);
     } else {
         return dlopen(libPath, RTLD_LAZY|RTLD_LOCAL);
@@ -25,6 +25,10 @@
 typedef void celix_library_handle_t;
 
 celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const char *libPath);
+/**
+ * Returns whether libraries are opened with RTLD_NODELETE, i.e. stay loaded after they are closed.
+ */
+bool celix_libloader_isNoDelete(celix_bundle_context_t *ctx);
 void celix_libloader_close(celix_library_handle_t *handle);
 void* celix_libloader_getSymbol(celix_library_handle_t *handle, const char *name);
 const char* celix_libloader_getLastError();
@@ -0,0 +1,220 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "celix_lifecycle_timeline.h"
+#include "celix_threads.h"
+#include "celix_utils.h"
+#include "celix_long_hash_map.h"
+
+typedef struct celix_lifecycle_event {
+    long bndId;
+    char *subject;
+    const char *phase;
+    bool component;
+    struct timespec begin;
+    struct timespec end;
+} celix_lifecycle_event_t;
+
+struct celix_lifecycle_timeline {
+    celix_thread_mutex_t mutex; //protects below
+    struct timespec epoch; //creation time, events are reported relative to this time
+    size_t maxNrOfEvents;
+    size_t nrOfEvents;
+    size_t nrOfDroppedEvents;
+    celix_lifecycle_event_t *events;
+};
+
+celix_lifecycle_timeline_t* celix_lifecycleTimeline_create(size_t maxNrOfEvents) {
+    celix_lifecycle_timeline_t *timeline = calloc(1, sizeof(*timeline));
+    if (timeline != NULL) {
+        timeline->events = calloc(maxNrOfEvents > 0 ? maxNrOfEvents : 1, sizeof(*timeline->events));
+        if (timeline->events == NULL) {
+            free(timeline);
+            return NULL;
+        }
+        timeline->maxNrOfEvents = maxNrOfEvents;
+        clock_gettime(CLOCK_MONOTONIC, &timeline->epoch);
+        celixThreadMutex_create(&timeline->mutex, NULL);
+    }
+    return timeline;
+}
+
+void celix_lifecycleTimeline_destroy(celix_lifecycle_timeline_t *timeline) {
+    if (timeline != NULL) {
+        for (size_t i = 0; i < timeline->nrOfEvents; ++i) {
+            free(timeline->events[i].subject);
+        }
+        free(timeline->events);
+        celixThreadMutex_destroy(&timeline->mutex);
+        free(timeline);
+    }
+}
+
+void celix_lifecycleTimeline_record(celix_lifecycle_timeline_t *timeline, long bndId, const char *subject, const char *phase, bool component, const struct timespec *begin) {
+    if (timeline == NULL) {
+        return;
+    }
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    char *copy = celix_utils_strdup(subject == NULL ? "" : subject);
+
+    celixThreadMutex_lock(&timeline->mutex);
+    if (timeline->nrOfEvents < timeline->maxNrOfEvents) {
+        celix_lifecycle_event_t *event = &timeline->events[timeline->nrOfEvents++];
+        event->bndId = bndId;
+        event->subject = copy;
+        event->phase = phase;
+        event->component = component;
+        event->begin = *begin;
+        event->end = end;
+        copy = NULL;
+    } else {
+        timeline->nrOfDroppedEvents += 1;
+    }
+    celixThreadMutex_unlock(&timeline->mutex);
+
+    free(copy);
+}
+
+static int celix_lifecycleTimeline_compareEvents(const void *a, const void *b) {
+    const celix_lifecycle_event_t *e1 = a;
+    const celix_lifecycle_event_t *e2 = b;
+    double diff = celix_difftime(&e2->begin, &e1->begin);
+    if (diff < 0) {
+        return -1;
+    } else if (diff > 0) {
+        return 1;
+    }
+    //same begin, outer (longer) phase first
+    diff = celix_difftime(&e1->end, &e2->end);
+    return diff < 0 ? -1 : (diff > 0 ? 1 : 0);
+}
+
+/**
+ * Returns a copy of the events sorted on begin time. Subjects are not copied, so the copy is only valid while the
+ * timeline is not destroyed.
+ */
+static celix_lifecycle_event_t* celix_lifecycleTimeline_sortedEvents(celix_lifecycle_timeline_t *timeline, size_t *size, size_t *dropped) {
+    celixThreadMutex_lock(&timeline->mutex);
+    *size = timeline->nrOfEvents;
+    *dropped = timeline->nrOfDroppedEvents;
+    celix_lifecycle_event_t *events = malloc((*size > 0 ? *size : 1) * sizeof(*events));
+    if (events != NULL) {
+        memcpy(events, timeline->events, *size * sizeof(*events));
+    }
+    celixThreadMutex_unlock(&timeline->mutex);
+    if (events != NULL) {
+        qsort(events, *size, sizeof(*events), celix_lifecycleTimeline_compareEvents);
+    }
+    return events;
+}
+
+void celix_lifecycleTimeline_print(celix_lifecycle_timeline_t *timeline, FILE *stream) {
+    size_t size = 0;
+    size_t dropped = 0;
+    celix_lifecycle_event_t *events = celix_lifecycleTimeline_sortedEvents(timeline, &size, &dropped);
+    if (events == NULL) {
+        return;
+    }
+    fprintf(stream, "%12s %12s %6s %-10s %-16s %s\n", "Begin (ms)", "Took (ms)", "Bundle", "Type", "Phase", "Name");
+    for (size_t i = 0; i < size; ++i) {
+        celix_lifecycle_event_t *event = &events[i];
+        fprintf(stream, "%12.3f %12.3f %6li %-10s %-16s %s\n",
+                celix_difftime(&timeline->epoch, &event->begin) * 1000.0,
+                celix_difftime(&event->begin, &event->end) * 1000.0,
+                event->bndId,
+                event->component ? "component" : "bundle",
+                event->phase,
+                event->subject);
+    }
+    if (dropped > 0) {
+        fprintf(stream, "Note: %zu events dropped, the timeline is full.\n", dropped);
+    }
+    free(events);
+}
+
+static void celix_lifecycleTimeline_writeJsonString(FILE *stream, const char *str) {
+    fputc('"', stream);
+    for (const char *c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(stream, "\\%c", *c);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(stream, "\\u%04x", (unsigned int)(unsigned char)*c);
+        } else {
+            fputc(*c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+celix_status_t celix_lifecycleTimeline_writeTraceEvents(celix_lifecycle_timeline_t *timeline, FILE *stream) {
+    size_t size = 0;
+    size_t dropped = 0;
+    celix_lifecycle_event_t *events = celix_lifecycleTimeline_sortedEvents(timeline, &size, &dropped);
+    if (events == NULL) {
+        return CELIX_ENOMEM;
+    }
+    long pid = (long)getpid();
+
+    fprintf(stream, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+
+    //name every bundle "thread" after the first bundle phase of that bundle
+    celix_long_hash_map_t *named = celix_longHashMap_create();
+    for (size_t i = 0; i < size; ++i) {
+        celix_lifecycle_event_t *event = &events[i];
+        if (!event->component && !celix_longHashMap_hasKey(named, event->bndId)) {
+            celix_longHashMap_putLong(named, event->bndId, 1);
+            fprintf(stream, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%li,\"tid\":%li,\"args\":{\"name\":", first ? "" : ",", pid, event->bndId);
+            celix_lifecycleTimeline_writeJsonString(stream, event->subject);
+            fprintf(stream, "}}");
+            first = false;
+        }
+    }
+    celix_longHashMap_destroy(named);
+
+    for (size_t i = 0; i < size; ++i) {
+        celix_lifecycle_event_t *event = &events[i];
+        fprintf(stream, "%s\n{\"name\":", first ? "" : ",");
+        if (event->component) {
+            char *name = NULL;
+            asprintf(&name, "%s %s", event->subject, event->phase);
+            celix_lifecycleTimeline_writeJsonString(stream, name == NULL ? event->phase : name);
+            free(name);
+        } else {
+            celix_lifecycleTimeline_writeJsonString(stream, event->phase);
+        }
+        fprintf(stream, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%li,\"tid\":%li,\"args\":{\"bundleId\":%li,\"subject\":",
+                event->component ? "component" : "bundle",
+                celix_difftime(&timeline->epoch, &event->begin) * 1000000.0,
+                celix_difftime(&event->begin, &event->end) * 1000000.0,
+                pid, event->bndId, event->bndId);
+        celix_lifecycleTimeline_writeJsonString(stream, event->subject);
+        fprintf(stream, "}}");
+        first = false;
+    }
+    fprintf(stream, "\n],\"otherData\":{\"droppedEvents\":%zu}}\n", dropped);
+
+    free(events);
+    return ferror(stream) ? CELIX_FILE_IO_EXCEPTION : CELIX_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_LIFECYCLE_TIMELINE_H
+#define CELIX_CELIX_LIFECYCLE_TIMELINE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "celix_errno.h"
+
+/**
+ * A bounded, thread safe record of bundle and component lifecycle phases (install, extract, resolve, start, ...)
+ * with monotonic begin and end timestamps. Used to diagnose where (startup) time goes.
+ */
+typedef struct celix_lifecycle_timeline celix_lifecycle_timeline_t;
+
+/**
+ * Creates a timeline which records at most maxNrOfEvents events; later events are dropped (and counted).
+ */
+celix_lifecycle_timeline_t* celix_lifecycleTimeline_create(size_t maxNrOfEvents);
+
+void celix_lifecycleTimeline_destroy(celix_lifecycle_timeline_t *timeline);
+
+/**
+ * Records a lifecycle phase.
+ * @param bndId The bundle id of the bundle the phase belongs to.
+ * @param subject The bundle (symbolic name or location) or component name. Will be copied.
+ * @param phase The phase name. Must be a static string.
+ * @param component Whether this is a component (true) or bundle (false) phase.
+ * @param begin The (CLOCK_MONOTONIC) begin time of the phase. The end time is the current time.
+ */
+void celix_lifecycleTimeline_record(celix_lifecycle_timeline_t *timeline, long bndId, const char *subject, const char *phase, bool component, const struct timespec *begin);
+
+/**
+ * Prints the recorded events, ordered on begin time, as a human readable table.
+ */
+void celix_lifecycleTimeline_print(celix_lifecycle_timeline_t *timeline, FILE *stream);
+
+/**
+ * Writes the recorded events as Chrome trace event JSON (chrome://tracing, Perfetto).
+ * Every bundle is presented as a separate thread (tid is the bundle id).
+ */
+celix_status_t celix_lifecycleTimeline_writeTraceEvents(celix_lifecycle_timeline_t *timeline, FILE *stream);
+
+#endif //CELIX_CELIX_LIFECYCLE_TIMELINE_H
@@ -19,13 +19,19 @@
 
 
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <uuid/uuid.h>
+#include <time.h>
 
 #include "celix_constants.h"
 #include "filter.h"
 #include "dm_component_impl.h"
+#include "bundle_context_private.h"
+#include "framework_private.h"
+#include "celix_bundle.h"
+#include "dm_executor_pool.h"
 
 
 typedef struct dm_executor_struct * dm_executor_pt;
@@ -54,6 +60,17 @@ struct celix_dm_component_struct {
 
     hash_map_pt dependencyEvents; //protected by mutex
 
+    celix_array_list_t *pendingEvents; //dm_handle_event_type_pt entries, not yet handled. protected by mutex
+    celix_array_list_t *handlingEvents; //the batch of events being handled, only used on the executor thread
+    bool deferStateChange; //only used on the executor thread
+    bool stateChangePending; //only used on the executor thread
+
+    //statistics, updated using atomics
+    size_t nrOfDependencyEvents;
+    size_t nrOfEventBatches;
+    size_t nrOfStateEvaluations;
+    size_t nrOfCoalescedStateEvaluations;
+
     dm_executor_pt executor;
 };
 
@@ -64,31 +81,47 @@ typedef struct dm_interface_struct {
     long svcId;
 } dm_interface_t;
 
-struct dm_executor_struct {
-    pthread_t runningThread;
-    bool runningThreadSet;
-    celix_array_list_t *workQueue;
-    pthread_mutex_t mutex;
-};
-
 typedef struct dm_executor_task_struct {
     celix_dm_component_t *component;
     void (*command)(void *command_ptr, void *data);
     void *data;
 } dm_executor_task_t;
 
+#define DM_EXECUTOR_INITIAL_QUEUE_CAPACITY 8
+#define DM_EXECUTOR_MAX_TASKS_PER_POOL_JOB 16
+
+struct dm_executor_struct {
+    pthread_t runningThread;
+    bool runningThreadSet;
+
+    //ring buffer of tasks, stored by value
+    dm_executor_task_t *tasks;
+    size_t capacity;
+    size_t head;
+    size_t size;
+
+    pthread_mutex_t mutex; //protects above and submitted
+    pthread_cond_t idleCond; //broadcast when the executor stops running tasks
+
+    celix_dm_executor_pool_t *pool; //NULL if tasks are run on the calling thread
+    celix_dm_executor_pool_job_t job; //pool job, which runs the queued tasks of this executor
+    bool submitted; //true if the job is submitted to the pool and not yet started
+};
+
 typedef struct dm_handle_event_type_struct {
 	celix_dm_service_dependency_t *dependency;
 	dm_event_pt event;
 	dm_event_pt newEvent;
 } *dm_handle_event_type_pt;
 
-static celix_status_t executor_runTasks(dm_executor_pt executor, pthread_t  currentThread __attribute__((unused)));
+static celix_status_t executor_runTasks(dm_executor_pt executor, bool onPool);
 static celix_status_t executor_execute(dm_executor_pt executor);
 static celix_status_t executor_executeTask(dm_executor_pt executor, celix_dm_component_t *component, void (*command), void *data);
 static celix_status_t executor_schedule(dm_executor_pt executor, celix_dm_component_t *component, void (*command), void *data);
-static celix_status_t executor_create(celix_dm_component_t *component __attribute__((unused)), dm_executor_pt *executor);
+static celix_status_t executor_create(celix_dm_component_t *component, dm_executor_pt *executor);
 static void executor_destroy(dm_executor_pt executor);
+static void executor_waitForIdle(dm_executor_pt executor);
+static void executor_runPendingTasks(dm_executor_pt executor);
 
 static celix_status_t component_invokeRemoveRequiredDependencies(celix_dm_component_t *component);
 static celix_status_t component_invokeRemoveInstanceBoundDependencies(celix_dm_component_t *component);
@@ -115,6 +148,7 @@ static celix_status_t component_startTask(celix_dm_component_t *component, void
 static celix_status_t component_stopTask(celix_dm_component_t *component, void * data __attribute__((unused)));
 static celix_status_t component_removeTask(celix_dm_component_t *component, celix_dm_service_dependency_t *dependency);
 static celix_status_t component_handleEventTask(celix_dm_component_t *component, dm_handle_event_type_pt data);
+static celix_status_t component_handleEventsTask(celix_dm_component_t *component, void *data);
 
 static celix_status_t component_handleAdded(celix_dm_component_t *component, celix_dm_service_dependency_t *dependency, dm_event_pt event);
 static celix_status_t component_handleChanged(celix_dm_component_t *component, celix_dm_service_dependency_t *dependency, dm_event_pt event);
@@ -155,6 +189,8 @@ celix_dm_component_t* celix_dmComponent_create(bundle_context_t *context, const
     component->setCLanguageProperty = false;
 
     component->dependencyEvents = hashMap_create(NULL, NULL, NULL, NULL);
+    component->pendingEvents = celix_arrayList_create();
+    component->handlingEvents = celix_arrayList_create();
 
     component->executor = NULL;
     executor_create(component, &component->executor);
@@ -191,6 +227,7 @@ void celix_dmComponent_destroy(celix_dm_component_t *component) {
 		}
 		arrayList_destroy(component->dm_interfaces);
 
+		executor_waitForIdle(component->executor);
 		executor_destroy(component->executor);
 
 		hash_map_iterator_pt iter = hashMapIterator_create(component->dependencyEvents);
@@ -205,6 +242,18 @@ void celix_dmComponent_destroy(celix_dm_component_t *component) {
 
 		hashMap_destroy(component->dependencyEvents, false, false);
 
+		//note events still pending are never handled and are therefore owned by the component
+		for (int k = 0; k < celix_arrayList_size(component->pendingEvents); ++k) {
+		    dm_handle_event_type_pt data = celix_arrayList_get(component->pendingEvents, k);
+		    event_destroy(&data->event);
+		    if (data->newEvent != NULL) {
+		        event_destroy(&data->newEvent);
+		    }
+		    free(data);
+		}
+		celix_arrayList_destroy(component->pendingEvents);
+		celix_arrayList_destroy(component->handlingEvents);
+
 		arrayList_destroy(component->dependencies);
 		pthread_mutex_destroy(&component->mutex);
 
@@ -470,13 +519,72 @@ celix_status_t celix_private_dmComponent_handleEvent(celix_dm_component_t *compo
 	data->dependency = dependency;
 	data->event = event;
 	data->newEvent = NULL;
+	bool waitForEvent = event->event_type == DM_EVENT_REMOVED || event->event_type == DM_EVENT_SWAPPED;
 
-	status = executor_executeTask(component->executor, component, component_handleEventTask, data);
-//	component_handleEventTask(component, data);
+	__atomic_add_fetch(&component->nrOfDependencyEvents, 1, __ATOMIC_RELAXED);
+
+	//note events are queued per component and only the first pending event schedules a task, so that a burst of
+	//events is handled as one batch.
+	pthread_mutex_lock(&component->mutex);
+	celix_arrayList_add(component->pendingEvents, data);
+	bool schedule = celix_arrayList_size(component->pendingEvents) == 1;
+	pthread_mutex_unlock(&component->mutex);
+
+	if (schedule) {
+	    status = executor_executeTask(component->executor, component, component_handleEventsTask, NULL);
+	}
+
+	//note removed and swapped events are handled before returning, also when the tasks run on the shared worker pool,
+	//so that a component is stopped (or no longer uses the service) before the removed service is ungotten and freed.
+	//A pool worker does not wait for the executor, because the executor can be running on another worker waiting for
+	//this worker. Instead the pending events are handled inline, as is done for the calling thread executor.
+	if (waitForEvent) {
+	    if (component->executor->pool != NULL && celix_dmExecutorPool_isWorker(component->executor->pool)) {
+	        executor_runPendingTasks(component->executor);
+	    } else {
+	        executor_waitForIdle(component->executor);
+	    }
+	}
 
 	return status;
 }
 
+/**
+ * Handles all pending dependency events as one batch.
+ * The state evaluation for added and changed dependencies is deferred till the end of the batch, so that a burst of
+ * new services results in a single state change. Removed and swapped dependencies are still evaluated directly,
+ * so that a component is stopped before a required service is removed.
+ */
+static celix_status_t component_handleEventsTask(celix_dm_component_t *component, void *data __attribute__((unused))) {
+    celix_status_t status = CELIX_SUCCESS;
+
+    pthread_mutex_lock(&component->mutex);
+    celix_array_list_t *events = component->pendingEvents;
+    component->pendingEvents = component->handlingEvents;
+    component->handlingEvents = events;
+    pthread_mutex_unlock(&component->mutex);
+
+    __atomic_add_fetch(&component->nrOfEventBatches, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < celix_arrayList_size(events); ++i) {
+        dm_handle_event_type_pt eventData = celix_arrayList_get(events, i);
+        dm_event_type_e type = eventData->event->event_type;
+        component->deferStateChange = type == DM_EVENT_ADDED || type == DM_EVENT_CHANGED;
+        component_handleEventTask(component, eventData);
+    }
+    component->deferStateChange = false;
+    celix_arrayList_clear(events);
+
+    if (component->stateChangePending) {
+        status = component_handleChange(component);
+    }
+
+    return status;
+}
+
+void celix_private_dmComponent_wait(celix_dm_component_t *component) {
+    executor_waitForIdle(component->executor);
+}
+
 static celix_status_t component_handleEventTask(celix_dm_component_t *component, dm_handle_event_type_pt data) {
 	celix_status_t status = CELIX_SUCCESS;
 
@@ -809,6 +917,16 @@ static celix_status_t component_handleChange(celix_dm_component_t *component) {
     celix_dm_component_state_t oldState;
     celix_dm_component_state_t newState;
 
+    if (component->deferStateChange) {
+        if (component->stateChangePending) {
+            __atomic_add_fetch(&component->nrOfCoalescedStateEvaluations, 1, __ATOMIC_RELAXED);
+        }
+        component->stateChangePending = true;
+        return status;
+    }
+    component->stateChangePending = false;
+    __atomic_add_fetch(&component->nrOfStateEvaluations, 1, __ATOMIC_RELAXED);
+
     bool transition = false;
     do {
         oldState = component->state;
@@ -889,6 +1007,10 @@ static celix_status_t component_calculateNewState(celix_dm_component_t *componen
     return status;
 }
 
+static void component_recordLifecyclePhase(celix_dm_component_t *component, const char *phase, const struct timespec *begin) {
+    celix_framework_recordLifecyclePhase(component->context->framework, celix_bundle_getId(component->context->bundle), component->name, phase, true, begin);
+}
+
 static celix_status_t component_performTransition(celix_dm_component_t *component, celix_dm_component_state_t oldState, celix_dm_component_state_t newState, bool *transition) {
     celix_status_t status = CELIX_SUCCESS;
     //printf("performing transition for %s in thread %i from %i to %i\n", component->name, (int) pthread_self(), oldState, newState);
@@ -902,7 +1024,10 @@ static celix_status_t component_performTransition(celix_dm_component_t *componen
         component_invokeAddRequiredDependencies(component);
         component_invokeAutoConfigDependencies(component);
         if (component->callbackInit) {
+            struct timespec begin;
+            clock_gettime(CLOCK_MONOTONIC, &begin);
         	status = component->callbackInit(component->implementation);
+            component_recordLifecyclePhase(component, "init", &begin);
         }
         *transition = true;
     } else if (oldState == DM_CMP_STATE_INSTANTIATED_AND_WAITING_FOR_REQUIRED && newState == DM_CMP_STATE_TRACKING_OPTIONAL) {
@@ -910,14 +1035,20 @@ static celix_status_t component_performTransition(celix_dm_component_t *componen
         component_invokeAutoConfigInstanceBoundDependencies(component);
 		component_invokeAddOptionalDependencies(component);
         if (component->callbackStart) {
+            struct timespec begin;
+            clock_gettime(CLOCK_MONOTONIC, &begin);
         	status = component->callbackStart(component->implementation);
+            component_recordLifecyclePhase(component, "start", &begin);
         }
         component_registerServices(component);
         *transition = true;
     } else if (oldState == DM_CMP_STATE_TRACKING_OPTIONAL && newState == DM_CMP_STATE_INSTANTIATED_AND_WAITING_FOR_REQUIRED) {
         component_unregisterServices(component);
         if (component->callbackStop) {
+            struct timespec begin;
+            clock_gettime(CLOCK_MONOTONIC, &begin);
         	status = component->callbackStop(component->implementation);
+            component_recordLifecyclePhase(component, "stop", &begin);
         }
 		component_invokeRemoveOptionalDependencies(component);
         component_invokeRemoveInstanceBoundDependencies(component);
@@ -1334,16 +1465,24 @@ celix_bundle_context_t* celix_dmComponent_getBundleContext(celix_dm_component_t
 }
 
 
-static celix_status_t executor_create(celix_dm_component_t *component __attribute__((unused)), dm_executor_pt *executor) {
+static void executor_runPoolJob(celix_dm_executor_pool_job_t *job);
+
+static celix_status_t executor_create(celix_dm_component_t *component, dm_executor_pt *executor) {
     celix_status_t status = CELIX_SUCCESS;
 
-    *executor = malloc(sizeof(**executor));
+    *executor = calloc(1, sizeof(**executor));
     if (!*executor) {
         status = CELIX_ENOMEM;
     } else {
-        (*executor)->workQueue = celix_arrayList_create();
+        (*executor)->tasks = malloc(DM_EXECUTOR_INITIAL_QUEUE_CAPACITY * sizeof(*(*executor)->tasks));
+        (*executor)->capacity = DM_EXECUTOR_INITIAL_QUEUE_CAPACITY;
         pthread_mutex_init(&(*executor)->mutex, NULL);
+        pthread_cond_init(&(*executor)->idleCond, NULL);
         (*executor)->runningThreadSet = false;
+        if (component->context != NULL && component->context->framework != NULL) {
+            (*executor)->pool = component->context->framework->dmExecutorPool;
+        }
+        (*executor)->job.run = executor_runPoolJob;
     }
 
     return status;
@@ -1353,47 +1492,75 @@ static void executor_destroy(dm_executor_pt executor) {
 
 	if (executor) {
 		pthread_mutex_destroy(&executor->mutex);
-		celix_arrayList_destroy(executor->workQueue);
+		pthread_cond_destroy(&executor->idleCond);
+		free(executor->tasks);
 
 		free(executor);
 	}
 }
 
-static celix_status_t executor_schedule(dm_executor_pt executor, celix_dm_component_t *component, void (*command), void *data) {
-    celix_status_t status = CELIX_SUCCESS;
-
-    dm_executor_task_t *task = NULL;
-    task = malloc(sizeof(*task));
-    if (!task) {
-        status = CELIX_ENOMEM;
-    } else {
-        task->component = component;
-        task->command = command;
-        task->data = data;
+/**
+ * Adds a task to the task ring buffer. Should be called with the executor mutex locked.
+ */
+static celix_status_t executor_pushTask(dm_executor_pt executor, celix_dm_component_t *component, void (*command), void *data) {
+    if (executor->size == executor->capacity) {
+        size_t newCapacity = executor->capacity == 0 ? DM_EXECUTOR_INITIAL_QUEUE_CAPACITY : executor->capacity * 2;
+        dm_executor_task_t *newTasks = malloc(newCapacity * sizeof(*newTasks));
+        if (newTasks == NULL) {
+            return CELIX_ENOMEM;
+        }
+        for (size_t i = 0; i < executor->size; ++i) {
+            newTasks[i] = executor->tasks[(executor->head + i) % executor->capacity];
+        }
+        free(executor->tasks);
+        executor->tasks = newTasks;
+        executor->capacity = newCapacity;
+        executor->head = 0;
+    }
+    dm_executor_task_t *task = &executor->tasks[(executor->head + executor->size) % executor->capacity];
+    task->component = component;
+    task->command = command;
+    task->data = data;
+    executor->size += 1;
+    return CELIX_SUCCESS;
+}
 
-        pthread_mutex_lock(&executor->mutex);
-        celix_arrayList_add(executor->workQueue, task);
-        pthread_mutex_unlock(&executor->mutex);
+/**
+ * Removes the first task from the task ring buffer. Should be called with the executor mutex locked.
+ */
+static bool executor_popTask(dm_executor_pt executor, dm_executor_task_t *task) {
+    if (executor->size == 0) {
+        return false;
     }
+    *task = executor->tasks[executor->head];
+    executor->head = (executor->head + 1) % executor->capacity;
+    executor->size -= 1;
+    return true;
+}
 
+static celix_status_t executor_schedule(dm_executor_pt executor, celix_dm_component_t *component, void (*command), void *data) {
+    pthread_mutex_lock(&executor->mutex);
+    celix_status_t status = executor_pushTask(executor, component, command, data);
+    pthread_mutex_unlock(&executor->mutex);
     return status;
 }
 
 static celix_status_t executor_executeTask(dm_executor_pt executor, celix_dm_component_t *component, void (*command), void *data) {
     celix_status_t status = CELIX_SUCCESS;
 
-    // Check thread and executor thread, if the same, execute immediately.
-//    bool execute = false;
-//    pthread_mutex_lock(&executor->mutex);
-//    pthread_t currentThread = pthread_self();
-//    if (pthread_equal(executor->runningThread, currentThread)) {
-//        execute = true;
-//    }
-//    pthread_mutex_unlock(&executor->mutex);
-
-    // For now, just schedule.
-    executor_schedule(executor, component, command, data);
-    executor_execute(executor);
+    if (executor->pool == NULL) {
+        status = executor_schedule(executor, component, command, data);
+        executor_execute(executor);
+    } else {
+        //queue the task and, if the executor is not running or already submitted, let the pool run the tasks.
+        pthread_mutex_lock(&executor->mutex);
+        status = executor_pushTask(executor, component, command, data);
+        if (status == CELIX_SUCCESS && !executor->runningThreadSet && !executor->submitted) {
+            executor->submitted = true;
+            celix_dmExecutorPool_submit(executor->pool, &executor->job);
+        }
+        pthread_mutex_unlock(&executor->mutex);
+    }
 
     return status;
 }
@@ -1411,45 +1578,119 @@ static celix_status_t executor_execute(dm_executor_pt executor) {
     }
     pthread_mutex_unlock(&executor->mutex);
     if (execute) {
-        executor_runTasks(executor, currentThread);
+        executor_runTasks(executor, false);
     }
 
     return status;
 }
 
-static celix_status_t executor_runTasks(dm_executor_pt executor, pthread_t currentThread __attribute__((unused))) {
+/**
+ * Runs the queued tasks. Should be called by the thread which claimed the executor (runningThreadSet).
+ * When running on a pool thread, at most DM_EXECUTOR_MAX_TASKS_PER_POOL_JOB tasks are run before the executor is
+ * resubmitted to the pool, so that a busy component does not starve the other components.
+ */
+static celix_status_t executor_runTasks(dm_executor_pt executor, bool onPool) {
     celix_status_t status = CELIX_SUCCESS;
-//    bool execute = false;
+    int nrOfTasks = 0;
 
-    dm_executor_task_t *entry = NULL;
+    dm_executor_task_t task;
+    while (true) {
+        pthread_mutex_lock(&executor->mutex);
+        if (onPool && executor->size > 0 && nrOfTasks >= DM_EXECUTOR_MAX_TASKS_PER_POOL_JOB) {
+            executor->runningThreadSet = false;
+            executor->submitted = true;
+            celix_dmExecutorPool_submit(executor->pool, &executor->job);
+            pthread_cond_broadcast(&executor->idleCond); //note waiting threads can now run the remaining tasks
+            pthread_mutex_unlock(&executor->mutex);
+            break;
+        }
+        if (!executor_popTask(executor, &task)) {
+            //note clearing the running thread in the same critical section as the empty check, so that a concurrently
+            //scheduled task is always picked up by the thread scheduling it.
+            executor->runningThreadSet = false;
+            pthread_cond_broadcast(&executor->idleCond);
+            pthread_mutex_unlock(&executor->mutex);
+            break;
+        }
+        pthread_mutex_unlock(&executor->mutex);
 
-    pthread_mutex_lock(&executor->mutex);
-    if (celix_arrayList_size(executor->workQueue) > 0) {
-	    entry = celix_arrayList_get(executor->workQueue, 0);
-	    celix_arrayList_removeAt(executor->workQueue, 0);
+        task.command(task.component, task.data);
+        nrOfTasks += 1;
     }
-    pthread_mutex_unlock(&executor->mutex);
 
-    while (entry != NULL) {
-	    entry->command(entry->component, entry->data);
-	    free(entry);
+    return status;
+}
 
-	    pthread_mutex_lock(&executor->mutex);
-	    if (celix_arrayList_size(executor->workQueue) > 0) {
-		    entry = celix_arrayList_get(executor->workQueue, 0);
-		    celix_arrayList_removeAt(executor->workQueue, 0);
-	    } else {
-		    entry = NULL;
-	    }
-	    pthread_mutex_unlock(&executor->mutex);
-    }
+static void executor_runPoolJob(celix_dm_executor_pool_job_t *job) {
+    dm_executor_pt executor = (dm_executor_pt)((char*)job - offsetof(struct dm_executor_struct, job));
+    pthread_t currentThread = pthread_self();
 
+    pthread_mutex_lock(&executor->mutex);
+    executor->submitted = false;
+    bool execute = false;
+    if (!executor->runningThreadSet) {
+        executor->runningThread = currentThread;
+        executor->runningThreadSet = true;
+        execute = true;
+    }
+    pthread_mutex_unlock(&executor->mutex);
+    if (execute) {
+        executor_runTasks(executor, true);
+    }
+}
 
+/**
+ * Waits until all queued tasks of the executor are run.
+ * If the executor job is still queued in the pool, the tasks are run on the calling thread instead.
+ * Returns immediately if called from a task of the executor itself.
+ */
+static void executor_waitForIdle(dm_executor_pt executor) {
+    if (executor == NULL || executor->pool == NULL) {
+        return; //note without pool, tasks are always run before executor_executeTask returns.
+    }
+    pthread_t currentThread = pthread_self();
     pthread_mutex_lock(&executor->mutex);
-    executor->runningThreadSet = false;
+    if (executor->runningThreadSet && pthread_equal(executor->runningThread, currentThread)) {
+        pthread_mutex_unlock(&executor->mutex);
+        return;
+    }
+    while (executor->runningThreadSet || executor->submitted) {
+        if (executor->submitted && !executor->runningThreadSet && celix_dmExecutorPool_cancel(executor->pool, &executor->job)) {
+            executor->submitted = false;
+            executor->runningThread = currentThread;
+            executor->runningThreadSet = true;
+            pthread_mutex_unlock(&executor->mutex);
+            executor_runTasks(executor, false);
+            pthread_mutex_lock(&executor->mutex);
+        } else {
+            pthread_cond_wait(&executor->idleCond, &executor->mutex);
+        }
+    }
     pthread_mutex_unlock(&executor->mutex);
+}
 
-    return status;
+/**
+ * Runs the queued tasks of the executor on the calling thread, if the executor is not running on another thread.
+ * If the executor job is still queued in the pool, the job is cancelled. If the executor is running on another thread,
+ * the tasks are run by that thread and this returns without waiting (as is done for the calling thread executor).
+ */
+static void executor_runPendingTasks(dm_executor_pt executor) {
+    pthread_mutex_lock(&executor->mutex);
+    bool execute = false;
+    if (!executor->runningThreadSet) {
+        if (executor->submitted && celix_dmExecutorPool_cancel(executor->pool, &executor->job)) {
+            executor->submitted = false;
+        }
+        //note if the job could not be cancelled, it is already taken by a worker and runs nothing when it finds the
+        //executor claimed or without tasks.
+        executor->runningThread = pthread_self();
+        executor->runningThreadSet = true;
+        execute = true;
+    }
+    pthread_mutex_unlock(&executor->mutex);
+    if (execute) {
+        executor_runTasks(executor, false);
+    }
 }
 
 celix_status_t component_getComponentInfo(celix_dm_component_t *component, dm_component_info_pt *out) {
@@ -1472,6 +1713,10 @@ celix_status_t celix_dmComponent_getComponentInfo(celix_dm_component_t *componen
     info->active = false;
     memcpy(info->id, component->id, DM_COMPONENT_MAX_ID_LENGTH);
     memcpy(info->name, component->name, DM_COMPONENT_MAX_NAME_LENGTH);
+    info->nrOfDependencyEvents = __atomic_load_n(&component->nrOfDependencyEvents, __ATOMIC_RELAXED);
+    info->nrOfEventBatches = __atomic_load_n(&component->nrOfEventBatches, __ATOMIC_RELAXED);
+    info->nrOfStateEvaluations = __atomic_load_n(&component->nrOfStateEvaluations, __ATOMIC_RELAXED);
+    info->nrOfCoalescedStateEvaluations = __atomic_load_n(&component->nrOfCoalescedStateEvaluations, __ATOMIC_RELAXED);
 
     switch (component->state) {
         case DM_CMP_STATE_INACTIVE :
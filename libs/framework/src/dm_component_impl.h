@@ -41,6 +41,11 @@ celix_status_t celix_private_dmComponent_stop(celix_dm_component_t *component);
 
 celix_status_t celix_private_dmComponent_handleEvent(celix_dm_component_t *component, celix_dm_service_dependency_t *dependency, dm_event_pt event);
 
+/**
+ * Waits until the queued tasks of the component are handled.
+ */
+void celix_private_dmComponent_wait(celix_dm_component_t *component);
+
 #ifdef __cplusplus
 }
 #endif
@@ -116,6 +116,22 @@ celix_status_t celix_dependencyManager_removeAllComponents(celix_dependency_mana
 }
 
 
+void celix_dependencyManager_wait(celix_dependency_manager_t *manager) {
+    celix_array_list_t *cmps = celix_arrayList_create();
+    celixThreadMutex_lock(&manager->mutex);
+    for (int i = 0; i < celix_arrayList_size(manager->components); ++i) {
+        celix_arrayList_add(cmps, celix_arrayList_get(manager->components, i));
+    }
+    celixThreadMutex_unlock(&manager->mutex);
+
+    //note waiting outside the manager lock, component tasks can use the dependency manager
+    for (int i = 0; i < celix_arrayList_size(cmps); ++i) {
+        celix_private_dmComponent_wait(celix_arrayList_get(cmps, i));
+    }
+    celix_arrayList_destroy(cmps);
+}
+
+
 static void celix_dm_getInfoCallback(void *handle, const celix_bundle_t *bnd) {
 	celix_dependency_manager_info_t **out = handle;
 
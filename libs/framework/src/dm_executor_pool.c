@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+
+#include "celix_threads.h"
+#include "dm_executor_pool.h"
+
+struct celix_dm_executor_pool {
+    int nrOfThreads;
+    celix_thread_t *threads;
+
+    celix_thread_mutex_t mutex; //protects below and the job next/queued fields
+    celix_thread_cond_t cond;
+    bool active;
+    celix_dm_executor_pool_job_t *first;
+    celix_dm_executor_pool_job_t *last;
+};
+
+static void* celix_dmExecutorPool_worker(void *data) {
+    celix_dm_executor_pool_t *pool = data;
+    celixThreadMutex_lock(&pool->mutex);
+    while (true) {
+        while (pool->first == NULL && pool->active) {
+            celixThreadCondition_wait(&pool->cond, &pool->mutex);
+        }
+        celix_dm_executor_pool_job_t *job = pool->first;
+        if (job == NULL) {
+            break; //not active and no jobs left
+        }
+        pool->first = job->next;
+        if (pool->first == NULL) {
+            pool->last = NULL;
+        }
+        job->next = NULL;
+        job->queued = false;
+        celixThreadMutex_unlock(&pool->mutex);
+
+        job->run(job); //note job can be reused or destroyed after this
+
+        celixThreadMutex_lock(&pool->mutex);
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+celix_dm_executor_pool_t* celix_dmExecutorPool_create(int nrOfThreads) {
+    celix_dm_executor_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL || nrOfThreads <= 0) {
+        free(pool);
+        return NULL;
+    }
+    pool->threads = calloc(nrOfThreads, sizeof(*pool->threads));
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
+    celixThreadMutex_create(&pool->mutex, NULL);
+    celixThreadCondition_init(&pool->cond, NULL);
+    pool->active = true;
+    for (int i = 0; i < nrOfThreads; ++i) {
+        if (celixThread_create(&pool->threads[i], NULL, celix_dmExecutorPool_worker, pool) != CELIX_SUCCESS) {
+            break;
+        }
+        celixThread_setName(&pool->threads[i], "CelixDmExecutor");
+        pool->nrOfThreads += 1;
+    }
+    if (pool->nrOfThreads == 0) {
+        celix_dmExecutorPool_destroy(pool);
+        pool = NULL;
+    }
+    return pool;
+}
+
+void celix_dmExecutorPool_destroy(celix_dm_executor_pool_t *pool) {
+    if (pool != NULL) {
+        celixThreadMutex_lock(&pool->mutex);
+        pool->active = false;
+        celixThreadCondition_broadcast(&pool->cond);
+        celixThreadMutex_unlock(&pool->mutex);
+        for (int i = 0; i < pool->nrOfThreads; ++i) {
+            celixThread_join(pool->threads[i], NULL);
+        }
+        celixThreadMutex_destroy(&pool->mutex);
+        celixThreadCondition_destroy(&pool->cond);
+        free(pool->threads);
+        free(pool);
+    }
+}
+
+void celix_dmExecutorPool_submit(celix_dm_executor_pool_t *pool, celix_dm_executor_pool_job_t *job) {
+    celixThreadMutex_lock(&pool->mutex);
+    job->next = NULL;
+    job->queued = true;
+    if (pool->last == NULL) {
+        pool->first = job;
+    } else {
+        pool->last->next = job;
+    }
+    pool->last = job;
+    celixThreadCondition_signal(&pool->cond);
+    celixThreadMutex_unlock(&pool->mutex);
+}
+
+bool celix_dmExecutorPool_cancel(celix_dm_executor_pool_t *pool, celix_dm_executor_pool_job_t *job) {
+    bool cancelled = false;
+    celixThreadMutex_lock(&pool->mutex);
+    if (job->queued) {
+        celix_dm_executor_pool_job_t *prev = NULL;
+        for (celix_dm_executor_pool_job_t *cur = pool->first; cur != NULL; prev = cur, cur = cur->next) {
+            if (cur == job) {
+                if (prev == NULL) {
+                    pool->first = cur->next;
+                } else {
+                    prev->next = cur->next;
+                }
+                if (pool->last == cur) {
+                    pool->last = prev;
+                }
+                job->next = NULL;
+                job->queued = false;
+                cancelled = true;
+                break;
+            }
+        }
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+    return cancelled;
+}
+
+bool celix_dmExecutorPool_isWorker(celix_dm_executor_pool_t *pool) {
+    celix_thread_t self = celixThread_self();
+    for (int i = 0; i < pool->nrOfThreads; ++i) { //note the threads are not changed after the pool is created
+        if (celixThread_equals(pool->threads[i], self)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_DM_EXECUTOR_POOL_H
+#define CELIX_DM_EXECUTOR_POOL_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A bounded pool of worker threads, shared by the dependency manager component executors
+ * (see CELIX_DM_COMPONENT_EXECUTOR_THREADS).
+ * Jobs are run in FIFO order. A job which is not yet taken by a worker can be cancelled, so that a thread waiting for
+ * a component executor can run the component tasks itself instead of waiting for a (possible busy) worker.
+ */
+typedef struct celix_dm_executor_pool celix_dm_executor_pool_t;
+
+typedef struct celix_dm_executor_pool_job {
+    void (*run)(struct celix_dm_executor_pool_job *job);
+
+    //private, protected by the pool mutex
+    struct celix_dm_executor_pool_job *next;
+    bool queued;
+} celix_dm_executor_pool_job_t;
+
+celix_dm_executor_pool_t* celix_dmExecutorPool_create(int nrOfThreads);
+
+/**
+ * Runs the remaining jobs, stops the workers and destroys the pool.
+ */
+void celix_dmExecutorPool_destroy(celix_dm_executor_pool_t *pool);
+
+/**
+ * Queues a job. The job should not already be queued and should stay valid until it is run or cancelled.
+ */
+void celix_dmExecutorPool_submit(celix_dm_executor_pool_t *pool, celix_dm_executor_pool_job_t *job);
+
+/**
+ * Removes a queued job from the pool.
+ * @return true if the job was removed, false if the job is not queued (anymore), i.e. it is already taken by a worker.
+ */
+bool celix_dmExecutorPool_cancel(celix_dm_executor_pool_t *pool, celix_dm_executor_pool_job_t *job);
+
+/**
+ * Returns whether the calling thread is a worker of the pool.
+ * A worker should not wait for other jobs of the pool, because these jobs can be waiting for the worker.
+ */
+bool celix_dmExecutorPool_isWorker(celix_dm_executor_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_DM_EXECUTOR_POOL_H
@@ -30,16 +30,20 @@
 #include "framework_private.h"
 #include "celix_constants.h"
 #include "resolver.h"
+#include "requirement.h"
+#include "capability.h"
 #include "utils.h"
 #include "linked_list_iterator.h"
 #include "service_reference_private.h"
 #include "service_registration_private.h"
+#include "bundle_revision_private.h"
 #include "bundle_private.h"
 #include "celix_bundle_context.h"
 #include "bundle_context_private.h"
 #include "service_tracker.h"
 #include "celix_library_loader.h"
 #include "celix_log_constants.h"
+#include "archive.h"
 
 typedef celix_status_t (*create_function_fp)(bundle_context_t *context, void **userData);
 typedef celix_status_t (*start_function_fp)(void *userData, bundle_context_t *context);
@@ -117,33 +121,42 @@ static inline void fw_bundleEntry_decreaseUseCount(celix_framework_bundle_entry_
 }
 
 static inline celix_framework_bundle_entry_t* fw_bundleEntry_getBundleEntryAndIncreaseUseCount(celix_framework_t *fw, long bndId) {
-    celix_framework_bundle_entry_t* found = NULL;
-    celixThreadMutex_lock(&fw->installedBundles.mutex);
-    for (int i = 0; i < celix_arrayList_size(fw->installedBundles.entries); ++i) {
-        celix_framework_bundle_entry_t *entry = celix_arrayList_get(fw->installedBundles.entries, i);
-        if (entry->bndId == bndId) {
-            fw_bundleEntry_increaseUseCount(entry);
-            found = entry;
-            break;
-        }
+    //note the read lock only prevents the removal of the entry, concurrent lookups do not block each other
+    celixThreadRwlock_readLock(&fw->installedBundles.lock);
+    celix_framework_bundle_entry_t* found = celix_longHashMap_get(fw->installedBundles.entriesById, bndId);
+    if (found != NULL) {
+        fw_bundleEntry_increaseUseCount(found);
     }
-    celixThreadMutex_unlock(&fw->installedBundles.mutex);
+    celixThreadRwlock_unlock(&fw->installedBundles.lock);
     return found;
 }
 
-static inline celix_framework_bundle_entry_t* fw_bundleEntry_removeBundleEntryAndIncreaseUseCount(celix_framework_t *fw, long bndId) {
-    celix_framework_bundle_entry_t* found = NULL;
-    celixThreadMutex_lock(&fw->installedBundles.mutex);
-    for (int i = 0; i < celix_arrayList_size(fw->installedBundles.entries); ++i) {
-        celix_framework_bundle_entry_t *entry = celix_arrayList_get(fw->installedBundles.entries, i);
-        if (entry->bndId == bndId) {
-            found = entry;
-            fw_bundleEntry_increaseUseCount(entry);
-            celix_arrayList_removeAt(fw->installedBundles.entries, i);
-            break;
-        }
+static inline void fw_bundleEntry_addBundleEntry(celix_framework_t *fw, celix_framework_bundle_entry_t *entry) {
+    const char *location = NULL;
+    bundle_getBundleLocation(entry->bnd, &location);
+    celixThreadRwlock_writeLock(&fw->installedBundles.lock);
+    celix_arrayList_add(fw->installedBundles.entries, entry);
+    celix_longHashMap_put(fw->installedBundles.entriesById, entry->bndId, entry);
+    if (location != NULL) {
+        celix_stringHashMap_put(fw->installedBundles.entriesByLocation, location, entry);
     }
-    celixThreadMutex_unlock(&fw->installedBundles.mutex);
+    celixThreadRwlock_unlock(&fw->installedBundles.lock);
+}
+
+static inline celix_framework_bundle_entry_t* fw_bundleEntry_removeBundleEntryAndIncreaseUseCount(celix_framework_t *fw, long bndId) {
+    celixThreadRwlock_writeLock(&fw->installedBundles.lock);
+    celix_framework_bundle_entry_t* found = celix_longHashMap_get(fw->installedBundles.entriesById, bndId);
+    if (found != NULL) {
+        fw_bundleEntry_increaseUseCount(found);
+        celix_longHashMap_remove(fw->installedBundles.entriesById, bndId);
+        const char *location = NULL;
+        bundle_getBundleLocation(found->bnd, &location);
+        if (location != NULL && celix_stringHashMap_get(fw->installedBundles.entriesByLocation, location) == found) {
+            celix_stringHashMap_remove(fw->installedBundles.entriesByLocation, location);
+        }
+        celix_arrayList_remove(fw->installedBundles.entries, found);
+    }
+    celixThreadRwlock_unlock(&fw->installedBundles.lock);
     return found;
 }
 
@@ -162,6 +175,8 @@ celix_status_t fw_populateDependentGraph(framework_pt framework, bundle_pt expor
 celix_status_t fw_fireBundleEvent(framework_pt framework, bundle_event_type_e, celix_framework_bundle_entry_t* entry);
 celix_status_t fw_fireFrameworkEvent(framework_pt framework, framework_event_type_e eventType, celix_status_t errorCode);
 static void *fw_eventDispatcher(void *fw);
+static void *fw_listenerWorker(void *data);
+static void fw_stopListenerWorkers(celix_framework_t *framework);
 
 celix_status_t fw_invokeBundleListener(framework_pt framework, bundle_listener_pt listener, bundle_event_pt event, bundle_pt bundle);
 celix_status_t fw_invokeFrameworkListener(framework_pt framework, framework_listener_pt listener, framework_event_pt event, bundle_pt bundle);
@@ -177,6 +192,7 @@ static celix_status_t frameworkActivator_destroy(void * userData, bundle_context
 static void framework_autoStartConfiguredBundles(bundle_context_t *fwCtx);
 static void framework_autoInstallConfiguredBundlesForList(bundle_context_t *fwCtx, const char *autoStart, celix_array_list_t *installedBundles);
 static void framework_autoStartConfiguredBundlesForList(bundle_context_t *fwCtx, const celix_array_list_t *installedBundles);
+static void framework_autoStartConfiguredBundlesParallel(bundle_context_t *fwCtx, int level, const char *autoStart, int nrOfThreads);
 
 struct fw_refreshHelper {
     framework_pt framework;
@@ -188,6 +204,13 @@ celix_status_t fw_refreshHelper_refreshOrRemove(struct fw_refreshHelper * refres
 celix_status_t fw_refreshHelper_restart(struct fw_refreshHelper * refreshHelper);
 celix_status_t fw_refreshHelper_stop(struct fw_refreshHelper * refreshHelper);
 
+typedef struct fw_bundle_listener_event {
+    celix_framework_bundle_entry_t *bndEntry;
+    int eventType;
+    struct timespec firedTime;
+    struct fw_bundle_listener_event *next;
+} fw_bundle_listener_event_t;
+
 struct fw_bundleListener {
 	bundle_pt bundle;
 	bundle_listener_pt listener;
@@ -195,6 +218,16 @@ struct fw_bundleListener {
     celix_thread_mutex_t useMutex; //protects useCount
     celix_thread_cond_t useCond;
     size_t useCount;
+
+    //below is protected by the framework listenerWorkers mutex
+    fw_bundle_listener_event_t *firstEvent; //ordered queue of events, only used with event dispatcher threads
+    fw_bundle_listener_event_t *lastEvent;
+    size_t queueDepth;
+    bool scheduled; //true if the listener is in the ready queue or handled by a worker
+    struct fw_bundleListener *nextReady;
+    size_t nrOfDeliveredEvents;
+    double totalLatency;
+    double maxLatency;
 };
 
 typedef struct fw_bundleListener * fw_bundle_listener_pt;
@@ -215,7 +248,7 @@ static inline void fw_bundleListener_destroy(fw_bundle_listener_pt listener, boo
 }
 
 static inline void fw_bundleListener_increaseUseCount(fw_bundle_listener_pt listener) {
-    //pre condition mutex is taken on  fw->installedBundles.mutex
+    //pre condition mutex is taken on  fw->installedBundles.lock
     assert(listener != NULL);
     celixThreadMutex_lock(&listener->useMutex);
     ++listener->useCount;
@@ -223,7 +256,7 @@ static inline void fw_bundleListener_increaseUseCount(fw_bundle_listener_pt list
 }
 
 static inline void fw_bundleListener_decreaseUseCount(fw_bundle_listener_pt listener) {
-    //pre condition mutex is taken on  fw->installedBundles.mutex
+    //pre condition mutex is taken on  fw->installedBundles.lock
     celixThreadMutex_lock(&listener->useMutex);
     assert(listener->useCount > 0);
     --listener->useCount;
@@ -255,10 +288,20 @@ struct request {
 
 	char *filter;
 	celix_framework_bundle_entry_t* bndEntry;
+
+	struct timespec firedTime;
+
+	service_registration_t **registrations; //for EVENT_TYPE_SERVICE, registrations (retained) for which the REGISTERED events are delivered
+	size_t nrOfRegistrations;
+
+	struct request *next; //next request in the dispatcher queue or free list
 };
 
 typedef struct request request_t;
 
+//nr of request nodes kept in the dispatcher free list, more concurrent events fall back to malloc/free.
+#define CELIX_FRAMEWORK_NR_OF_PREALLOCATED_REQUESTS 64
+
 
 celix_status_t framework_create(framework_pt *framework, properties_pt config) {
     celix_status_t status = CELIX_SUCCESS;
@@ -274,8 +317,13 @@ celix_status_t framework_create(framework_pt *framework, properties_pt config) {
         status = CELIX_DO_IF(status, celixThreadMutex_create(&(*framework)->dispatcher.mutex, NULL));
         status = CELIX_DO_IF(status, celixThreadMutex_create(&(*framework)->frameworkListenersLock, &attr));
         status = CELIX_DO_IF(status, celixThreadMutex_create(&(*framework)->bundleListenerLock, NULL));
-        status = CELIX_DO_IF(status, celixThreadMutex_create(&(*framework)->installedBundles.mutex, NULL));
+        status = CELIX_DO_IF(status, celixThreadRwlock_create(&(*framework)->installedBundles.lock, NULL));
+        status = CELIX_DO_IF(status, celixThreadMutex_create(&(*framework)->resolveLock, NULL));
         status = CELIX_DO_IF(status, celixThreadCondition_init(&(*framework)->dispatcher.cond, NULL));
+        status = CELIX_DO_IF(status, celixThreadCondition_init(&(*framework)->dispatcher.handledCond, NULL));
+        status = CELIX_DO_IF(status, celixThreadMutex_create(&(*framework)->listenerWorkers.mutex, NULL));
+        status = CELIX_DO_IF(status, celixThreadCondition_init(&(*framework)->listenerWorkers.cond, NULL));
+        status = CELIX_DO_IF(status, celixThreadCondition_init(&(*framework)->listenerWorkers.idleCond, NULL));
         if (status == CELIX_SUCCESS) {
             (*framework)->bundle = NULL;
             (*framework)->registry = NULL;
@@ -286,10 +334,23 @@ celix_status_t framework_create(framework_pt *framework, properties_pt config) {
             (*framework)->cache = NULL;
             (*framework)->installRequestMap = hashMap_create(utils_stringHash, utils_stringHash, utils_stringEquals, utils_stringEquals);
             (*framework)->installedBundles.entries = celix_arrayList_create();
+            (*framework)->installedBundles.entriesById = celix_longHashMap_create();
+            (*framework)->installedBundles.entriesByLocation = celix_stringHashMap_create();
             (*framework)->bundleListeners = NULL;
             (*framework)->frameworkListeners = NULL;
-            (*framework)->dispatcher.requests = NULL;
-            (*framework)->dispatcher.nrOfLocalRequest = 0;
+            (*framework)->dispatcher.firstRequest = NULL;
+            (*framework)->dispatcher.lastRequest = NULL;
+            (*framework)->dispatcher.freeRequests = NULL;
+            (*framework)->dispatcher.nrOfFreeRequests = 0;
+            (*framework)->dispatcher.queuedSeq = 0;
+            (*framework)->dispatcher.handledSeq = 0;
+            (*framework)->listenerWorkers.nrOfThreads = 0;
+            (*framework)->listenerWorkers.threads = NULL;
+            (*framework)->listenerWorkers.active = true;
+            (*framework)->listenerWorkers.firstReady = NULL;
+            (*framework)->listenerWorkers.lastReady = NULL;
+            (*framework)->listenerWorkers.nrOfQueuedEvents = 0;
+            (*framework)->dmExecutorPool = NULL;
             (*framework)->configurationMap = config;
 
             const char* logStr = getenv(CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL_CONFIG_NAME);
@@ -298,6 +359,9 @@ celix_status_t framework_create(framework_pt *framework, properties_pt config) {
             }
             (*framework)->logger = celix_frameworkLogger_create(celix_logUtils_logLevelFromString(logStr, CELIX_LOG_LEVEL_INFO));
 
+            long maxNrOfEvents = celix_properties_getAsLong(config, CELIX_FRAMEWORK_LIFECYCLE_TIMELINE_MAX_EVENTS, 4096);
+            (*framework)->timeline = maxNrOfEvents > 0 ? celix_lifecycleTimeline_create((size_t)maxNrOfEvents) : NULL;
+
             status = CELIX_DO_IF(status, bundle_create(&(*framework)->bundle));
             status = CELIX_DO_IF(status, bundle_getBundleId((*framework)->bundle, &(*framework)->bundleId));
             status = CELIX_DO_IF(status, bundle_setFramework((*framework)->bundle, (*framework)));
@@ -330,7 +394,7 @@ celix_status_t framework_destroy(framework_pt framework) {
 
     serviceRegistry_destroy(framework->registry);
 
-    celixThreadMutex_lock(&framework->installedBundles.mutex);
+    celixThreadRwlock_writeLock(&framework->installedBundles.lock);
     for (int i = 0; i < celix_arrayList_size(framework->installedBundles.entries); ++i) {
         celix_framework_bundle_entry_t *entry = celix_arrayList_get(framework->installedBundles.entries, i);
         celixThreadMutex_lock(&entry->useMutex);
@@ -341,9 +405,9 @@ celix_status_t framework_destroy(framework_pt framework) {
             const char *bndName = celix_bundle_getSymbolicName(bnd);
             fw_log(framework->logger, CELIX_LOG_LEVEL_FATAL, "Cannot destroy framework. The use count of bundle %s (bnd id %li) is not 0, but %u.", bndName, entry->bndId, count);
             celixThreadMutex_lock(&framework->dispatcher.mutex);
-            int nrOfRequests = celix_arrayList_size(framework->dispatcher.requests);
+            long nrOfRequests = framework->dispatcher.queuedSeq - framework->dispatcher.handledSeq;
             celixThreadMutex_unlock(&framework->dispatcher.mutex);
-            fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "nr of request left: %i (should be 0).", nrOfRequests);
+            fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "nr of request left: %li (should be 0).", nrOfRequests);
         }
         fw_bundleEntry_destroy(entry, true);
 
@@ -376,7 +440,12 @@ celix_status_t framework_destroy(framework_pt framework) {
 
     }
     celix_arrayList_destroy(framework->installedBundles.entries);
-    celixThreadMutex_destroy(&framework->installedBundles.mutex);
+    celix_longHashMap_destroy(framework->installedBundles.entriesById);
+    celix_stringHashMap_destroy(framework->installedBundles.entriesByLocation);
+    celixThreadRwlock_unlock(&framework->installedBundles.lock);
+    celixThreadRwlock_destroy(&framework->installedBundles.lock);
+    celixThreadMutex_destroy(&framework->resolveLock);
+    celix_lifecycleTimeline_destroy(framework->timeline);
 
 	hashMap_destroy(framework->installRequestMap, false, false);
 
@@ -387,12 +456,23 @@ celix_status_t framework_destroy(framework_pt framework) {
         arrayList_destroy(framework->frameworkListeners);
     }
 
-    assert(celix_arrayList_size(framework->dispatcher.requests) == 0);
-    celix_arrayList_destroy(framework->dispatcher.requests);
+    assert(framework->dispatcher.firstRequest == NULL);
+    request_t *freeRequest = framework->dispatcher.freeRequests;
+    while (freeRequest != NULL) {
+        request_t *next = freeRequest->next;
+        free(freeRequest);
+        freeRequest = next;
+    }
 
 	bundleCache_destroy(&framework->cache);
 
 	celixThreadCondition_destroy(&framework->dispatcher.cond);
+	celixThreadCondition_destroy(&framework->dispatcher.handledCond);
+	fw_stopListenerWorkers(framework); //note normally already stopped during the framework shutdown
+	celixThreadMutex_destroy(&framework->listenerWorkers.mutex);
+	celixThreadCondition_destroy(&framework->listenerWorkers.cond);
+	celixThreadCondition_destroy(&framework->listenerWorkers.idleCond);
+	celix_dmExecutorPool_destroy(framework->dmExecutorPool);
     celixThreadMutex_destroy(&framework->frameworkListenersLock);
 	celixThreadMutex_destroy(&framework->bundleListenerLock);
 	celixThreadMutex_destroy(&framework->dispatcher.mutex);
@@ -428,8 +508,31 @@ celix_status_t fw_init(framework_pt framework) {
 	celix_status_t status = CELIX_SUCCESS;
 	status = CELIX_DO_IF(status, arrayList_create(&framework->bundleListeners));
 	status = CELIX_DO_IF(status, arrayList_create(&framework->frameworkListeners));
-	status = CELIX_DO_IF(status, arrayList_create(&framework->dispatcher.requests));
+	for (int i = 0; status == CELIX_SUCCESS && i < CELIX_FRAMEWORK_NR_OF_PREALLOCATED_REQUESTS; ++i) {
+	    request_t *request = calloc(1, sizeof(*request));
+	    if (request == NULL) {
+	        status = CELIX_ENOMEM;
+	    } else {
+	        request->next = framework->dispatcher.freeRequests;
+	        framework->dispatcher.freeRequests = request;
+	        framework->dispatcher.nrOfFreeRequests += 1;
+	    }
+	}
 	status = CELIX_DO_IF(status, celixThread_create(&framework->dispatcher.thread, NULL, fw_eventDispatcher, framework));
+	long nrOfListenerWorkers = celix_properties_getAsLong(framework->configurationMap, CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, 0);
+	if (status == CELIX_SUCCESS && nrOfListenerWorkers > 0) {
+	    framework->listenerWorkers.threads = calloc(nrOfListenerWorkers, sizeof(*framework->listenerWorkers.threads));
+	    for (int i = 0; framework->listenerWorkers.threads != NULL && i < nrOfListenerWorkers; ++i) {
+	        if (celixThread_create(&framework->listenerWorkers.threads[i], NULL, fw_listenerWorker, framework) != CELIX_SUCCESS) {
+	            break;
+	        }
+	        framework->listenerWorkers.nrOfThreads += 1;
+	    }
+	}
+	long nrOfDmExecutorThreads = celix_properties_getAsLong(framework->configurationMap, CELIX_DM_COMPONENT_EXECUTOR_THREADS, 0);
+	if (status == CELIX_SUCCESS && nrOfDmExecutorThreads > 0) {
+	    framework->dmExecutorPool = celix_dmExecutorPool_create((int)nrOfDmExecutorThreads);
+	}
 	status = CELIX_DO_IF(status, bundle_getState(framework->bundle, &state));
 	if (status == CELIX_SUCCESS) {
 	    if ((state == OSGI_FRAMEWORK_BUNDLE_INSTALLED) || (state == OSGI_FRAMEWORK_BUNDLE_RESOLVED)) {
@@ -453,9 +556,7 @@ celix_status_t fw_init(framework_pt framework) {
         long bndId = -1L;
         bundle_getBundleId(framework->bundle, &bndId);
         celix_framework_bundle_entry_t *entry = fw_bundleEntry_create(framework->bundle);
-        celixThreadMutex_lock(&framework->installedBundles.mutex);
-        celix_arrayList_add(framework->installedBundles.entries, entry);
-        celixThreadMutex_unlock(&framework->installedBundles.mutex);
+        fw_bundleEntry_addBundleEntry(framework, entry);
     }
     status = CELIX_DO_IF(status, bundle_getCurrentModule(framework->bundle, &module));
     if (status == CELIX_SUCCESS) {
@@ -588,8 +689,26 @@ celix_status_t framework_start(framework_pt framework) {
 static void framework_autoStartConfiguredBundles(bundle_context_t *fwCtx) {
     const char* cosgiKeys[] = {"cosgi.auto.start.0","cosgi.auto.start.1","cosgi.auto.start.2","cosgi.auto.start.3","cosgi.auto.start.4","cosgi.auto.start.5","cosgi.auto.start.6"};
     const char* celixKeys[] = {CELIX_AUTO_START_0, CELIX_AUTO_START_1, CELIX_AUTO_START_2, CELIX_AUTO_START_3, CELIX_AUTO_START_4, CELIX_AUTO_START_5, CELIX_AUTO_START_6};
-    celix_array_list_t *installedBundles = celix_arrayList_create();
     size_t len = 7;
+    bool parallel = celix_bundleContext_getPropertyAsBool(fwCtx, CELIX_AUTO_START_PARALLEL, false);
+    if (parallel) {
+        long nrOfThreads = celix_bundleContext_getPropertyAsLong(fwCtx, CELIX_AUTO_START_PARALLEL_THREADS, sysconf(_SC_NPROCESSORS_ONLN));
+        if (nrOfThreads < 1) {
+            nrOfThreads = 1;
+        }
+        for (int i = 0; i < len; ++i) {
+            const char *autoStart = celix_bundleContext_getProperty(fwCtx, celixKeys[i], NULL);
+            if (autoStart == NULL) {
+                autoStart = celix_bundleContext_getProperty(fwCtx, cosgiKeys[i], NULL);
+            }
+            if (autoStart != NULL) {
+                framework_autoStartConfiguredBundlesParallel(fwCtx, i, autoStart, (int)nrOfThreads);
+            }
+        }
+        return;
+    }
+
+    celix_array_list_t *installedBundles = celix_arrayList_create();
     for (int i = 0; i < len; ++i) {
         const char *autoStart = celix_bundleContext_getProperty(fwCtx, celixKeys[i], NULL);
         if (autoStart == NULL) {
@@ -638,6 +757,219 @@ static void framework_autoStartConfiguredBundlesForList(bundle_context_t *fwCtx,
     }
 }
 
+typedef struct celix_framework_auto_start_entry {
+    const char *location;
+    bundle_t *bnd;
+    celix_status_t installStatus;
+    celix_status_t startStatus;
+    double installTime; //in seconds
+    double startTime; //in seconds
+    int wave;
+} celix_framework_auto_start_entry_t;
+
+typedef struct celix_framework_parallel_job {
+    bundle_context_t *fwCtx;
+    celix_framework_auto_start_entry_t *entries;
+    int *indices; //the indices of the entries to process
+    int size;
+    int next; //atomic, the next indices index to process
+    bool start; //true for starting bundles, false for installing bundles
+} celix_framework_parallel_job_t;
+
+static void* framework_autoStartParallelWorker(void *data) {
+    celix_framework_parallel_job_t *job = data;
+    int idx;
+    while ((idx = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->size) {
+        celix_framework_auto_start_entry_t *entry = &job->entries[job->indices[idx]];
+        struct timespec begin;
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        if (job->start) {
+            entry->startStatus = bundle_startWithOptions(entry->bnd, 0);
+        } else {
+            entry->installStatus = bundleContext_installBundle(job->fwCtx, entry->location, &entry->bnd);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        if (job->start) {
+            entry->startTime = celix_difftime(&begin, &end);
+        } else {
+            entry->installTime = celix_difftime(&begin, &end);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Installs or starts the bundles of the provided entries using (at most) nrOfThreads threads.
+ * The calling thread is one of the worker threads.
+ */
+static void framework_autoStartRunParallel(bundle_context_t *fwCtx, celix_framework_auto_start_entry_t *entries, int *indices, int size, bool start, int nrOfThreads) {
+    celix_framework_parallel_job_t job;
+    job.fwCtx = fwCtx;
+    job.entries = entries;
+    job.indices = indices;
+    job.size = size;
+    job.next = 0;
+    job.start = start;
+
+    int nrOfExtraThreads = (nrOfThreads < size ? nrOfThreads : size) - 1;
+    celix_thread_t threads[nrOfExtraThreads > 0 ? nrOfExtraThreads : 1];
+    int nrOfCreatedThreads = 0;
+    for (int i = 0; i < nrOfExtraThreads; ++i) {
+        if (celixThread_create(&threads[nrOfCreatedThreads], NULL, framework_autoStartParallelWorker, &job) == CELIX_SUCCESS) {
+            nrOfCreatedThreads += 1;
+        }
+    }
+    framework_autoStartParallelWorker(&job);
+    for (int i = 0; i < nrOfCreatedThreads; ++i) {
+        celixThread_join(threads[i], NULL);
+    }
+}
+
+/**
+ * Returns true if one of the requirements of the bundle module of entry is satisfied by a capability of the bundle
+ * module of the other entry.
+ */
+static bool framework_autoStartDependsOn(celix_framework_auto_start_entry_t *entry, celix_framework_auto_start_entry_t *other) {
+    module_pt module = NULL;
+    module_pt otherModule = NULL;
+    bundle_getCurrentModule(entry->bnd, &module);
+    bundle_getCurrentModule(other->bnd, &otherModule);
+    linked_list_pt reqs = module == NULL ? NULL : module_getRequirements(module);
+    linked_list_pt caps = otherModule == NULL ? NULL : module_getCapabilities(otherModule);
+    for (int i = 0; reqs != NULL && caps != NULL && i < linkedList_size(reqs); ++i) {
+        requirement_pt req = linkedList_get(reqs, i);
+        const char *targetName = NULL;
+        requirement_getTargetName(req, &targetName);
+        for (int k = 0; targetName != NULL && k < linkedList_size(caps); ++k) {
+            capability_pt cap = linkedList_get(caps, k);
+            const char *serviceName = NULL;
+            bool satisfied = false;
+            capability_getServiceName(cap, &serviceName);
+            if (serviceName != NULL && strcmp(targetName, serviceName) == 0) {
+                requirement_isSatisfied(req, cap, &satisfied);
+                if (satisfied) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Installs the bundles of a single auto start level concurrently and starts them in waves.
+ * A bundle is started in a wave after the waves of the bundles (in the same level) it depends on, based on the
+ * manifest requirements and capabilities. Bundles in the same wave are started concurrently.
+ */
+static void framework_autoStartConfiguredBundlesParallel(bundle_context_t *fwCtx, int level, const char *autoStartIn, int nrOfThreads) {
+    celix_framework_t *fw = fwCtx->framework;
+    char delims[] = " ";
+    char *savePtr = NULL;
+    char *autoStart = celix_utils_strdup(autoStartIn);
+    if (autoStart == NULL) {
+        return;
+    }
+
+    struct timespec begin;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+
+    int size = 0;
+    int cap = 8;
+    celix_framework_auto_start_entry_t *entries = calloc(cap, sizeof(*entries));
+    if (entries == NULL) {
+        fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, CELIX_ENOMEM, "Could not auto start the bundles of level %i", level);
+        free(autoStart);
+        return;
+    }
+    for (char *location = strtok_r(autoStart, delims, &savePtr); location != NULL; location = strtok_r(NULL, delims, &savePtr)) {
+        bool duplicate = false;
+        for (int i = 0; i < size; ++i) {
+            if (strcmp(entries[i].location, location) == 0) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) {
+            continue;
+        }
+        if (size == cap) {
+            celix_framework_auto_start_entry_t *newEntries = realloc(entries, cap * 2 * sizeof(*entries));
+            if (newEntries == NULL) {
+                //note the already collected bundles are still auto started
+                fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, CELIX_ENOMEM, "Could not auto start bundle '%s' and the remaining bundles of level %i", location, level);
+                break;
+            }
+            entries = newEntries;
+            cap *= 2;
+        }
+        memset(&entries[size], 0, sizeof(entries[size]));
+        entries[size].location = location;
+        size += 1;
+    }
+
+    int indices[size > 0 ? size : 1];
+    for (int i = 0; i < size; ++i) {
+        indices[i] = i;
+    }
+    framework_autoStartRunParallel(fwCtx, entries, indices, size, false, nrOfThreads);
+
+    //assign waves; a bundle is started one wave after the latest bundle it depends on.
+    //The number of iterations is bounded by the number of bundles, so dependency cycles end up in the last wave.
+    int nrOfWaves = 0;
+    for (int i = 0; i < size; ++i) {
+        if (entries[i].installStatus != CELIX_SUCCESS) {
+            fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Could not install bundle '%s'", entries[i].location);
+            entries[i].wave = -1;
+        } else {
+            nrOfWaves = 1;
+        }
+    }
+    bool changed = true;
+    for (int iteration = 0; changed && iteration < size; ++iteration) {
+        changed = false;
+        for (int i = 0; i < size; ++i) {
+            for (int k = 0; entries[i].wave >= 0 && k < size; ++k) {
+                if (k != i && entries[k].wave >= entries[i].wave && framework_autoStartDependsOn(&entries[i], &entries[k])) {
+                    entries[i].wave = entries[k].wave + 1;
+                    nrOfWaves = entries[i].wave + 1 > nrOfWaves ? entries[i].wave + 1 : nrOfWaves;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    for (int wave = 0; wave < nrOfWaves; ++wave) {
+        int waveSize = 0;
+        for (int i = 0; i < size; ++i) {
+            if (entries[i].wave == wave) {
+                indices[waveSize++] = i;
+            }
+        }
+        framework_autoStartRunParallel(fwCtx, entries, indices, waveSize, true, nrOfThreads);
+    }
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    for (int i = 0; i < size; ++i) {
+        if (entries[i].wave < 0) {
+            continue;
+        }
+        long bndId = -1;
+        bundle_getBundleId(entries[i].bnd, &bndId);
+        if (entries[i].startStatus != CELIX_SUCCESS) {
+            fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Could not start bundle %li", bndId);
+        }
+        fw_log(fw->logger, CELIX_LOG_LEVEL_INFO, "Auto start level %i: bundle %li ('%s') installed in %.3f ms and started in %.3f ms (wave %i)",
+               level, bndId, entries[i].location, entries[i].installTime * 1000.0, entries[i].startTime * 1000.0, entries[i].wave);
+    }
+    fw_log(fw->logger, CELIX_LOG_LEVEL_INFO, "Auto start level %i: %i bundle(s) handled in %i wave(s) using %i thread(s) in %.3f ms",
+           level, size, nrOfWaves, nrOfThreads, celix_difftime(&begin, &end) * 1000.0);
+
+    free(entries);
+    free(autoStart);
+}
+
 celix_status_t framework_stop(framework_pt framework) {
 	celix_status_t status = fw_stopBundle(framework, framework->bundleId, true);
 	if (status == CELIX_SUCCESS) {
@@ -720,6 +1052,9 @@ celix_status_t fw_installBundle2(framework_pt framework, bundle_pt * bundle, lon
         return CELIX_FILE_IO_EXCEPTION;
     }
 
+    struct timespec installBegin;
+    clock_gettime(CLOCK_MONOTONIC, &installBegin);
+
     //increase use count of framework bundle to prevent a stop.
     celix_framework_bundle_entry_t *entry = fw_bundleEntry_getBundleEntryAndIncreaseUseCount(framework, framework->bundleId);
 
@@ -742,7 +1077,10 @@ celix_status_t fw_installBundle2(framework_pt framework, bundle_pt * bundle, lon
         if (archive == NULL) {
             id = framework_getNextBundleId(framework);
 
+            struct timespec extractBegin;
+            clock_gettime(CLOCK_MONOTONIC, &extractBegin);
             status = CELIX_DO_IF(status, bundleCache_createArchive(framework->cache, id, location, inputFile, &archive));
+            celix_framework_recordLifecyclePhase(framework, id, location, "extract", false, &extractBegin);
 
             if (status != CELIX_SUCCESS) {
             	bundleArchive_destroy(archive);
@@ -761,11 +1099,10 @@ celix_status_t fw_installBundle2(framework_pt framework, bundle_pt * bundle, lon
             bundle_getBundleId(*bundle, &bndId);
             celix_framework_bundle_entry_t *bEntry = fw_bundleEntry_create(*bundle);
             fw_bundleEntry_increaseUseCount(bEntry);
-            celixThreadMutex_lock(&framework->installedBundles.mutex);
-            celix_arrayList_add(framework->installedBundles.entries, bEntry);
-            celixThreadMutex_unlock(&framework->installedBundles.mutex);
+            fw_bundleEntry_addBundleEntry(framework, bEntry);
             fw_fireBundleEvent(framework, OSGI_FRAMEWORK_BUNDLE_EVENT_INSTALLED, bEntry);
             fw_bundleEntry_decreaseUseCount(bEntry);
+            celix_framework_recordLifecyclePhase(framework, bndId, location, "install", false, &installBegin);
         } else {
             status = CELIX_BUNDLE_EXCEPTION;
             status = CELIX_DO_IF(status, bundleArchive_closeAndDelete(archive));
@@ -853,16 +1190,22 @@ celix_status_t fw_startBundle(framework_pt framework, long bndId, int options __
             case OSGI_FRAMEWORK_BUNDLE_INSTALLED:
                 bundle_getCurrentModule(entry->bnd, &module);
                 module_getSymbolicName(module, &name);
+                celixThreadMutex_lock(&framework->resolveLock);
                 if (!module_isResolved(module)) {
+                    struct timespec resolveBegin;
+                    clock_gettime(CLOCK_MONOTONIC, &resolveBegin);
                     wires = resolver_resolve(module);
+                    celix_framework_recordLifecyclePhase(framework, bndId, name, "resolve", false, &resolveBegin);
                     if (wires == NULL) {
+                        celixThreadMutex_unlock(&framework->resolveLock);
                         fw_bundleEntry_decreaseUseCount(entry);
                         return CELIX_BUNDLE_EXCEPTION;
                     }
                     status = framework_markResolvedModules(framework, wires);
-                    if (status != CELIX_SUCCESS) {
-                        break;
-                    }
+                }
+                celixThreadMutex_unlock(&framework->resolveLock);
+                if (status != CELIX_SUCCESS) {
+                    break;
                 }
                 /* no break */
             case OSGI_FRAMEWORK_BUNDLE_RESOLVED:
@@ -910,7 +1253,10 @@ celix_status_t fw_startBundle(framework_pt framework, long bndId, int options __
 
                         if (status == CELIX_SUCCESS) {
                             if (create != NULL) {
+                                struct timespec createBegin;
+                                clock_gettime(CLOCK_MONOTONIC, &createBegin);
                                 status = CELIX_DO_IF(status, create(context, &userData));
+                                celix_framework_recordLifecyclePhase(framework, bndId, name, "activator create", false, &createBegin);
                                 if (status == CELIX_SUCCESS) {
                                     activator->userData = userData;
                                 }
@@ -918,7 +1264,10 @@ celix_status_t fw_startBundle(framework_pt framework, long bndId, int options __
                         }
                         if (status == CELIX_SUCCESS) {
                             if (start != NULL) {
+                                struct timespec startBegin;
+                                clock_gettime(CLOCK_MONOTONIC, &startBegin);
                                 status = CELIX_DO_IF(status, start(userData, context));
+                                celix_framework_recordLifecyclePhase(framework, bndId, name, "activator start", false, &startBegin);
                             }
                         }
 
@@ -1089,7 +1438,10 @@ celix_status_t fw_stopBundle(framework_pt framework, long bndId, bool record) {
 	        status = CELIX_DO_IF(status, bundle_getContext(entry->bnd, &context));
 	        if (status == CELIX_SUCCESS) {
                 if (activator->stop != NULL) {
+                    struct timespec stopBegin;
+                    clock_gettime(CLOCK_MONOTONIC, &stopBegin);
                     status = CELIX_DO_IF(status, activator->stop(activator->userData, context));
+                    celix_framework_recordLifecyclePhase(framework, bndId, celix_bundle_getSymbolicName(entry->bnd), "activator stop", false, &stopBegin);
                     if (status == CELIX_SUCCESS) {
                         celix_dependency_manager_t *mng = celix_bundleContext_getDependencyManager(context);
                         celix_dependencyManager_removeAllComponents(mng);
@@ -1102,6 +1454,10 @@ celix_status_t fw_stopBundle(framework_pt framework, long bndId, bool record) {
                 }
 	        }
 
+            if (context != NULL) {
+                celix_bundleContext_cleanupUseTrackers(context);
+            }
+
             if (bndId > 0) {
 	            celix_serviceTracker_syncForContext(entry->bnd->context);
                 status = CELIX_DO_IF(status, serviceRegistry_clearServiceRegistrations(framework->registry, entry->bnd));
@@ -1191,7 +1547,7 @@ static celix_status_t fw_uninstallBundleEntry(celix_framework_t *framework, celi
 
         status = CELIX_DO_IF(status, fw_fireBundleEvent(framework, OSGI_FRAMEWORK_BUNDLE_EVENT_UNINSTALLED, entry));
 
-        //NOTE wait outside installedBundles.mutex
+        //NOTE wait outside installedBundles.lock
         fw_bundleEntry_decreaseUseCount(entry);
         fw_bundleEntry_destroy(entry, true); //wait till use count is 0 -> e.g. not used
 
@@ -1522,7 +1878,7 @@ celix_status_t fw_addBundleListener(framework_pt framework, bundle_pt bundle, bu
     bundleListener->useCount = 1;
     celix_array_list_t* installedBundles = celix_arrayList_create();
 
-    celixThreadMutex_lock(&framework->installedBundles.mutex);
+    celixThreadRwlock_readLock(&framework->installedBundles.lock);
     int size = celix_arrayList_size(framework->installedBundles.entries);
     for (int i = 0; i < size; ++i) {
         celix_framework_bundle_entry_t *entry = celix_arrayList_get(framework->installedBundles.entries, i);
@@ -1535,7 +1891,7 @@ celix_status_t fw_addBundleListener(framework_pt framework, bundle_pt bundle, bu
     celixThreadMutex_lock(&framework->bundleListenerLock);
     celix_arrayList_add(framework->bundleListeners, bundleListener);
     celixThreadMutex_unlock(&framework->bundleListenerLock);
-    celixThreadMutex_unlock(&framework->installedBundles.mutex);
+    celixThreadRwlock_unlock(&framework->installedBundles.lock);
 
     //Calling bundle events for already installed bundles.
     for (int i =0 ; i < celix_arrayList_size(installedBundles); ++i) {
@@ -1655,9 +2011,7 @@ celix_status_t fw_removeFrameworkListener(framework_pt framework, bundle_pt bund
 //}
 
 long framework_getNextBundleId(framework_pt framework) {
-    long id = framework->nextBundleId;
-    framework->nextBundleId++;
-    return id;
+    return __atomic_fetch_add(&framework->nextBundleId, 1, __ATOMIC_RELAXED);
 }
 
 celix_status_t framework_markResolvedModules(framework_pt framework, linked_list_pt resolvedModuleWireMap) {
@@ -1757,7 +2111,10 @@ celix_status_t framework_markBundleResolved(framework_pt framework, module_pt mo
             bool isSystemBundle = false;
             bundle_isSystemBundle(bundle, &isSystemBundle);
             if (!isSystemBundle) {
+                struct timespec loadBegin;
+                clock_gettime(CLOCK_MONOTONIC, &loadBegin);
                 status = CELIX_DO_IF(status, framework_loadBundleLibraries(framework, bundle));
+                celix_framework_recordLifecyclePhase(framework, bndId, celix_bundle_getSymbolicName(bundle), "load libraries", false, &loadBegin);
             }
 
             status = CELIX_DO_IF(status, framework_setBundleStateAndNotify(framework, bundle, OSGI_FRAMEWORK_BUNDLE_RESOLVED));
@@ -1789,13 +2146,13 @@ array_list_pt framework_getBundles(framework_pt framework) {
     array_list_pt bundles = NULL;
     arrayList_create(&bundles);
 
-    celixThreadMutex_lock(&framework->installedBundles.mutex);
+    celixThreadRwlock_readLock(&framework->installedBundles.lock);
     int size = celix_arrayList_size(framework->installedBundles.entries);
     for (int i = 0; i < size; ++i) {
         celix_framework_bundle_entry_t *entry = celix_arrayList_get(framework->installedBundles.entries, i);
         celix_arrayList_add(bundles, entry->bnd);
     }
-    celixThreadMutex_unlock(&framework->installedBundles.mutex);
+    celixThreadRwlock_unlock(&framework->installedBundles.lock);
 
     return bundles;
 }
@@ -1805,18 +2162,14 @@ bundle_pt framework_getBundle(framework_pt framework, const char* location) {
     //promote to use the celix_bundleContext_useBundle(s) functions and deprecated this one
     bundle_t *bnd = NULL;
 
-    celixThreadMutex_lock(&framework->installedBundles.mutex);
-    int size = celix_arrayList_size(framework->installedBundles.entries);
-    for (int i = 0; i < size; ++i) {
-        celix_framework_bundle_entry_t *entry = celix_arrayList_get(framework->installedBundles.entries, i);
-        const char *loc = NULL;
-        bundle_getBundleLocation(entry->bnd, &loc);
-        if (loc != NULL && location != NULL && strncmp(loc, location, strlen(loc)) == 0) {
+    if (location != NULL) {
+        celixThreadRwlock_readLock(&framework->installedBundles.lock);
+        celix_framework_bundle_entry_t *entry = celix_stringHashMap_get(framework->installedBundles.entriesByLocation, location);
+        if (entry != NULL) {
             bnd = entry->bnd;
-            break;
         }
+        celixThreadRwlock_unlock(&framework->installedBundles.lock);
     }
-    celixThreadMutex_unlock(&framework->installedBundles.mutex);
 
 
     return bnd;
@@ -1845,7 +2198,7 @@ static void* framework_shutdown(void *framework) {
 
     celix_array_list_t *stopEntries = celix_arrayList_create();
     celix_framework_bundle_entry_t *fwEntry = NULL;
-    celixThreadMutex_lock(&fw->installedBundles.mutex);
+    celixThreadRwlock_readLock(&fw->installedBundles.lock);
     int size = celix_arrayList_size(fw->installedBundles.entries);
     for (int i = 0; i < size; ++i) {
         celix_framework_bundle_entry_t *entry = celix_arrayList_get(fw->installedBundles.entries, i);
@@ -1856,7 +2209,7 @@ static void* framework_shutdown(void *framework) {
             fwEntry = entry;
         }
     }
-    celixThreadMutex_unlock(&fw->installedBundles.mutex);
+    celixThreadRwlock_unlock(&fw->installedBundles.lock);
 
 
     size = celix_arrayList_size(stopEntries);
@@ -1922,6 +2275,56 @@ bundle_context_t* framework_getContext(const_framework_pt framework) {
     return result;
 }
 
+/**
+ * Takes a request node from the dispatcher free list or allocates a new one if the free list is empty.
+ * Should be called with the dispatcher mutex locked.
+ */
+static request_t* fw_allocRequest(celix_framework_t *framework) {
+    request_t *request = framework->dispatcher.freeRequests;
+    if (request != NULL) {
+        framework->dispatcher.freeRequests = request->next;
+        framework->dispatcher.nrOfFreeRequests -= 1;
+        memset(request, 0, sizeof(*request));
+    } else {
+        request = calloc(1, sizeof(*request));
+    }
+    return request;
+}
+
+/**
+ * Returns a request node to the dispatcher free list or frees it if the free list is full.
+ * Should be called with the dispatcher mutex locked.
+ */
+static void fw_releaseRequest(celix_framework_t *framework, request_t *request) {
+    if (framework->dispatcher.nrOfFreeRequests < CELIX_FRAMEWORK_NR_OF_PREALLOCATED_REQUESTS) {
+        request->next = framework->dispatcher.freeRequests;
+        framework->dispatcher.freeRequests = request;
+        framework->dispatcher.nrOfFreeRequests += 1;
+    } else {
+        free(request);
+    }
+}
+
+/**
+ * Appends a request to the dispatcher queue and wakes up the dispatcher if the queue was empty.
+ * Should be called with the dispatcher mutex locked.
+ */
+static void fw_queueRequest(celix_framework_t *framework, request_t *request) {
+    request->next = NULL;
+    bool wasEmpty = framework->dispatcher.firstRequest == NULL;
+    if (wasEmpty) {
+        framework->dispatcher.firstRequest = request;
+    } else {
+        framework->dispatcher.lastRequest->next = request;
+    }
+    framework->dispatcher.lastRequest = request;
+    framework->dispatcher.queuedSeq += 1;
+    if (wasEmpty) {
+        //note the dispatcher only waits when the queue is empty, so only the first queued request needs a signal
+        celixThreadCondition_signal(&framework->dispatcher.cond);
+    }
+}
+
 celix_status_t fw_fireBundleEvent(framework_pt framework, bundle_event_type_e eventType, celix_framework_bundle_entry_t* entry) {
     celix_status_t status = CELIX_SUCCESS;
 
@@ -1932,7 +2335,8 @@ celix_status_t fw_fireBundleEvent(framework_pt framework, bundle_event_type_e ev
         }
     }
 
-    request_t* request = (request_t*) calloc(1, sizeof(*request));
+    celixThreadMutex_lock(&framework->dispatcher.mutex);
+    request_t* request = fw_allocRequest(framework);
     if (!request) {
         status = CELIX_ENOMEM;
     } else {
@@ -1943,12 +2347,11 @@ celix_status_t fw_fireBundleEvent(framework_pt framework, bundle_event_type_e ev
         request->type = BUNDLE_EVENT_TYPE;
         request->error = NULL;
         request->bndEntry = entry;
+        clock_gettime(CLOCK_MONOTONIC, &request->firedTime);
 
-        celixThreadMutex_lock(&framework->dispatcher.mutex);
         if (framework->dispatcher.active) {
             //fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE, "Adding dispatcher bundle event request for bnd id %li with event type %i", entry->bndId, eventType);
-            celix_arrayList_add(framework->dispatcher.requests, request);
-            celixThreadCondition_broadcast(&framework->dispatcher.cond);
+            fw_queueRequest(framework, request);
         } else {
             /*
              * NOTE because stopping the framework is done through stopping the framework bundle,
@@ -1958,10 +2361,10 @@ celix_status_t fw_fireBundleEvent(framework_pt framework, bundle_event_type_e ev
              */
             fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE, "Cannot fire event dispatcher not active. Event is %x for bundle %s", eventType, celix_bundle_getSymbolicName(entry->bnd));
             fw_bundleEntry_decreaseUseCount(entry);
-            free(request);
+            fw_releaseRequest(framework, request);
         }
-        celixThreadMutex_unlock(&framework->dispatcher.mutex);
     }
+    celixThreadMutex_unlock(&framework->dispatcher.mutex);
 
     framework_logIfError(framework->logger, status, NULL, "Failed to fire bundle event");
 
@@ -1971,7 +2374,8 @@ celix_status_t fw_fireBundleEvent(framework_pt framework, bundle_event_type_e ev
 celix_status_t fw_fireFrameworkEvent(framework_pt framework, framework_event_type_e eventType, celix_status_t errorCode) {
     celix_status_t status = CELIX_SUCCESS;
 
-    request_t* request = calloc(1, sizeof(*request));
+    celixThreadMutex_lock(&framework->dispatcher.mutex);
+    request_t* request = fw_allocRequest(framework);
     if (!request) {
         status = CELIX_ENOMEM;
     } else {
@@ -1980,21 +2384,20 @@ celix_status_t fw_fireFrameworkEvent(framework_pt framework, framework_event_typ
         request->type = FRAMEWORK_EVENT_TYPE;
         request->errorCode = errorCode;
         request->error = "";
+        request->bndEntry = NULL;
 
         if (errorCode != CELIX_SUCCESS) {
             request->error = celix_strerror(errorCode);
         }
 
-        celixThreadMutex_lock(&framework->dispatcher.mutex);
         if (framework->dispatcher.active) {
             //fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE, "Adding dispatcher framework event request for event type %i", eventType);
-            celix_arrayList_add(framework->dispatcher.requests, request);
-            celixThreadCondition_broadcast(&framework->dispatcher.cond);
+            fw_queueRequest(framework, request);
         } else {
-            free(request);
+            fw_releaseRequest(framework, request);
         }
-        celixThreadMutex_unlock(&framework->dispatcher.mutex);
     }
+    celixThreadMutex_unlock(&framework->dispatcher.mutex);
 
     framework_logIfError(framework->logger, status, NULL, "Failed to fire framework event");
 
@@ -2002,6 +2405,139 @@ celix_status_t fw_fireFrameworkEvent(framework_pt framework, framework_event_typ
 }
 
 
+/**
+ * Calls the bundle listener and updates the listener latency statistics.
+ */
+static void fw_callBundleListener(celix_framework_t *framework, fw_bundle_listener_pt listener, celix_framework_bundle_entry_t *bndEntry, int eventType, const struct timespec *firedTime) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double latency = celix_difftime(firedTime, &now);
+
+    bundle_event_t event;
+    memset(&event, 0, sizeof(event));
+    event.bnd = bndEntry->bnd;
+    event.type = eventType;
+    fw_invokeBundleListener(framework, listener->listener, &event, listener->bundle);
+
+    celixThreadMutex_lock(&framework->listenerWorkers.mutex);
+    listener->nrOfDeliveredEvents += 1;
+    listener->totalLatency += latency;
+    if (latency > listener->maxLatency) {
+        listener->maxLatency = latency;
+    }
+    celixThreadMutex_unlock(&framework->listenerWorkers.mutex);
+}
+
+/**
+ * Appends the bundle event to the queue of every listener and makes the listeners ready for the listener workers.
+ * Every queued event keeps a use count on the listener and the bundle entry.
+ */
+static void fw_queueBundleEventForListeners(celix_framework_t *framework, celix_array_list_t *listeners, request_t *request) {
+    celixThreadMutex_lock(&framework->listenerWorkers.mutex);
+    for (int i = 0; i < celix_arrayList_size(listeners); ++i) {
+        fw_bundle_listener_pt listener = celix_arrayList_get(listeners, i);
+        fw_bundle_listener_event_t *event = calloc(1, sizeof(*event));
+        if (event == NULL) {
+            fw_bundleListener_decreaseUseCount(listener);
+            continue;
+        }
+        fw_bundleEntry_increaseUseCount(request->bndEntry);
+        event->bndEntry = request->bndEntry;
+        event->eventType = request->eventType;
+        event->firedTime = request->firedTime;
+        if (listener->lastEvent == NULL) {
+            listener->firstEvent = event;
+        } else {
+            listener->lastEvent->next = event;
+        }
+        listener->lastEvent = event;
+        listener->queueDepth += 1;
+        framework->listenerWorkers.nrOfQueuedEvents += 1;
+
+        if (!listener->scheduled) {
+            listener->scheduled = true;
+            listener->nextReady = NULL;
+            if (framework->listenerWorkers.lastReady == NULL) {
+                framework->listenerWorkers.firstReady = listener;
+            } else {
+                framework->listenerWorkers.lastReady->nextReady = listener;
+            }
+            framework->listenerWorkers.lastReady = listener;
+            celixThreadCondition_signal(&framework->listenerWorkers.cond);
+        }
+    }
+    celixThreadMutex_unlock(&framework->listenerWorkers.mutex);
+}
+
+static void* fw_listenerWorker(void *data) {
+    celix_framework_t *framework = data;
+    celixThreadMutex_lock(&framework->listenerWorkers.mutex);
+    while (true) {
+        while (framework->listenerWorkers.firstReady == NULL && framework->listenerWorkers.active) {
+            celixThreadCondition_wait(&framework->listenerWorkers.cond, &framework->listenerWorkers.mutex);
+        }
+        fw_bundle_listener_pt listener = framework->listenerWorkers.firstReady;
+        if (listener == NULL) {
+            break; //not active and no queued events left
+        }
+        framework->listenerWorkers.firstReady = listener->nextReady;
+        if (framework->listenerWorkers.firstReady == NULL) {
+            framework->listenerWorkers.lastReady = NULL;
+        }
+        fw_bundle_listener_event_t *event = listener->firstEvent;
+        listener->firstEvent = event->next;
+        if (listener->firstEvent == NULL) {
+            listener->lastEvent = NULL;
+        }
+        listener->queueDepth -= 1;
+        celixThreadMutex_unlock(&framework->listenerWorkers.mutex);
+
+        fw_callBundleListener(framework, listener, event->bndEntry, event->eventType, &event->firedTime);
+        fw_bundleEntry_decreaseUseCount(event->bndEntry);
+        free(event);
+
+        celixThreadMutex_lock(&framework->listenerWorkers.mutex);
+        if (listener->firstEvent != NULL) {
+            //handle one event per turn and re-queue the listener at the back, so that (idle) workers take turns
+            listener->nextReady = NULL;
+            if (framework->listenerWorkers.lastReady == NULL) {
+                framework->listenerWorkers.firstReady = listener;
+            } else {
+                framework->listenerWorkers.lastReady->nextReady = listener;
+            }
+            framework->listenerWorkers.lastReady = listener;
+            celixThreadCondition_signal(&framework->listenerWorkers.cond);
+        } else {
+            listener->scheduled = false;
+        }
+        framework->listenerWorkers.nrOfQueuedEvents -= 1;
+        if (framework->listenerWorkers.nrOfQueuedEvents == 0) {
+            celixThreadCondition_broadcast(&framework->listenerWorkers.idleCond);
+        }
+        celixThreadMutex_unlock(&framework->listenerWorkers.mutex);
+        fw_bundleListener_decreaseUseCount(listener); //note listener can be destroyed after this
+        celixThreadMutex_lock(&framework->listenerWorkers.mutex);
+    }
+    celixThreadMutex_unlock(&framework->listenerWorkers.mutex);
+    return NULL;
+}
+
+/**
+ * Stops the listener workers, after all queued listener events are handled.
+ */
+static void fw_stopListenerWorkers(celix_framework_t *framework) {
+    celixThreadMutex_lock(&framework->listenerWorkers.mutex);
+    framework->listenerWorkers.active = false;
+    celixThreadCondition_broadcast(&framework->listenerWorkers.cond);
+    celixThreadMutex_unlock(&framework->listenerWorkers.mutex);
+    for (int i = 0; i < framework->listenerWorkers.nrOfThreads; ++i) {
+        celixThread_join(framework->listenerWorkers.threads[i], NULL);
+    }
+    free(framework->listenerWorkers.threads);
+    framework->listenerWorkers.threads = NULL;
+    framework->listenerWorkers.nrOfThreads = 0;
+}
+
 static void fw_handleEventRequest(celix_framework_t *framework, request_t* request) {
     if (request->type == BUNDLE_EVENT_TYPE) {
         celix_array_list_t *localListeners = celix_arrayList_create();
@@ -2012,16 +2548,14 @@ static void fw_handleEventRequest(celix_framework_t *framework, request_t* reque
             celix_arrayList_add(localListeners, listener);
         }
         celixThreadMutex_unlock(&framework->bundleListenerLock);
-        for (int i = 0; i < celix_arrayList_size(localListeners); ++i) {
-            fw_bundle_listener_pt listener = arrayList_get(localListeners, i);
-
-            bundle_event_t event;
-            memset(&event, 0, sizeof(event));
-            event.bnd = request->bndEntry->bnd;
-            event.type = request->eventType;
-            fw_invokeBundleListener(framework, listener->listener, &event, listener->bundle);
-
-            fw_bundleListener_decreaseUseCount(listener);
+        if (framework->listenerWorkers.nrOfThreads > 0) {
+            fw_queueBundleEventForListeners(framework, localListeners, request);
+        } else {
+            for (int i = 0; i < celix_arrayList_size(localListeners); ++i) {
+                fw_bundle_listener_pt listener = arrayList_get(localListeners, i);
+                fw_callBundleListener(framework, listener, request->bndEntry, request->eventType, &request->firedTime);
+                fw_bundleListener_decreaseUseCount(listener);
+            }
         }
         celix_arrayList_destroy(localListeners);
     } else  if (request->type == FRAMEWORK_EVENT_TYPE) {
@@ -2038,74 +2572,72 @@ static void fw_handleEventRequest(celix_framework_t *framework, request_t* reque
             fw_invokeFrameworkListener(framework, listener->listener, &event, listener->bundle);
         }
         celixThreadMutex_unlock(&framework->frameworkListenersLock);
+    } else if (request->type == EVENT_TYPE_SERVICE) {
+        celix_serviceRegistry_deliverRegisteredEvents(framework->registry, request->registrations, request->nrOfRegistrations);
+        for (size_t i = 0; i < request->nrOfRegistrations; ++i) {
+            serviceRegistration_release(request->registrations[i]);
+        }
+        free(request->registrations);
     }
 }
 
-static inline void fw_handleEvents(celix_framework_t* framework, celix_array_list_t* localRequests) {
+/**
+ * Waits until requests are queued or the dispatcher is deactivated, takes all queued requests and handles them.
+ * Returns whether the dispatcher is still active.
+ */
+static bool fw_handleEvents(celix_framework_t* framework) {
     celixThreadMutex_lock(&framework->dispatcher.mutex);
-    if (celix_arrayList_size(framework->dispatcher.requests) == 0) {
-        //TODO needs a timed wait, because this loop sometimes misses the active=false/broadcast.
-        //FIXME an go back to 'normal' cond wait.
-        celixThreadCondition_timedwaitRelative(&framework->dispatcher.cond, &framework->dispatcher.mutex, 1, 0);
-    }
-    for (int i = 0; i < celix_arrayList_size(framework->dispatcher.requests); ++i) {
-        request_t* r = celix_arrayList_get(framework->dispatcher.requests, i);
-        celix_arrayList_add(localRequests, r);
-//        if (r->type == BUNDLE_EVENT_TYPE) {
-//            fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE,
-//                   "Removing dispatcher bundle event request for bnd id %li with event type %i", r->bndEntry->bndId, r->eventType);
-//        } else {
-//            fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE,
-//                   "Removing dispatcher framework event request for event type %i", r->eventType);
-//        }
+    while (framework->dispatcher.firstRequest == NULL && framework->dispatcher.active) {
+        celixThreadCondition_wait(&framework->dispatcher.cond, &framework->dispatcher.mutex);
     }
-    celix_arrayList_clear(framework->dispatcher.requests);
-    framework->dispatcher.nrOfLocalRequest = celix_arrayList_size(localRequests);
+    request_t *requests = framework->dispatcher.firstRequest;
+    framework->dispatcher.firstRequest = NULL;
+    framework->dispatcher.lastRequest = NULL;
+    bool active = framework->dispatcher.active;
     celixThreadMutex_unlock(&framework->dispatcher.mutex);
 
-    for (int i = 0; i < celix_arrayList_size(localRequests); ++i) {
-        request_t* request = celix_arrayList_get(localRequests, i);
+    if (requests == NULL) {
+        return active;
+    }
+
+    long nrOfHandled = 0;
+    request_t *last = NULL;
+    for (request_t *request = requests; request != NULL; request = request->next) {
         fw_handleEventRequest(framework, request);
         if (request->bndEntry != NULL) {
             fw_bundleEntry_decreaseUseCount(request->bndEntry);
         }
-        free(request);
+        nrOfHandled += 1;
+        last = request;
     }
-    celix_arrayList_clear(localRequests);
 
     celixThreadMutex_lock(&framework->dispatcher.mutex);
-    framework->dispatcher.nrOfLocalRequest = 0;
+    framework->dispatcher.handledSeq += nrOfHandled;
+    if (framework->dispatcher.nrOfFreeRequests < CELIX_FRAMEWORK_NR_OF_PREALLOCATED_REQUESTS) {
+        //return the complete batch to the free list in one go
+        last->next = framework->dispatcher.freeRequests;
+        framework->dispatcher.freeRequests = requests;
+        framework->dispatcher.nrOfFreeRequests += nrOfHandled;
+    } else {
+        while (requests != NULL) {
+            request_t *next = requests->next;
+            free(requests);
+            requests = next;
+        }
+    }
+    celixThreadCondition_broadcast(&framework->dispatcher.handledCond); //trigger threads waiting for an empty event queue
     celixThreadMutex_unlock(&framework->dispatcher.mutex);
+    return true; //always do another run, so that requests queued before deactivation are handled
 }
 
 static void *fw_eventDispatcher(void *fw) {
     framework_pt framework = (framework_pt) fw;
 
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    bool active = framework->dispatcher.active;
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
-
-    celix_array_list_t *localRequests = celix_arrayList_create();
-
+    bool active = true;
     while (active) {
-        fw_handleEvents(framework, localRequests);
-
-        celixThreadMutex_lock(&framework->dispatcher.mutex);
-        celixThreadCondition_broadcast(&framework->dispatcher.cond); //trigger threads waiting for an empty event queue (after local events are handled)
-        active = framework->dispatcher.active;
-        celixThreadMutex_unlock(&framework->dispatcher.mutex);
-    }
-
-    //not active any more, last run for possible request left overs
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    bool needLastRun = celix_arrayList_size(framework->dispatcher.requests) > 0;
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
-    if (needLastRun) {
-        fw_handleEvents(framework, localRequests);
+        active = fw_handleEvents(framework);
     }
 
-
-    celix_arrayList_destroy(localRequests);
     celixThread_exit(NULL);
     return NULL;
 
@@ -2157,6 +2689,7 @@ static celix_status_t frameworkActivator_stop(void * userData, bundle_context_t
             celixThreadCondition_broadcast(&framework->dispatcher.cond);
             celixThreadMutex_unlock(&framework->dispatcher.mutex);
             celixThread_join(framework->dispatcher.thread, NULL);
+            fw_stopListenerWorkers(framework);
             fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE, "Joined shutdown thread for framework %s", celix_framework_getUUID(framework));
 
             celixThread_create(&framework->shutdown.thread, NULL, &framework_shutdown, framework);
@@ -2289,11 +2822,15 @@ static celix_status_t framework_loadLibrary(framework_pt framework, const char *
     status = CELIX_DO_IF(status, bundleArchive_getCurrentRevisionNumber(archive, &revisionNumber));
 
     memset(libraryPath, 0, 256);
+    char libraryName[256];
     int written = 0;
     if (strncmp("lib", library, 3) == 0) {
-        written = snprintf(libraryPath, 256, "%s/version%ld.%ld/%s", archiveRoot, refreshCount, revisionNumber, library);
+        written = snprintf(libraryName, 256, "%s", library);
     } else {
-        written = snprintf(libraryPath, 256, "%s/version%ld.%ld/%s%s%s", archiveRoot, refreshCount, revisionNumber, library_prefix, library, library_extension);
+        written = snprintf(libraryName, 256, "%s%s%s", library_prefix, library, library_extension);
+    }
+    if (written < 256) {
+        written = snprintf(libraryPath, 256, "%s/version%ld.%ld/%s", archiveRoot, refreshCount, revisionNumber, libraryName);
     }
 
     if (written >= 256) {
@@ -2302,10 +2839,32 @@ static celix_status_t framework_loadLibrary(framework_pt framework, const char *
     } else {
         celix_bundle_context_t *fwCtx = NULL;
         bundle_getContext(framework->bundle, &fwCtx);
+        int memFd = -1;
+        if (access(libraryPath, F_OK) != 0 && celix_bundleContext_getPropertyAsBool(fwCtx, CELIX_LOAD_BUNDLE_LIBRARIES_FROM_ARCHIVE, false)) {
+            //library is not extracted, load it from the bundle zip using a memory file
+            bundle_revision_pt revision = NULL;
+            const char *location = NULL;
+            status = CELIX_DO_IF(status, bundleArchive_getCurrentRevision(archive, &revision));
+            status = CELIX_DO_IF(status, bundleRevision_getLocation(revision, &location));
+            if (status == CELIX_SUCCESS && extractBundleEntryToMemoryFile(location, libraryName, &memFd) == CELIX_SUCCESS) {
+                snprintf(libraryPath, 256, "/proc/self/fd/%i", memFd);
+            } else if (status == CELIX_SUCCESS) {
+                //fallback to loading the library from disk
+                char revisionRoot[256];
+                snprintf(revisionRoot, sizeof(revisionRoot), "%s/version%ld.%ld", archiveRoot, refreshCount, revisionNumber);
+                fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "Cannot load library %s from bundle zip %s using a memory file, extracting it to %s", libraryName, location, revisionRoot);
+                if (extractBundleEntry(location, libraryName, revisionRoot) != CELIX_SUCCESS) {
+                    fw_log(framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot extract library %s from bundle zip %s", libraryName, location);
+                }
+            }
+        }
         *handle = celix_libloader_open(fwCtx, libraryPath);
         if (*handle == NULL) {
             error = celix_libloader_getLastError();
             status =  CELIX_BUNDLE_EXCEPTION;
+            if (memFd >= 0) {
+                close(memFd);
+            }
         } else {
             bundle_revision_pt revision = NULL;
             array_list_pt handles = NULL;
@@ -2316,6 +2875,12 @@ static celix_status_t framework_loadLibrary(framework_pt framework, const char *
             if(handles != NULL){
                 arrayList_add(handles, *handle);
             }
+
+            //note the memory file stays open while the library is loaded, so that its /proc/self/fd path is unique.
+            //Libraries loaded with RTLD_NODELETE are never unloaded, so their memory file is never closed.
+            if (memFd >= 0 && revision != NULL && !celix_libloader_isNoDelete(fwCtx)) {
+                celix_bundleRevision_addLibraryFd(revision, memFd);
+            }
         }
     }
 
@@ -2339,7 +2904,7 @@ static celix_status_t framework_loadLibrary(framework_pt framework, const char *
 void celix_framework_useBundles(framework_t *fw, bool includeFrameworkBundle, void *callbackHandle, void(*use)(void *handle, const bundle_t *bnd)) {
     celix_array_list_t *bundleIds = celix_arrayList_create();
 
-    celixThreadMutex_lock(&fw->installedBundles.mutex);
+    celixThreadRwlock_readLock(&fw->installedBundles.lock);
     int size = celix_arrayList_size(fw->installedBundles.entries);
     for (int i = 0; i < size; ++i) {
         celix_framework_bundle_entry_t *entry = celix_arrayList_get(fw->installedBundles.entries, i);
@@ -2348,7 +2913,7 @@ void celix_framework_useBundles(framework_t *fw, bool includeFrameworkBundle, vo
             celix_arrayList_addLong(bundleIds, entry->bndId);
         }
     }
-    celixThreadMutex_unlock(&fw->installedBundles.mutex);
+    celixThreadRwlock_unlock(&fw->installedBundles.lock);
 
     //note that stored bundle ids can now already be invalid (race cond),
     //but the celix_framework_useBundle function should be able to handle this safely.
@@ -2384,6 +2949,64 @@ bool celix_framework_useBundle(framework_t *fw, bool onlyActive, long bundleId,
     return called;
 }
 
+/**
+ * Queues the delivery of the REGISTERED events for the provided registry entries on the Celix event thread.
+ * If the event dispatcher is not active (anymore) the events are delivered on the calling thread.
+ */
+static celix_status_t fw_fireServicesRegisteredEvent(celix_framework_t *fw, celix_framework_bundle_entry_t *entry, celix_service_registry_registration_entry_t *entries, size_t nrOfEntries) {
+    service_registration_t **registrations = malloc(nrOfEntries * sizeof(*registrations));
+    if (registrations == NULL) {
+        return CELIX_ENOMEM;
+    }
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        registrations[i] = entries[i].registration;
+        serviceRegistration_retain(registrations[i]);
+    }
+
+    bool queued = false;
+    celixThreadMutex_lock(&fw->dispatcher.mutex);
+    request_t *request = fw->dispatcher.active ? fw_allocRequest(fw) : NULL;
+    if (request != NULL) {
+        fw_bundleEntry_increaseUseCount(entry);
+        request->type = EVENT_TYPE_SERVICE;
+        request->bndEntry = entry;
+        request->registrations = registrations;
+        request->nrOfRegistrations = nrOfEntries;
+        fw_queueRequest(fw, request);
+        queued = true;
+    }
+    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+
+    if (!queued) {
+        celix_serviceRegistry_deliverRegisteredEvents(fw->registry, registrations, nrOfEntries);
+        for (size_t i = 0; i < nrOfEntries; ++i) {
+            serviceRegistration_release(registrations[i]);
+        }
+        free(registrations);
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_framework_registerServices(framework_t *fw, const celix_bundle_t *bnd, celix_service_registry_registration_entry_t *entries, size_t nrOfEntries, bool async) {
+    celix_status_t status = CELIX_SUCCESS;
+    long bndId = celix_bundle_getId(bnd);
+    celix_framework_bundle_entry_t *entry = fw_bundleEntry_getBundleEntryAndIncreaseUseCount(fw, bndId);
+    if (entry == NULL) {
+        status = CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    status = CELIX_DO_IF(status, celix_serviceRegistry_registerServices(fw->registry, bnd, entries, nrOfEntries, !async));
+    if (status == CELIX_SUCCESS && async && nrOfEntries > 0) {
+        status = fw_fireServicesRegisteredEvent(fw, entry, entries, nrOfEntries);
+    }
+
+    if (entry != NULL) {
+        fw_bundleEntry_decreaseUseCount(entry);
+    }
+    framework_logIfError(fw->logger, status, NULL, "Cannot register %zu services for bundle %li", nrOfEntries, bndId);
+    return status;
+}
+
 service_registration_t* celix_framework_registerServiceFactory(framework_t *fw , const celix_bundle_t *bnd, const char* serviceName, celix_service_factory_t *factory, celix_properties_t *properties) {
     const char *error = NULL;
     celix_status_t status = CELIX_SUCCESS;
@@ -2529,12 +3152,71 @@ bool celix_framework_startBundle(celix_framework_t *fw, long bndId) {
 
 void celix_framework_waitForEmptyEventQueue(celix_framework_t *fw) {
     celixThreadMutex_lock(&fw->dispatcher.mutex);
-    while ((celix_arrayList_size(fw->dispatcher.requests) + fw->dispatcher.nrOfLocalRequest) != 0) {
-        celixThreadCondition_wait(&fw->dispatcher.cond, &fw->dispatcher.mutex);
+    long seq = fw->dispatcher.queuedSeq;
+    while (fw->dispatcher.handledSeq < seq) {
+        celixThreadCondition_wait(&fw->dispatcher.handledCond, &fw->dispatcher.mutex);
     }
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
+
+    //with listener workers, the handled bundle events can still be queued for the bundle listeners
+    celixThreadMutex_lock(&fw->listenerWorkers.mutex);
+    while (fw->listenerWorkers.nrOfQueuedEvents > 0) {
+        celixThreadCondition_wait(&fw->listenerWorkers.idleCond, &fw->listenerWorkers.mutex);
+    }
+    celixThreadMutex_unlock(&fw->listenerWorkers.mutex);
 }
 
 void celix_framework_setLogCallback(celix_framework_t* fw, void* logHandle, void (*logFunction)(void* handle, celix_log_level_e level, const char* file, const char *function, int line, const char *format, va_list formatArgs)) {
     celix_frameworkLogger_setLogCallback(fw->logger, logHandle, logFunction);
-}
\ No newline at end of file
+}
+
+void celix_framework_recordLifecyclePhase(celix_framework_t *fw, long bndId, const char *subject, const char *phase, bool component, const struct timespec *begin) {
+    if (fw != NULL && fw->timeline != NULL) {
+        celix_lifecycleTimeline_record(fw->timeline, bndId, subject, phase, component, begin);
+    }
+}
+
+void celix_framework_printLifecycleTimeline(celix_framework_t *fw, FILE *stream) {
+    if (fw->timeline != NULL) {
+        celix_lifecycleTimeline_print(fw->timeline, stream);
+    } else {
+        fprintf(stream, "Lifecycle timeline is disabled (%s=0)\n", CELIX_FRAMEWORK_LIFECYCLE_TIMELINE_MAX_EVENTS);
+    }
+}
+
+celix_status_t celix_framework_writeLifecycleTimelineAsTraceEvents(celix_framework_t *fw, FILE *stream) {
+    if (fw->timeline == NULL) {
+        return CELIX_ILLEGAL_STATE;
+    }
+    return celix_lifecycleTimeline_writeTraceEvents(fw->timeline, stream);
+}
+
+celix_array_list_t* celix_framework_listBundleListenerStats(celix_framework_t *fw) {
+    celix_array_list_t *result = celix_arrayList_create();
+    celixThreadMutex_lock(&fw->bundleListenerLock);
+    celixThreadMutex_lock(&fw->listenerWorkers.mutex);
+    for (int i = 0; i < celix_arrayList_size(fw->bundleListeners); ++i) {
+        fw_bundle_listener_pt listener = celix_arrayList_get(fw->bundleListeners, i);
+        celix_framework_bundle_listener_stats_t *stats = calloc(1, sizeof(*stats));
+        if (stats != NULL) {
+            stats->bndId = celix_bundle_getId(listener->bundle);
+            stats->queueDepth = listener->queueDepth;
+            stats->nrOfDeliveredEvents = listener->nrOfDeliveredEvents;
+            stats->averageLatencyInSeconds = listener->nrOfDeliveredEvents > 0 ? listener->totalLatency / (double)listener->nrOfDeliveredEvents : 0.0;
+            stats->maxLatencyInSeconds = listener->maxLatency;
+            celix_arrayList_add(result, stats);
+        }
+    }
+    celixThreadMutex_unlock(&fw->listenerWorkers.mutex);
+    celixThreadMutex_unlock(&fw->bundleListenerLock);
+    return result;
+}
+
+void celix_framework_destroyBundleListenerStats(celix_array_list_t *list) {
+    if (list != NULL) {
+        for (int i = 0; i < celix_arrayList_size(list); ++i) {
+            free(celix_arrayList_get(list, i));
+        }
+        celix_arrayList_destroy(list);
+    }
+}
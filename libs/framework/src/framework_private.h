@@ -26,6 +26,8 @@
 #include "manifest.h"
 #include "wire.h"
 #include "hash_map.h"
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
 #include "array_list.h"
 #include "celix_errno.h"
 #include "service_factory.h"
@@ -40,6 +42,8 @@
 
 #include "celix_threads.h"
 #include "service_registry.h"
+#include "celix_lifecycle_timeline.h"
+#include "dm_executor_pool.h"
 
 struct celix_framework {
 #ifdef WITH_APR
@@ -55,7 +59,7 @@ struct celix_framework {
     array_list_pt bundleListeners;
     celix_thread_mutex_t bundleListenerLock;
 
-    long nextBundleId;
+    long nextBundleId; //atomic
     celix_service_registry_t *registry;
     bundle_cache_pt cache;
 
@@ -70,25 +74,62 @@ struct celix_framework {
     struct {
         celix_array_list_t *entries; //value = celix_framework_bundle_entry_t*. Note ordered by installed bundle time
                                      //i.e. later installed bundle are last
-        celix_thread_mutex_t mutex;
+        celix_long_hash_map_t *entriesById; //key = bundle id, value = celix_framework_bundle_entry_t*
+        celix_string_hash_map_t *entriesByLocation; //key = bundle location, value = celix_framework_bundle_entry_t*
+        celix_thread_rwlock_t lock; //protects the entries list and indices, lookups only need the read lock
     } installedBundles;
 
 
     properties_pt configurationMap;
 
+    celix_thread_mutex_t resolveLock; //serializes resolving and marking modules resolved when bundles are started concurrently
+
 
     struct {
-        celix_thread_cond_t cond;
+        celix_thread_cond_t cond; //signalled when a request is queued or the dispatcher is deactivated
+        celix_thread_cond_t handledCond; //signalled when the dispatcher has handled a batch of requests
         celix_thread_t thread;
-        celix_thread_mutex_t mutex; //protect active and requests
+        celix_thread_mutex_t mutex; //protect active, the request queue, the free list and the sequence counters
         bool active;
-        celix_array_list_t *requests;
-        size_t nrOfLocalRequest;
+        struct request *firstRequest; //FIFO queue of pending requests, NULL if empty
+        struct request *lastRequest;
+        struct request *freeRequests; //preallocated request nodes, reused for new events
+        size_t nrOfFreeRequests;
+        long queuedSeq; //nr of requests queued since the framework was created
+        long handledSeq; //nr of requests handled since the framework was created
     } dispatcher;
 
+    /**
+     * Optional worker threads for calling bundle listeners (see CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS).
+     * Every bundle listener has its own ordered queue of bundle events. Listeners with queued events are in a
+     * shared ready queue from which idle workers take the next listener, so that a slow listener only delays its
+     * own events. A listener is handled by at most one worker at a time, which keeps the per listener ordering.
+     */
+    struct {
+        int nrOfThreads; //0 if bundle listeners are called on the dispatcher thread
+        celix_thread_t *threads;
+        celix_thread_mutex_t mutex; //protects below, the listener queues and the listener statistics
+        celix_thread_cond_t cond; //signalled when a listener becomes ready or the workers are stopped
+        celix_thread_cond_t idleCond; //signalled when all queued listener events are handled
+        bool active;
+        struct fw_bundleListener *firstReady; //FIFO of listeners with queued events, which are not handled by a worker
+        struct fw_bundleListener *lastReady;
+        size_t nrOfQueuedEvents; //total nr of queued or in progress listener events
+    } listenerWorkers;
+
     celix_framework_logger_t* logger;
+
+    celix_lifecycle_timeline_t *timeline; //NULL if the lifecycle timeline is disabled
+
+    celix_dm_executor_pool_t *dmExecutorPool; //NULL if dm components run their tasks on the calling thread (see CELIX_DM_COMPONENT_EXECUTOR_THREADS)
 };
 
+/**
+ * Records a bundle or component lifecycle phase, which began at begin and ends now, in the framework lifecycle
+ * timeline. Does nothing if the timeline is disabled.
+ */
+void celix_framework_recordLifecyclePhase(celix_framework_t *fw, long bndId, const char *subject, const char *phase, bool component, const struct timespec *begin);
+
 FRAMEWORK_EXPORT celix_status_t fw_getProperty(framework_pt framework, const char* name, const char* defaultValue, const char** value);
 
 FRAMEWORK_EXPORT celix_status_t fw_installBundle(framework_pt framework, bundle_pt * bundle, const char * location, const char *inputFile);
@@ -153,4 +194,11 @@ FRAMEWORK_EXPORT bundle_pt framework_getBundleById(framework_pt framework, long
 
 service_registration_t* celix_framework_registerServiceFactory(framework_t *fw , const celix_bundle_t *bnd, const char* serviceName, celix_service_factory_t *factory, celix_properties_t *properties);
 
+/**
+ * Register multiple services for the provided bundle under a single registry lock acquisition.
+ * If async is false the REGISTERED events are fired in one pass before returning, if async is true the
+ * REGISTERED events are delivered on the Celix event thread.
+ */
+celix_status_t celix_framework_registerServices(framework_t *fw, const celix_bundle_t *bnd, celix_service_registry_registration_entry_t *entries, size_t nrOfEntries, bool async);
+
 #endif /* FRAMEWORK_PRIVATE_H_ */
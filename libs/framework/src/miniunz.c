@@ -40,6 +40,10 @@
 #include <utime.h>
 #endif
 #include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #include "unzip.h"
 #include "archive.h"
@@ -168,7 +172,17 @@ int makedir (char *newdir)
   return 1;
 }
 
-int do_extract_currentfile(unzFile uf, char * revisionRoot) {
+/* returns 1 if the zip entry is a (top level) shared library */
+static int is_library_entry(const char *filename_inzip)
+{
+    if (strchr(filename_inzip, '/') != NULL || strncmp(filename_inzip, "lib", 3) != 0) {
+        return 0;
+    }
+    size_t len = strlen(filename_inzip);
+    return strstr(filename_inzip, ".so") != NULL || (len > 6 && strcmp(filename_inzip + len - 6, ".dylib") == 0);
+}
+
+int do_extract_currentfile(unzFile uf, char * revisionRoot, int skipLibraries) {
     char filename_inzip[256];
     char* filename_withoutpath;
     char* p;
@@ -186,6 +200,10 @@ int do_extract_currentfile(unzFile uf, char * revisionRoot) {
         return err;
     }
 
+    if (skipLibraries && is_library_entry(filename_inzip)) {
+        return UNZ_OK;
+    }
+
     size_buf = WRITEBUFFERSIZE;
     buf = (void*)malloc(size_buf);
     if (buf==NULL)
@@ -305,7 +323,7 @@ int do_extract_currentfile(unzFile uf, char * revisionRoot) {
 }
 
 
-int do_extract(unzFile uf, char * revisionRoot) {
+int do_extract(unzFile uf, char * revisionRoot, int skipLibraries) {
     uLong i;
     unz_global_info64 gi;
     int err;
@@ -316,7 +334,7 @@ int do_extract(unzFile uf, char * revisionRoot) {
 
     for (i=0;i<gi.number_entry;i++)
     {
-        if (do_extract_currentfile(uf, revisionRoot) != UNZ_OK)
+        if (do_extract_currentfile(uf, revisionRoot, skipLibraries) != UNZ_OK)
             break;
 
         if ((i+1)<gi.number_entry)
@@ -333,7 +351,7 @@ int do_extract(unzFile uf, char * revisionRoot) {
     return 0;
 }
 
-celix_status_t extractBundle(const char* bundleName, const char* revisionRoot) {
+static celix_status_t extractBundleInternal(const char* bundleName, const char* revisionRoot, int skipLibraries) {
     celix_status_t status = CELIX_SUCCESS;
     char filename_try[MAXFILENAME+16] = "";
     unzFile uf=NULL;
@@ -371,7 +389,7 @@ celix_status_t extractBundle(const char* bundleName, const char* revisionRoot) {
         printf("Cannot open %s or %s.zip\n",bundleName,bundleName);
         status = CELIX_FILE_IO_EXCEPTION;
     } else {
-        if (do_extract(uf, (char*)revisionRoot) != 0) {
+        if (do_extract(uf, (char*)revisionRoot, skipLibraries) != 0) {
             status = CELIX_FILE_IO_EXCEPTION;
         }
 
@@ -380,3 +398,78 @@ celix_status_t extractBundle(const char* bundleName, const char* revisionRoot) {
 
     return status;
 }
+
+celix_status_t extractBundle(const char* bundleName, const char* revisionRoot) {
+    return extractBundleInternal(bundleName, revisionRoot, 0);
+}
+
+celix_status_t extractBundleWithoutLibraries(const char* bundleName, const char* revisionRoot) {
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    return extractBundleInternal(bundleName, revisionRoot, 1);
+#else
+    //libraries cannot be loaded from memory files, so extract them
+    return extractBundleInternal(bundleName, revisionRoot, 0);
+#endif
+}
+
+celix_status_t extractBundleEntryToMemoryFile(const char* bundleName, const char* entryName, int* fdOut) {
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    celix_status_t status = CELIX_SUCCESS;
+    int fd = -1;
+    unzFile uf = unzOpen64(bundleName);
+    if (uf == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+
+    if (unzLocateFile(uf, entryName, 1) != UNZ_OK || unzOpenCurrentFile(uf) != UNZ_OK) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    } else {
+        fd = memfd_create(entryName, MFD_CLOEXEC);
+        if (fd < 0) {
+            status = CELIX_FILE_IO_EXCEPTION;
+        }
+        char buf[WRITEBUFFERSIZE];
+        int read = 0;
+        while (status == CELIX_SUCCESS && (read = unzReadCurrentFile(uf, buf, sizeof(buf))) > 0) {
+            for (int written = 0; status == CELIX_SUCCESS && written < read;) {
+                ssize_t rc = write(fd, buf + written, (size_t)(read - written));
+                if (rc < 0) {
+                    status = CELIX_FILE_IO_EXCEPTION;
+                } else {
+                    written += (int)rc;
+                }
+            }
+        }
+        if (read < 0) {
+            status = CELIX_FILE_IO_EXCEPTION;
+        }
+        unzCloseCurrentFile(uf);
+    }
+    unzClose(uf);
+
+    if (status == CELIX_SUCCESS) {
+        *fdOut = fd;
+    } else if (fd >= 0) {
+        close(fd);
+    }
+    return status;
+#else
+    (void)bundleName;
+    (void)entryName;
+    (void)fdOut;
+    return CELIX_ILLEGAL_STATE;
+#endif
+}
+
+celix_status_t extractBundleEntry(const char* bundleName, const char* entryName, const char* revisionRoot) {
+    celix_status_t status = CELIX_SUCCESS;
+    unzFile uf = unzOpen64(bundleName);
+    if (uf == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    if (unzLocateFile(uf, entryName, 1) != UNZ_OK || do_extract_currentfile(uf, (char*)revisionRoot, 0) != UNZ_OK) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    }
+    unzClose(uf);
+    return status;
+}
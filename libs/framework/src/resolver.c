@@ -32,6 +32,7 @@
 #include "linked_list_iterator.h"
 #include "bundle.h"
 #include "celix_log.h"
+#include "celix_threads.h"
 
 struct capabilityList {
     char * serviceName;
@@ -55,12 +56,21 @@ linked_list_pt m_unresolvedServices = NULL;
 // List containing capability_t_LISTs
 linked_list_pt m_resolvedServices = NULL;
 
+//Protects the module and capability lists above, modules can be installed and resolved concurrently
+//(e.g. when auto start bundles are installed in parallel)
+static celix_thread_mutex_t m_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static linked_list_pt resolver_resolveInternal(module_pt root);
+static void resolver_moduleResolvedInternal(module_pt module);
+static void resolver_addModuleInternal(module_pt module);
+static void resolver_removeModuleInternal(module_pt module);
+
 int resolver_populateCandidatesMap(hash_map_pt candidatesMap, module_pt targetModule);
 capability_list_pt resolver_getCapabilityList(linked_list_pt list, const char* name);
 void resolver_removeInvalidCandidate(module_pt module, hash_map_pt candidates, linked_list_pt invalid);
 linked_list_pt resolver_populateWireMap(hash_map_pt candidates, module_pt importer, linked_list_pt wireMap);
 
-linked_list_pt resolver_resolve(module_pt root) {
+static linked_list_pt resolver_resolveInternal(module_pt root) {
     hash_map_pt candidatesMap = NULL;
     linked_list_pt wireMap = NULL;
     linked_list_pt resolved = NULL;
@@ -245,7 +255,7 @@ void resolver_removeInvalidCandidate(module_pt invalidModule, hash_map_pt candid
     }
 }
 
-void resolver_addModule(module_pt module) {
+static void resolver_addModuleInternal(module_pt module) {
 
     if (m_modules == NULL) {
         linkedList_create(&m_modules);
@@ -287,7 +297,7 @@ void resolver_addModule(module_pt module) {
     }
 }
 
-void resolver_removeModule(module_pt module) {
+static void resolver_removeModuleInternal(module_pt module) {
     linked_list_pt caps = NULL;
     linkedList_removeElement(m_modules, module);
     caps = module_getCapabilities(module);
@@ -341,7 +351,7 @@ void resolver_removeModule(module_pt module) {
     }
 }
 
-void resolver_moduleResolved(module_pt module) {
+static void resolver_moduleResolvedInternal(module_pt module) {
 
     if (module_isResolved(module)) {
         linked_list_pt capsCopy = NULL;
@@ -415,6 +425,31 @@ void resolver_moduleResolved(module_pt module) {
     }
 }
 
+linked_list_pt resolver_resolve(module_pt root) {
+    celixThreadMutex_lock(&m_mutex);
+    linked_list_pt wires = resolver_resolveInternal(root);
+    celixThreadMutex_unlock(&m_mutex);
+    return wires;
+}
+
+void resolver_moduleResolved(module_pt module) {
+    celixThreadMutex_lock(&m_mutex);
+    resolver_moduleResolvedInternal(module);
+    celixThreadMutex_unlock(&m_mutex);
+}
+
+void resolver_addModule(module_pt module) {
+    celixThreadMutex_lock(&m_mutex);
+    resolver_addModuleInternal(module);
+    celixThreadMutex_unlock(&m_mutex);
+}
+
+void resolver_removeModule(module_pt module) {
+    celixThreadMutex_lock(&m_mutex);
+    resolver_removeModuleInternal(module);
+    celixThreadMutex_unlock(&m_mutex);
+}
+
 capability_list_pt resolver_getCapabilityList(linked_list_pt list, const char * name) {
     capability_list_pt capabilityList = NULL;
     linked_list_iterator_pt iterator = linkedListIterator_create(list, 0);
@@ -39,14 +39,15 @@
 static void serviceReference_destroy(service_reference_pt);
 static void serviceReference_logWarningUsageCountBelowZero(service_reference_pt ref);
 
-celix_status_t serviceReference_create(registry_callback_t callback, bundle_pt referenceOwner, service_registration_pt registration,  service_reference_pt *out) {
+celix_status_t serviceReference_create(registry_callback_t callback, celix_object_pool_t *pool, bundle_pt referenceOwner, service_registration_pt registration,  service_reference_pt *out) {
 	celix_status_t status = CELIX_SUCCESS;
 
-	service_reference_pt ref = calloc(1, sizeof(*ref));
+	service_reference_pt ref = pool != NULL ? celix_objectPool_alloc(pool) : calloc(1, sizeof(*ref));
 	if (!ref) {
 		status = CELIX_ENOMEM;
 	} else {
         ref->callback = callback;
+        ref->pool = pool;
 		ref->referenceOwner = referenceOwner;
 		ref->registration = registration;
         ref->service = NULL;
@@ -172,7 +173,11 @@ static void serviceReference_destroy(service_reference_pt ref) {
 	assert(ref->refCount == 0);
     celixThreadRwlock_destroy(&ref->lock);
 	ref->registration = NULL;
-	free(ref);
+	if (ref->pool != NULL) {
+	    celix_objectPool_free(ref->pool, ref);
+	} else {
+	    free(ref);
+	}
 }
 
 celix_status_t serviceReference_getBundle(service_reference_pt ref, bundle_pt *bundle) {
@@ -243,17 +248,15 @@ FRAMEWORK_EXPORT celix_status_t serviceReference_getPropertyKeys(service_referen
 
     celixThreadRwlock_readLock(&ref->lock);
     serviceRegistration_getProperties(ref->registration, &props);
-    hash_map_iterator_pt it;
     int i = 0;
-    int vsize = hashMap_size(props);
+    int vsize = celix_properties_size(props);
     *size = (unsigned int)vsize;
     *keys = malloc(vsize * sizeof(**keys));
-    it = hashMapIterator_create(props);
-    while (hashMapIterator_hasNext(it)) {
-        (*keys)[i] = hashMapIterator_nextKey(it);
+    const char *key = NULL;
+    CELIX_PROPERTIES_FOR_EACH(props, key) {
+        (*keys)[i] = (char*)key;
         i++;
     }
-    hashMapIterator_destroy(it);
     celixThreadRwlock_unlock(&ref->lock);
     return status;
 }
@@ -29,6 +29,7 @@
 
 #include "registry_callback_private.h"
 #include "service_reference.h"
+#include "celix_object_pool.h"
 
 
 struct serviceReference {
@@ -42,9 +43,14 @@ struct serviceReference {
     size_t usageCount;
 
     celix_thread_rwlock_t lock;
+
+    celix_object_pool_t *pool; //pool the reference is allocated from, NULL if allocated with calloc
 };
 
-celix_status_t serviceReference_create(registry_callback_t callback, bundle_pt referenceOwner, service_registration_pt registration, service_reference_pt *reference);
+/**
+ * Creates a service reference. If pool is not NULL, the reference is allocated from - and returned to - the pool.
+ */
+celix_status_t serviceReference_create(registry_callback_t callback, celix_object_pool_t *pool, bundle_pt referenceOwner, service_registration_pt registration, service_reference_pt *reference);
 
 celix_status_t serviceReference_retain(service_reference_pt ref);
 celix_status_t serviceReference_release(service_reference_pt ref, bool *destroyed);
@@ -65,6 +65,8 @@ static celix_status_t serviceRegistration_createInternal(registry_callback_t cal
 		}
 
 		reg->isUnregistering = false;
+		reg->isRegistered = false;
+		reg->registeredEventPending = false;
 		celixThreadRwlock_create(&reg->lock, NULL);
 
 		celixThreadRwlock_writeLock(&reg->lock);
@@ -105,6 +107,7 @@ static celix_status_t serviceRegistration_destroy(service_registration_pt regist
 	registration->className = NULL;
 
     registration->callback.unregister = NULL;
+    registration->callback.modified = NULL;
 
 	properties_destroy(registration->properties);
 	celixThreadRwlock_unlock(&registration->lock);
@@ -115,15 +118,11 @@ static celix_status_t serviceRegistration_destroy(service_registration_pt regist
 }
 
 static celix_status_t serviceRegistration_initializeProperties(service_registration_pt registration, properties_pt dictionary) {
-    char sId[32];
-
 	if (dictionary == NULL) {
 		dictionary = properties_create();
 	}
 
-
-	snprintf(sId, 32, "%lu", registration->serviceId);
-	properties_set(dictionary, (char *) OSGI_FRAMEWORK_SERVICE_ID, sId);
+	celix_properties_setLong(dictionary, OSGI_FRAMEWORK_SERVICE_ID, registration->serviceId);
 
 	if (properties_get(dictionary, (char *) OSGI_FRAMEWORK_OBJECTCLASS) == NULL) {
 		properties_set(dictionary, (char *) OSGI_FRAMEWORK_OBJECTCLASS, registration->className);
@@ -232,9 +231,22 @@ celix_status_t serviceRegistration_setProperties(service_registration_pt registr
     celix_status_t status;
 
     celixThreadRwlock_writeLock(&registration->lock);
+    if (properties != NULL && registration->properties != NULL) {
+        //note the objectClass cannot be changed, the service registry indexes the registration on it.
+        const char *objectClass = properties_get(registration->properties, (char *) OSGI_FRAMEWORK_OBJECTCLASS);
+        if (objectClass != NULL) {
+            properties_set(properties, (char *) OSGI_FRAMEWORK_OBJECTCLASS, objectClass);
+        }
+    }
     status = serviceRegistration_initializeProperties(registration, properties);
+    registry_callback_t callback = registration->callback;
     celixThreadRwlock_unlock(&registration->lock);
 
+    //note called without the registration lock, the registry locks the registry before reading the registration
+    if (status == CELIX_SUCCESS && callback.modified != NULL) {
+        callback.modified(callback.handle, registration);
+    }
+
 	return status;
 }
 
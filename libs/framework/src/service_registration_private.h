@@ -39,6 +39,9 @@ struct serviceRegistration {
 	unsigned long serviceId;
 
 	bool isUnregistering;
+	bool isRegistered; //true while the registration is part of the service registry, protected by the registry lock
+	bool registeredEventPending; //true until the REGISTERED events of a batch registration are delivered, protected by the registry lock
+	unsigned long registeredListenerSeq; //service listeners with a lower seq were added before the batch registration
 
 	enum celix_service_type svcType;
 	const void * svcObj;
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
 #include <celix_api.h>
 
 #include "service_registry_private.h"
@@ -50,6 +51,9 @@ static celix_status_t serviceRegistry_setReferenceStatus(service_registry_pt reg
 static celix_status_t serviceRegistry_getUsingBundles(service_registry_pt registry, service_registration_pt reg, array_list_pt *bundles);
 static celix_status_t serviceRegistry_getServiceReference_internal(service_registry_pt registry, bundle_pt owner, service_registration_pt registration, service_reference_pt *out);
 static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration);
+static void celix_serviceRegistry_serviceChangedForListeners(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration, unsigned long fromSeq, unsigned long toSeq);
+static celix_array_list_t** celix_serviceRegistry_collectRegisteredEventListeners(celix_service_registry_t *registry, service_registration_t **registrations, size_t nrOfRegistrations);
+static void celix_serviceRegistry_invokeServiceListeners(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration, celix_array_list_t *matchedEntries);
 static void serviceRegistry_callHooksForListenerFilter(service_registry_pt registry, celix_bundle_t *owner, const celix_filter_t *filter, bool removed);
 
     static celix_service_registry_listener_hook_entry_t* celix_createHookEntry(long svcId, celix_listener_hook_service_t*);
@@ -65,6 +69,23 @@ static void celix_increasePendingRegisteredEvent(celix_service_registry_t *regis
 static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId);
 static void celix_waitForPendingRegisteredEvents(celix_service_registry_t *registry, long svcId);
 
+static void celix_serviceRegistry_getIndexNames(service_registration_t *registration, const char **svcName, const char **objectClass);
+static void celix_serviceRegistry_addToNameIndex(celix_service_registry_t *registry, service_registration_t *registration);
+static void celix_serviceRegistry_removeFromNameIndex(celix_service_registry_t *registry, service_registration_t *registration);
+static const char* celix_serviceRegistry_findRequiredObjectClass(const celix_filter_t *filter);
+static bool celix_serviceRegistry_registrationMatches(service_registration_t *registration, const char *serviceName, const celix_filter_t *filter);
+static void celix_serviceRegistry_collectMatchingRegistrations(celix_array_list_t *regs, const char *serviceName, const celix_filter_t *filter, celix_array_list_t *matchingRegistrations);
+static void celix_serviceRegistry_addServiceListenerToBucket(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry);
+static void celix_serviceRegistry_removeServiceListenerFromBucket(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry);
+static void celix_serviceRegistry_collectMatchingServiceListeners(celix_service_registry_t *registry, celix_array_list_t *bucket, celix_properties_t *props, unsigned long fromSeq, unsigned long toSeq, celix_array_list_t *matchedEntries);
+static celix_service_registry_snapshot_t* celix_serviceRegistry_createSnapshot(bool withUnnamed);
+static void celix_serviceRegistry_destroySnapshotAndBuckets(celix_service_registry_snapshot_t *snapshot);
+static celix_array_list_t* celix_serviceRegistry_getSnapshotEntries(celix_service_registry_snapshot_t *snapshot, const char *name);
+static void celix_serviceRegistry_publishRegistrationsBucket(celix_service_registry_t *registry, const char *name);
+static void celix_serviceRegistry_publishRegistrationBuckets(celix_service_registry_t *registry, service_registration_t *registration);
+static void celix_serviceRegistry_publishListenersBucket(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry);
+static void celix_serviceRegistry_registrationModified(celix_service_registry_t *registry, service_registration_t *registration);
+
 celix_status_t serviceRegistry_create(framework_pt framework, service_registry_pt *out) {
 	celix_status_t status;
 
@@ -76,23 +97,35 @@ celix_status_t serviceRegistry_create(framework_pt framework, service_registry_p
         reg->callback.handle = reg;
         reg->callback.getUsingBundles = (void *)serviceRegistry_getUsingBundles;
         reg->callback.unregister = (void *) serviceRegistry_unregisterService;
+        reg->callback.modified = (void *) celix_serviceRegistry_registrationModified;
 
 		reg->serviceRegistrations = hashMap_create(NULL, NULL, NULL, NULL);
+		reg->serviceRegistrationsByName = celix_stringHashMap_create();
 		reg->framework = framework;
 		reg->nextServiceId = 1L;
 		reg->serviceReferences = hashMap_create(NULL, NULL, NULL, NULL);
+		reg->referencePool = celix_objectPool_create(sizeof(struct serviceReference), 0);
 
         reg->checkDeletedReferences = CHECK_DELETED_REFERENCES;
         reg->deletedServiceReferences = hashMap_create(NULL, NULL, NULL, NULL);
 
 		reg->listenerHooks = celix_arrayList_create();
 		reg->serviceListeners = celix_arrayList_create();
+		reg->serviceListenersByObjectClass = celix_stringHashMap_create();
+		reg->serviceListenersWithoutObjectClass = celix_arrayList_create();
 
 		celixThreadMutex_create(&reg->pendingRegisterEvents.mutex, NULL);
 		celixThreadCondition_init(&reg->pendingRegisterEvents.cond, NULL);
-		reg->pendingRegisterEvents.map = hashMap_create(NULL, NULL, NULL, NULL);
+		reg->pendingRegisterEvents.map = celix_longHashMap_create();
+
+		reg->epochDomain = celix_epochDomain_create();
+		reg->registrationsSnapshot = celix_serviceRegistry_createSnapshot(false);
+		reg->listenersSnapshot = celix_serviceRegistry_createSnapshot(true);
 
 		status = celixThreadRwlock_create(&reg->lock, NULL);
+		if (status == CELIX_SUCCESS && reg->epochDomain == NULL) {
+		    status = CELIX_ENOMEM;
+		}
 	}
 
 	if (status == CELIX_SUCCESS) {
@@ -114,10 +147,13 @@ celix_status_t serviceRegistry_destroy(service_registry_pt registry) {
     }
     for (int i = 0; i < size; ++i) {
         celix_service_registry_service_listener_entry_t *entry = celix_arrayList_get(registry->serviceListeners, i);
+        celix_serviceRegistry_removeServiceListenerFromBucket(registry, entry);
         celix_decreaseCountServiceListener(entry);
         celix_waitAndDestroyServiceListener(entry);
     }
     arrayList_destroy(registry->serviceListeners);
+    celix_stringHashMap_destroy(registry->serviceListenersByObjectClass);
+    celix_arrayList_destroy(registry->serviceListenersWithoutObjectClass);
 
     //destroy service registration map
     size = hashMap_size(registry->serviceRegistrations);
@@ -140,12 +176,27 @@ celix_status_t serviceRegistry_destroy(service_registry_pt registry) {
     assert(size == 0);
     hashMap_destroy(registry->serviceRegistrations, false, false);
 
+    //destroy service registration by name index, note the lists are already empty if the registrations map was empty
+    CELIX_STRING_HASH_MAP_ITERATE(registry->serviceRegistrationsByName, nameIter) {
+        celix_arrayList_destroy(nameIter.value);
+    }
+    celix_stringHashMap_destroy(registry->serviceRegistrationsByName);
+
     //destroy service references (double) map);
-    size = hashMap_size(registry->serviceReferences);
+    size = 0;
+    iter = hashMapIterator_construct(registry->serviceReferences);
+    while (hashMapIterator_hasNext(&iter)) {
+        celix_long_hash_map_t *refsMap = hashMapIterator_nextValue(&iter);
+        size += (int)celix_longHashMap_size(refsMap);
+        celix_longHashMap_destroy(refsMap);
+    }
     if (size > 0) {
         fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Unexpected service references left in the service registry! Nr of references: %i", size);
     }
     hashMap_destroy(registry->serviceReferences, false, false);
+    if (celix_objectPool_nrOfAllocatedObjects(registry->referencePool) == 0) {
+        celix_objectPool_destroy(registry->referencePool);
+    } //else dangling references are still using the pool, leak the pool instead of invalidating them
 
     //destroy listener hooks
     size = celix_arrayList_size(registry->listenerHooks);
@@ -157,11 +208,16 @@ celix_status_t serviceRegistry_destroy(service_registry_pt registry) {
 
     hashMap_destroy(registry->deletedServiceReferences, false, false);
 
-    size = hashMap_size(registry->pendingRegisterEvents.map);
+    size = (int)celix_longHashMap_size(registry->pendingRegisterEvents.map);
     assert(size == 0);
     celixThreadMutex_destroy(&registry->pendingRegisterEvents.mutex);
     celixThreadCondition_destroy(&registry->pendingRegisterEvents.cond);
-    hashMap_destroy(registry->pendingRegisterEvents.map, false, false);
+    celix_longHashMap_destroy(registry->pendingRegisterEvents.map);
+
+    //no readers left, the current snapshots can be destroyed directly
+    celix_serviceRegistry_destroySnapshotAndBuckets(registry->registrationsSnapshot);
+    celix_serviceRegistry_destroySnapshotAndBuckets(registry->listenersSnapshot);
+    celix_epochDomain_destroy(registry->epochDomain);
 
     free(registry);
 
@@ -205,31 +261,48 @@ celix_status_t serviceRegistry_registerServiceFactory(service_registry_pt regist
     return serviceRegistry_registerServiceInternal(registry, bundle, serviceName, (const void *) factory, dictionary, CELIX_DEPRECATED_FACTORY_SERVICE, registration);
 }
 
-static celix_status_t serviceRegistry_registerServiceInternal(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, enum celix_service_type svcType, service_registration_pt *registration) {
-	array_list_pt regs;
+static service_registration_t* serviceRegistry_createRegistration(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, enum celix_service_type svcType) {
+    service_registration_t *registration;
 	long svcId = celix_serviceRegistry_nextSvcId(registry);
 
 	if (svcType == CELIX_DEPRECATED_FACTORY_SERVICE) {
-        *registration = serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName,
+        registration = serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName,
                                                                  svcId, serviceObject,
                                                                  dictionary);
     } else if (svcType == CELIX_FACTORY_SERVICE) {
-        *registration = celix_serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName, svcId, (celix_service_factory_t*)serviceObject, dictionary);
+        registration = celix_serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName, svcId, (celix_service_factory_t*)serviceObject, dictionary);
 	} else { //plain
-	    *registration = serviceRegistration_create(registry->callback, bundle, serviceName, svcId, serviceObject, dictionary);
+	    registration = serviceRegistration_create(registry->callback, bundle, serviceName, svcId, serviceObject, dictionary);
 	}
 	//printf("Registering service %li with name %s\n", svcId, serviceName);
 
-    serviceRegistry_addHooks(registry, serviceName, serviceObject, *registration);
+    serviceRegistry_addHooks(registry, serviceName, serviceObject, registration);
+    return registration;
+}
 
-	celixThreadRwlock_writeLock(&registry->lock);
-	regs = (array_list_pt) hashMap_get(registry->serviceRegistrations, bundle);
+/**
+ * Adds a created registration to the registry indices. Should be called with the registry write lock taken.
+ * Note that the registrations snapshot is not published, this is left to the caller.
+ */
+static void serviceRegistry_addRegistrationLocked(service_registry_pt registry, bundle_pt bundle, service_registration_t *registration) {
+	array_list_pt regs = (array_list_pt) hashMap_get(registry->serviceRegistrations, bundle);
 	if (regs == NULL) {
 		regs = NULL;
 		arrayList_create(&regs);
         hashMap_put(registry->serviceRegistrations, bundle, regs);
     }
-	arrayList_add(regs, *registration);
+	arrayList_add(regs, registration);
+	celix_serviceRegistry_addToNameIndex(registry, registration);
+	registration->isRegistered = true;
+}
+
+static celix_status_t serviceRegistry_registerServiceInternal(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, enum celix_service_type svcType, service_registration_pt *registration) {
+    *registration = serviceRegistry_createRegistration(registry, bundle, serviceName, serviceObject, dictionary, svcType);
+    long svcId = serviceRegistration_getServiceId(*registration);
+
+	celixThreadRwlock_writeLock(&registry->lock);
+	serviceRegistry_addRegistrationLocked(registry, bundle, *registration);
+	celix_serviceRegistry_publishRegistrationBuckets(registry, *registration);
 
     //update pending register event
     celix_increasePendingRegisteredEvent(registry, svcId);
@@ -248,6 +321,92 @@ static celix_status_t serviceRegistry_registerServiceInternal(service_registry_p
 	return CELIX_SUCCESS;
 }
 
+celix_status_t celix_serviceRegistry_registerServices(
+        celix_service_registry_t *registry,
+        const celix_bundle_t *bnd,
+        celix_service_registry_registration_entry_t *entries,
+        size_t nrOfEntries,
+        bool fireRegisteredEvents) {
+    if (nrOfEntries == 0) {
+        return CELIX_SUCCESS;
+    }
+    celix_bundle_t *bundle = (celix_bundle_t*)bnd;
+    service_registration_t **registrations = malloc(nrOfEntries * sizeof(*registrations));
+    if (registrations == NULL) {
+        return CELIX_ENOMEM;
+    }
+
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        celix_service_registry_registration_entry_t *entry = &entries[i];
+        enum celix_service_type svcType = entry->factory ? CELIX_FACTORY_SERVICE : CELIX_PLAIN_SERVICE;
+        entry->registration = serviceRegistry_createRegistration(registry, bundle, entry->serviceName, entry->svc, entry->properties, svcType);
+        registrations[i] = entry->registration;
+    }
+
+    //add all registrations and publish every changed snapshot bucket once under one write lock acquisition.
+    //The registrations are marked as pending with the current listener sequence number: service listeners added
+    //after this point get the REGISTERED event from celix_serviceRegistry_addServiceListener and are skipped when the
+    //REGISTERED events are delivered.
+    celix_string_hash_map_t *changedNames = celix_stringHashMap_create();
+    celixThreadRwlock_writeLock(&registry->lock);
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        serviceRegistry_addRegistrationLocked(registry, bundle, registrations[i]);
+        registrations[i]->registeredEventPending = true;
+        registrations[i]->registeredListenerSeq = registry->nextListenerSeq;
+        const char *svcName = NULL;
+        const char *objectClass = NULL;
+        celix_serviceRegistry_getIndexNames(registrations[i], &svcName, &objectClass);
+        celix_stringHashMap_put(changedNames, svcName, NULL);
+        if (objectClass != NULL) {
+            celix_stringHashMap_put(changedNames, objectClass, NULL);
+        }
+    }
+    CELIX_STRING_HASH_MAP_ITERATE(changedNames, iter) {
+        celix_serviceRegistry_publishRegistrationsBucket(registry, iter.key);
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+    celix_stringHashMap_destroy(changedNames);
+
+    if (fireRegisteredEvents) {
+        celix_serviceRegistry_deliverRegisteredEvents(registry, registrations, nrOfEntries);
+    }
+    free(registrations);
+    return CELIX_SUCCESS;
+}
+
+void celix_serviceRegistry_deliverRegisteredEvents(celix_service_registry_t *registry, service_registration_t **registrations, size_t nrOfRegistrations) {
+    service_registration_t **stillRegistered = malloc(nrOfRegistrations * sizeof(*stillRegistered));
+    if (stillRegistered == NULL) {
+        return;
+    }
+    size_t nrOfStillRegistered = 0;
+
+    //note the pending flag is cleared and the matching listeners are collected under the registry write lock.
+    //Only listeners added before the registration get the REGISTERED event from here, listeners added after the
+    //registration get it from celix_serviceRegistry_addServiceListener, so every listener gets exactly one REGISTERED
+    //event. The pending register event count ensures that a concurrent unregister waits for the events to be delivered.
+    celixThreadRwlock_writeLock(&registry->lock);
+    for (size_t i = 0; i < nrOfRegistrations; ++i) {
+        if (registrations[i]->isRegistered && registrations[i]->registeredEventPending) {
+            registrations[i]->registeredEventPending = false;
+            celix_increasePendingRegisteredEvent(registry, serviceRegistration_getServiceId(registrations[i]));
+            stillRegistered[nrOfStillRegistered++] = registrations[i];
+        }
+    }
+    celix_array_list_t **matchedEntries = celix_serviceRegistry_collectRegisteredEventListeners(registry, stillRegistered, nrOfStillRegistered);
+    celixThreadRwlock_unlock(&registry->lock);
+
+    for (size_t i = 0; i < nrOfStillRegistered; ++i) {
+        if (matchedEntries != NULL) {
+            celix_serviceRegistry_invokeServiceListeners(registry, OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED, stillRegistered[i], matchedEntries[i]);
+            celix_arrayList_destroy(matchedEntries[i]);
+        }
+        celix_decreasePendingRegisteredEvent(registry, serviceRegistration_getServiceId(stillRegistered[i]));
+    }
+    free(matchedEntries);
+    free(stillRegistered);
+}
+
 celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, bundle_pt bundle, service_registration_pt registration) {
 	// array_list_t clients;
 	celix_array_list_t *regs;
@@ -262,6 +421,11 @@ celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, b
 	serviceRegistry_removeHook(registry, registration);
 
 	celixThreadRwlock_writeLock(&registry->lock);
+	registration->isRegistered = false;
+	//if the REGISTERED events were never delivered, only the listeners added after the registration have seen the
+	//service (see celix_serviceRegistry_addServiceListener) and only those should get the UNREGISTERING event
+	unsigned long unregisteringFromSeq = registration->registeredEventPending ? registration->registeredListenerSeq : 0;
+	registration->registeredEventPending = false;
 	regs = (celix_array_list_t*) hashMap_get(registry->serviceRegistrations, bundle);
 	if (regs != NULL) {
 		arrayList_removeElement(regs, registration);
@@ -271,21 +435,23 @@ celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, b
             hashMap_remove(registry->serviceRegistrations, bundle);
         }
 	}
+	celix_serviceRegistry_removeFromNameIndex(registry, registration);
+	celix_serviceRegistry_publishRegistrationBuckets(registry, registration);
 	celixThreadRwlock_unlock(&registry->lock);
 
 
     //check and wait for pending register events
     celix_waitForPendingRegisteredEvents(registry, svcId);
 
-    celix_serviceRegistry_serviceChanged(registry, OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING, registration);
+    celix_serviceRegistry_serviceChangedForListeners(registry, OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING, registration, unregisteringFromSeq, ULONG_MAX);
 
     celixThreadRwlock_readLock(&registry->lock);
     //invalidate service references
     hash_map_iterator_pt iter = hashMapIterator_create(registry->serviceReferences);
     while (hashMapIterator_hasNext(iter)) {
-        hash_map_pt refsMap = hashMapIterator_nextValue(iter);
+        celix_long_hash_map_t *refsMap = hashMapIterator_nextValue(iter);
         service_reference_pt ref = refsMap != NULL ?
-                                   hashMap_get(refsMap, (void*)registration->serviceId) : NULL;
+                                   celix_longHashMap_get(refsMap, registration->serviceId) : NULL;
         if (ref != NULL) {
             serviceReference_invalidate(ref);
         }
@@ -294,6 +460,9 @@ celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, b
 	celixThreadRwlock_unlock(&registry->lock);
 
 	serviceRegistration_invalidate(registration);
+
+    //lock free readers can still use the registration from an older snapshot, wait for them before releasing it
+    celix_epochDomain_synchronize(registry->epochDomain);
     serviceRegistration_release(registration);
 
 	return CELIX_SUCCESS;
@@ -321,7 +490,11 @@ celix_status_t serviceRegistry_clearServiceRegistrations(service_registry_pt reg
             serviceRegistration_unregister(reg);
         }
         else {
+            celixThreadRwlock_writeLock(&registry->lock);
             arrayList_remove(registrations, 0);
+            celix_serviceRegistry_removeFromNameIndex(registry, reg);
+            celix_serviceRegistry_publishRegistrationBuckets(registry, reg);
+            celixThreadRwlock_unlock(&registry->lock);
         }
 
         // not removed by last unregister call?
@@ -361,23 +534,23 @@ static celix_status_t serviceRegistry_getServiceReference_internal(service_regis
 	celix_status_t status = CELIX_SUCCESS;
 	bundle_pt bundle = NULL;
     service_reference_pt ref = NULL;
-    hash_map_pt references = NULL;
+    celix_long_hash_map_t *references = NULL;
 
     references = hashMap_get(registry->serviceReferences, owner);
     if (references == NULL) {
-        references = hashMap_create(NULL, NULL, NULL, NULL);
+        references = celix_longHashMap_create();
         hashMap_put(registry->serviceReferences, owner, references);
 	}
 
-    ref = hashMap_get(references, (void*)registration->serviceId);
+    ref = celix_longHashMap_get(references, registration->serviceId);
 
     if (ref == NULL) {
         status = serviceRegistration_getBundle(registration, &bundle);
         if (status == CELIX_SUCCESS) {
-            status = serviceReference_create(registry->callback, owner, registration, &ref);
+            status = serviceReference_create(registry->callback, registry->referencePool, owner, registration, &ref);
         }
         if (status == CELIX_SUCCESS) {
-            hashMap_put(references, (void*)registration->serviceId, ref);
+            celix_longHashMap_put(references, registration->serviceId, ref);
             hashMap_put(registry->deletedServiceReferences, ref, (void *)false);
         }
     } else {
@@ -396,54 +569,30 @@ static celix_status_t serviceRegistry_getServiceReference_internal(service_regis
 
 celix_status_t serviceRegistry_getServiceReferences(service_registry_pt registry, bundle_pt owner, const char *serviceName, filter_pt filter, array_list_pt *out) {
 	celix_status_t status;
-	hash_map_iterator_pt iterator;
     array_list_pt references = NULL;
 	array_list_pt matchingRegistrations = NULL;
-    bool matchResult;
 
     status = arrayList_create(&references);
     status = CELIX_DO_IF(status, arrayList_create(&matchingRegistrations));
 
-    celixThreadRwlock_readLock(&registry->lock);
-	iterator = hashMapIterator_create(registry->serviceRegistrations);
-	while (status == CELIX_SUCCESS && hashMapIterator_hasNext(iterator)) {
-		array_list_pt regs = (array_list_pt) hashMapIterator_nextValue(iterator);
-		unsigned int regIdx;
-		for (regIdx = 0; (regs != NULL) && regIdx < arrayList_size(regs); regIdx++) {
-			service_registration_pt registration = (service_registration_pt) arrayList_get(regs, regIdx);
-			properties_pt props = NULL;
-
-			status = serviceRegistration_getProperties(registration, &props);
-			if (status == CELIX_SUCCESS) {
-				bool matched = false;
-				matchResult = false;
-				if (filter != NULL) {
-					filter_match(filter, props, &matchResult);
-				}
-				if ((serviceName == NULL) && ((filter == NULL) || matchResult)) {
-					matched = true;
-				} else if (serviceName != NULL) {
-					const char *className = NULL;
-					matchResult = false;
-					serviceRegistration_getServiceName(registration, &className);
-					if (filter != NULL) {
-						filter_match(filter, props, &matchResult);
-					}
-					if ((strcmp(className, serviceName) == 0) && ((filter == NULL) || matchResult)) {
-						matched = true;
-					}
-				}
-				if (matched) {
-					if (serviceRegistration_isValid(registration)) {
-                        serviceRegistration_retain(registration);
-                        arrayList_add(matchingRegistrations, registration);
-					}
-				}
-			}
-		}
-	}
-    celixThreadRwlock_unlock(&registry->lock);
-	hashMapIterator_destroy(iterator);
+    //if the service name is known (directly or as required objectClass in the filter) only the indexed candidates are checked
+    const char *indexName = serviceName != NULL ? serviceName : celix_serviceRegistry_findRequiredObjectClass(filter);
+
+    //lock free lookup on the registrations snapshot
+    celix_epochDomain_enter(registry->epochDomain);
+    if (status == CELIX_SUCCESS) {
+        celix_service_registry_snapshot_t *snapshot = __atomic_load_n(&registry->registrationsSnapshot, __ATOMIC_ACQUIRE);
+        if (indexName != NULL) {
+            celix_serviceRegistry_collectMatchingRegistrations(celix_serviceRegistry_getSnapshotEntries(snapshot, indexName), serviceName, filter, matchingRegistrations);
+        } else {
+            //all buckets, a registration is only taken from the bucket of its service name (it can also be indexed on its objectClass)
+            CELIX_STRING_HASH_MAP_ITERATE(snapshot->byName, iter) {
+                celix_service_registry_snapshot_bucket_t *bucket = iter.value;
+                celix_serviceRegistry_collectMatchingRegistrations(__atomic_load_n(&bucket->entries, __ATOMIC_ACQUIRE), iter.key, filter, matchingRegistrations);
+            }
+        }
+    }
+    celix_epochDomain_exit(registry->epochDomain);
 
     if (status == CELIX_SUCCESS) {
         unsigned int i;
@@ -510,6 +659,7 @@ celix_status_t serviceRegistry_ungetServiceReference(service_registry_pt registr
     celixThreadRwlock_writeLock(&registry->lock);
     serviceRegistry_checkReference(registry, reference, &refStatus);
     if (refStatus == REF_ACTIVE) {
+        long refId = serviceReference_getServiceId(reference); //note reference can be destroyed by the release
         serviceReference_getUsageCount(reference, &count);
         serviceReference_release(reference, &destroyed);
         if (destroyed) {
@@ -518,34 +668,12 @@ celix_status_t serviceRegistry_ungetServiceReference(service_registry_pt registr
                 serviceRegistry_logWarningServiceReferenceUsageCount(registry, bundle, reference, count, 0);
             }
 
-            hash_map_pt refsMap = hashMap_get(registry->serviceReferences, bundle);
-
-            unsigned long refId = 0UL;
-            service_reference_pt ref = NULL;
-
-            if (refsMap != NULL) {
-                hash_map_iterator_t iter = hashMapIterator_construct(refsMap);
-                while (hashMapIterator_hasNext(&iter)) {
-                    hash_map_entry_pt entry = hashMapIterator_nextEntry(&iter);
-                    refId = (unsigned long) hashMapEntry_getKey(entry); //note could be invalid e.g. freed
-                    ref = hashMapEntry_getValue(entry);
-
-                    if (ref == reference) {
-                        break;
-                    } else {
-                        ref = NULL;
-                        refId = 0UL;
-                    }
-                }
-            }
+            celix_long_hash_map_t *refsMap = hashMap_get(registry->serviceReferences, bundle);
+            service_reference_pt ref = refsMap != NULL ? celix_longHashMap_get(refsMap, refId) : NULL;
 
-            if (ref != NULL) {
-                hashMap_remove(refsMap, (void*)refId);
-                int size = hashMap_size(refsMap);
-                if (size == 0) {
-                    hashMap_destroy(refsMap, false, false);
-                    hashMap_remove(registry->serviceReferences, bundle);
-                }
+            if (ref == reference) {
+                //note the (empty) references map is kept for the bundle, to prevent recreating it for every service event
+                celix_longHashMap_remove(refsMap, refId);
                 serviceRegistry_setReferenceStatus(registry, reference, true);
             } else {
                 fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot find reference %p in serviceReferences map",
@@ -627,11 +755,10 @@ celix_status_t serviceRegistry_clearReferencesFor(service_registry_pt registry,
 
     celixThreadRwlock_writeLock(&registry->lock);
 
-    hash_map_pt refsMap = hashMap_remove(registry->serviceReferences, bundle);
+    celix_long_hash_map_t *refsMap = hashMap_remove(registry->serviceReferences, bundle);
     if (refsMap != NULL) {
-        hash_map_iterator_pt iter = hashMapIterator_create(refsMap);
-        while (hashMapIterator_hasNext(iter)) {
-            service_reference_pt ref = hashMapIterator_nextValue(iter);
+        CELIX_LONG_HASH_MAP_ITERATE(refsMap, iter) {
+            service_reference_pt ref = iter.value;
             size_t refCount;
             size_t usageCount;
 
@@ -650,8 +777,7 @@ celix_status_t serviceRegistry_clearReferencesFor(service_registry_pt registry,
             serviceRegistry_setReferenceStatus(registry, ref, true);
 
         }
-        hashMapIterator_destroy(iter);
-        hashMap_destroy(refsMap, false, false);
+        celix_longHashMap_destroy(refsMap);
     }
 
     celixThreadRwlock_unlock(&registry->lock);
@@ -668,15 +794,12 @@ celix_status_t serviceRegistry_getServicesInUse(service_registry_pt registry, bu
     //LOCK
     celixThreadRwlock_readLock(&registry->lock);
 
-    hash_map_pt refsMap = hashMap_get(registry->serviceReferences, bundle);
+    celix_long_hash_map_t *refsMap = hashMap_get(registry->serviceReferences, bundle);
 
     if(refsMap) {
-        hash_map_iterator_pt iter = hashMapIterator_create(refsMap);
-        while (hashMapIterator_hasNext(iter)) {
-            service_reference_pt ref = hashMapIterator_nextValue(iter);
-            arrayList_add(result, ref);
+        CELIX_LONG_HASH_MAP_ITERATE(refsMap, iter) {
+            arrayList_add(result, iter.value);
         }
-        hashMapIterator_destroy(iter);
     }
 
     //UNLOCK
@@ -932,8 +1055,8 @@ static celix_status_t serviceRegistry_getUsingBundles(service_registry_pt regist
         while (hashMapIterator_hasNext(iter)) {
             hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
             bundle_pt registrationUser = hashMapEntry_getKey(entry);
-            hash_map_pt regMap = hashMapEntry_getValue(entry);
-            if (hashMap_containsKey(regMap, (void*)registration->serviceId)) {
+            celix_long_hash_map_t *regMap = hashMapEntry_getValue(entry);
+            if (celix_longHashMap_hasKey(regMap, registration->serviceId)) {
                 arrayList_add(bundles, registrationUser);
             }
         }
@@ -1112,6 +1235,7 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
     celix_service_registry_service_listener_entry_t *entry = calloc(1, sizeof(*entry));
     entry->bundle = bundle;
     entry->filter = filter;
+    entry->objectClass = celix_serviceRegistry_findRequiredObjectClass(filter);
     entry->listener = listener;
     entry->useCount = 1; //new entry -> count on 1
     celixThreadMutex_create(&entry->mutex, NULL);
@@ -1120,22 +1244,36 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
     celix_array_list_t *registrations =  celix_arrayList_create();
 
     celixThreadRwlock_writeLock(&registry->lock);
+    entry->seq = registry->nextListenerSeq++;
     celix_arrayList_add(registry->serviceListeners, entry); //use count 1
+    celix_serviceRegistry_addServiceListenerToBucket(registry, entry);
+    celix_serviceRegistry_publishListenersBucket(registry, entry);
 
-    //find already registered services
-    hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_array_list_t *regs = (array_list_pt) hashMapIterator_nextValue(&iter);
+    //find already registered services. Note that this includes registrations for which the REGISTERED events are
+    //still pending, celix_serviceRegistry_deliverRegisteredEvents skips listeners added after the registration.
+    if (entry->objectClass != NULL) {
+        celix_array_list_t *regs = celix_stringHashMap_get(registry->serviceRegistrationsByName, entry->objectClass);
         for (int regIdx = 0; (regs != NULL) && regIdx < celix_arrayList_size(regs); ++regIdx) {
             service_registration_pt registration = celix_arrayList_get(regs, regIdx);
-            properties_pt props = NULL;
-            serviceRegistration_getProperties(registration, &props);
-            if (celix_filter_match(filter, props)) {
+            if (celix_serviceRegistry_registrationMatches(registration, NULL, filter)) {
                 serviceRegistration_retain(registration);
-                long svcId = serviceRegistration_getServiceId(registration);
                 celix_arrayList_add(registrations, registration);
                 //update pending register event count
-                celix_increasePendingRegisteredEvent(registry, svcId);
+                celix_increasePendingRegisteredEvent(registry, serviceRegistration_getServiceId(registration));
+            }
+        }
+    } else {
+        hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
+        while (hashMapIterator_hasNext(&iter)) {
+            celix_array_list_t *regs = (array_list_pt) hashMapIterator_nextValue(&iter);
+            for (int regIdx = 0; (regs != NULL) && regIdx < celix_arrayList_size(regs); ++regIdx) {
+                service_registration_pt registration = celix_arrayList_get(regs, regIdx);
+                if (celix_serviceRegistry_registrationMatches(registration, NULL, filter)) {
+                    serviceRegistration_retain(registration);
+                    celix_arrayList_add(registrations, registration);
+                    //update pending register event count
+                    celix_increasePendingRegisteredEvent(registry, serviceRegistration_getServiceId(registration));
+                }
             }
         }
     }
@@ -1150,12 +1288,13 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
         service_registration_pt reg = celix_arrayList_get(registrations, i);
         long svcId = serviceRegistration_getServiceId(reg);
         service_reference_pt ref = NULL;
-        serviceRegistry_getServiceReference_internal(registry, bundle, reg, &ref);
+        serviceRegistry_getServiceReference(registry, bundle, reg, &ref);
         celix_service_event_t event;
         event.reference = ref;
         event.type = OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED;
         listener->serviceChanged(listener->handle, &event);
-        serviceReference_release(ref, NULL);
+        //note unget (and not only release) the reference, so that a destroyed reference is also removed from the bundle references
+        serviceRegistry_ungetServiceReference(registry, bundle, ref);
         serviceRegistration_release(reg);
 
         //update pending register event count
@@ -1178,12 +1317,16 @@ celix_status_t celix_serviceRegistry_removeServiceListener(celix_service_registr
         if (visit->listener == listener) {
             entry = visit;
             celix_arrayList_removeAt(registry->serviceListeners, i);
+            celix_serviceRegistry_removeServiceListenerFromBucket(registry, entry);
+            celix_serviceRegistry_publishListenersBucket(registry, entry);
             break;
         }
     }
     celixThreadRwlock_unlock(&registry->lock);
 
     if (entry != NULL) {
+        //lock free readers can still use the entry from an older snapshot, wait for them before destroying it
+        celix_epochDomain_synchronize(registry->epochDomain);
         serviceRegistry_callHooksForListenerFilter(registry, entry->bundle, entry->filter, true);
         celix_waitAndDestroyServiceListener(entry);
     } else {
@@ -1193,37 +1336,68 @@ celix_status_t celix_serviceRegistry_removeServiceListener(celix_service_registr
     return CELIX_SUCCESS;
 }
 
-static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration) {
-    celix_service_registry_service_listener_entry_t *entry;
+/**
+ * Collects (and increases the use count of) the service listeners - added in the listener sequence range
+ * [fromSeq, toSeq) - matching the registration from a listeners snapshot.
+ * Should be called inside an epoch read section.
+ */
+static void celix_serviceRegistry_collectMatchingServiceListenersForRegistration(celix_service_registry_t *registry, celix_service_registry_snapshot_t *snapshot, service_registration_pt registration, unsigned long fromSeq, unsigned long toSeq, celix_array_list_t *matchedEntries) {
+    const char *svcName = NULL;
+    celix_properties_t *props = NULL;
+    serviceRegistration_getServiceName(registration, &svcName);
+    serviceRegistration_getProperties(registration, &props);
+    const char *objectClass = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, NULL);
 
-    celix_array_list_t* retainedEntries = celix_arrayList_create();
-    celix_array_list_t* matchedEntries = celix_arrayList_create();
+    //only the listeners which require the objectClass of the registration or no objectClass at all can match
+    celix_serviceRegistry_collectMatchingServiceListeners(registry, celix_serviceRegistry_getSnapshotEntries(snapshot, svcName), props, fromSeq, toSeq, matchedEntries);
+    if (objectClass != NULL && strcmp(objectClass, svcName) != 0) {
+        celix_serviceRegistry_collectMatchingServiceListeners(registry, celix_serviceRegistry_getSnapshotEntries(snapshot, objectClass), props, fromSeq, toSeq, matchedEntries);
+    }
+    celix_serviceRegistry_collectMatchingServiceListeners(registry, __atomic_load_n(&snapshot->unnamed->entries, __ATOMIC_ACQUIRE), props, fromSeq, toSeq, matchedEntries);
+}
 
-    celixThreadRwlock_readLock(&registry->lock);
-    for (int i = 0; i < celix_arrayList_size(registry->serviceListeners); ++i) {
-        entry = celix_arrayList_get(registry->serviceListeners, i);
-        celix_arrayList_add(retainedEntries, entry);
-        celix_increaseCountServiceListener(entry); //ensure that use count > 0, so that the listener cannot be destroyed until all pending event are handled.
+/**
+ * Collects the matching listeners for the REGISTERED events of multiple (batch) registrations in one pass from a single
+ * listeners snapshot. Only listeners added before the registration are collected.
+ * Returns an array with a list of matched listener entries per registration (or NULL).
+ */
+static celix_array_list_t** celix_serviceRegistry_collectRegisteredEventListeners(celix_service_registry_t *registry, service_registration_t **registrations, size_t nrOfRegistrations) {
+    if (nrOfRegistrations == 0) {
+        return NULL;
+    }
+    celix_array_list_t **matchedEntries = malloc(nrOfRegistrations * sizeof(*matchedEntries));
+    if (matchedEntries == NULL) {
+        return NULL;
     }
-    celixThreadRwlock_unlock(&registry->lock);
 
-    for (int i = 0; i < celix_arrayList_size(retainedEntries); ++i) {
-        entry = celix_arrayList_get(retainedEntries, i);
-        int matched = 0;
-        celix_properties_t *props = NULL;
-        bool matchResult = false;
-        serviceRegistration_getProperties(registration, &props);
-        if (entry->filter != NULL) {
-            filter_match(entry->filter, props, &matchResult);
-        }
-        matched = (entry->filter == NULL) || matchResult;
-        if (matched) {
-            celix_arrayList_add(matchedEntries, entry);
-        } else {
-            celix_decreaseCountServiceListener(entry); //Not a match -> release entry
-        }
+    celix_epochDomain_enter(registry->epochDomain);
+    celix_service_registry_snapshot_t *snapshot = __atomic_load_n(&registry->listenersSnapshot, __ATOMIC_ACQUIRE);
+    for (size_t i = 0; i < nrOfRegistrations; ++i) {
+        matchedEntries[i] = celix_arrayList_create();
+        celix_serviceRegistry_collectMatchingServiceListenersForRegistration(registry, snapshot, registrations[i], 0, registrations[i]->registeredListenerSeq, matchedEntries[i]);
     }
-    celix_arrayList_destroy(retainedEntries);
+    celix_epochDomain_exit(registry->epochDomain);
+    return matchedEntries;
+}
+
+static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration) {
+    celix_serviceRegistry_serviceChangedForListeners(registry, eventType, registration, 0, ULONG_MAX);
+}
+
+static void celix_serviceRegistry_serviceChangedForListeners(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration, unsigned long fromSeq, unsigned long toSeq) {
+    celix_array_list_t* matchedEntries = celix_arrayList_create();
+
+    celix_epochDomain_enter(registry->epochDomain);
+    celix_service_registry_snapshot_t *snapshot = __atomic_load_n(&registry->listenersSnapshot, __ATOMIC_ACQUIRE);
+    celix_serviceRegistry_collectMatchingServiceListenersForRegistration(registry, snapshot, registration, fromSeq, toSeq, matchedEntries);
+    celix_epochDomain_exit(registry->epochDomain);
+
+    celix_serviceRegistry_invokeServiceListeners(registry, eventType, registration, matchedEntries);
+    celix_arrayList_destroy(matchedEntries);
+}
+
+static void celix_serviceRegistry_invokeServiceListeners(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration, celix_array_list_t *matchedEntries) {
+    celix_service_registry_service_listener_entry_t *entry;
 
     /*
      * TODO FIXME, A deadlock can happen when (e.g.) a service is deregistered, triggering this fw_serviceChanged and
@@ -1245,27 +1419,26 @@ static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *regis
         serviceRegistry_ungetServiceReference(registry, entry->bundle, reference);
         celix_decreaseCountServiceListener(entry); //decrease usage, so that the listener can be destroyed (if use count is now 0)
     }
-    celix_arrayList_destroy(matchedEntries);
 }
 
 
 static void celix_increasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
-    long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+    long count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     count += 1;
-    hashMap_put(registry->pendingRegisterEvents.map, (void*)svcId, (void*)count);
+    celix_longHashMap_putLong(registry->pendingRegisterEvents.map, svcId, count);
     celixThreadMutex_unlock(&registry->pendingRegisterEvents.mutex);
 }
 
 static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
-    long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+    long count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     assert(count >= 1);
     count -= 1;
     if (count > 0) {
-        hashMap_put(registry->pendingRegisterEvents.map, (void *)svcId, (void *)count);
+        celix_longHashMap_putLong(registry->pendingRegisterEvents.map, svcId, count);
     } else {
-        hashMap_remove(registry->pendingRegisterEvents.map, (void*)svcId);
+        celix_longHashMap_remove(registry->pendingRegisterEvents.map, svcId);
     }
     celixThreadCondition_signal(&registry->pendingRegisterEvents.cond);
     celixThreadMutex_unlock(&registry->pendingRegisterEvents.mutex);
@@ -1273,10 +1446,10 @@ static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *regis
 
 static void celix_waitForPendingRegisteredEvents(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
-    long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+    long count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     while (count > 0) {
         celixThreadCondition_wait(&registry->pendingRegisterEvents.cond, &registry->pendingRegisterEvents.mutex);
-        count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+        count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     }
     celixThreadMutex_unlock(&registry->pendingRegisterEvents.mutex);
 }
@@ -1284,4 +1457,320 @@ static void celix_waitForPendingRegisteredEvents(celix_service_registry_t *regis
 long celix_serviceRegistry_nextSvcId(celix_service_registry_t* registry) {
     long scvId = __atomic_fetch_add(&registry->nextServiceId, 1, __ATOMIC_SEQ_CST);
     return scvId;
-}
\ No newline at end of file
+}
+static long celix_serviceRegistry_getRanking(service_registration_t *registration) {
+    celix_properties_t *props = NULL;
+    serviceRegistration_getProperties(registration, &props);
+    return celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_RANKING, 0);
+}
+
+static void celix_serviceRegistry_addToNameIndexForName(celix_service_registry_t *registry, const char *name, service_registration_t *registration) {
+    //precondition write locked on registry->lock
+    celix_array_list_t *regs = celix_stringHashMap_get(registry->serviceRegistrationsByName, name);
+    if (regs == NULL) {
+        regs = celix_arrayList_create();
+        celix_stringHashMap_put(registry->serviceRegistrationsByName, name, regs);
+    }
+
+    //insert sorted on ranking (high to low) and svc id (low to high)
+    long svcId = serviceRegistration_getServiceId(registration);
+    long ranking = celix_serviceRegistry_getRanking(registration);
+    int size = celix_arrayList_size(regs);
+    int insertIdx = size;
+    for (int i = 0; i < size; ++i) {
+        service_registration_t *visit = celix_arrayList_get(regs, i);
+        int cmp = utils_compareServiceIdsAndRanking(svcId, ranking, serviceRegistration_getServiceId(visit), celix_serviceRegistry_getRanking(visit));
+        if (cmp > 0) {
+            insertIdx = i;
+            break;
+        }
+    }
+    if (insertIdx == size) {
+        celix_arrayList_add(regs, registration);
+    } else {
+        arrayList_addIndex(regs, insertIdx, registration);
+    }
+}
+
+static void celix_serviceRegistry_removeFromNameIndexForName(celix_service_registry_t *registry, const char *name, service_registration_t *registration) {
+    //precondition write locked on registry->lock
+    celix_array_list_t *regs = celix_stringHashMap_get(registry->serviceRegistrationsByName, name);
+    if (regs != NULL) {
+        celix_arrayList_remove(regs, registration);
+        if (celix_arrayList_size(regs) == 0) {
+            celix_stringHashMap_remove(registry->serviceRegistrationsByName, name);
+            celix_arrayList_destroy(regs);
+        }
+    }
+}
+
+/**
+ * Re-sorts the registration in the service name index after its properties are changed, because the index is sorted
+ * on the service ranking property.
+ */
+static void celix_serviceRegistry_registrationModified(celix_service_registry_t *registry, service_registration_t *registration) {
+    celixThreadRwlock_writeLock(&registry->lock);
+    if (registration->isRegistered) {
+        celix_serviceRegistry_removeFromNameIndex(registry, registration);
+        celix_serviceRegistry_addToNameIndex(registry, registration);
+        celix_serviceRegistry_publishRegistrationBuckets(registry, registration);
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+}
+
+/**
+ * Returns the names a registration is indexed on: the service name and - if present and different - the objectClass
+ * property (otherwise objectClass is set to NULL), so that lookups on both the service name and objectClass filters can
+ * use the index.
+ */
+static void celix_serviceRegistry_getIndexNames(service_registration_t *registration, const char **svcName, const char **objectClass) {
+    celix_properties_t *props = NULL;
+    serviceRegistration_getServiceName(registration, svcName);
+    serviceRegistration_getProperties(registration, &props);
+    *objectClass = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, NULL);
+    if (*objectClass != NULL && strcmp(*objectClass, *svcName) == 0) {
+        *objectClass = NULL;
+    }
+}
+
+/**
+ * Adds the registration to the service name index, see celix_serviceRegistry_getIndexNames.
+ */
+static void celix_serviceRegistry_addToNameIndex(celix_service_registry_t *registry, service_registration_t *registration) {
+    //precondition write locked on registry->lock
+    const char *svcName = NULL;
+    const char *objectClass = NULL;
+    celix_serviceRegistry_getIndexNames(registration, &svcName, &objectClass);
+    celix_serviceRegistry_addToNameIndexForName(registry, svcName, registration);
+    if (objectClass != NULL) {
+        celix_serviceRegistry_addToNameIndexForName(registry, objectClass, registration);
+    }
+}
+
+static void celix_serviceRegistry_removeFromNameIndex(celix_service_registry_t *registry, service_registration_t *registration) {
+    //precondition write locked on registry->lock
+    const char *svcName = NULL;
+    const char *objectClass = NULL;
+    celix_serviceRegistry_getIndexNames(registration, &svcName, &objectClass);
+    celix_serviceRegistry_removeFromNameIndexForName(registry, svcName, registration);
+    if (objectClass != NULL) {
+        celix_serviceRegistry_removeFromNameIndexForName(registry, objectClass, registration);
+    }
+}
+
+/**
+ * Returns the objectClass value a filter requires, i.e. an (objectClass=<value>) equal operand at the top level or
+ * as part of (nested) AND operands. Returns NULL if the filter can match services without a specific objectClass.
+ */
+static const char* celix_serviceRegistry_findRequiredObjectClass(const celix_filter_t *filter) {
+    const char *result = NULL;
+    if (filter != NULL) {
+        if (filter->operand == CELIX_FILTER_OPERAND_AND) {
+            int size = celix_arrayList_size(filter->children);
+            for (int i = 0; i < size && result == NULL; ++i) {
+                celix_filter_t *child = celix_arrayList_get(filter->children, i);
+                result = celix_serviceRegistry_findRequiredObjectClass(child);
+            }
+        } else if (filter->operand == CELIX_FILTER_OPERAND_EQUAL && filter->attribute != NULL && strcmp(filter->attribute, OSGI_FRAMEWORK_OBJECTCLASS) == 0) {
+            result = filter->value;
+        }
+    }
+    return result;
+}
+
+static bool celix_serviceRegistry_registrationMatches(service_registration_t *registration, const char *serviceName, const celix_filter_t *filter) {
+    bool matched = serviceRegistration_isValid(registration);
+    if (matched && serviceName != NULL) {
+        const char *className = NULL;
+        serviceRegistration_getServiceName(registration, &className);
+        matched = className != NULL && strcmp(className, serviceName) == 0;
+    }
+    if (matched && filter != NULL) {
+        celix_properties_t *props = NULL;
+        serviceRegistration_getProperties(registration, &props);
+        matched = celix_filter_match(filter, props);
+    }
+    return matched;
+}
+
+static void celix_serviceRegistry_collectMatchingRegistrations(celix_array_list_t *regs, const char *serviceName, const celix_filter_t *filter, celix_array_list_t *matchingRegistrations) {
+    //precondition inside an epoch read section on a registrations snapshot
+    for (int regIdx = 0; (regs != NULL) && regIdx < celix_arrayList_size(regs); ++regIdx) {
+        service_registration_pt registration = celix_arrayList_get(regs, regIdx);
+        if (celix_serviceRegistry_registrationMatches(registration, serviceName, filter)) {
+            serviceRegistration_retain(registration);
+            celix_arrayList_add(matchingRegistrations, registration);
+        }
+    }
+}
+
+static void celix_serviceRegistry_addServiceListenerToBucket(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry) {
+    //precondition write locked on registry->lock
+    if (entry->objectClass != NULL) {
+        celix_array_list_t *bucket = celix_stringHashMap_get(registry->serviceListenersByObjectClass, entry->objectClass);
+        if (bucket == NULL) {
+            bucket = celix_arrayList_create();
+            celix_stringHashMap_put(registry->serviceListenersByObjectClass, entry->objectClass, bucket);
+        }
+        celix_arrayList_add(bucket, entry);
+    } else {
+        celix_arrayList_add(registry->serviceListenersWithoutObjectClass, entry);
+    }
+}
+
+static void celix_serviceRegistry_removeServiceListenerFromBucket(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry) {
+    //precondition write locked on registry->lock
+    if (entry->objectClass != NULL) {
+        celix_array_list_t *bucket = celix_stringHashMap_get(registry->serviceListenersByObjectClass, entry->objectClass);
+        if (bucket != NULL) {
+            celix_arrayList_remove(bucket, entry);
+            if (celix_arrayList_size(bucket) == 0) {
+                celix_stringHashMap_remove(registry->serviceListenersByObjectClass, entry->objectClass);
+                celix_arrayList_destroy(bucket);
+            }
+        }
+    } else {
+        celix_arrayList_remove(registry->serviceListenersWithoutObjectClass, entry);
+    }
+}
+
+static void celix_serviceRegistry_collectMatchingServiceListeners(celix_service_registry_t *registry __attribute__((unused)), celix_array_list_t *bucket, celix_properties_t *props, unsigned long fromSeq, unsigned long toSeq, celix_array_list_t *matchedEntries) {
+    //precondition inside an epoch read section on a listeners snapshot
+    int size = bucket != NULL ? celix_arrayList_size(bucket) : 0;
+    for (int i = 0; i < size; ++i) {
+        celix_service_registry_service_listener_entry_t *entry = celix_arrayList_get(bucket, i);
+        if (entry->seq < fromSeq || entry->seq >= toSeq) {
+            continue;
+        }
+        if (entry->filter == NULL || celix_filter_match(entry->filter, props)) {
+            celix_increaseCountServiceListener(entry); //ensure that use count > 0, so that the listener cannot be destroyed until all pending event are handled.
+            celix_arrayList_add(matchedEntries, entry);
+        }
+    }
+}
+
+static void celix_serviceRegistry_destroyEntriesList(void *list) {
+    celix_arrayList_destroy(list);
+}
+
+static celix_service_registry_snapshot_bucket_t* celix_serviceRegistry_createSnapshotBucket(celix_array_list_t *entries) {
+    celix_service_registry_snapshot_bucket_t *bucket = calloc(1, sizeof(*bucket));
+    bucket->entries = entries != NULL ? arrayList_clone(entries) : celix_arrayList_create();
+    return bucket;
+}
+
+static void celix_serviceRegistry_destroySnapshotBucket(void *data) {
+    celix_service_registry_snapshot_bucket_t *bucket = data;
+    if (bucket != NULL) {
+        celix_arrayList_destroy(bucket->entries);
+        free(bucket);
+    }
+}
+
+static celix_service_registry_snapshot_t* celix_serviceRegistry_createSnapshot(bool withUnnamed) {
+    celix_service_registry_snapshot_t *snapshot = calloc(1, sizeof(*snapshot));
+    snapshot->byName = celix_stringHashMap_create();
+    snapshot->unnamed = withUnnamed ? celix_serviceRegistry_createSnapshotBucket(NULL) : NULL;
+    return snapshot;
+}
+
+/**
+ * Creates a new snapshot version which shares the buckets (and the unnamed bucket) with the provided snapshot.
+ */
+static celix_service_registry_snapshot_t* celix_serviceRegistry_copySnapshot(const celix_service_registry_snapshot_t *snapshot) {
+    celix_service_registry_snapshot_t *copy = calloc(1, sizeof(*copy));
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.initialCapacity = (unsigned int)celix_stringHashMap_size(snapshot->byName) * 2;
+    copy->byName = celix_stringHashMap_createWithOptions(&opts);
+    CELIX_STRING_HASH_MAP_ITERATE(snapshot->byName, iter) {
+        celix_stringHashMap_put(copy->byName, iter.key, iter.value);
+    }
+    copy->unnamed = snapshot->unnamed;
+    return copy;
+}
+
+/**
+ * Destroys a retired snapshot version. The buckets are shared with newer versions and not destroyed.
+ */
+static void celix_serviceRegistry_destroySnapshot(void *data) {
+    celix_service_registry_snapshot_t *snapshot = data;
+    if (snapshot != NULL) {
+        celix_stringHashMap_destroy(snapshot->byName);
+        free(snapshot);
+    }
+}
+
+static void celix_serviceRegistry_destroySnapshotAndBuckets(celix_service_registry_snapshot_t *snapshot) {
+    CELIX_STRING_HASH_MAP_ITERATE(snapshot->byName, iter) {
+        celix_serviceRegistry_destroySnapshotBucket(iter.value);
+    }
+    celix_serviceRegistry_destroySnapshotBucket(snapshot->unnamed);
+    celix_serviceRegistry_destroySnapshot(snapshot);
+}
+
+static celix_array_list_t* celix_serviceRegistry_getSnapshotEntries(celix_service_registry_snapshot_t *snapshot, const char *name) {
+    //precondition inside an epoch read section on the snapshot
+    celix_service_registry_snapshot_bucket_t *bucket = celix_stringHashMap_get(snapshot->byName, name);
+    return bucket != NULL ? __atomic_load_n(&bucket->entries, __ATOMIC_ACQUIRE) : NULL;
+}
+
+static void celix_serviceRegistry_replaceSnapshotBucketEntries(celix_service_registry_t *registry, celix_service_registry_snapshot_bucket_t *bucket, celix_array_list_t *entries) {
+    //precondition write locked on registry->lock
+    celix_array_list_t *old = __atomic_exchange_n(&bucket->entries, arrayList_clone(entries), __ATOMIC_SEQ_CST);
+    celix_epochDomain_retire(registry->epochDomain, old, celix_serviceRegistry_destroyEntriesList);
+}
+
+/**
+ * Publishes the (possibly removed) index list for name in the snapshot. Only the bucket for name is copied; a new
+ * snapshot version is only published if the name is added to or removed from the snapshot.
+ */
+static void celix_serviceRegistry_publishSnapshotBucket(celix_service_registry_t *registry, celix_service_registry_snapshot_t **snapshotPtr, const char *name, celix_array_list_t *entries) {
+    //precondition write locked on registry->lock, snapshots are only replaced under the write lock
+    celix_service_registry_snapshot_t *snapshot = *snapshotPtr;
+    celix_service_registry_snapshot_bucket_t *bucket = celix_stringHashMap_get(snapshot->byName, name);
+    if (bucket != NULL && entries != NULL) {
+        celix_serviceRegistry_replaceSnapshotBucketEntries(registry, bucket, entries);
+    } else if (bucket != NULL || entries != NULL) {
+        celix_service_registry_snapshot_t *updated = celix_serviceRegistry_copySnapshot(snapshot);
+        if (entries != NULL) {
+            celix_stringHashMap_put(updated->byName, name, celix_serviceRegistry_createSnapshotBucket(entries));
+        } else {
+            celix_stringHashMap_remove(updated->byName, name);
+        }
+        celix_service_registry_snapshot_t *old = __atomic_exchange_n(snapshotPtr, updated, __ATOMIC_SEQ_CST);
+        celix_epochDomain_retire(registry->epochDomain, old, celix_serviceRegistry_destroySnapshot);
+        if (bucket != NULL) {
+            celix_epochDomain_retire(registry->epochDomain, bucket, celix_serviceRegistry_destroySnapshotBucket);
+        }
+    }
+}
+
+static void celix_serviceRegistry_publishRegistrationsBucket(celix_service_registry_t *registry, const char *name) {
+    //precondition write locked on registry->lock
+    celix_array_list_t *regs = celix_stringHashMap_get(registry->serviceRegistrationsByName, name);
+    celix_serviceRegistry_publishSnapshotBucket(registry, &registry->registrationsSnapshot, name, regs);
+}
+
+/**
+ * Publishes the snapshot buckets of the names the registration is indexed on.
+ */
+static void celix_serviceRegistry_publishRegistrationBuckets(celix_service_registry_t *registry, service_registration_t *registration) {
+    //precondition write locked on registry->lock
+    const char *svcName = NULL;
+    const char *objectClass = NULL;
+    celix_serviceRegistry_getIndexNames(registration, &svcName, &objectClass);
+    celix_serviceRegistry_publishRegistrationsBucket(registry, svcName);
+    if (objectClass != NULL) {
+        celix_serviceRegistry_publishRegistrationsBucket(registry, objectClass);
+    }
+}
+
+static void celix_serviceRegistry_publishListenersBucket(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry) {
+    //precondition write locked on registry->lock
+    if (entry->objectClass != NULL) {
+        celix_array_list_t *bucket = celix_stringHashMap_get(registry->serviceListenersByObjectClass, entry->objectClass);
+        celix_serviceRegistry_publishSnapshotBucket(registry, &registry->listenersSnapshot, entry->objectClass, bucket);
+    } else {
+        celix_serviceRegistry_replaceSnapshotBucketEntries(registry, registry->listenersSnapshot->unnamed, registry->serviceListenersWithoutObjectClass);
+    }
+}
@@ -31,6 +31,31 @@
 #include "service_registry.h"
 #include "listener_hook_service.h"
 #include "service_reference.h"
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
+#include "celix_epoch.h"
+#include "celix_object_pool.h"
+
+/**
+ * Read copy of a single registry index list. The entries list is immutable and replaced (copy-on-write) with an
+ * atomic pointer swap when the index list changes; the previous list is reclaimed through the registry epoch domain.
+ * Buckets are owned by the registry and shared between snapshot versions.
+ */
+typedef struct celix_service_registry_snapshot_bucket {
+    celix_array_list_t *entries; //accessed atomically
+} celix_service_registry_snapshot_bucket_t;
+
+/**
+ * Read copy of a registry index, used for lock free lookups.
+ * A new snapshot version - sharing the unchanged buckets - is only published (atomic pointer swap) when a name is
+ * added to or removed from the index; updates of an existing name only replace the entries of that bucket.
+ * The snapshot does not own the indexed registrations or listener entries, these are only released after an epoch
+ * grace period (see celix_epochDomain_synchronize).
+ */
+typedef struct celix_service_registry_snapshot {
+    celix_string_hash_map_t *byName; //key = service name or required objectClass, value = celix_service_registry_snapshot_bucket_t*
+    celix_service_registry_snapshot_bucket_t *unnamed; //listener entries without a required objectClass for the listeners snapshot, NULL for the registrations snapshot
+} celix_service_registry_snapshot_t;
 
 struct celix_serviceRegistry {
 	framework_pt framework;
@@ -39,15 +64,29 @@ struct celix_serviceRegistry {
     celix_thread_rwlock_t lock; //protect below
 
 	hash_map_t *serviceRegistrations; //key = bundle (reg owner), value = list ( registration )
-	hash_map_t *serviceReferences; //key = bundle, value = map (key = serviceId, value = reference)
+	celix_string_hash_map_t *serviceRegistrationsByName; //key = service name (objectClass), value = list ( registration ), sorted on ranking (high to low) and svc id (low to high)
+	hash_map_t *serviceReferences; //key = bundle, value = celix_long_hash_map_t (key = serviceId, value = reference). Maps are kept until the bundle references are cleared
+	celix_object_pool_t *referencePool; //pool for the service reference objects, references are created and destroyed for every service event
 
 	bool checkDeletedReferences; //If enabled. check if provided service references are still valid
 	hash_map_t *deletedServiceReferences; //key = ref pointer, value = bool
 
 	long nextServiceId;
+	unsigned long nextListenerSeq; //sequence number for the next added service listener
 
 	celix_array_list_t *listenerHooks; //celix_service_registry_listener_hook_entry_t*
 	celix_array_list_t *serviceListeners; //celix_service_registry_service_listener_entry_t*
+	celix_string_hash_map_t *serviceListenersByObjectClass; //key = objectClass required by the listener filter, value = list (celix_service_registry_service_listener_entry_t*)
+	celix_array_list_t *serviceListenersWithoutObjectClass; //celix_service_registry_service_listener_entry_t*, listeners with a filter that does not require an objectClass
+
+	/**
+	 * Read snapshots of the registration and service listener indices. Updated (under the write lock) for the changed
+	 * names on every register, unregister and service listener change and read - without taking the lock - inside an
+	 * epoch read section.
+	 */
+	celix_epoch_domain_t *epochDomain;
+	celix_service_registry_snapshot_t *registrationsSnapshot; //accessed atomically
+	celix_service_registry_snapshot_t *listenersSnapshot; //accessed atomically
 
 	/**
 	 * The pending register events are introduced to ensure UNREGISTERING events are always
@@ -61,7 +100,7 @@ struct celix_serviceRegistry {
 	struct {
 	    celix_thread_mutex_t mutex;
 	    celix_thread_cond_t cond;
-	    hash_map_t *map; //key = svc id, value = long (nr of pending register events)
+	    celix_long_hash_map_t *map; //key = svc id, value = long (nr of pending register events)
 	} pendingRegisterEvents;
 };
 
@@ -76,7 +115,9 @@ typedef struct celix_service_registry_listener_hook_entry {
 typedef struct celix_service_registry_service_listener_entry {
     celix_bundle_t *bundle;
     celix_filter_t *filter;
+    const char *objectClass; //objectClass required by the filter (points to the filter value) or NULL
     celix_service_listener_t *listener;
+    unsigned long seq; //order in which the service listeners are added, immutable after the entry is added
     celix_thread_mutex_t mutex; //protects below
     celix_thread_cond_t cond;
     unsigned int useCount;
@@ -37,6 +37,7 @@
 static celix_status_t serviceTracker_track(celix_service_tracker_instance_t *tracker, service_reference_pt reference, celix_service_event_t *event);
 static celix_status_t serviceTracker_untrack(celix_service_tracker_instance_t *tracker, service_reference_pt reference, celix_service_event_t *event);
 static void serviceTracker_untrackTracked(celix_service_tracker_instance_t *tracker, celix_tracked_entry_t *tracked);
+static void serviceTracker_addTrackedSorted(celix_service_tracker_instance_t *instance, celix_tracked_entry_t *tracked);
 static celix_status_t serviceTracker_invokeAddingService(celix_service_tracker_instance_t *tracker, service_reference_pt ref, void **svcOut);
 static celix_status_t serviceTracker_invokeAddService(celix_service_tracker_instance_t *tracker, celix_tracked_entry_t *tracked);
 static celix_status_t serviceTracker_invokeRemovingService(celix_service_tracker_instance_t *tracker, celix_tracked_entry_t *tracked);
@@ -76,6 +77,8 @@ static inline celix_tracked_entry_t* tracked_create(service_reference_pt ref, vo
     tracked->properties = props;
     tracked->serviceOwner = bnd;
     tracked->serviceName = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, "Error");
+    tracked->serviceId = celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_ID, -1);
+    tracked->serviceRanking = celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_RANKING, 0);
 
     tracked->useCount = 1;
     celixThreadMutex_create(&tracked->mutex, NULL);
@@ -137,6 +140,8 @@ celix_status_t serviceTracker_createWithFilter(bundle_context_pt context, const
 		(*tracker)->context = context;
 		(*tracker)->filter = strdup(filter);
         (*tracker)->customizer = customizer;
+        celixThreadMutex_create(&(*tracker)->waitMutex, NULL);
+        celixThreadCondition_init(&(*tracker)->trackedCond, NULL);
 	}
 
 	framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Cannot create service tracker [filter=%s]", filter);
@@ -149,6 +154,8 @@ celix_status_t serviceTracker_destroy(service_tracker_pt tracker) {
 	    serviceTrackerCustomizer_destroy(tracker->customizer);
 	}
 
+    celixThreadMutex_destroy(&tracker->waitMutex);
+    celixThreadCondition_destroy(&tracker->trackedCond);
     free(tracker->serviceName);
 	free(tracker->filter);
 	free(tracker);
@@ -167,6 +174,7 @@ celix_status_t serviceTracker_open(service_tracker_pt tracker) {
     if (tracker->instance == NULL) {
         instance = calloc(1, sizeof(*instance));
         instance->context = tracker->context;
+        instance->tracker = tracker;
 
         instance->closing = false;
         instance->activeServiceChangeCalls = 0;
@@ -463,6 +471,35 @@ static celix_status_t serviceTracker_track(celix_service_tracker_instance_t *ins
     }
     celixThreadRwlock_unlock(&instance->lock);
 
+    if (found != NULL && event->type == OSGI_FRAMEWORK_SERVICE_EVENT_MODIFIED) {
+        //ranking can be changed, resort if needed.
+        //note the registration properties are replaced on modification, so the entry is updated with the current
+        //properties of the registration
+        service_registration_t *reg = NULL;
+        celix_properties_t *props = NULL;
+        serviceReference_getServiceRegistration(reference, &reg);
+        if (reg != NULL) {
+            serviceRegistration_getProperties(reg, &props);
+        }
+        bool resorted = false;
+        celixThreadRwlock_writeLock(&instance->lock);
+        if (props != NULL) {
+            found->properties = props;
+            found->serviceName = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, "Error");
+            long ranking = celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_RANKING, 0);
+            if (ranking != found->serviceRanking) {
+                arrayList_removeElement(instance->trackedServices, found);
+                found->serviceRanking = ranking;
+                serviceTracker_addTrackedSorted(instance, found);
+                resorted = true;
+            }
+        }
+        celixThreadRwlock_unlock(&instance->lock);
+        if (resorted) {
+            serviceTracker_useHighestRankingServiceInternal(instance, found->serviceName, instance, NULL, NULL, serviceTracker_checkAndInvokeSetService);
+        }
+    }
+
     if (found == NULL) {
         //NEW entry
         void *service = NULL;
@@ -483,9 +520,15 @@ static celix_status_t serviceTracker_track(celix_service_tracker_instance_t *ins
             celix_tracked_entry_t *tracked = tracked_create(reference, service, props, bnd); //use count 1
 
             celixThreadRwlock_writeLock(&instance->lock);
-            arrayList_add(instance->trackedServices, tracked);
+            serviceTracker_addTrackedSorted(instance, tracked);
             celixThreadRwlock_unlock(&instance->lock);
 
+            //notify use calls waiting for a service
+            celixThreadMutex_lock(&instance->tracker->waitMutex);
+            instance->tracker->trackedCount += 1;
+            celixThreadCondition_broadcast(&instance->tracker->trackedCond);
+            celixThreadMutex_unlock(&instance->tracker->waitMutex);
+
             serviceTracker_invokeAddService(instance, tracked);
             serviceTracker_useHighestRankingServiceInternal(instance, tracked->serviceName, instance, NULL, NULL, serviceTracker_checkAndInvokeSetService);
         }
@@ -614,6 +657,25 @@ static celix_status_t serviceTracker_untrack(celix_service_tracker_instance_t* i
     return status;
 }
 
+static void serviceTracker_addTrackedSorted(celix_service_tracker_instance_t *instance, celix_tracked_entry_t *tracked) {
+    //precondition write locked on instance->lock
+    int size = celix_arrayList_size(instance->trackedServices);
+    int insertIdx = size;
+    for (int i = 0; i < size; ++i) {
+        celix_tracked_entry_t *visit = celix_arrayList_get(instance->trackedServices, i);
+        int cmp = utils_compareServiceIdsAndRanking(tracked->serviceId, tracked->serviceRanking, visit->serviceId, visit->serviceRanking);
+        if (cmp > 0) {
+            insertIdx = i;
+            break;
+        }
+    }
+    if (insertIdx == size) {
+        celix_arrayList_add(instance->trackedServices, tracked);
+    } else {
+        arrayList_addIndex(instance->trackedServices, insertIdx, tracked);
+    }
+}
+
 static void serviceTracker_untrackTracked(celix_service_tracker_instance_t *instance, celix_tracked_entry_t *tracked) {
     if (tracked != NULL) {
         serviceTracker_invokeRemovingService(instance, tracked);
@@ -692,6 +754,8 @@ celix_service_tracker_t* celix_serviceTracker_createWithOptions(
         if (tracker != NULL) {
             tracker->context = ctx;
             tracker->serviceName = celix_utils_strdup(opts->filter.serviceName);
+            celixThreadMutex_create(&tracker->waitMutex, NULL);
+            celixThreadCondition_init(&tracker->trackedCond, NULL);
 
             //setting callbacks
             tracker->callbackHandle = opts->callbackHandle;
@@ -789,22 +853,22 @@ static bool serviceTracker_useHighestRankingServiceInternal(celix_service_tracke
                                                             void (*useWithProperties)(void *handle, void *svc, const celix_properties_t *props),
                                                             void (*useWithOwner)(void *handle, void *svc, const celix_properties_t *props, const celix_bundle_t *owner)) {
     bool called = false;
-    celix_tracked_entry_t *tracked = NULL;
     celix_tracked_entry_t *highest = NULL;
-    long highestRank = 0;
-    unsigned int i;
 
-    //first lock tracker and get highest tracked entry
+    //first lock tracker and get highest tracked entry, the tracked services are sorted on ranking
     celixThreadRwlock_readLock(&instance->lock);
     unsigned int size = arrayList_size(instance->trackedServices);
-
-    for (i = 0; i < size; i++) {
-        tracked = (celix_tracked_entry_t *) arrayList_get(instance->trackedServices, i);
-        if (serviceName != NULL && tracked->serviceName != NULL && strncmp(tracked->serviceName, serviceName, 10*1024) == 0) {
-            const char *val = properties_getWithDefault(tracked->properties, OSGI_FRAMEWORK_SERVICE_RANKING, "0");
-            long rank = strtol(val, NULL, 10);
-            if (highest == NULL || rank > highestRank) {
-                highest = tracked;
+    if (size > 0 && serviceName != NULL) {
+        highest = arrayList_get(instance->trackedServices, 0);
+        if (highest->serviceName == NULL || strcmp(highest->serviceName, serviceName) != 0) {
+            //tracked services with different service names (e.g. tracker with a custom objectClass filter), find first matching
+            highest = NULL;
+            for (unsigned int i = 1; i < size; i++) {
+                celix_tracked_entry_t *tracked = arrayList_get(instance->trackedServices, i);
+                if (tracked->serviceName != NULL && strcmp(tracked->serviceName, serviceName) == 0) {
+                    highest = tracked;
+                    break;
+                }
             }
         }
     }
@@ -846,24 +910,38 @@ bool celix_serviceTracker_useHighestRankingService(
     bool called = false;
     struct timespec start, now;
     clock_gettime(CLOCK_MONOTONIC, &start);
-    do {
+    while (true) {
+        celixThreadMutex_lock(&tracker->waitMutex);
+        unsigned long trackedCount = tracker->trackedCount;
+        celixThreadMutex_unlock(&tracker->waitMutex);
+
         celixThreadRwlock_readLock(&tracker->instanceLock);
         if (tracker->instance != NULL) {
             called = serviceTracker_useHighestRankingServiceInternal(tracker->instance, serviceName, callbackHandle, use, useWithProperties, useWithOwner);
         }
         celixThreadRwlock_unlock(&tracker->instanceLock);
 
-        if (waitTimeoutInSeconds <= 0) {
+        if (called || waitTimeoutInSeconds <= 0) {
             break;
-        } else if (!called) {
+        }
+
+        //wait - for the remaining timeout - till a new service is tracked
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        double remaining = waitTimeoutInSeconds - celix_difftime(&start, &now);
+        celixThreadMutex_lock(&tracker->waitMutex);
+        while (tracker->trackedCount == trackedCount && remaining > 0) {
+            long seconds = (long)remaining;
+            long nanoseconds = (long)((remaining - (double)seconds) * 1000000000.0);
+            celixThreadCondition_timedwaitRelative(&tracker->trackedCond, &tracker->waitMutex, seconds, nanoseconds);
             clock_gettime(CLOCK_MONOTONIC, &now);
-            double diff = celix_difftime(&start, &now);
-            if (diff > waitTimeoutInSeconds) {
-                break;
-            }
-            usleep(10);
+            remaining = waitTimeoutInSeconds - celix_difftime(&start, &now);
+        }
+        bool newServiceTracked = tracker->trackedCount != trackedCount;
+        celixThreadMutex_unlock(&tracker->waitMutex);
+        if (!newServiceTracked) {
+            break; //timeout
         }
-    } while (!called);
+    }
     return called;
 }
 
@@ -54,12 +54,14 @@ typedef struct celix_service_tracker_instance {
 	void (*modifiedWithOwner)(void *handle, void *svc, const properties_t *props, const bundle_t *owner);
 
 	celix_thread_rwlock_t lock; //projects trackedServices
-	array_list_t *trackedServices;
+	array_list_t *trackedServices; //sorted on ranking (high to low) and svc id (low to high), first entry is the highest ranking service
 
 	celix_thread_mutex_t mutex; //protect current highest service id
 	long currentHighestServiceId;
 
 	celix_thread_t shutdownThread; //will be created when this instance is shutdown
+
+	celix_service_tracker_t *tracker; //owner, used to notify use calls waiting for a service
 } celix_service_tracker_instance_t;
 
 struct celix_serviceTracker {
@@ -89,6 +91,10 @@ struct celix_serviceTracker {
 	celix_thread_rwlock_t instanceLock;
 	celix_service_tracker_instance_t *instance; /*NULL -> close, !NULL->open*/
 
+	celix_thread_mutex_t waitMutex; //protects below
+	celix_thread_cond_t trackedCond; //broadcast when a new service is tracked
+	unsigned long trackedCount; //nr of services tracked, used to detect tracked services while waiting
+
 };
 
 typedef struct celix_tracked_entry {
@@ -97,6 +103,8 @@ typedef struct celix_tracked_entry {
 	const char *serviceName;
 	properties_t *properties;
 	bundle_t *serviceOwner;
+	long serviceId;
+	long serviceRanking; //updated on modified events, protected by the tracker instance lock
 
     celix_thread_mutex_t mutex; //protects useCount
 	celix_thread_cond_t useCond;
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include "celix_filter.h"
+
+/**
+ * Reference implementation of the previous (uncompiled) filter matching: string compare for all compare operands,
+ * an allocating substring matcher and evaluation of the AND/OR children in filter order.
+ */
+static bool legacyMatch(const celix_filter_t* filter, const celix_properties_t* props) {
+    switch (filter->operand) {
+        case CELIX_FILTER_OPERAND_AND:
+        case CELIX_FILTER_OPERAND_OR: {
+            bool isAnd = filter->operand == CELIX_FILTER_OPERAND_AND;
+            for (int i = 0; i < celix_arrayList_size(filter->children); ++i) {
+                auto* child = static_cast<celix_filter_t*>(celix_arrayList_get(filter->children, i));
+                if (legacyMatch(child, props) != isAnd) {
+                    return !isAnd;
+                }
+            }
+            return isAnd;
+        }
+        case CELIX_FILTER_OPERAND_NOT:
+            return !legacyMatch(static_cast<celix_filter_t*>(celix_arrayList_get(filter->children, 0)), props);
+        case CELIX_FILTER_OPERAND_PRESENT:
+            return celix_properties_get(props, filter->attribute, nullptr) != nullptr;
+        default:
+            break;
+    }
+    const char* value = celix_properties_get(props, filter->attribute, nullptr);
+    if (value == nullptr) {
+        return false;
+    }
+    switch (filter->operand) {
+        case CELIX_FILTER_OPERAND_SUBSTRING: {
+            size_t pos = 0;
+            int size = celix_arrayList_size(filter->children);
+            for (int i = 0; i < size; ++i) {
+                auto* substr = static_cast<char*>(celix_arrayList_get(filter->children, i));
+                if (substr == nullptr) {
+                    continue;
+                }
+                size_t len = strlen(substr);
+                char* region = static_cast<char*>(calloc(1, len + 1));
+                strncpy(region, value + pos, len);
+                const char* found = i == 0 ? (strcmp(region, substr) == 0 ? value : nullptr) : strstr(value + pos, substr);
+                free(region);
+                if (found == nullptr) {
+                    return false;
+                }
+                pos = (found - value) + len;
+            }
+            return true;
+        }
+        case CELIX_FILTER_OPERAND_GREATER:
+            return strcmp(value, filter->value) > 0;
+        case CELIX_FILTER_OPERAND_GREATEREQUAL:
+            return strcmp(value, filter->value) >= 0;
+        case CELIX_FILTER_OPERAND_LESS:
+            return strcmp(value, filter->value) < 0;
+        case CELIX_FILTER_OPERAND_LESSEQUAL:
+            return strcmp(value, filter->value) <= 0;
+        default:
+            return strcmp(value, filter->value) == 0;
+    }
+}
+
+static const char* const FILTERS[] = {
+        "(service.ranking>=10)",
+        "(&(service.version>=1.0.0)(service.version<2.0.0))",
+        "(component.name=celix*dependency*manager)",
+        "(&(component.name=*manager)(|(service.ranking>100)(missing=*))(objectClass=calc))",
+};
+
+static celix_properties_t* createProperties() {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "objectClass", "calc");
+    celix_properties_set(props, "service.ranking", "9");
+    celix_properties_set(props, "service.version", "1.10.0");
+    celix_properties_set(props, "component.name", "celix_dependency_manager");
+    return props;
+}
+
+static void FilterBenchmark_compiledMatch(benchmark::State& state) {
+    celix_properties_t* props = createProperties();
+    celix_filter_t* filter = celix_filter_create(FILTERS[state.range(0)]);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(celix_filter_match(filter, props));
+    }
+    celix_filter_destroy(filter);
+    celix_properties_destroy(props);
+    state.SetLabel(FILTERS[state.range(0)]);
+}
+
+static void FilterBenchmark_legacyMatch(benchmark::State& state) {
+    celix_properties_t* props = createProperties();
+    celix_filter_t* filter = celix_filter_create(FILTERS[state.range(0)]);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyMatch(filter, props));
+    }
+    celix_filter_destroy(filter);
+    celix_properties_destroy(props);
+    state.SetLabel(FILTERS[state.range(0)]);
+}
+
+BENCHMARK(FilterBenchmark_compiledMatch)->DenseRange(0, 3);
+BENCHMARK(FilterBenchmark_legacyMatch)->DenseRange(0, 3);
@@ -0,0 +1,139 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hash_map.h"
+#include "utils.h"
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
+
+static std::vector<std::string> createKeys(int64_t count) {
+    std::vector<std::string> keys{};
+    for (int64_t i = 0; i < count; ++i) {
+        keys.emplace_back(std::string{"service.property."} + std::to_string(i));
+    }
+    return keys;
+}
+
+/**
+ * Returns the lookup order for the keys, shuffled so that the lookups do not follow the insertion (allocation) order.
+ */
+static std::vector<size_t> createLookupOrder(size_t count) {
+    std::vector<size_t> order{};
+    for (size_t i = 0; i < count; ++i) {
+        order.push_back(i);
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937{42});
+    return order;
+}
+
+static void HashMapBenchmark_stringHashMapGet(benchmark::State& state) {
+    auto keys = createKeys(state.range(0));
+    auto* map = celix_stringHashMap_create();
+    for (auto& key : keys) {
+        celix_stringHashMap_put(map, key.c_str(), (void*)key.c_str());
+    }
+    auto order = createLookupOrder(keys.size());
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(celix_stringHashMap_get(map, keys[order[i++ % order.size()]].c_str()));
+    }
+    celix_stringHashMap_destroy(map);
+}
+
+static void HashMapBenchmark_legacyStringHashMapGet(benchmark::State& state) {
+    auto keys = createKeys(state.range(0));
+    auto* map = hashMap_create(utils_stringHash, nullptr, utils_stringEquals, nullptr);
+    for (auto& key : keys) {
+        hashMap_put(map, (void*)key.c_str(), (void*)key.c_str());
+    }
+    auto order = createLookupOrder(keys.size());
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hashMap_get(map, keys[order[i++ % order.size()]].c_str()));
+    }
+    hashMap_destroy(map, false, false);
+}
+
+static void HashMapBenchmark_stringHashMapPutRemove(benchmark::State& state) {
+    auto keys = createKeys(state.range(0));
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true; //as the legacy hash map, do not copy the keys
+    auto* map = celix_stringHashMap_createWithOptions(&opts);
+    for (auto _ : state) {
+        for (auto& key : keys) {
+            celix_stringHashMap_put(map, key.c_str(), (void*)key.c_str());
+        }
+        for (auto& key : keys) {
+            celix_stringHashMap_remove(map, key.c_str());
+        }
+    }
+    celix_stringHashMap_destroy(map);
+}
+
+static void HashMapBenchmark_legacyStringHashMapPutRemove(benchmark::State& state) {
+    auto keys = createKeys(state.range(0));
+    auto* map = hashMap_create(utils_stringHash, nullptr, utils_stringEquals, nullptr);
+    for (auto _ : state) {
+        for (auto& key : keys) {
+            hashMap_put(map, (void*)key.c_str(), (void*)key.c_str());
+        }
+        for (auto& key : keys) {
+            hashMap_remove(map, key.c_str());
+        }
+    }
+    hashMap_destroy(map, false, false);
+}
+
+static void HashMapBenchmark_longHashMapGet(benchmark::State& state) {
+    auto* map = celix_longHashMap_create();
+    for (long i = 0; i < state.range(0); ++i) {
+        celix_longHashMap_putLong(map, i, i);
+    }
+    long i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(celix_longHashMap_get(map, i++ % state.range(0)));
+    }
+    celix_longHashMap_destroy(map);
+}
+
+static void HashMapBenchmark_legacyLongHashMapGet(benchmark::State& state) {
+    auto* map = hashMap_create(nullptr, nullptr, nullptr, nullptr);
+    for (long i = 0; i < state.range(0); ++i) {
+        hashMap_put(map, (void*)i, (void*)i);
+    }
+    long i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hashMap_get(map, (void*)(i++ % state.range(0))));
+    }
+    hashMap_destroy(map, false, false);
+}
+
+BENCHMARK(HashMapBenchmark_stringHashMapGet)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(HashMapBenchmark_legacyStringHashMapGet)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(HashMapBenchmark_stringHashMapPutRemove)->Arg(10)->Arg(1000);
+BENCHMARK(HashMapBenchmark_legacyStringHashMapPutRemove)->Arg(10)->Arg(1000);
+BENCHMARK(HashMapBenchmark_longHashMapGet)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK(HashMapBenchmark_legacyLongHashMapGet)->Arg(10)->Arg(1000)->Arg(100000);
@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "celix_filter.h"
+#include "celix_version.h"
+
+class FilterTestSuite : public ::testing::Test {
+public:
+    static bool match(const char* filterStr, const celix_properties_t* props) {
+        celix_filter_t* filter = celix_filter_create(filterStr);
+        EXPECT_TRUE(filter != nullptr) << "Invalid filter " << filterStr;
+        bool result = celix_filter_match(filter, props);
+        celix_filter_destroy(filter);
+        return result;
+    }
+};
+
+TEST_F(FilterTestSuite, NumericCompare) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "service.ranking", "9");
+    celix_properties_set(props, "temperature", "-2.5");
+
+    EXPECT_FALSE(match("(service.ranking>=10)", props)); //lexicographic "9" >= "10" would be true
+    EXPECT_TRUE(match("(service.ranking<10)", props));
+    EXPECT_TRUE(match("(service.ranking>-1)", props));
+    EXPECT_TRUE(match("(service.ranking<=9)", props));
+    EXPECT_FALSE(match("(service.ranking>9)", props));
+
+    EXPECT_TRUE(match("(temperature<-2.25)", props));
+    EXPECT_TRUE(match("(temperature>-10)", props));
+    EXPECT_FALSE(match("(temperature>=0.5)", props));
+
+    //not a number, fallback to string compare
+    celix_properties_set(props, "service.ranking", "abc");
+    EXPECT_TRUE(match("(service.ranking>=10)", props));
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(FilterTestSuite, VersionCompare) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "service.version", "1.10.0");
+
+    EXPECT_TRUE(match("(service.version>=1.9.0)", props)); //lexicographic "1.10.0" >= "1.9.0" would be false
+    EXPECT_TRUE(match("(&(service.version>=1.0.0)(service.version<2.0.0))", props));
+    EXPECT_FALSE(match("(&(service.version>=1.11.0)(service.version<2.0.0))", props));
+    EXPECT_TRUE(match("(service.version<=1.10.0)", props));
+    EXPECT_TRUE(match("(service.version<1.10.0.qualifier)", props));
+
+    celix_properties_set(props, "service.version", "2");
+    EXPECT_TRUE(match("(service.version>1.2.3)", props));
+
+    //versions set as version are compared as version
+    celix_version_t* version = celix_version_createVersion(1, 10, 0, nullptr);
+    celix_properties_setVersion(props, "service.version", version);
+    celix_version_destroy(version);
+    EXPECT_TRUE(match("(service.version>=1.9)", props));
+    EXPECT_FALSE(match("(service.version<1.9)", props));
+    EXPECT_TRUE(match("(service.version>1.2)", props));
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(FilterTestSuite, DecimalCompare) {
+    //two part values which are not set as version are compared as decimal
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "load", "0.25");
+    celix_properties_set(props, "x", "1.25");
+
+    EXPECT_FALSE(match("(load>0.3)", props));
+    EXPECT_TRUE(match("(load<0.3)", props));
+    EXPECT_TRUE(match("(x<1.5)", props));
+    EXPECT_FALSE(match("(x>=1.5)", props));
+    EXPECT_TRUE(match("(x>1.2)", props));
+
+    celix_properties_setDouble(props, "load", 0.25);
+    EXPECT_TRUE(match("(load<0.3)", props));
+    EXPECT_FALSE(match("(load>=0.3)", props));
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(FilterTestSuite, SubstringMatch) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "name", "celix_framework_bundle");
+
+    EXPECT_TRUE(match("(name=celix*)", props));
+    EXPECT_TRUE(match("(name=*bundle)", props));
+    EXPECT_TRUE(match("(name=*framework*)", props));
+    EXPECT_TRUE(match("(name=celix*work*bundle)", props));
+    EXPECT_TRUE(match("(name=c*x*f*e)", props));
+    EXPECT_FALSE(match("(name=celix*bundles)", props));
+    EXPECT_FALSE(match("(name=*bundle*framework*)", props));
+    EXPECT_FALSE(match("(name=framework*)", props));
+    EXPECT_FALSE(match("(name=celix_framework*framework_bundle)", props)); //prefix and suffix should not overlap
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(FilterTestSuite, AndOrEvaluation) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "objectClass", "calc");
+    celix_properties_set(props, "service.ranking", "100");
+
+    EXPECT_TRUE(match("(&(objectClass=c*)(service.ranking>=50)(objectClass=*))", props));
+    EXPECT_FALSE(match("(&(objectClass=c*)(service.ranking>=500)(objectClass=*))", props));
+    EXPECT_TRUE(match("(|(objectClass=x*)(service.ranking>=50)(missing=*))", props));
+    EXPECT_FALSE(match("(|(objectClass=x*)(service.ranking>=500)(missing=*))", props));
+    EXPECT_TRUE(match("(!(&(objectClass=calc)(missing=*)))", props));
+
+    //evaluation order must not change the filter children order
+    celix_filter_t* filter = celix_filter_create("(&(objectClass=c*)(missing=*))");
+    ASSERT_TRUE(filter != nullptr);
+    auto* first = static_cast<celix_filter_t*>(celix_arrayList_get(filter->children, 0));
+    EXPECT_EQ(CELIX_FILTER_OPERAND_SUBSTRING, first->operand);
+    celix_filter_destroy(filter);
+
+    celix_properties_destroy(props);
+}
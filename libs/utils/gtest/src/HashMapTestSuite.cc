@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <set>
+
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
+
+class HashMapTestSuite : public ::testing::Test {};
+
+TEST_F(HashMapTestSuite, StringHashMapPutGetRemove) {
+    auto* map = celix_stringHashMap_create();
+    EXPECT_EQ(0, celix_stringHashMap_size(map));
+    EXPECT_EQ(nullptr, celix_stringHashMap_get(map, "key"));
+
+    int a = 1;
+    int b = 2;
+    EXPECT_EQ(CELIX_SUCCESS, celix_stringHashMap_put(map, "key", &a));
+    EXPECT_EQ(&a, celix_stringHashMap_get(map, "key"));
+    EXPECT_TRUE(celix_stringHashMap_hasKey(map, "key"));
+    EXPECT_EQ(1, celix_stringHashMap_size(map));
+
+    //replace
+    celix_stringHashMap_put(map, "key", &b);
+    EXPECT_EQ(&b, celix_stringHashMap_get(map, "key"));
+    EXPECT_EQ(1, celix_stringHashMap_size(map));
+
+    celix_stringHashMap_putLong(map, "long", 42);
+    EXPECT_EQ(42, celix_stringHashMap_getLong(map, "long", -1));
+    EXPECT_EQ(-1, celix_stringHashMap_getLong(map, "missing", -1));
+
+    EXPECT_TRUE(celix_stringHashMap_remove(map, "key"));
+    EXPECT_FALSE(celix_stringHashMap_remove(map, "key"));
+    EXPECT_FALSE(celix_stringHashMap_hasKey(map, "key"));
+    EXPECT_EQ(1, celix_stringHashMap_size(map));
+
+    celix_stringHashMap_destroy(map);
+}
+
+TEST_F(HashMapTestSuite, StringHashMapGrowAndIterate) {
+    auto* map = celix_stringHashMap_create();
+    const int count = 1000;
+    for (int i = 0; i < count; ++i) {
+        auto key = std::string{"key"} + std::to_string(i);
+        celix_stringHashMap_putLong(map, key.c_str(), i);
+    }
+    EXPECT_EQ(count, celix_stringHashMap_size(map));
+    for (int i = 0; i < count; ++i) {
+        auto key = std::string{"key"} + std::to_string(i);
+        EXPECT_EQ(i, celix_stringHashMap_getLong(map, key.c_str(), -1));
+    }
+
+    //remove the even entries, leaving tombstones
+    for (int i = 0; i < count; i += 2) {
+        auto key = std::string{"key"} + std::to_string(i);
+        EXPECT_TRUE(celix_stringHashMap_remove(map, key.c_str()));
+    }
+
+    std::set<std::string> keys{};
+    size_t expectedIndex = 0;
+    CELIX_STRING_HASH_MAP_ITERATE(map, iter) {
+        EXPECT_EQ(expectedIndex++, iter.index);
+        EXPECT_EQ(1, (long)(intptr_t)iter.value % 2);
+        keys.emplace(iter.key);
+    }
+    EXPECT_EQ(count / 2, keys.size());
+
+    //reinserting reuses tombstones
+    for (int i = 0; i < count; i += 2) {
+        auto key = std::string{"key"} + std::to_string(i);
+        celix_stringHashMap_putLong(map, key.c_str(), i);
+    }
+    EXPECT_EQ(count, celix_stringHashMap_size(map));
+    EXPECT_EQ(500, celix_stringHashMap_getLong(map, "key500", -1));
+
+    celix_stringHashMap_destroy(map);
+}
+
+static int removedCount = 0;
+
+TEST_F(HashMapTestSuite, StringHashMapRemovedCallbackAndIteratorRemove) {
+    removedCount = 0;
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.removedCallback = [](void* value) {
+        removedCount += 1;
+        free(value);
+    };
+    auto* map = celix_stringHashMap_createWithOptions(&opts);
+    for (int i = 0; i < 10; ++i) {
+        auto key = std::to_string(i);
+        celix_stringHashMap_put(map, key.c_str(), malloc(8));
+    }
+    celix_stringHashMap_put(map, "0", malloc(8)); //replace -> callback
+    EXPECT_EQ(1, removedCount);
+
+    auto iter = celix_stringHashMap_begin(map);
+    while (!celix_stringHashMapIterator_isEnd(&iter)) {
+        if (std::stoi(iter.key) < 5) {
+            celix_stringHashMapIterator_remove(&iter);
+        } else {
+            celix_stringHashMapIterator_next(&iter);
+        }
+    }
+    EXPECT_EQ(6, removedCount);
+    EXPECT_EQ(5, celix_stringHashMap_size(map));
+
+    celix_stringHashMap_destroy(map);
+    EXPECT_EQ(11, removedCount);
+}
+
+TEST_F(HashMapTestSuite, StringHashMapWeakKeys) {
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true;
+    auto* map = celix_stringHashMap_createWithOptions(&opts);
+    const char* key1 = "key";
+    std::string key2 = "key";
+    celix_stringHashMap_putLong(map, key1, 1);
+    celix_stringHashMap_putLong(map, key2.c_str(), 2);
+    EXPECT_EQ(1, celix_stringHashMap_size(map));
+    auto iter = celix_stringHashMap_begin(map);
+    EXPECT_EQ(key2.c_str(), iter.key); //weak key is updated on replace
+    celix_stringHashMap_destroy(map);
+}
+
+TEST_F(HashMapTestSuite, LongHashMapPutGetRemove) {
+    auto* map = celix_longHashMap_create();
+    const long count = 1000;
+    for (long i = -count; i < count; ++i) {
+        celix_longHashMap_putLong(map, i * 7, i);
+    }
+    EXPECT_EQ(2 * count, celix_longHashMap_size(map));
+    for (long i = -count; i < count; ++i) {
+        EXPECT_EQ(i, celix_longHashMap_getLong(map, i * 7, 0));
+    }
+    EXPECT_FALSE(celix_longHashMap_hasKey(map, 1));
+    EXPECT_EQ(nullptr, celix_longHashMap_get(map, 1));
+
+    for (long i = -count; i < count; ++i) {
+        EXPECT_TRUE(celix_longHashMap_remove(map, i * 7));
+    }
+    EXPECT_EQ(0, celix_longHashMap_size(map));
+    auto emptyIter = celix_longHashMap_begin(map);
+    EXPECT_TRUE(celix_longHashMapIterator_isEnd(&emptyIter));
+
+    celix_longHashMap_put(map, 1, map);
+    long visited = 0;
+    CELIX_LONG_HASH_MAP_ITERATE(map, iter) {
+        EXPECT_EQ(1, iter.key);
+        EXPECT_EQ(map, iter.value);
+        visited += 1;
+    }
+    EXPECT_EQ(1, visited);
+
+    celix_longHashMap_clear(map);
+    EXPECT_EQ(0, celix_longHashMap_size(map));
+    celix_longHashMap_destroy(map);
+}
@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "celix_object_pool.h"
+
+class ObjectPoolTestSuite : public ::testing::Test {};
+
+TEST_F(ObjectPoolTestSuite, AllocAndFree) {
+    auto* pool = celix_objectPool_create(24, 4);
+    EXPECT_EQ(0, celix_objectPool_nrOfAllocatedObjects(pool));
+    EXPECT_EQ(0, celix_objectPool_capacity(pool));
+
+    std::set<void*> objects{};
+    for (int i = 0; i < 10; ++i) {
+        auto* obj = static_cast<char*>(celix_objectPool_alloc(pool));
+        ASSERT_NE(nullptr, obj);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(obj) % 16); //aligned
+        for (int j = 0; j < 24; ++j) {
+            EXPECT_EQ(0, obj[j]); //zero initialized
+        }
+        memset(obj, 0xFF, 24);
+        objects.insert(obj);
+    }
+    EXPECT_EQ(10, objects.size()); //unique
+    EXPECT_EQ(10, celix_objectPool_nrOfAllocatedObjects(pool));
+    EXPECT_EQ(12, celix_objectPool_capacity(pool)); //3 slabs of 4 objects
+
+    for (auto* obj : objects) {
+        celix_objectPool_free(pool, obj);
+    }
+    EXPECT_EQ(0, celix_objectPool_nrOfAllocatedObjects(pool));
+
+    //freed objects are reused
+    void* obj = celix_objectPool_alloc(pool);
+    EXPECT_EQ(1, objects.count(obj));
+    EXPECT_EQ(0, static_cast<char*>(obj)[0]);
+    EXPECT_EQ(12, celix_objectPool_capacity(pool));
+    celix_objectPool_free(pool, obj);
+
+    celix_objectPool_destroy(pool);
+}
+
+TEST_F(ObjectPoolTestSuite, ConcurrentAllocAndFree) {
+    auto* pool = celix_objectPool_create(sizeof(long), 0);
+    std::vector<std::thread> threads{};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([pool, t] {
+            for (int i = 0; i < 1000; ++i) {
+                auto* a = static_cast<long*>(celix_objectPool_alloc(pool));
+                auto* b = static_cast<long*>(celix_objectPool_alloc(pool));
+                *a = t;
+                *b = i;
+                EXPECT_EQ(t, *a);
+                celix_objectPool_free(pool, a);
+                celix_objectPool_free(pool, b);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, celix_objectPool_nrOfAllocatedObjects(pool));
+    celix_objectPool_destroy(pool);
+}
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "celix_properties.h"
+#include "celix_version.h"
+
+class PropertiesTestSuite : public ::testing::Test {};
+
+TEST_F(PropertiesTestSuite, TypedSetAndGet) {
+    celix_properties_t* props = celix_properties_create();
+
+    celix_properties_setLong(props, "long", 42);
+    celix_properties_setDouble(props, "double", 1.5);
+    celix_properties_setBool(props, "bool", true);
+    celix_properties_set(props, "string", "value");
+
+    EXPECT_EQ(42, celix_properties_getAsLong(props, "long", -1));
+    EXPECT_STREQ("42", celix_properties_get(props, "long", nullptr));
+    EXPECT_DOUBLE_EQ(1.5, celix_properties_getAsDouble(props, "double", -1.0));
+    EXPECT_TRUE(celix_properties_getAsBool(props, "bool", false));
+    EXPECT_STREQ("true", celix_properties_get(props, "bool", nullptr));
+
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_LONG, celix_properties_getType(props, "long"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_DOUBLE, celix_properties_getType(props, "double"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_BOOL, celix_properties_getType(props, "bool"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_STRING, celix_properties_getType(props, "string"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_UNSET, celix_properties_getType(props, "missing"));
+
+    //overwriting a typed value with a string value resets the typed value
+    celix_properties_set(props, "long", "10");
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_STRING, celix_properties_getType(props, "long"));
+    EXPECT_EQ(10, celix_properties_getAsLong(props, "long", -1));
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, ParseStringValues) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "long", "123");
+    celix_properties_set(props, "double", "2.25");
+    celix_properties_set(props, "bool", " FALSE ");
+    celix_properties_set(props, "version", "1.2.3.qualifier");
+    celix_properties_set(props, "garbage", "garbage");
+
+    //parsed once, repeated gets return the cached value
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(123, celix_properties_getAsLong(props, "long", -1));
+        EXPECT_DOUBLE_EQ(123.0, celix_properties_getAsDouble(props, "long", -1.0));
+        EXPECT_DOUBLE_EQ(2.25, celix_properties_getAsDouble(props, "double", -1.0));
+        EXPECT_FALSE(celix_properties_getAsBool(props, "bool", true));
+    }
+
+    EXPECT_EQ(-1, celix_properties_getAsLong(props, "garbage", -1));
+    EXPECT_DOUBLE_EQ(-1.0, celix_properties_getAsDouble(props, "garbage", -1.0));
+    EXPECT_TRUE(celix_properties_getAsBool(props, "garbage", true));
+    EXPECT_EQ(nullptr, celix_properties_getAsVersion(props, "garbage", nullptr));
+
+    const celix_version_t* version = celix_properties_getAsVersion(props, "version", nullptr);
+    ASSERT_TRUE(version != nullptr);
+    EXPECT_EQ(version, celix_properties_getAsVersion(props, "version", nullptr));
+    EXPECT_EQ(0, celix_version_compareToMajorMinor(version, 1, 2));
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, VersionAndCopy) {
+    celix_properties_t* props = celix_properties_create();
+    celix_version_t* version = celix_version_createVersion(1, 2, 3, "q");
+    celix_properties_setVersion(props, "version", version);
+    celix_properties_setDouble(props, "double", 1.0 / 3.0);
+    celix_version_destroy(version);
+
+    EXPECT_STREQ("1.2.3.q", celix_properties_get(props, "version", nullptr));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_VERSION, celix_properties_getType(props, "version"));
+
+    celix_properties_t* copy = celix_properties_copy(props);
+    EXPECT_EQ(2, celix_properties_size(copy));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_VERSION, celix_properties_getType(copy, "version"));
+    const celix_version_t* copiedVersion = celix_properties_getAsVersion(copy, "version", nullptr);
+    ASSERT_TRUE(copiedVersion != nullptr);
+    EXPECT_EQ(0, celix_version_compareTo(copiedVersion, celix_properties_getAsVersion(props, "version", nullptr)));
+    EXPECT_DOUBLE_EQ(1.0 / 3.0, celix_properties_getAsDouble(copy, "double", 0.0)); //not parsed from the "%f" string form
+
+    celix_properties_unset(copy, "version");
+    EXPECT_EQ(1, celix_properties_size(copy));
+    EXPECT_EQ(nullptr, celix_properties_get(copy, "version", nullptr));
+
+    celix_properties_destroy(copy);
+    celix_properties_destroy(props);
+}
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_LONG_HASH_MAP_H_
+#define CELIX_LONG_HASH_MAP_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "celix_errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A hash map with long keys, using open addressing (linear probing) and storing the (mixed) key hash inline
+ * in the slots. See celix_string_hash_map.h.
+ *
+ * The map is not thread safe.
+ */
+typedef struct celix_long_hash_map celix_long_hash_map_t;
+
+typedef struct celix_long_hash_map_create_options {
+    /**
+     * Optional callback called with the value of every entry removed from the map; i.e. on remove, on replacing a
+     * value with put, on clear and on destroy.
+     */
+    void (*removedCallback)(void *value);
+
+    /**
+     * The initial capacity of the map, rounded up to a power of 2. Default (0) is 16.
+     */
+    unsigned int initialCapacity;
+} celix_long_hash_map_create_options_t;
+
+#define CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS {.removedCallback = NULL, .initialCapacity = 0}
+
+typedef struct celix_long_hash_map_iterator {
+    size_t index; //the index of the entry in the iteration (0 .. size)
+    long key;
+    void *value;
+
+    celix_long_hash_map_t *_map; //private
+    size_t _slot; //private
+} celix_long_hash_map_iterator_t;
+
+celix_long_hash_map_t* celix_longHashMap_create(void);
+
+celix_long_hash_map_t* celix_longHashMap_createWithOptions(const celix_long_hash_map_create_options_t *opts);
+
+void celix_longHashMap_destroy(celix_long_hash_map_t *map);
+
+size_t celix_longHashMap_size(const celix_long_hash_map_t *map);
+
+/**
+ * Returns the value for the key or NULL if the map does not contain the key.
+ */
+void* celix_longHashMap_get(const celix_long_hash_map_t *map, long key);
+
+/**
+ * Returns the value for the key as long or defaultValue if the map does not contain the key.
+ */
+long celix_longHashMap_getLong(const celix_long_hash_map_t *map, long key, long defaultValue);
+
+bool celix_longHashMap_hasKey(const celix_long_hash_map_t *map, long key);
+
+/**
+ * Adds the value for the key or replaces the value if the key is already present.
+ * Returns CELIX_ENOMEM if the map could not grow.
+ */
+celix_status_t celix_longHashMap_put(celix_long_hash_map_t *map, long key, void *value);
+
+/**
+ * Adds a long value for the key. Retrieve it with celix_longHashMap_getLong.
+ */
+celix_status_t celix_longHashMap_putLong(celix_long_hash_map_t *map, long key, long value);
+
+/**
+ * Removes the entry for the key. Returns true if an entry was removed.
+ */
+bool celix_longHashMap_remove(celix_long_hash_map_t *map, long key);
+
+/**
+ * Removes all entries from the map.
+ */
+void celix_longHashMap_clear(celix_long_hash_map_t *map);
+
+celix_long_hash_map_iterator_t celix_longHashMap_begin(const celix_long_hash_map_t *map);
+
+bool celix_longHashMapIterator_isEnd(const celix_long_hash_map_iterator_t *iter);
+
+void celix_longHashMapIterator_next(celix_long_hash_map_iterator_t *iter);
+
+/**
+ * Removes the current entry of the iterator and moves the iterator to the next entry.
+ */
+void celix_longHashMapIterator_remove(celix_long_hash_map_iterator_t *iter);
+
+#define CELIX_LONG_HASH_MAP_ITERATE(map, iterName) \
+    for (celix_long_hash_map_iterator_t iterName = celix_longHashMap_begin(map); !celix_longHashMapIterator_isEnd(&(iterName)); celix_longHashMapIterator_next(&(iterName)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_LONG_HASH_MAP_H_ */
@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_OBJECT_POOL_H_
+#define CELIX_OBJECT_POOL_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A thread safe pool for fixed size objects.
+ *
+ * Objects are allocated in slabs of multiple objects and freed objects are kept on a free list, so that objects
+ * which are often created and destroyed do not result in malloc/free calls. The slabs are only released when the
+ * pool is destroyed.
+ */
+typedef struct celix_object_pool celix_object_pool_t;
+
+/**
+ * Creates an object pool for objects of objectSize bytes.
+ * If objectsPerSlab is 0, a default of 64 objects per slab is used.
+ */
+celix_object_pool_t* celix_objectPool_create(size_t objectSize, size_t objectsPerSlab);
+
+/**
+ * Destroys the pool and all its slabs. Objects still allocated from the pool become invalid.
+ */
+void celix_objectPool_destroy(celix_object_pool_t *pool);
+
+/**
+ * Allocates a zero initialized object from the pool. Returns NULL if no memory is available.
+ */
+void* celix_objectPool_alloc(celix_object_pool_t *pool);
+
+/**
+ * Returns an object to the pool. The object must be allocated from the same pool.
+ */
+void celix_objectPool_free(celix_object_pool_t *pool, void *object);
+
+/**
+ * Returns the number of objects currently allocated from the pool.
+ */
+size_t celix_objectPool_nrOfAllocatedObjects(celix_object_pool_t *pool);
+
+/**
+ * Returns the number of objects the pool can hand out without allocating a new slab, including the allocated objects.
+ */
+size_t celix_objectPool_capacity(celix_object_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_OBJECT_POOL_H_ */
@@ -20,8 +20,10 @@
 #include <stdio.h>
 
 #include "hash_map.h"
+#include "celix_string_hash_map.h"
 #include "exports.h"
 #include "celix_errno.h"
+#include "celix_version.h"
 
 #ifndef CELIX_PROPERTIES_H_
 #define CELIX_PROPERTIES_H_
@@ -30,8 +32,21 @@
 extern "C" {
 #endif
 
-typedef hash_map_t celix_properties_t;
-typedef hash_map_iterator_t celix_properties_iterator_t;
+typedef struct celix_properties celix_properties_t;
+typedef celix_string_hash_map_iterator_t celix_properties_iterator_t;
+
+/**
+ * The type of a property value, i.e. the type used to set the value.
+ * Values are always also available as string (celix_properties_get).
+ */
+typedef enum celix_properties_value_type {
+    CELIX_PROPERTIES_VALUE_TYPE_UNSET   = 0,
+    CELIX_PROPERTIES_VALUE_TYPE_STRING  = 1,
+    CELIX_PROPERTIES_VALUE_TYPE_LONG    = 2,
+    CELIX_PROPERTIES_VALUE_TYPE_DOUBLE  = 3,
+    CELIX_PROPERTIES_VALUE_TYPE_BOOL    = 4,
+    CELIX_PROPERTIES_VALUE_TYPE_VERSION = 5
+} celix_properties_value_type_e;
 
 
 /**********************************************************************************************************************
@@ -72,6 +87,20 @@ void celix_properties_setBool(celix_properties_t *props, const char *key, bool v
 void celix_properties_setDouble(celix_properties_t *props, const char *key, double val);
 double celix_properties_getAsDouble(const celix_properties_t *props, const char *key, double defaultValue);
 
+/**
+ * Returns the version value of the property. The version is parsed from the string value once and owned by the properties.
+ * @return The version or defaultValue if the property is not set or cannot be parsed to a version.
+ */
+const celix_version_t* celix_properties_getAsVersion(const celix_properties_t *props, const char *key, const celix_version_t *defaultValue);
+void celix_properties_setVersion(celix_properties_t *props, const char *key, const celix_version_t *version);
+
+/**
+ * Returns the type used to set the property value or CELIX_PROPERTIES_VALUE_TYPE_UNSET if the property is not set.
+ * Note that typed getters (e.g. celix_properties_getAsLong) parse string values once and cache the result, so
+ * repeated typed gets are cheap regardless of the value type.
+ */
+celix_properties_value_type_e celix_properties_getType(const celix_properties_t *props, const char *key);
+
 int celix_properties_size(const celix_properties_t *properties);
 
 celix_properties_iterator_t celix_propertiesIterator_construct(const celix_properties_t *properties);
@@ -79,7 +108,7 @@ bool celix_propertiesIterator_hasNext(celix_properties_iterator_t *iter);
 const char* celix_propertiesIterator_nextKey(celix_properties_iterator_t *iter);
 
 #define CELIX_PROPERTIES_FOR_EACH(props, key) \
-    for(hash_map_iterator_t iter = celix_propertiesIterator_construct(props); \
+    for(celix_properties_iterator_t iter = celix_propertiesIterator_construct(props); \
         celix_propertiesIterator_hasNext(&iter), (key) = celix_propertiesIterator_nextKey(&iter);)
 
 
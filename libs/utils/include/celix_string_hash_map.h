@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_STRING_HASH_MAP_H_
+#define CELIX_STRING_HASH_MAP_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "celix_errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A hash map with string keys, using open addressing (linear probing) and storing the key hash inline
+ * in the slots. Compared to the (Java-style) hash_map_t there is no allocation per entry, and a lookup only
+ * needs a strcmp for slots with a matching hash.
+ *
+ * The map is not thread safe.
+ */
+typedef struct celix_string_hash_map celix_string_hash_map_t;
+
+typedef struct celix_string_hash_map_create_options {
+    /**
+     * Optional callback called with the value of every entry removed from the map; i.e. on remove, on replacing a
+     * value with put, on clear and on destroy.
+     */
+    void (*removedCallback)(void *value);
+
+    /**
+     * If true the keys are not copied, but used as provided. The caller must ensure the key stays valid as long
+     * as the entry is in the map. When an existing value is replaced, the key of the put call will be used as
+     * (weak) key.
+     * Default false: keys are copied and freed by the map.
+     */
+    bool storeKeysWeakly;
+
+    /**
+     * The initial capacity of the map, rounded up to a power of 2. Default (0) is 16.
+     */
+    unsigned int initialCapacity;
+} celix_string_hash_map_create_options_t;
+
+#define CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS {.removedCallback = NULL, .storeKeysWeakly = false, .initialCapacity = 0}
+
+typedef struct celix_string_hash_map_iterator {
+    size_t index; //the index of the entry in the iteration (0 .. size)
+    const char *key;
+    void *value;
+
+    celix_string_hash_map_t *_map; //private
+    size_t _slot; //private
+} celix_string_hash_map_iterator_t;
+
+celix_string_hash_map_t* celix_stringHashMap_create(void);
+
+celix_string_hash_map_t* celix_stringHashMap_createWithOptions(const celix_string_hash_map_create_options_t *opts);
+
+void celix_stringHashMap_destroy(celix_string_hash_map_t *map);
+
+size_t celix_stringHashMap_size(const celix_string_hash_map_t *map);
+
+/**
+ * Returns the value for the key or NULL if the map does not contain the key.
+ */
+void* celix_stringHashMap_get(const celix_string_hash_map_t *map, const char *key);
+
+/**
+ * Returns the value for the key as long or defaultValue if the map does not contain the key.
+ */
+long celix_stringHashMap_getLong(const celix_string_hash_map_t *map, const char *key, long defaultValue);
+
+bool celix_stringHashMap_hasKey(const celix_string_hash_map_t *map, const char *key);
+
+/**
+ * Adds the value for the key or replaces the value if the key is already present.
+ * Returns CELIX_ENOMEM if the map could not grow.
+ */
+celix_status_t celix_stringHashMap_put(celix_string_hash_map_t *map, const char *key, void *value);
+
+/**
+ * Adds a long value for the key. Retrieve it with celix_stringHashMap_getLong.
+ */
+celix_status_t celix_stringHashMap_putLong(celix_string_hash_map_t *map, const char *key, long value);
+
+/**
+ * Removes the entry for the key. Returns true if an entry was removed.
+ */
+bool celix_stringHashMap_remove(celix_string_hash_map_t *map, const char *key);
+
+/**
+ * Removes all entries from the map.
+ */
+void celix_stringHashMap_clear(celix_string_hash_map_t *map);
+
+celix_string_hash_map_iterator_t celix_stringHashMap_begin(const celix_string_hash_map_t *map);
+
+bool celix_stringHashMapIterator_isEnd(const celix_string_hash_map_iterator_t *iter);
+
+void celix_stringHashMapIterator_next(celix_string_hash_map_iterator_t *iter);
+
+/**
+ * Removes the current entry of the iterator and moves the iterator to the next entry.
+ */
+void celix_stringHashMapIterator_remove(celix_string_hash_map_iterator_t *iter);
+
+#define CELIX_STRING_HASH_MAP_ITERATE(map, iterName) \
+    for (celix_string_hash_map_iterator_t iterName = celix_stringHashMap_begin(map); !celix_stringHashMapIterator_isEnd(&(iterName)); celix_stringHashMapIterator_next(&(iterName)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_STRING_HASH_MAP_H_ */
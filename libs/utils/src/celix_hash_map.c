@@ -0,0 +1,493 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "celix_string_hash_map.h"
+#include "celix_long_hash_map.h"
+
+#define CELIX_HASH_MAP_DEFAULT_CAPACITY 16
+//slot hash values 0 and 1 are reserved to mark empty and deleted slots.
+#define CELIX_HASH_MAP_EMPTY_SLOT 0
+#define CELIX_HASH_MAP_DELETED_SLOT 1
+#define CELIX_HASH_MAP_IS_USED(slot) ((slot)->hash > CELIX_HASH_MAP_DELETED_SLOT)
+
+typedef union celix_hash_map_key {
+    const char *strKey;
+    long longKey;
+} celix_hash_map_key_t;
+
+typedef struct celix_hash_map_slot {
+    uint32_t hash;
+    celix_hash_map_key_t key;
+    void *value;
+} celix_hash_map_slot_t;
+
+typedef struct celix_hash_map {
+    celix_hash_map_slot_t *slots;
+    size_t capacity; //power of 2
+    size_t size; //nr of used slots
+    size_t nrOfDeleted; //nr of deleted slots (tombstones)
+    bool stringKeys;
+    bool storeKeysWeakly;
+    void (*removedCallback)(void *value);
+} celix_hash_map_t;
+
+struct celix_string_hash_map {
+    celix_hash_map_t genericMap;
+};
+
+struct celix_long_hash_map {
+    celix_hash_map_t genericMap;
+};
+
+static uint32_t celix_hashMap_adjustHash(uint32_t hash) {
+    return hash > CELIX_HASH_MAP_DELETED_SLOT ? hash : hash + 2;
+}
+
+static uint32_t celix_hashMap_hashString(const char *key) {
+    //FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char*)key; *c != '\0'; ++c) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    //finalize (avalanche), the multiplication only propagates upwards and the slot index uses the low bits
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    return celix_hashMap_adjustHash(hash);
+}
+
+static uint32_t celix_hashMap_hashLong(long key) {
+    //fold the high bits and apply a supplemental hash (as done for java.util.HashMap), this spreads the low
+    //bits for clustered keys while sequential keys (e.g. service ids) stay in neighbouring slots.
+    uint32_t h = (uint32_t)((uint64_t)key ^ ((uint64_t)key >> 32));
+    h ^= (h >> 20) ^ (h >> 12);
+    h = h ^ (h >> 7) ^ (h >> 4);
+    return celix_hashMap_adjustHash(h);
+}
+
+static uint32_t celix_hashMap_hash(const celix_hash_map_t *map, celix_hash_map_key_t key) {
+    return map->stringKeys ? celix_hashMap_hashString(key.strKey) : celix_hashMap_hashLong(key.longKey);
+}
+
+static size_t celix_hashMap_roundCapacity(size_t requested) {
+    size_t cap = CELIX_HASH_MAP_DEFAULT_CAPACITY;
+    while (cap < requested) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+static bool celix_hashMap_init(celix_hash_map_t *map, bool stringKeys, bool storeKeysWeakly, void (*removedCallback)(void*), unsigned int initialCapacity) {
+    map->capacity = celix_hashMap_roundCapacity(initialCapacity);
+    map->slots = calloc(map->capacity, sizeof(*map->slots));
+    map->size = 0;
+    map->nrOfDeleted = 0;
+    map->stringKeys = stringKeys;
+    map->storeKeysWeakly = storeKeysWeakly;
+    map->removedCallback = removedCallback;
+    return map->slots != NULL;
+}
+
+static celix_hash_map_slot_t* celix_hashMap_findString(const celix_hash_map_t *map, const char *key, uint32_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t idx = hash & mask;
+    for (size_t probes = 0; probes < map->capacity; ++probes) {
+        celix_hash_map_slot_t *slot = &map->slots[idx];
+        if (slot->hash == CELIX_HASH_MAP_EMPTY_SLOT) {
+            return NULL;
+        } else if (slot->hash == hash && strcmp(slot->key.strKey, key) == 0) {
+            return slot;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return NULL;
+}
+
+static celix_hash_map_slot_t* celix_hashMap_findLong(const celix_hash_map_t *map, long key, uint32_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t idx = hash & mask;
+    for (size_t probes = 0; probes < map->capacity; ++probes) {
+        celix_hash_map_slot_t *slot = &map->slots[idx];
+        if (slot->hash == CELIX_HASH_MAP_EMPTY_SLOT) {
+            return NULL;
+        } else if (slot->key.longKey == key && slot->hash == hash) {
+            return slot;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return NULL;
+}
+
+/**
+ * Returns the slot containing the key or NULL.
+ */
+static celix_hash_map_slot_t* celix_hashMap_find(const celix_hash_map_t *map, celix_hash_map_key_t key, uint32_t hash) {
+    return map->stringKeys ? celix_hashMap_findString(map, key.strKey, hash) : celix_hashMap_findLong(map, key.longKey, hash);
+}
+
+static void celix_hashMap_freeSlot(celix_hash_map_t *map, celix_hash_map_slot_t *slot, bool callRemovedCallback) {
+    if (map->stringKeys && !map->storeKeysWeakly) {
+        free((char*)slot->key.strKey);
+    }
+    if (callRemovedCallback && map->removedCallback != NULL) {
+        map->removedCallback(slot->value);
+    }
+}
+
+/**
+ * Inserts a new (not yet present) key in the slots array. No resize and no key copy.
+ */
+static void celix_hashMap_insertNew(celix_hash_map_slot_t *slots, size_t capacity, uint32_t hash, celix_hash_map_key_t key, void *value) {
+    size_t mask = capacity - 1;
+    size_t idx = hash & mask;
+    while (CELIX_HASH_MAP_IS_USED(&slots[idx])) {
+        idx = (idx + 1) & mask;
+    }
+    slots[idx].hash = hash;
+    slots[idx].key = key;
+    slots[idx].value = value;
+}
+
+static bool celix_hashMap_rehash(celix_hash_map_t *map, size_t newCapacity) {
+    celix_hash_map_slot_t *newSlots = calloc(newCapacity, sizeof(*newSlots));
+    if (newSlots == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < map->capacity; ++i) {
+        celix_hash_map_slot_t *slot = &map->slots[i];
+        if (CELIX_HASH_MAP_IS_USED(slot)) {
+            celix_hashMap_insertNew(newSlots, newCapacity, slot->hash, slot->key, slot->value);
+        }
+    }
+    free(map->slots);
+    map->slots = newSlots;
+    map->capacity = newCapacity;
+    map->nrOfDeleted = 0;
+    return true;
+}
+
+static celix_status_t celix_hashMap_put(celix_hash_map_t *map, celix_hash_map_key_t key, void *value) {
+    uint32_t hash = celix_hashMap_hash(map, key);
+    celix_hash_map_slot_t *existing = celix_hashMap_find(map, key, hash);
+    if (existing != NULL) {
+        void *old = existing->value;
+        existing->value = value;
+        if (map->stringKeys && map->storeKeysWeakly) {
+            existing->key = key;
+        }
+        if (map->removedCallback != NULL && old != value) {
+            map->removedCallback(old);
+        }
+        return CELIX_SUCCESS;
+    }
+
+    //keep the load factor (including tombstones) at most 0.75
+    if ((map->size + map->nrOfDeleted + 1) * 4 > map->capacity * 3) {
+        size_t newCapacity = celix_hashMap_roundCapacity((map->size + 1) * 2);
+        if (newCapacity < map->capacity) {
+            newCapacity = map->capacity; //only clear the tombstones
+        }
+        if (!celix_hashMap_rehash(map, newCapacity)) {
+            return CELIX_ENOMEM;
+        }
+    }
+
+    if (map->stringKeys && !map->storeKeysWeakly) {
+        key.strKey = strdup(key.strKey);
+        if (key.strKey == NULL) {
+            return CELIX_ENOMEM;
+        }
+    }
+
+    size_t mask = map->capacity - 1;
+    size_t idx = hash & mask;
+    while (CELIX_HASH_MAP_IS_USED(&map->slots[idx])) {
+        idx = (idx + 1) & mask;
+    }
+    if (map->slots[idx].hash == CELIX_HASH_MAP_DELETED_SLOT) {
+        map->nrOfDeleted -= 1;
+    }
+    map->slots[idx].hash = hash;
+    map->slots[idx].key = key;
+    map->slots[idx].value = value;
+    map->size += 1;
+    return CELIX_SUCCESS;
+}
+
+static void celix_hashMap_removeSlot(celix_hash_map_t *map, celix_hash_map_slot_t *slot) {
+    celix_hashMap_freeSlot(map, slot, true);
+    slot->value = NULL;
+    map->size -= 1;
+
+    size_t mask = map->capacity - 1;
+    size_t idx = (size_t)(slot - map->slots);
+    if (map->slots[(idx + 1) & mask].hash == CELIX_HASH_MAP_EMPTY_SLOT) {
+        //end of a probe sequence, so no tombstone needed. Also clear the tombstones directly preceding this slot.
+        slot->hash = CELIX_HASH_MAP_EMPTY_SLOT;
+        idx = (idx - 1) & mask;
+        while (map->slots[idx].hash == CELIX_HASH_MAP_DELETED_SLOT) {
+            map->slots[idx].hash = CELIX_HASH_MAP_EMPTY_SLOT;
+            map->nrOfDeleted -= 1;
+            idx = (idx - 1) & mask;
+        }
+    } else {
+        slot->hash = CELIX_HASH_MAP_DELETED_SLOT;
+        map->nrOfDeleted += 1;
+    }
+}
+
+static bool celix_hashMap_remove(celix_hash_map_t *map, celix_hash_map_key_t key) {
+    celix_hash_map_slot_t *slot = celix_hashMap_find(map, key, celix_hashMap_hash(map, key));
+    if (slot != NULL) {
+        celix_hashMap_removeSlot(map, slot);
+        return true;
+    }
+    return false;
+}
+
+static void celix_hashMap_clear(celix_hash_map_t *map) {
+    for (size_t i = 0; i < map->capacity; ++i) {
+        celix_hash_map_slot_t *slot = &map->slots[i];
+        if (CELIX_HASH_MAP_IS_USED(slot)) {
+            celix_hashMap_freeSlot(map, slot, true);
+        }
+        slot->hash = CELIX_HASH_MAP_EMPTY_SLOT;
+        slot->value = NULL;
+    }
+    map->size = 0;
+    map->nrOfDeleted = 0;
+}
+
+static size_t celix_hashMap_nextUsedSlot(const celix_hash_map_t *map, size_t start) {
+    size_t i = start;
+    while (i < map->capacity && !CELIX_HASH_MAP_IS_USED(&map->slots[i])) {
+        ++i;
+    }
+    return i;
+}
+
+/**********************************************************************************************************************
+ * String hash map
+ **********************************************************************************************************************/
+
+celix_string_hash_map_t* celix_stringHashMap_create(void) {
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    return celix_stringHashMap_createWithOptions(&opts);
+}
+
+celix_string_hash_map_t* celix_stringHashMap_createWithOptions(const celix_string_hash_map_create_options_t *opts) {
+    celix_string_hash_map_t *map = calloc(1, sizeof(*map));
+    if (map != NULL && !celix_hashMap_init(&map->genericMap, true, opts->storeKeysWeakly, opts->removedCallback, opts->initialCapacity)) {
+        free(map);
+        map = NULL;
+    }
+    return map;
+}
+
+void celix_stringHashMap_destroy(celix_string_hash_map_t *map) {
+    if (map != NULL) {
+        celix_hashMap_clear(&map->genericMap);
+        free(map->genericMap.slots);
+        free(map);
+    }
+}
+
+size_t celix_stringHashMap_size(const celix_string_hash_map_t *map) {
+    return map->genericMap.size;
+}
+
+void* celix_stringHashMap_get(const celix_string_hash_map_t *map, const char *key) {
+    celix_hash_map_slot_t *slot = celix_hashMap_findString(&map->genericMap, key, celix_hashMap_hashString(key));
+    return slot == NULL ? NULL : slot->value;
+}
+
+long celix_stringHashMap_getLong(const celix_string_hash_map_t *map, const char *key, long defaultValue) {
+    celix_hash_map_slot_t *slot = celix_hashMap_findString(&map->genericMap, key, celix_hashMap_hashString(key));
+    return slot == NULL ? defaultValue : (long)(intptr_t)slot->value;
+}
+
+bool celix_stringHashMap_hasKey(const celix_string_hash_map_t *map, const char *key) {
+    return celix_hashMap_findString(&map->genericMap, key, celix_hashMap_hashString(key)) != NULL;
+}
+
+celix_status_t celix_stringHashMap_put(celix_string_hash_map_t *map, const char *key, void *value) {
+    celix_hash_map_key_t k = {.strKey = key};
+    return celix_hashMap_put(&map->genericMap, k, value);
+}
+
+celix_status_t celix_stringHashMap_putLong(celix_string_hash_map_t *map, const char *key, long value) {
+    return celix_stringHashMap_put(map, key, (void*)(intptr_t)value);
+}
+
+bool celix_stringHashMap_remove(celix_string_hash_map_t *map, const char *key) {
+    celix_hash_map_key_t k = {.strKey = key};
+    return celix_hashMap_remove(&map->genericMap, k);
+}
+
+void celix_stringHashMap_clear(celix_string_hash_map_t *map) {
+    celix_hashMap_clear(&map->genericMap);
+}
+
+static void celix_stringHashMapIterator_update(celix_string_hash_map_iterator_t *iter) {
+    const celix_hash_map_t *map = &iter->_map->genericMap;
+    iter->_slot = celix_hashMap_nextUsedSlot(map, iter->_slot);
+    if (iter->_slot < map->capacity) {
+        iter->key = map->slots[iter->_slot].key.strKey;
+        iter->value = map->slots[iter->_slot].value;
+    } else {
+        iter->key = NULL;
+        iter->value = NULL;
+    }
+}
+
+celix_string_hash_map_iterator_t celix_stringHashMap_begin(const celix_string_hash_map_t *map) {
+    celix_string_hash_map_iterator_t iter;
+    memset(&iter, 0, sizeof(iter));
+    iter._map = (celix_string_hash_map_t*)map;
+    celix_stringHashMapIterator_update(&iter);
+    return iter;
+}
+
+bool celix_stringHashMapIterator_isEnd(const celix_string_hash_map_iterator_t *iter) {
+    return iter->_slot >= iter->_map->genericMap.capacity;
+}
+
+void celix_stringHashMapIterator_next(celix_string_hash_map_iterator_t *iter) {
+    if (!celix_stringHashMapIterator_isEnd(iter)) {
+        iter->index += 1;
+        iter->_slot += 1;
+        celix_stringHashMapIterator_update(iter);
+    }
+}
+
+void celix_stringHashMapIterator_remove(celix_string_hash_map_iterator_t *iter) {
+    if (!celix_stringHashMapIterator_isEnd(iter)) {
+        //removal leaves a tombstone, so the slots are not moved and the iteration can continue
+        celix_hashMap_removeSlot(&iter->_map->genericMap, &iter->_map->genericMap.slots[iter->_slot]);
+        iter->_slot += 1;
+        celix_stringHashMapIterator_update(iter);
+    }
+}
+
+/**********************************************************************************************************************
+ * Long hash map
+ **********************************************************************************************************************/
+
+celix_long_hash_map_t* celix_longHashMap_create(void) {
+    celix_long_hash_map_create_options_t opts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+    return celix_longHashMap_createWithOptions(&opts);
+}
+
+celix_long_hash_map_t* celix_longHashMap_createWithOptions(const celix_long_hash_map_create_options_t *opts) {
+    celix_long_hash_map_t *map = calloc(1, sizeof(*map));
+    if (map != NULL && !celix_hashMap_init(&map->genericMap, false, false, opts->removedCallback, opts->initialCapacity)) {
+        free(map);
+        map = NULL;
+    }
+    return map;
+}
+
+void celix_longHashMap_destroy(celix_long_hash_map_t *map) {
+    if (map != NULL) {
+        celix_hashMap_clear(&map->genericMap);
+        free(map->genericMap.slots);
+        free(map);
+    }
+}
+
+size_t celix_longHashMap_size(const celix_long_hash_map_t *map) {
+    return map->genericMap.size;
+}
+
+void* celix_longHashMap_get(const celix_long_hash_map_t *map, long key) {
+    celix_hash_map_slot_t *slot = celix_hashMap_findLong(&map->genericMap, key, celix_hashMap_hashLong(key));
+    return slot == NULL ? NULL : slot->value;
+}
+
+long celix_longHashMap_getLong(const celix_long_hash_map_t *map, long key, long defaultValue) {
+    celix_hash_map_slot_t *slot = celix_hashMap_findLong(&map->genericMap, key, celix_hashMap_hashLong(key));
+    return slot == NULL ? defaultValue : (long)(intptr_t)slot->value;
+}
+
+bool celix_longHashMap_hasKey(const celix_long_hash_map_t *map, long key) {
+    return celix_hashMap_findLong(&map->genericMap, key, celix_hashMap_hashLong(key)) != NULL;
+}
+
+celix_status_t celix_longHashMap_put(celix_long_hash_map_t *map, long key, void *value) {
+    celix_hash_map_key_t k = {.longKey = key};
+    return celix_hashMap_put(&map->genericMap, k, value);
+}
+
+celix_status_t celix_longHashMap_putLong(celix_long_hash_map_t *map, long key, long value) {
+    return celix_longHashMap_put(map, key, (void*)(intptr_t)value);
+}
+
+bool celix_longHashMap_remove(celix_long_hash_map_t *map, long key) {
+    celix_hash_map_key_t k = {.longKey = key};
+    return celix_hashMap_remove(&map->genericMap, k);
+}
+
+void celix_longHashMap_clear(celix_long_hash_map_t *map) {
+    celix_hashMap_clear(&map->genericMap);
+}
+
+static void celix_longHashMapIterator_update(celix_long_hash_map_iterator_t *iter) {
+    const celix_hash_map_t *map = &iter->_map->genericMap;
+    iter->_slot = celix_hashMap_nextUsedSlot(map, iter->_slot);
+    if (iter->_slot < map->capacity) {
+        iter->key = map->slots[iter->_slot].key.longKey;
+        iter->value = map->slots[iter->_slot].value;
+    } else {
+        iter->key = 0;
+        iter->value = NULL;
+    }
+}
+
+celix_long_hash_map_iterator_t celix_longHashMap_begin(const celix_long_hash_map_t *map) {
+    celix_long_hash_map_iterator_t iter;
+    memset(&iter, 0, sizeof(iter));
+    iter._map = (celix_long_hash_map_t*)map;
+    celix_longHashMapIterator_update(&iter);
+    return iter;
+}
+
+bool celix_longHashMapIterator_isEnd(const celix_long_hash_map_iterator_t *iter) {
+    return iter->_slot >= iter->_map->genericMap.capacity;
+}
+
+void celix_longHashMapIterator_next(celix_long_hash_map_iterator_t *iter) {
+    if (!celix_longHashMapIterator_isEnd(iter)) {
+        iter->index += 1;
+        iter->_slot += 1;
+        celix_longHashMapIterator_update(iter);
+    }
+}
+
+void celix_longHashMapIterator_remove(celix_long_hash_map_iterator_t *iter) {
+    if (!celix_longHashMapIterator_isEnd(iter)) {
+        celix_hashMap_removeSlot(&iter->_map->genericMap, &iter->_map->genericMap.slots[iter->_slot]);
+        iter->_slot += 1;
+        celix_longHashMapIterator_update(iter);
+    }
+}
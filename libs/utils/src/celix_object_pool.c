@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_object_pool.h"
+#include "celix_threads.h"
+
+#define CELIX_OBJECT_POOL_ALIGNMENT 16
+#define CELIX_OBJECT_POOL_DEFAULT_OBJECTS_PER_SLAB 64
+
+typedef union celix_object_pool_slab {
+    union celix_object_pool_slab *next;
+    char padding[CELIX_OBJECT_POOL_ALIGNMENT]; //keeps the objects after the slab header aligned
+} celix_object_pool_slab_t;
+
+typedef struct celix_object_pool_free_object {
+    struct celix_object_pool_free_object *next;
+} celix_object_pool_free_object_t;
+
+struct celix_object_pool {
+    size_t objectSize; //rounded up to the pool alignment
+    size_t objectsPerSlab;
+
+    celix_thread_mutex_t mutex; //protects below
+    celix_object_pool_slab_t *slabs;
+    celix_object_pool_free_object_t *freeList;
+    size_t nrOfAllocated;
+    size_t capacity;
+};
+
+celix_object_pool_t* celix_objectPool_create(size_t objectSize, size_t objectsPerSlab) {
+    celix_object_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool != NULL) {
+        if (objectSize < sizeof(celix_object_pool_free_object_t)) {
+            objectSize = sizeof(celix_object_pool_free_object_t);
+        }
+        pool->objectSize = (objectSize + CELIX_OBJECT_POOL_ALIGNMENT - 1) & ~((size_t)CELIX_OBJECT_POOL_ALIGNMENT - 1);
+        pool->objectsPerSlab = objectsPerSlab == 0 ? CELIX_OBJECT_POOL_DEFAULT_OBJECTS_PER_SLAB : objectsPerSlab;
+        celixThreadMutex_create(&pool->mutex, NULL);
+    }
+    return pool;
+}
+
+void celix_objectPool_destroy(celix_object_pool_t *pool) {
+    if (pool != NULL) {
+        celix_object_pool_slab_t *slab = pool->slabs;
+        while (slab != NULL) {
+            celix_object_pool_slab_t *next = slab->next;
+            free(slab);
+            slab = next;
+        }
+        celixThreadMutex_destroy(&pool->mutex);
+        free(pool);
+    }
+}
+
+static void celix_objectPool_addSlab(celix_object_pool_t *pool) {
+    //precondition pool->mutex locked
+    celix_object_pool_slab_t *slab = malloc(sizeof(*slab) + pool->objectSize * pool->objectsPerSlab);
+    if (slab != NULL) {
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        char *objects = (char*)(slab + 1);
+        //add in reverse, so that objects are handed out in address order
+        for (size_t i = pool->objectsPerSlab; i > 0; --i) {
+            celix_object_pool_free_object_t *obj = (celix_object_pool_free_object_t*)(objects + (i - 1) * pool->objectSize);
+            obj->next = pool->freeList;
+            pool->freeList = obj;
+        }
+        pool->capacity += pool->objectsPerSlab;
+    }
+}
+
+void* celix_objectPool_alloc(celix_object_pool_t *pool) {
+    celixThreadMutex_lock(&pool->mutex);
+    if (pool->freeList == NULL) {
+        celix_objectPool_addSlab(pool);
+    }
+    celix_object_pool_free_object_t *obj = pool->freeList;
+    if (obj != NULL) {
+        pool->freeList = obj->next;
+        pool->nrOfAllocated += 1;
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+
+    if (obj != NULL) {
+        memset(obj, 0, pool->objectSize);
+    }
+    return obj;
+}
+
+void celix_objectPool_free(celix_object_pool_t *pool, void *object) {
+    if (object != NULL) {
+        celix_object_pool_free_object_t *obj = object;
+        celixThreadMutex_lock(&pool->mutex);
+        obj->next = pool->freeList;
+        pool->freeList = obj;
+        pool->nrOfAllocated -= 1;
+        celixThreadMutex_unlock(&pool->mutex);
+    }
+}
+
+size_t celix_objectPool_nrOfAllocatedObjects(celix_object_pool_t *pool) {
+    celixThreadMutex_lock(&pool->mutex);
+    size_t result = pool->nrOfAllocated;
+    celixThreadMutex_unlock(&pool->mutex);
+    return result;
+}
+
+size_t celix_objectPool_capacity(celix_object_pool_t *pool) {
+    celixThreadMutex_lock(&pool->mutex);
+    size_t result = pool->capacity;
+    celixThreadMutex_unlock(&pool->mutex);
+    return result;
+}
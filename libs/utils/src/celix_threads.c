@@ -162,16 +162,24 @@ celix_status_t celixThreadCondition_timedwaitRelative(celix_thread_cond_t *cond,
     struct timespec time;
     gettimeofday(&tv, NULL);
     TIMEVAL_TO_TIMESPEC(&tv, &time)
-    time.tv_sec += seconds;
-    time.tv_nsec += nanoseconds;
+    time.tv_sec += seconds + nanoseconds / 1000000000L;
+    time.tv_nsec += nanoseconds % 1000000000L;
+    if (time.tv_nsec >= 1000000000L) {
+        time.tv_sec += 1;
+        time.tv_nsec -= 1000000000L;
+    }
     return pthread_cond_timedwait(cond, mutex, &time);
 }
 #else
 celix_status_t celixThreadCondition_timedwaitRelative(celix_thread_cond_t *cond, celix_thread_mutex_t *mutex, long seconds, long nanoseconds) {
     struct timespec time;
     clock_gettime(CLOCK_REALTIME, &time);
-    time.tv_sec += seconds;
-    time.tv_nsec += nanoseconds;
+    time.tv_sec += seconds + nanoseconds / 1000000000L;
+    time.tv_nsec += nanoseconds % 1000000000L;
+    if (time.tv_nsec >= 1000000000L) {
+        time.tv_sec += 1;
+        time.tv_nsec -= 1000000000L;
+    }
     return pthread_cond_timedwait(cond, mutex, &time);
 }
 #endif
@@ -22,6 +22,8 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <assert.h>
+#include <errno.h>
+#include <limits.h>
 #include <utils.h>
 
 #include "celix_filter.h"
@@ -38,7 +40,62 @@ static char * filter_parseAttr(char* filterString, int* pos);
 static char * filter_parseValue(char* filterString, int* pos);
 static celix_array_list_t* filter_parseSubstring(char* filterString, int* pos);
 
-static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, bool *result);
+static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, celix_properties_value_type_e propertyType, bool *result);
+static void filter_compile(celix_filter_t* filter);
+
+typedef struct celix_filter_internal celix_filter_internal_t;
+
+static void filter_destroyInternal(celix_filter_internal_t* internal);
+
+typedef struct celix_filter_version {
+    int major;
+    int minor;
+    int micro;
+    const char *qualifier; //not '\0' terminated, see qualifierLength
+    size_t qualifierLength;
+    int nrOfParts; //the number of parsed parts, including the qualifier
+} celix_filter_version_t;
+
+struct celix_filter_internal {
+    //pre-parsed operand value, used for the GREATER(EQUAL) and LESS(EQUAL) operands
+    bool convertedToLong;
+    long longValue;
+    bool convertedToDouble;
+    double doubleValue;
+    bool convertedToVersion;
+    celix_filter_version_t versionValue;
+
+    //substring matcher, used for the SUBSTRING operand. Note the substrings point to the filter children strings
+    size_t nrOfSubstrings;
+    const char **substrings;
+    size_t *substringLengths;
+    bool anchoredAtStart;
+    bool anchoredAtEnd;
+
+    //children sorted on evaluation cost (cheapest first), used for the AND and OR operands
+    size_t nrOfChildren;
+    celix_filter_t **orderedChildren;
+
+    int cost; //relative cost of evaluating the filter
+};
+
+/**
+ * Filter node as allocated by the filter parser. The public filter struct is the first member, so that the compiled
+ * form of the filter can be kept private.
+ */
+typedef struct celix_filter_node {
+    celix_filter_t filter;
+    celix_filter_internal_t *internal;
+} celix_filter_node_t;
+
+static celix_filter_t* filter_createNode(void) {
+    celix_filter_node_t *node = calloc(1, sizeof(*node));
+    return node == NULL ? NULL : &node->filter;
+}
+
+static inline celix_filter_internal_t* filter_getInternal(const celix_filter_t* filter) {
+    return ((const celix_filter_node_t*)filter)->internal;
+}
 
 static void filter_skipWhiteSpace(char * filterString, int * pos) {
     int length;
@@ -134,7 +191,7 @@ static celix_filter_t * filter_parseAndOrOr(char * filterString, celix_filter_op
         children = NULL;
     }
 
-    celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+    celix_filter_t * filter = filter_createNode();
     filter->operand = andOrOr;
     filter->children = children;
 
@@ -155,7 +212,7 @@ static celix_filter_t * filter_parseNot(char * filterString, int * pos) {
     celix_array_list_t* children = celix_arrayList_create();
     celix_arrayList_add(children, child);
 
-    celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+    celix_filter_t * filter = filter_createNode();
     filter->operand = CELIX_FILTER_OPERAND_NOT;
     filter->children = children;
 
@@ -172,7 +229,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
     switch(filterString[*pos]) {
         case '~': {
             if (filterString[*pos + 1] == '=') {
-                celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+                celix_filter_t * filter = filter_createNode();
                 *pos += 2;
                 filter->operand = CELIX_FILTER_OPERAND_APPROX;
                 filter->attribute = attr;
@@ -183,7 +240,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
         }
         case '>': {
             if (filterString[*pos + 1] == '=') {
-                celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+                celix_filter_t * filter = filter_createNode();
                 *pos += 2;
                 filter->operand = CELIX_FILTER_OPERAND_GREATEREQUAL;
                 filter->attribute = attr;
@@ -191,7 +248,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
                 return filter;
             }
             else {
-                celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+                celix_filter_t * filter = filter_createNode();
                 *pos += 1;
                 filter->operand = CELIX_FILTER_OPERAND_GREATER;
                 filter->attribute = attr;
@@ -202,7 +259,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
         }
         case '<': {
             if (filterString[*pos + 1] == '=') {
-                celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+                celix_filter_t * filter = filter_createNode();
                 *pos += 2;
                 filter->operand = CELIX_FILTER_OPERAND_LESSEQUAL;
                 filter->attribute = attr;
@@ -210,7 +267,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
                 return filter;
             }
             else {
-                celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+                celix_filter_t * filter = filter_createNode();
                 *pos += 1;
                 filter->operand = CELIX_FILTER_OPERAND_LESS;
                 filter->attribute = attr;
@@ -227,7 +284,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
                 *pos += 2;
                 filter_skipWhiteSpace(filterString, pos);
                 if (filterString[*pos] == ')') {
-                    celix_filter_t * filter = (celix_filter_t *) calloc(1, sizeof(*filter));
+                    celix_filter_t * filter = filter_createNode();
                     filter->operand = CELIX_FILTER_OPERAND_PRESENT;
                     filter->attribute = attr;
                     filter->value = NULL;
@@ -235,7 +292,7 @@ static celix_filter_t * filter_parseItem(char * filterString, int * pos) {
                 }
                 *pos = oldPos;
             }
-            filter = (celix_filter_t *) calloc(1, sizeof(*filter));            
+            filter = filter_createNode();            
             (*pos)++;
             subs = filter_parseSubstring(filterString, pos);
             if(subs!=NULL){
@@ -412,7 +469,179 @@ celix_status_t filter_match(celix_filter_t * filter, celix_properties_t *propert
     return CELIX_SUCCESS;
 }
 
-static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, bool *out) {
+static bool filter_convertToLong(const char *str, long *out) {
+    char *end = NULL;
+    errno = 0;
+    long result = strtol(str, &end, 10);
+    if (end == str || errno != 0) {
+        return false;
+    }
+    while (isspace(*end)) {
+        ++end;
+    }
+    if (*end != '\0') {
+        return false;
+    }
+    *out = result;
+    return true;
+}
+
+static bool filter_convertToDouble(const char *str, double *out) {
+    char *end = NULL;
+    errno = 0;
+    double result = strtod(str, &end);
+    if (end == str || errno != 0) {
+        return false;
+    }
+    while (isspace(*end)) {
+        ++end;
+    }
+    if (*end != '\0') {
+        return false;
+    }
+    *out = result;
+    return true;
+}
+
+static bool filter_parseVersionNumber(const char **str, int *out) {
+    const char *c = *str;
+    if (!isdigit(*c)) {
+        return false;
+    }
+    long result = 0;
+    while (isdigit(*c)) {
+        result = result * 10 + (*c - '0');
+        if (result > INT_MAX) {
+            return false;
+        }
+        ++c;
+    }
+    *out = (int)result;
+    *str = c;
+    return true;
+}
+
+/**
+ * Parses a version (major('.'minor('.'micro('.'qualifier)?)?)?) without allocating memory.
+ */
+static bool filter_convertToVersion(const char *str, celix_filter_version_t *out) {
+    celix_filter_version_t version = {0, 0, 0, "", 0, 1};
+    const char *c = str;
+    bool valid = filter_parseVersionNumber(&c, &version.major);
+    if (valid && *c == '.') {
+        ++c;
+        ++version.nrOfParts;
+        valid = filter_parseVersionNumber(&c, &version.minor);
+    }
+    if (valid && *c == '.') {
+        ++c;
+        ++version.nrOfParts;
+        valid = filter_parseVersionNumber(&c, &version.micro);
+    }
+    if (valid && *c == '.') {
+        ++c;
+        ++version.nrOfParts;
+        version.qualifier = c;
+        while (isalnum(*c) || *c == '_' || *c == '-') {
+            ++c;
+        }
+        version.qualifierLength = c - version.qualifier;
+        valid = version.qualifierLength > 0;
+    }
+    if (valid && *c == '\0') {
+        *out = version;
+        return true;
+    }
+    return false;
+}
+
+static int filter_compareVersions(const celix_filter_version_t *v1, const celix_filter_version_t *v2) {
+    if (v1->major != v2->major) {
+        return v1->major < v2->major ? -1 : 1;
+    } else if (v1->minor != v2->minor) {
+        return v1->minor < v2->minor ? -1 : 1;
+    } else if (v1->micro != v2->micro) {
+        return v1->micro < v2->micro ? -1 : 1;
+    }
+    size_t len = v1->qualifierLength < v2->qualifierLength ? v1->qualifierLength : v2->qualifierLength;
+    int cmp = strncmp(v1->qualifier, v2->qualifier, len);
+    if (cmp == 0 && v1->qualifierLength != v2->qualifierLength) {
+        cmp = v1->qualifierLength < v2->qualifierLength ? -1 : 1;
+    }
+    return cmp;
+}
+
+/**
+ * Compares the property value with the filter value.
+ * If both values can be converted to a long the values are compared as long. Versions are compared as version if the
+ * property is set as version, or if one of the values is a 3-part or qualified version (e.g. "1.10.0"). Otherwise,
+ * values which can be converted to a double are compared as double (so "0.25" < "0.3") and the remaining values are
+ * compared as string.
+ */
+static int filter_compareValues(const celix_filter_t* filter, const char *propertyValue, celix_properties_value_type_e propertyType) {
+    const celix_filter_internal_t *internal = filter_getInternal(filter);
+    if (internal != NULL) {
+        long longValue;
+        double doubleValue;
+        celix_filter_version_t versionValue;
+        if (propertyType != CELIX_PROPERTIES_VALUE_TYPE_VERSION && internal->convertedToLong && filter_convertToLong(propertyValue, &longValue)) {
+            return longValue < internal->longValue ? -1 : (longValue > internal->longValue ? 1 : 0);
+        }
+        if (propertyType != CELIX_PROPERTIES_VALUE_TYPE_DOUBLE && internal->convertedToVersion && filter_convertToVersion(propertyValue, &versionValue)) {
+            bool asVersion = propertyType == CELIX_PROPERTIES_VALUE_TYPE_VERSION ||
+                             versionValue.nrOfParts >= 3 || internal->versionValue.nrOfParts >= 3 ||
+                             !internal->convertedToDouble;
+            if (asVersion) {
+                return filter_compareVersions(&versionValue, &internal->versionValue);
+            }
+        }
+        if (internal->convertedToDouble && filter_convertToDouble(propertyValue, &doubleValue)) {
+            return doubleValue < internal->doubleValue ? -1 : (doubleValue > internal->doubleValue ? 1 : 0);
+        }
+    }
+    return strcmp(propertyValue, filter->value);
+}
+
+static bool filter_matchSubstring(const celix_filter_internal_t *internal, const char *propertyValue) {
+    const char *pos = propertyValue;
+    const char *end = propertyValue + strlen(propertyValue);
+    size_t first = 0;
+    size_t last = internal->nrOfSubstrings;
+
+    if (internal->anchoredAtStart) {
+        if (strncmp(pos, internal->substrings[0], internal->substringLengths[0]) != 0) {
+            return false;
+        }
+        pos += internal->substringLengths[0];
+        first = 1;
+    }
+    if (internal->anchoredAtEnd) {
+        if (first == last) {
+            //single substring which is both prefix and suffix
+            return pos == end;
+        }
+        last -= 1;
+    }
+
+    for (size_t i = first; i < last; ++i) {
+        const char *found = strstr(pos, internal->substrings[i]);
+        if (found == NULL) {
+            return false;
+        }
+        pos = found + internal->substringLengths[i];
+    }
+
+    if (internal->anchoredAtEnd) {
+        size_t len = internal->substringLengths[last];
+        if ((size_t)(end - pos) < len) {
+            return false;
+        }
+        return strncmp(end - len, internal->substrings[last], len) == 0;
+    }
+    return true;
+}
+
+static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, celix_properties_value_type_e propertyType, bool *out) {
     celix_status_t  status = CELIX_SUCCESS;
     bool result = false;
 
@@ -423,80 +652,29 @@ static celix_status_t filter_compare(const celix_filter_t* filter, const char *p
 
     switch (filter->operand) {
         case CELIX_FILTER_OPERAND_SUBSTRING: {
-            int pos = 0;
-            unsigned int i;
-            int size = celix_arrayList_size(filter->children);
-            for (i = 0; i < size; i++) {
-                char * substr = (char *) celix_arrayList_get(filter->children, i);
-
-                if (i + 1 < size) {
-                    if (substr == NULL) {
-                        unsigned int index;
-                        char * substr2 = (char *) celix_arrayList_get(filter->children, i + 1);
-                        if (substr2 == NULL) {
-                            continue;
-                        }
-                        index = strcspn(propertyValue+pos, substr2);
-                        if (index == strlen(propertyValue+pos)) {
-                            *out = false;
-                            return CELIX_SUCCESS;
-                        }
-
-                        pos = index + strlen(substr2);
-                        if (i + 2 < size) {
-                            i++;
-                        }
-                    } else {
-                        unsigned int len = strlen(substr);
-                        char * region = (char *)calloc(1, len+1);
-                        strncpy(region, propertyValue+pos, len);
-                        region[len]    = '\0';
-                        if (strcmp(region, substr) == 0) {
-                            pos += len;
-                        } else {
-                            free(region);
-                            *out = false;
-                            return CELIX_SUCCESS;
-                        }
-                        free(region);
-                    }
-                } else {
-                    unsigned int len;
-                    int begin;
-
-                    if (substr == NULL) {
-                        *out = true;
-                        return CELIX_SUCCESS;
-                    }
-                    len = strlen(substr);
-                    begin = strlen(propertyValue)-len;
-                    *out = (strcmp(propertyValue+begin, substr) == 0);
-                    return CELIX_SUCCESS;
-                }
-            }
-            *out = true;
-            return CELIX_SUCCESS;
+            result = filter_getInternal(filter) == NULL || filter_matchSubstring(filter_getInternal(filter), propertyValue);
+            break;
         }
         case CELIX_FILTER_OPERAND_APPROX: //TODO: Implement strcmp with ignorecase and ignorespaces
         case CELIX_FILTER_OPERAND_EQUAL: {
-            *out = (strcmp(propertyValue, filter->value) == 0);
-            return CELIX_SUCCESS;
+            result = (strcmp(propertyValue, filter->value) == 0);
+            break;
         }
         case CELIX_FILTER_OPERAND_GREATER: {
-            *out = (strcmp(propertyValue, filter->value) > 0);
-            return CELIX_SUCCESS;
+            result = filter_compareValues(filter, propertyValue, propertyType) > 0;
+            break;
         }
         case CELIX_FILTER_OPERAND_GREATEREQUAL: {
-            *out = (strcmp(propertyValue, filter->value) >= 0);
-            return CELIX_SUCCESS;
+            result = filter_compareValues(filter, propertyValue, propertyType) >= 0;
+            break;
         }
         case CELIX_FILTER_OPERAND_LESS: {
-            *out = (strcmp(propertyValue, filter->value) < 0);
-            return CELIX_SUCCESS;
+            result = filter_compareValues(filter, propertyValue, propertyType) < 0;
+            break;
         }
         case CELIX_FILTER_OPERAND_LESSEQUAL: {
-            *out = (strcmp(propertyValue, filter->value) <= 0);
-            return CELIX_SUCCESS;
+            result = filter_compareValues(filter, propertyValue, propertyType) <= 0;
+            break;
         }
         case CELIX_FILTER_OPERAND_AND:
         case CELIX_FILTER_OPERAND_NOT:
@@ -512,6 +690,102 @@ static celix_status_t filter_compare(const celix_filter_t* filter, const char *p
     return status;
 }
 
+static void filter_compileSubstring(celix_filter_t* filter, celix_filter_internal_t *internal) {
+    int size = filter->children == NULL ? 0 : celix_arrayList_size(filter->children);
+    internal->substrings = calloc(size + 1, sizeof(*internal->substrings));
+    internal->substringLengths = calloc(size + 1, sizeof(*internal->substringLengths));
+    for (int i = 0; i < size; ++i) {
+        const char *substr = celix_arrayList_get(filter->children, i);
+        if (substr != NULL) {
+            internal->substrings[internal->nrOfSubstrings] = substr;
+            internal->substringLengths[internal->nrOfSubstrings] = strlen(substr);
+            internal->nrOfSubstrings += 1;
+        }
+    }
+    if (internal->nrOfSubstrings > 0) {
+        internal->anchoredAtStart = celix_arrayList_get(filter->children, 0) != NULL;
+        internal->anchoredAtEnd = celix_arrayList_get(filter->children, size - 1) != NULL;
+    }
+}
+
+static void filter_compileChildren(celix_filter_t* filter, celix_filter_internal_t *internal) {
+    int size = filter->children == NULL ? 0 : celix_arrayList_size(filter->children);
+    internal->orderedChildren = calloc(size + 1, sizeof(*internal->orderedChildren));
+    for (int i = 0; i < size; ++i) {
+        celix_filter_t *child = celix_arrayList_get(filter->children, i);
+        if (child == NULL) {
+            continue;
+        }
+        filter_compile(child);
+        int childCost = filter_getInternal(child) != NULL ? filter_getInternal(child)->cost : 0;
+        internal->cost += childCost;
+
+        //stable insertion sort on cost, so that cheap checks are evaluated first
+        size_t k = internal->nrOfChildren;
+        while (k > 0) {
+            celix_filter_t *prev = internal->orderedChildren[k - 1];
+            int prevCost = filter_getInternal(prev) != NULL ? filter_getInternal(prev)->cost : 0;
+            if (prevCost <= childCost) {
+                break;
+            }
+            internal->orderedChildren[k] = prev;
+            --k;
+        }
+        internal->orderedChildren[k] = child;
+        internal->nrOfChildren += 1;
+    }
+}
+
+/**
+ * Compiles the filter: pre-parses the operand values to long, double and version, creates a substring
+ * matcher for substring operands and orders the AND/OR children on evaluation cost.
+ */
+static void filter_compile(celix_filter_t* filter) {
+    celix_filter_internal_t *internal = calloc(1, sizeof(*internal));
+    if (internal == NULL) {
+        return;
+    }
+    switch (filter->operand) {
+        case CELIX_FILTER_OPERAND_AND:
+        case CELIX_FILTER_OPERAND_OR:
+        case CELIX_FILTER_OPERAND_NOT:
+            filter_compileChildren(filter, internal);
+            break;
+        case CELIX_FILTER_OPERAND_PRESENT:
+            internal->cost = 1;
+            break;
+        case CELIX_FILTER_OPERAND_EQUAL:
+        case CELIX_FILTER_OPERAND_APPROX:
+            internal->cost = 2;
+            break;
+        case CELIX_FILTER_OPERAND_GREATER:
+        case CELIX_FILTER_OPERAND_GREATEREQUAL:
+        case CELIX_FILTER_OPERAND_LESS:
+        case CELIX_FILTER_OPERAND_LESSEQUAL:
+            if (filter->value != NULL) {
+                internal->convertedToLong = filter_convertToLong(filter->value, &internal->longValue);
+                internal->convertedToDouble = filter_convertToDouble(filter->value, &internal->doubleValue);
+                internal->convertedToVersion = filter_convertToVersion(filter->value, &internal->versionValue);
+            }
+            internal->cost = 3;
+            break;
+        case CELIX_FILTER_OPERAND_SUBSTRING:
+            filter_compileSubstring(filter, internal);
+            internal->cost = 4;
+            break;
+    }
+    ((celix_filter_node_t*)filter)->internal = internal;
+}
+
+static void filter_destroyInternal(celix_filter_internal_t* internal) {
+    if (internal != NULL) {
+        free(internal->substrings);
+        free(internal->substringLengths);
+        free(internal->orderedChildren);
+        free(internal);
+    }
+}
+
 celix_status_t filter_getString(celix_filter_t * filter, const char **filterStr) {
     if (filter != NULL) {
         *filterStr = filter->filterStr;
@@ -552,6 +826,7 @@ celix_filter_t* celix_filter_create(const char *filterString) {
         free(filterStr);
     } else {
         filter->filterStr = filterStr;
+        filter_compile(filter);
     }
 
     return filter;
@@ -559,6 +834,8 @@ celix_filter_t* celix_filter_create(const char *filterString) {
 
 void celix_filter_destroy(celix_filter_t *filter) {
     if (filter != NULL) {
+        filter_destroyInternal(filter_getInternal(filter));
+        ((celix_filter_node_t*)filter)->internal = NULL;
         if(filter->children != NULL){
             if (filter->operand == CELIX_FILTER_OPERAND_SUBSTRING) {
                 int size = celix_arrayList_size(filter->children);
@@ -592,14 +869,29 @@ void celix_filter_destroy(celix_filter_t *filter) {
     }
 }
 
+static size_t filter_nrOfChildrenForEvaluation(const celix_filter_t *filter) {
+    const celix_filter_internal_t *internal = filter_getInternal(filter);
+    if (internal != NULL) {
+        return internal->nrOfChildren;
+    }
+    return filter->children == NULL ? 0 : celix_arrayList_size(filter->children);
+}
+
+static celix_filter_t* filter_getChildForEvaluation(const celix_filter_t *filter, size_t index) {
+    const celix_filter_internal_t *internal = filter_getInternal(filter);
+    if (internal != NULL) {
+        return internal->orderedChildren[index];
+    }
+    return celix_arrayList_get(filter->children, (int)index);
+}
+
 bool celix_filter_match(const celix_filter_t *filter, const celix_properties_t* properties) {
     bool result = false;
     switch (filter->operand) {
         case CELIX_FILTER_OPERAND_AND: {
-            celix_array_list_t* children = filter->children;
-            unsigned int i;
-            for (i = 0; i < celix_arrayList_size(children); i++) {
-                celix_filter_t * sfilter = (celix_filter_t *) celix_arrayList_get(children, i);
+            size_t size = filter_nrOfChildrenForEvaluation(filter);
+            for (size_t i = 0; i < size; i++) {
+                celix_filter_t * sfilter = filter_getChildForEvaluation(filter, i);
                 bool mresult = celix_filter_match(sfilter, properties);
                 if (!mresult) {
                     return false;
@@ -608,10 +900,9 @@ bool celix_filter_match(const celix_filter_t *filter, const celix_properties_t*
             return true;
         }
         case CELIX_FILTER_OPERAND_OR: {
-            celix_array_list_t* children = filter->children;
-            unsigned int i;
-            for (i = 0; i < celix_arrayList_size(children); i++) {
-                celix_filter_t * sfilter = (celix_filter_t *) celix_arrayList_get(children, i);
+            size_t size = filter_nrOfChildrenForEvaluation(filter);
+            for (size_t i = 0; i < size; i++) {
+                celix_filter_t * sfilter = filter_getChildForEvaluation(filter, i);
                 bool mresult = celix_filter_match(sfilter, properties);
                 if (mresult) {
                     return true;
@@ -632,7 +923,12 @@ bool celix_filter_match(const celix_filter_t *filter, const celix_properties_t*
         case CELIX_FILTER_OPERAND_LESSEQUAL :
         case CELIX_FILTER_OPERAND_APPROX : {
             char * value = (properties == NULL) ? NULL: (char*)celix_properties_get(properties, filter->attribute, NULL);
-            filter_compare(filter, value, &result);
+            celix_properties_value_type_e type = CELIX_PROPERTIES_VALUE_TYPE_STRING;
+            if (value != NULL && filter->operand != CELIX_FILTER_OPERAND_SUBSTRING && filter->operand != CELIX_FILTER_OPERAND_EQUAL && filter->operand != CELIX_FILTER_OPERAND_APPROX) {
+                //note the value type is only needed for ordering
+                type = celix_properties_getType(properties, filter->attribute);
+            }
+            filter_compare(filter, value, type, &result);
             return result;
         }
         case CELIX_FILTER_OPERAND_PRESENT: {
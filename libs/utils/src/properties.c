@@ -32,7 +32,9 @@
 #include "properties.h"
 #include "celix_properties.h"
 #include "utils.h"
-#include "hash_map_private.h"
+#include "celix_string_hash_map.h"
+#include "celix_utils.h"
+#include "celix_version.h"
 #include <errno.h>
 
 
@@ -217,19 +219,88 @@ static void parseLine(const char* line, celix_properties_t *props) {
 
 
 
+#define CELIX_PROPERTIES_LONG_PARSED     0x01
+#define CELIX_PROPERTIES_LONG_VALID      0x02
+#define CELIX_PROPERTIES_DOUBLE_PARSED   0x04
+#define CELIX_PROPERTIES_DOUBLE_VALID    0x08
+#define CELIX_PROPERTIES_BOOL_PARSED     0x10
+#define CELIX_PROPERTIES_BOOL_VALID      0x20
+#define CELIX_PROPERTIES_VERSION_PARSED  0x40
+
+/**
+ * A properties entry. The string form of the value is always present. The typed values are set by the typed setters
+ * or parsed (once) from the string form on the first typed get.
+ *
+ * Note that the typed values are lazily parsed from const getters, which can be called concurrently. The parsed
+ * values are therefore written and read with atomics and published with the parsedFlags (release/acquire).
+ */
+typedef struct celix_properties_entry {
+    char *key; //note the map stores the key weakly, the key is owned by the entry
+    char *value;
+    celix_properties_value_type_e valueType;
+    int parsedFlags;
+    long longValue;
+    double doubleValue;
+    bool boolValue;
+    celix_version_t *versionValue;
+} celix_properties_entry_t;
+
+struct celix_properties {
+    celix_string_hash_map_t *map; //key = char* (owned by entry), value = celix_properties_entry_t*
+};
+
+static celix_properties_entry_t* celix_properties_createEntry(char *value, celix_properties_value_type_e type) {
+    celix_properties_entry_t *entry = calloc(1, sizeof(*entry));
+    entry->value = value;
+    entry->valueType = type;
+    return entry;
+}
+
+static void celix_properties_destroyEntry(celix_properties_entry_t *entry) {
+    if (entry != NULL) {
+        free(entry->key);
+        free(entry->value);
+        celix_version_destroy(entry->versionValue);
+        free(entry);
+    }
+}
+
+static celix_properties_entry_t* celix_properties_getEntry(const celix_properties_t *properties, const char *key) {
+    celix_properties_entry_t *entry = NULL;
+    if (properties != NULL && key != NULL) {
+        entry = celix_stringHashMap_get(properties->map, key);
+    }
+    return entry != NULL && entry->value != NULL ? entry : NULL;
+}
+
+/**
+ * Puts the entry in the properties, taking ownership of the key.
+ */
+static void celix_properties_putEntry(celix_properties_t *properties, char *key, celix_properties_entry_t *entry) {
+    entry->key = key;
+    //note a replaced entry (and its key) is destroyed by the removed callback
+    celix_stringHashMap_put(properties->map, key, entry);
+}
+
+static void celix_properties_removedCallback(void *entry) {
+    celix_properties_destroyEntry(entry);
+}
+
 celix_properties_t* celix_properties_create(void) {
-    return hashMap_create(utils_stringHash, utils_stringHash, utils_stringEquals, utils_stringEquals);
+    celix_properties_t *props = malloc(sizeof(*props));
+    if (props != NULL) {
+        celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+        opts.storeKeysWeakly = true;
+        opts.removedCallback = celix_properties_removedCallback;
+        props->map = celix_stringHashMap_createWithOptions(&opts);
+    }
+    return props;
 }
 
 void celix_properties_destroy(celix_properties_t *properties) {
     if (properties != NULL) {
-        hash_map_iterator_pt iter = hashMapIterator_create(properties);
-        while (hashMapIterator_hasNext(iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-            hashMapEntry_clear(entry, true, true);
-        }
-        hashMapIterator_destroy(iter);
-        hashMap_destroy(properties, false, false);
+        celix_stringHashMap_destroy(properties->map);
+        free(properties);
     }
 }
 
@@ -308,14 +379,16 @@ celix_properties_t* celix_properties_loadFromString(const char *input) {
 
 void celix_properties_store(celix_properties_t *properties, const char *filename, const char *header) {
     FILE *file = fopen (filename, "w+" );
-    char *str;
+    const char *str;
 
     if (file != NULL) {
-        if (hashMap_size(properties) > 0) {
-            hash_map_iterator_pt iterator = hashMapIterator_create(properties);
-            while (hashMapIterator_hasNext(iterator)) {
-                hash_map_entry_pt entry = hashMapIterator_nextEntry(iterator);
-                str = hashMapEntry_getKey(entry);
+        if (celix_stringHashMap_size(properties->map) > 0) {
+            CELIX_STRING_HASH_MAP_ITERATE(properties->map, iter) {
+                celix_properties_entry_t *propEntry = iter.value;
+                if (propEntry->value == NULL) {
+                    continue;
+                }
+                str = iter.key;
                 for (int i = 0; i < strlen(str); i += 1) {
                     if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
                         fputc('\\', file);
@@ -325,7 +398,7 @@ void celix_properties_store(celix_properties_t *properties, const char *filename
 
                 fputc('=', file);
 
-                str = hashMapEntry_getValue(entry);
+                str = propEntry->value;
                 for (int i = 0; i < strlen(str); i += 1) {
                     if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
                         fputc('\\', file);
@@ -336,7 +409,6 @@ void celix_properties_store(celix_properties_t *properties, const char *filename
                 fputc('\n', file);
 
             }
-            hashMapIterator_destroy(iterator);
         }
         fclose(file);
     } else {
@@ -346,96 +418,115 @@ void celix_properties_store(celix_properties_t *properties, const char *filename
 
 celix_properties_t* celix_properties_copy(const celix_properties_t *properties) {
     celix_properties_t *copy = celix_properties_create();
-    if (copy != NULL) {
-        hash_map_iterator_t iter = hashMapIterator_construct((hash_map_t*)properties);
-        while (hashMapIterator_hasNext(&iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(&iter);
-            char *key = hashMapEntry_getKey(entry);
-            char *value = hashMapEntry_getValue(entry);
-            celix_properties_set(copy, key, value);
+    if (copy != NULL && properties != NULL) {
+        CELIX_STRING_HASH_MAP_ITERATE(properties->map, iter) {
+            const char *key = iter.key;
+            const celix_properties_entry_t *propEntry = iter.value;
+            celix_properties_entry_t *copyEntry = celix_properties_createEntry(propEntry->value == NULL ? NULL : celix_utils_strdup(propEntry->value), propEntry->valueType);
+            //note only copy the typed values set by typed setters, parsed values will be parsed again when needed
+            if (propEntry->valueType == CELIX_PROPERTIES_VALUE_TYPE_LONG) {
+                copyEntry->longValue = propEntry->longValue;
+                copyEntry->parsedFlags = CELIX_PROPERTIES_LONG_PARSED | CELIX_PROPERTIES_LONG_VALID;
+            } else if (propEntry->valueType == CELIX_PROPERTIES_VALUE_TYPE_DOUBLE) {
+                copyEntry->doubleValue = propEntry->doubleValue;
+                copyEntry->parsedFlags = CELIX_PROPERTIES_DOUBLE_PARSED | CELIX_PROPERTIES_DOUBLE_VALID;
+            } else if (propEntry->valueType == CELIX_PROPERTIES_VALUE_TYPE_BOOL) {
+                copyEntry->boolValue = propEntry->boolValue;
+                copyEntry->parsedFlags = CELIX_PROPERTIES_BOOL_PARSED | CELIX_PROPERTIES_BOOL_VALID;
+            } else if (propEntry->valueType == CELIX_PROPERTIES_VALUE_TYPE_VERSION) {
+                copyEntry->versionValue = celix_version_copy(propEntry->versionValue);
+                copyEntry->parsedFlags = CELIX_PROPERTIES_VERSION_PARSED;
+            }
+            celix_properties_putEntry(copy, celix_utils_strdup(key), copyEntry);
         }
     }
     return copy;
 }
 
 const char* celix_properties_get(const celix_properties_t *properties, const char *key, const char *defaultValue) {
-    const char* value = NULL;
-    if (properties != NULL) {
-        value = hashMap_get((hash_map_t*)properties, (void*)key);
-    }
-    return value == NULL ? defaultValue : value;
+    const celix_properties_entry_t *entry = celix_properties_getEntry(properties, key);
+    return entry == NULL ? defaultValue : entry->value;
 }
 
 void celix_properties_set(celix_properties_t *properties, const char *key, const char *value) {
     if (properties != NULL) {
-        hash_map_entry_pt entry = hashMap_getEntry(properties, key);
-        char *oldVal = NULL;
         char *newVal = value == NULL ? NULL : strndup(value, 1024 * 1024);
-        if (entry != NULL) {
-            char *oldKey = hashMapEntry_getKey(entry);
-            oldVal = hashMapEntry_getValue(entry);
-            hashMap_put(properties, oldKey, newVal);
-        } else {
-            hashMap_put(properties, strndup(key, 1024 * 1024), newVal);
-        }
-        free(oldVal);
+        celix_properties_putEntry(properties, strndup(key, 1024 * 1024), celix_properties_createEntry(newVal, CELIX_PROPERTIES_VALUE_TYPE_STRING));
     }
 }
 
 void celix_properties_setWithoutCopy(celix_properties_t *properties, char *key, char *value) {
     if (properties != NULL) {
-        hash_map_entry_pt entry = hashMap_getEntry(properties, key);
-        char *oldVal = NULL;
-        if (entry != NULL) {
-            char *oldKey = hashMapEntry_getKey(entry);
-            oldVal = hashMapEntry_getValue(entry);
-            hashMap_put(properties, oldKey, value);
-        } else {
-            hashMap_put(properties, key, value);
-        }
-        free(oldVal);
+        celix_properties_putEntry(properties, key, celix_properties_createEntry(value, CELIX_PROPERTIES_VALUE_TYPE_STRING));
     }
 }
 
 void celix_properties_unset(celix_properties_t *properties, const char *key) {
-    char* oldValue = hashMap_remove(properties, key);
-    free(oldValue);
+    if (properties != NULL) {
+        celix_stringHashMap_remove(properties->map, key);
+    }
+}
+
+celix_properties_value_type_e celix_properties_getType(const celix_properties_t *props, const char *key) {
+    const celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    return entry == NULL ? CELIX_PROPERTIES_VALUE_TYPE_UNSET : entry->valueType;
 }
 
 long celix_properties_getAsLong(const celix_properties_t *props, const char *key, long defaultValue) {
-    long result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
-    if (val != NULL) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL) {
+        return defaultValue;
+    }
+    int flags = __atomic_load_n(&entry->parsedFlags, __ATOMIC_ACQUIRE);
+    if ((flags & CELIX_PROPERTIES_LONG_PARSED) == 0) {
         char *enptr = NULL;
         errno = 0;
-        long r = strtol(val, &enptr, 10);
-        if (enptr != val && errno == 0) {
-            result = r;
+        long r = strtol(entry->value, &enptr, 10);
+        int parsed = CELIX_PROPERTIES_LONG_PARSED;
+        if (enptr != entry->value && errno == 0) {
+            __atomic_store_n(&entry->longValue, r, __ATOMIC_RELAXED);
+            parsed |= CELIX_PROPERTIES_LONG_VALID;
         }
+        flags = __atomic_or_fetch(&entry->parsedFlags, parsed, __ATOMIC_RELEASE);
     }
-    return result;
+    return (flags & CELIX_PROPERTIES_LONG_VALID) ? __atomic_load_n(&entry->longValue, __ATOMIC_RELAXED) : defaultValue;
 }
 
 void celix_properties_setLong(celix_properties_t *props, const char *key, long value) {
     char buf[32]; //should be enough to store long long int
     int writen = snprintf(buf, 32, "%li", value);
     if (writen <= 31) {
-        celix_properties_set(props, key, buf);
+        if (props != NULL) {
+            celix_properties_entry_t *entry = celix_properties_createEntry(celix_utils_strdup(buf), CELIX_PROPERTIES_VALUE_TYPE_LONG);
+            entry->longValue = value;
+            entry->parsedFlags = CELIX_PROPERTIES_LONG_PARSED | CELIX_PROPERTIES_LONG_VALID;
+            celix_properties_putEntry(props, strndup(key, 1024 * 1024), entry);
+        }
     } else {
         fprintf(stderr,"buf to small for value '%li'\n", value);
     }
 }
 
 double celix_properties_getAsDouble(const celix_properties_t *props, const char *key, double defaultValue) {
-    double result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
-    if (val != NULL) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL) {
+        return defaultValue;
+    }
+    int flags = __atomic_load_n(&entry->parsedFlags, __ATOMIC_ACQUIRE);
+    if ((flags & CELIX_PROPERTIES_DOUBLE_PARSED) == 0) {
         char *enptr = NULL;
         errno = 0;
-        double r = strtod(val, &enptr);
-        if (enptr != val && errno == 0) {
-            result = r;
+        double r = strtod(entry->value, &enptr);
+        int parsed = CELIX_PROPERTIES_DOUBLE_PARSED;
+        if (enptr != entry->value && errno == 0) {
+            __atomic_store(&entry->doubleValue, &r, __ATOMIC_RELAXED);
+            parsed |= CELIX_PROPERTIES_DOUBLE_VALID;
         }
+        flags = __atomic_or_fetch(&entry->parsedFlags, parsed, __ATOMIC_RELEASE);
+    }
+    double result = defaultValue;
+    if (flags & CELIX_PROPERTIES_DOUBLE_VALID) {
+        __atomic_load(&entry->doubleValue, &result, __ATOMIC_RELAXED);
     }
     return result;
 }
@@ -444,42 +535,89 @@ void celix_properties_setDouble(celix_properties_t *props, const char *key, doub
     char buf[32]; //should be enough to store long long int
     int writen = snprintf(buf, 32, "%f", val);
     if (writen <= 31) {
-        celix_properties_set(props, key, buf);
+        if (props != NULL) {
+            celix_properties_entry_t *entry = celix_properties_createEntry(celix_utils_strdup(buf), CELIX_PROPERTIES_VALUE_TYPE_DOUBLE);
+            entry->doubleValue = val;
+            entry->parsedFlags = CELIX_PROPERTIES_DOUBLE_PARSED | CELIX_PROPERTIES_DOUBLE_VALID;
+            celix_properties_putEntry(props, strndup(key, 1024 * 1024), entry);
+        }
     } else {
         fprintf(stderr,"buf to small for value '%f'\n", val);
     }
 }
 
 bool celix_properties_getAsBool(const celix_properties_t *props, const char *key, bool defaultValue) {
-    bool result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
-    if (val != NULL) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL) {
+        return defaultValue;
+    }
+    int flags = __atomic_load_n(&entry->parsedFlags, __ATOMIC_ACQUIRE);
+    if ((flags & CELIX_PROPERTIES_BOOL_PARSED) == 0) {
         char buf[32];
-        snprintf(buf, 32, "%s", val);
+        snprintf(buf, 32, "%s", entry->value);
         char *trimmed = utils_stringTrim(buf);
+        int parsed = CELIX_PROPERTIES_BOOL_PARSED;
         if (strncasecmp("true", trimmed, strlen("true")) == 0) {
-            result = true;
+            __atomic_store_n(&entry->boolValue, true, __ATOMIC_RELAXED);
+            parsed |= CELIX_PROPERTIES_BOOL_VALID;
         } else if (strncasecmp("false", trimmed, strlen("false")) == 0) {
-            result = false;
+            __atomic_store_n(&entry->boolValue, false, __ATOMIC_RELAXED);
+            parsed |= CELIX_PROPERTIES_BOOL_VALID;
         }
+        flags = __atomic_or_fetch(&entry->parsedFlags, parsed, __ATOMIC_RELEASE);
     }
-    return result;
+    return (flags & CELIX_PROPERTIES_BOOL_VALID) ? __atomic_load_n(&entry->boolValue, __ATOMIC_RELAXED) : defaultValue;
 }
 
 void celix_properties_setBool(celix_properties_t *props, const char *key, bool val) {
-    celix_properties_set(props, key, val ? "true" : "false");
+    if (props != NULL) {
+        celix_properties_entry_t *entry = celix_properties_createEntry(celix_utils_strdup(val ? "true" : "false"), CELIX_PROPERTIES_VALUE_TYPE_BOOL);
+        entry->boolValue = val;
+        entry->parsedFlags = CELIX_PROPERTIES_BOOL_PARSED | CELIX_PROPERTIES_BOOL_VALID;
+        celix_properties_putEntry(props, strndup(key, 1024 * 1024), entry);
+    }
+}
+
+const celix_version_t* celix_properties_getAsVersion(const celix_properties_t *props, const char *key, const celix_version_t *defaultValue) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL) {
+        return defaultValue;
+    }
+    int flags = __atomic_load_n(&entry->parsedFlags, __ATOMIC_ACQUIRE);
+    if ((flags & CELIX_PROPERTIES_VERSION_PARSED) == 0) {
+        celix_version_t *version = celix_version_createVersionFromString(entry->value);
+        celix_version_t *expected = NULL;
+        if (version != NULL && !__atomic_compare_exchange_n(&entry->versionValue, &expected, version, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            //parsed concurrently by another thread
+            celix_version_destroy(version);
+        }
+        __atomic_or_fetch(&entry->parsedFlags, CELIX_PROPERTIES_VERSION_PARSED, __ATOMIC_RELEASE);
+    }
+    celix_version_t *result = __atomic_load_n(&entry->versionValue, __ATOMIC_ACQUIRE);
+    return result == NULL ? defaultValue : result;
+}
+
+void celix_properties_setVersion(celix_properties_t *props, const char *key, const celix_version_t *version) {
+    if (props != NULL && version != NULL) {
+        celix_properties_entry_t *entry = celix_properties_createEntry(celix_version_toString(version), CELIX_PROPERTIES_VALUE_TYPE_VERSION);
+        entry->versionValue = celix_version_copy(version);
+        entry->parsedFlags = CELIX_PROPERTIES_VERSION_PARSED;
+        celix_properties_putEntry(props, strndup(key, 1024 * 1024), entry);
+    }
 }
 
 int celix_properties_size(const celix_properties_t *properties) {
-    return hashMap_size((hash_map_t*)properties);
+    return properties == NULL ? 0 : (int)celix_stringHashMap_size(properties->map);
 }
 
 celix_properties_iterator_t celix_propertiesIterator_construct(const celix_properties_t *properties) {
-    return hashMapIterator_construct((hash_map_t*)properties);
+    return celix_stringHashMap_begin(properties->map);
 }
 bool celix_propertiesIterator_hasNext(celix_properties_iterator_t *iter) {
-    return hashMapIterator_hasNext(iter);
+    return !celix_stringHashMapIterator_isEnd(iter);
 }
 const char* celix_propertiesIterator_nextKey(celix_properties_iterator_t *iter) {
-    return (const char*)hashMapIterator_nextKey(iter);
+    const char *key = iter->key;
+    celix_stringHashMapIterator_next(iter);
+    return key;
 }
@@ -561,7 +561,7 @@ celix_status_t managedServiceTracker_notifyUpdated(managed_service_tracker_pt tr
     }
 
     // (5.4) asynchUpdate(service,properties)
-    if ((properties == NULL) || (properties != NULL && hashMap_size(properties) == 0)) {
+    if ((properties == NULL) || (properties != NULL && celix_properties_size(properties) == 0)) {
         return managedServiceTracker_asynchUpdated(tracker, service, NULL);
     } else {
         return managedServiceTracker_asynchUpdated(tracker, service, properties);